@@ -1,2 +1,3 @@
 TEMPLATE = subdirs
 SUBDIRS +=  qmltooling
+qtHaveModule(quick): SUBDIRS += scenegraph
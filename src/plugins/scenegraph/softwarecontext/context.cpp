@@ -0,0 +1,158 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "context.h"
+#include "renderer.h"
+#include "pixmaptexture.h"
+#include "rectanglenode.h"
+#include "imagenode.h"
+#include "ninepatchnode.h"
+#include "glyphnode.h"
+#include "painternode.h"
+#include "softwarelayer.h"
+
+QT_BEGIN_NAMESPACE
+
+QSGSoftwareRenderContext::QSGSoftwareRenderContext(QSGContext *context)
+    : QSGRenderContext(context)
+    , m_initialized(false)
+{
+    // Large enough for any sensible item, QImage itself is limited to 32767.
+    m_maxTextureSize = 8192;
+}
+
+QSGSoftwareRenderContext::~QSGSoftwareRenderContext()
+{
+    invalidate();
+}
+
+/*!
+    Marks the context as ready. There is no OpenGL context to attach to, so
+    \a context is expected to be null and is ignored.
+ */
+void QSGSoftwareRenderContext::initialize(QOpenGLContext *context)
+{
+    Q_UNUSED(context);
+    if (m_initialized)
+        return;
+    m_initialized = true;
+    m_sg->renderContextInitialized(this);
+    emit initialized();
+}
+
+void QSGSoftwareRenderContext::invalidate()
+{
+    if (!m_initialized)
+        return;
+
+    qDeleteAll(m_texturesToDelete);
+    m_texturesToDelete.clear();
+
+    qDeleteAll(m_textures.values());
+    m_textures.clear();
+
+    m_initialized = false;
+    m_sg->renderContextInvalidated(this);
+    emit invalidated();
+}
+
+QSGDistanceFieldGlyphCache *QSGSoftwareRenderContext::distanceFieldGlyphCache(const QRawFont &)
+{
+    return 0;
+}
+
+QSGTexture *QSGSoftwareRenderContext::createTexture(const QImage &image) const
+{
+    return new QSGSoftwarePixmapTexture(image);
+}
+
+QSGTexture *QSGSoftwareRenderContext::createTextureNoAtlas(const QImage &image) const
+{
+    return new QSGSoftwarePixmapTexture(image);
+}
+
+QSGRenderer *QSGSoftwareRenderContext::createRenderer()
+{
+    return new QSGSoftwareRenderer(this);
+}
+
+
+QSGSoftwareContext::QSGSoftwareContext(QObject *parent)
+    : QSGContext(parent)
+{
+    setDistanceFieldEnabled(false);
+}
+
+void QSGSoftwareContext::renderContextInitialized(QSGRenderContext *)
+{
+    // The base implementation inspects the OpenGL context; nothing to decide here.
+}
+
+QSGRenderContext *QSGSoftwareContext::createRenderContext()
+{
+    return new QSGSoftwareRenderContext(this);
+}
+
+QSGRectangleNode *QSGSoftwareContext::createRectangleNode()
+{
+    return new QSGSoftwareRectangleNode();
+}
+
+QSGImageNode *QSGSoftwareContext::createImageNode()
+{
+    return new QSGSoftwareImageNode();
+}
+
+QSGPainterNode *QSGSoftwareContext::createPainterNode(QQuickPaintedItem *item)
+{
+    return new QSGSoftwarePainterNode(item);
+}
+
+QSGGlyphNode *QSGSoftwareContext::createGlyphNode(QSGRenderContext *rc, bool preferNativeGlyphNode)
+{
+    Q_UNUSED(rc);
+    Q_UNUSED(preferNativeGlyphNode);
+    return new QSGSoftwareGlyphNode();
+}
+
+QSGNinePatchNode *QSGSoftwareContext::createNinePatchNode()
+{
+    return new QSGSoftwareNinePatchNode();
+}
+
+QSGLayer *QSGSoftwareContext::createLayer(QSGRenderContext *renderContext)
+{
+    return new QSGSoftwareLayer(renderContext);
+}
+
+QT_END_NAMESPACE
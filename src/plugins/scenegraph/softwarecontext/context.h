@@ -0,0 +1,81 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef CONTEXT_H
+#define CONTEXT_H
+
+#include <private/qsgcontext_p.h>
+
+QT_BEGIN_NAMESPACE
+
+class QSGSoftwareRenderContext : public QSGRenderContext
+{
+    Q_OBJECT
+public:
+    QSGSoftwareRenderContext(QSGContext *context);
+    ~QSGSoftwareRenderContext();
+
+    bool isValid() const Q_DECL_OVERRIDE { return m_initialized; }
+    void initialize(QOpenGLContext *context) Q_DECL_OVERRIDE;
+    void invalidate() Q_DECL_OVERRIDE;
+
+    QSGDistanceFieldGlyphCache *distanceFieldGlyphCache(const QRawFont &font) Q_DECL_OVERRIDE;
+
+    QSGTexture *createTexture(const QImage &image) const Q_DECL_OVERRIDE;
+    QSGTexture *createTextureNoAtlas(const QImage &image) const Q_DECL_OVERRIDE;
+    QSGRenderer *createRenderer() Q_DECL_OVERRIDE;
+
+private:
+    bool m_initialized;
+};
+
+class QSGSoftwareContext : public QSGContext
+{
+    Q_OBJECT
+public:
+    explicit QSGSoftwareContext(QObject *parent = 0);
+
+    void renderContextInitialized(QSGRenderContext *renderContext) Q_DECL_OVERRIDE;
+    QSGRenderContext *createRenderContext() Q_DECL_OVERRIDE;
+
+    QSGRectangleNode *createRectangleNode() Q_DECL_OVERRIDE;
+    QSGImageNode *createImageNode() Q_DECL_OVERRIDE;
+    QSGPainterNode *createPainterNode(QQuickPaintedItem *item) Q_DECL_OVERRIDE;
+    QSGGlyphNode *createGlyphNode(QSGRenderContext *rc, bool preferNativeGlyphNode) Q_DECL_OVERRIDE;
+    QSGNinePatchNode *createNinePatchNode() Q_DECL_OVERRIDE;
+    QSGLayer *createLayer(QSGRenderContext *renderContext) Q_DECL_OVERRIDE;
+};
+
+QT_END_NAMESPACE
+
+#endif // CONTEXT_H
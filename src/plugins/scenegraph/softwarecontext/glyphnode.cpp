@@ -0,0 +1,113 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "glyphnode.h"
+
+#include <QtGui/qpainter.h>
+
+QT_BEGIN_NAMESPACE
+
+QSGSoftwareGlyphNode::QSGSoftwareGlyphNode()
+    : m_style(QQuickText::Normal)
+    , m_geometry(QSGGeometry::defaultAttributes_TexturedPoint2D(), 0)
+{
+    // Text nodes set usage patterns on the geometry; it stays empty.
+    setGeometry(&m_geometry);
+}
+
+void QSGSoftwareGlyphNode::setGlyphs(const QPointF &position, const QGlyphRun &glyphs)
+{
+    m_position = position;
+    m_glyphRun = glyphs;
+}
+
+void QSGSoftwareGlyphNode::setColor(const QColor &color)
+{
+    m_color = color;
+}
+
+void QSGSoftwareGlyphNode::setStyle(QQuickText::TextStyle style)
+{
+    m_style = style;
+}
+
+void QSGSoftwareGlyphNode::setStyleColor(const QColor &color)
+{
+    m_styleColor = color;
+}
+
+QPointF QSGSoftwareGlyphNode::baseLine() const
+{
+    return m_position;
+}
+
+void QSGSoftwareGlyphNode::setPreferredAntialiasingMode(AntialiasingMode)
+{
+}
+
+void QSGSoftwareGlyphNode::update()
+{
+    // Leave room for antialiasing and the one pixel style offsets.
+    m_bounding_rect = m_glyphRun.boundingRect().translated(m_position).adjusted(-2, -2, 2, 2);
+    markDirty(DirtyMaterial);
+}
+
+void QSGSoftwareGlyphNode::paint(QPainter *painter)
+{
+    painter->setBrush(QBrush());
+
+    switch (m_style) {
+    case QQuickText::Outline:
+        painter->setPen(m_styleColor);
+        painter->drawGlyphRun(m_position + QPointF(0, 1), m_glyphRun);
+        painter->drawGlyphRun(m_position + QPointF(0, -1), m_glyphRun);
+        painter->drawGlyphRun(m_position + QPointF(1, 0), m_glyphRun);
+        painter->drawGlyphRun(m_position + QPointF(-1, 0), m_glyphRun);
+        break;
+    case QQuickText::Raised:
+        painter->setPen(m_styleColor);
+        painter->drawGlyphRun(m_position + QPointF(0, 1), m_glyphRun);
+        break;
+    case QQuickText::Sunken:
+        painter->setPen(m_styleColor);
+        painter->drawGlyphRun(m_position + QPointF(0, -1), m_glyphRun);
+        break;
+    case QQuickText::Normal:
+        break;
+    }
+
+    painter->setPen(m_color);
+    painter->drawGlyphRun(m_position, m_glyphRun);
+}
+
+QT_END_NAMESPACE
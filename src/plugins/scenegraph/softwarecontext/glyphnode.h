@@ -0,0 +1,68 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef GLYPHNODE_H
+#define GLYPHNODE_H
+
+#include <private/qsgadaptationlayer_p.h>
+
+QT_BEGIN_NAMESPACE
+
+class QSGSoftwareGlyphNode : public QSGGlyphNode
+{
+public:
+    QSGSoftwareGlyphNode();
+
+    void setGlyphs(const QPointF &position, const QGlyphRun &glyphs) Q_DECL_OVERRIDE;
+    void setColor(const QColor &color) Q_DECL_OVERRIDE;
+    void setStyle(QQuickText::TextStyle style) Q_DECL_OVERRIDE;
+    void setStyleColor(const QColor &color) Q_DECL_OVERRIDE;
+    QPointF baseLine() const Q_DECL_OVERRIDE;
+    void setPreferredAntialiasingMode(AntialiasingMode) Q_DECL_OVERRIDE;
+
+    void update() Q_DECL_OVERRIDE;
+
+    void paint(QPainter *painter);
+
+private:
+    QPointF m_position;
+    QGlyphRun m_glyphRun;
+    QColor m_color;
+    QQuickText::TextStyle m_style;
+    QColor m_styleColor;
+    QSGGeometry m_geometry;
+};
+
+QT_END_NAMESPACE
+
+#endif // GLYPHNODE_H
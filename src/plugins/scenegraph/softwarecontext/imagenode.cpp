@@ -0,0 +1,201 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "imagenode.h"
+#include "pixmaptexture.h"
+
+#include <QtGui/qpainter.h>
+#include <QtCore/qmath.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Draws the \a source part of \a pixmap into \a target, showing the window
+    \a subSourceRect of the source repeated infinitely in both directions.
+ */
+static void qsgSoftwareDrawTiles(QPainter *painter, const QPixmap &pixmap, const QRectF &target,
+                                 const QRectF &source, const QRectF &subSourceRect)
+{
+    if (target.isEmpty() || source.isEmpty() || subSourceRect.isEmpty())
+        return;
+
+    if (subSourceRect.left() >= 0 && subSourceRect.top() >= 0
+        && subSourceRect.right() <= 1 && subSourceRect.bottom() <= 1) {
+        const QRectF subSource(source.x() + subSourceRect.x() * source.width(),
+                               source.y() + subSourceRect.y() * source.height(),
+                               subSourceRect.width() * source.width(),
+                               subSourceRect.height() * source.height());
+        painter->drawPixmap(target, pixmap, subSource);
+        return;
+    }
+
+    const qreal tileWidth = target.width() / subSourceRect.width();
+    const qreal tileHeight = target.height() / subSourceRect.height();
+    const qreal xOffset = subSourceRect.x() - qFloor(subSourceRect.x());
+    const qreal yOffset = subSourceRect.y() - qFloor(subSourceRect.y());
+
+    // Unscaled tiling of the whole pixmap is handled natively by the raster engine.
+    if (source == QRectF(pixmap.rect())
+        && qFuzzyCompare(tileWidth, source.width()) && qFuzzyCompare(tileHeight, source.height())) {
+        painter->drawTiledPixmap(target, pixmap, QPointF(xOffset * source.width(), yOffset * source.height()));
+        return;
+    }
+
+    painter->save();
+    painter->setClipRect(target, Qt::IntersectClip);
+    const int firstColumn = qFloor(subSourceRect.left());
+    const int lastColumn = qCeil(subSourceRect.right());
+    const int firstRow = qFloor(subSourceRect.top());
+    const int lastRow = qCeil(subSourceRect.bottom());
+    for (int row = firstRow; row < lastRow; ++row) {
+        const qreal y = target.y() + (row - subSourceRect.y()) * tileHeight;
+        for (int column = firstColumn; column < lastColumn; ++column) {
+            const qreal x = target.x() + (column - subSourceRect.x()) * tileWidth;
+            painter->drawPixmap(QRectF(x, y, tileWidth, tileHeight), pixmap, source);
+        }
+    }
+    painter->restore();
+}
+
+void qsgSoftwareDrawNinePatch(QPainter *painter, const QPixmap &pixmap,
+                              const QRectF &targetRect, const QRectF &innerTargetRect,
+                              const QRectF &innerSourceRect, const QRectF &subSourceRect)
+{
+    if (innerTargetRect == targetRect) {
+        qsgSoftwareDrawTiles(painter, pixmap, targetRect, innerSourceRect, subSourceRect);
+        return;
+    }
+
+    const QRectF sourceRect(pixmap.rect());
+    const qreal tx[4] = { targetRect.left(), innerTargetRect.left(), innerTargetRect.right(), targetRect.right() };
+    const qreal ty[4] = { targetRect.top(), innerTargetRect.top(), innerTargetRect.bottom(), targetRect.bottom() };
+    const qreal sx[4] = { sourceRect.left(), innerSourceRect.left(), innerSourceRect.right(), sourceRect.right() };
+    const qreal sy[4] = { sourceRect.top(), innerSourceRect.top(), innerSourceRect.bottom(), sourceRect.bottom() };
+
+    for (int row = 0; row < 3; ++row) {
+        for (int column = 0; column < 3; ++column) {
+            // Corners are stretched, edges and the center repeat along the inner axis.
+            const QRectF sub(column == 1 ? subSourceRect.x() : 0, row == 1 ? subSourceRect.y() : 0,
+                             column == 1 ? subSourceRect.width() : 1, row == 1 ? subSourceRect.height() : 1);
+            qsgSoftwareDrawTiles(painter, pixmap,
+                                 QRectF(QPointF(tx[column], ty[row]), QPointF(tx[column + 1], ty[row + 1])),
+                                 QRectF(QPointF(sx[column], sy[row]), QPointF(sx[column + 1], sy[row + 1])),
+                                 sub);
+        }
+    }
+}
+
+QSGSoftwareImageNode::QSGSoftwareImageNode()
+    : m_innerSourceRect(0, 0, 1, 1)
+    , m_subSourceRect(0, 0, 1, 1)
+    , m_texture(0)
+    , m_mirror(false)
+    , m_smooth(true)
+{
+}
+
+void QSGSoftwareImageNode::setTargetRect(const QRectF &rect)
+{
+    m_targetRect = rect;
+}
+
+void QSGSoftwareImageNode::setInnerTargetRect(const QRectF &rect)
+{
+    m_innerTargetRect = rect;
+}
+
+void QSGSoftwareImageNode::setInnerSourceRect(const QRectF &rect)
+{
+    m_innerSourceRect = rect;
+}
+
+void QSGSoftwareImageNode::setSubSourceRect(const QRectF &rect)
+{
+    m_subSourceRect = rect;
+}
+
+void QSGSoftwareImageNode::setTexture(QSGTexture *texture)
+{
+    m_texture = texture;
+}
+
+void QSGSoftwareImageNode::setMirror(bool mirror)
+{
+    m_mirror = mirror;
+}
+
+void QSGSoftwareImageNode::setMipmapFiltering(QSGTexture::Filtering)
+{
+}
+
+void QSGSoftwareImageNode::setFiltering(QSGTexture::Filtering filtering)
+{
+    m_smooth = filtering == QSGTexture::Linear;
+}
+
+void QSGSoftwareImageNode::setHorizontalWrapMode(QSGTexture::WrapMode)
+{
+    // Repetition is fully described by the sub-source rect.
+}
+
+void QSGSoftwareImageNode::setVerticalWrapMode(QSGTexture::WrapMode)
+{
+}
+
+void QSGSoftwareImageNode::update()
+{
+    markDirty(DirtyMaterial);
+}
+
+void QSGSoftwareImageNode::paint(QPainter *painter)
+{
+    const QPixmap pixmap = qsgSoftwarePixmap(m_texture);
+    if (pixmap.isNull())
+        return;
+
+    painter->setRenderHint(QPainter::SmoothPixmapTransform, m_smooth);
+
+    if (m_mirror) {
+        painter->translate(m_targetRect.left() + m_targetRect.right(), 0);
+        painter->scale(-1, 1);
+    }
+
+    const QRectF innerSourceRect(m_innerSourceRect.x() * pixmap.width(),
+                                 m_innerSourceRect.y() * pixmap.height(),
+                                 m_innerSourceRect.width() * pixmap.width(),
+                                 m_innerSourceRect.height() * pixmap.height());
+    qsgSoftwareDrawNinePatch(painter, pixmap, m_targetRect, m_innerTargetRect,
+                             innerSourceRect, m_subSourceRect);
+}
+
+QT_END_NAMESPACE
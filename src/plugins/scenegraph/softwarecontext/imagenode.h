@@ -0,0 +1,82 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef IMAGENODE_H
+#define IMAGENODE_H
+
+#include <private/qsgadaptationlayer_p.h>
+
+QT_BEGIN_NAMESPACE
+
+// Draws \a pixmap into \a targetRect as a 3x3 grid split by the inner rectangles.
+// The middle row and column repeat the inner source as specified by \a subSourceRect.
+void qsgSoftwareDrawNinePatch(QPainter *painter, const QPixmap &pixmap,
+                              const QRectF &targetRect, const QRectF &innerTargetRect,
+                              const QRectF &innerSourceRect, const QRectF &subSourceRect);
+
+class QSGSoftwareImageNode : public QSGImageNode
+{
+public:
+    QSGSoftwareImageNode();
+
+    void setTargetRect(const QRectF &rect) Q_DECL_OVERRIDE;
+    void setInnerTargetRect(const QRectF &rect) Q_DECL_OVERRIDE;
+    void setInnerSourceRect(const QRectF &rect) Q_DECL_OVERRIDE;
+    void setSubSourceRect(const QRectF &rect) Q_DECL_OVERRIDE;
+    void setTexture(QSGTexture *texture) Q_DECL_OVERRIDE;
+    void setMirror(bool mirror) Q_DECL_OVERRIDE;
+    void setMipmapFiltering(QSGTexture::Filtering filtering) Q_DECL_OVERRIDE;
+    void setFiltering(QSGTexture::Filtering filtering) Q_DECL_OVERRIDE;
+    void setHorizontalWrapMode(QSGTexture::WrapMode wrapMode) Q_DECL_OVERRIDE;
+    void setVerticalWrapMode(QSGTexture::WrapMode wrapMode) Q_DECL_OVERRIDE;
+
+    void update() Q_DECL_OVERRIDE;
+
+    QRectF rect() const { return m_targetRect; }
+    QSGTexture *texture() const { return m_texture; }
+    void paint(QPainter *painter);
+
+private:
+    QRectF m_targetRect;
+    QRectF m_innerTargetRect;
+    QRectF m_innerSourceRect;
+    QRectF m_subSourceRect;
+    QSGTexture *m_texture;
+
+    bool m_mirror;
+    bool m_smooth;
+};
+
+QT_END_NAMESPACE
+
+#endif // IMAGENODE_H
@@ -0,0 +1,88 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "ninepatchnode.h"
+#include "imagenode.h"
+#include "pixmaptexture.h"
+
+#include <QtGui/qpainter.h>
+
+QT_BEGIN_NAMESPACE
+
+QSGSoftwareNinePatchNode::QSGSoftwareNinePatchNode()
+    : m_texture(0)
+    , m_pixelRatio(1)
+{
+}
+
+void QSGSoftwareNinePatchNode::setTexture(QSGTexture *texture)
+{
+    m_texture = texture;
+}
+
+void QSGSoftwareNinePatchNode::setBounds(const QRectF &bounds)
+{
+    m_bounds = bounds;
+}
+
+void QSGSoftwareNinePatchNode::setDevicePixelRatio(qreal ratio)
+{
+    m_pixelRatio = ratio;
+}
+
+void QSGSoftwareNinePatchNode::setPadding(qreal left, qreal top, qreal right, qreal bottom)
+{
+    m_margins = QMarginsF(left, top, right, bottom);
+}
+
+void QSGSoftwareNinePatchNode::update()
+{
+    markDirty(DirtyMaterial);
+}
+
+void QSGSoftwareNinePatchNode::paint(QPainter *painter)
+{
+    const QPixmap pixmap = qsgSoftwarePixmap(m_texture);
+    if (pixmap.isNull())
+        return;
+
+    // The padding is given in logical pixels, the texture in device pixels.
+    const QRectF sourceRect(pixmap.rect());
+    const QRectF innerSourceRect = sourceRect - m_margins * m_pixelRatio;
+    const QRectF innerTargetRect = m_bounds - m_margins;
+
+    painter->setRenderHint(QPainter::SmoothPixmapTransform, true);
+    qsgSoftwareDrawNinePatch(painter, pixmap, m_bounds, innerTargetRect, innerSourceRect, QRectF(0, 0, 1, 1));
+}
+
+QT_END_NAMESPACE
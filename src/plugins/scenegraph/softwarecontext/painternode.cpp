@@ -0,0 +1,193 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "painternode.h"
+#include "pixmaptexture.h"
+
+#include <QtGui/qpainter.h>
+#include <QtCore/qmath.h>
+
+QT_BEGIN_NAMESPACE
+
+QSGSoftwarePainterNode::QSGSoftwarePainterNode(QQuickPaintedItem *item)
+    : m_item(item)
+    , m_texture(0)
+    , m_contentsScale(1)
+    , m_dirtyContents(false)
+    , m_dirtyImage(false)
+    , m_dirtyTexture(false)
+    , m_opaquePainting(false)
+    , m_linear_filtering(false)
+    , m_smoothPainting(false)
+{
+}
+
+QSGSoftwarePainterNode::~QSGSoftwarePainterNode()
+{
+    delete m_texture;
+}
+
+void QSGSoftwarePainterNode::setPreferredRenderTarget(QQuickPaintedItem::RenderTarget)
+{
+    // Every render target is an image when painting in software.
+}
+
+void QSGSoftwarePainterNode::setSize(const QSize &size)
+{
+    if (size == m_size)
+        return;
+    m_size = size;
+    m_dirtyImage = true;
+    m_dirtyContents = true;
+}
+
+void QSGSoftwarePainterNode::setDirty(const QRect &dirtyRect)
+{
+    m_dirtyContents = true;
+    m_dirtyRect = dirtyRect;
+}
+
+void QSGSoftwarePainterNode::setOpaquePainting(bool opaque)
+{
+    if (opaque == m_opaquePainting)
+        return;
+    m_opaquePainting = opaque;
+    m_dirtyImage = true;
+}
+
+void QSGSoftwarePainterNode::setLinearFiltering(bool linearFiltering)
+{
+    m_linear_filtering = linearFiltering;
+}
+
+void QSGSoftwarePainterNode::setMipmapping(bool)
+{
+}
+
+void QSGSoftwarePainterNode::setSmoothPainting(bool s)
+{
+    m_smoothPainting = s;
+}
+
+void QSGSoftwarePainterNode::setFillColor(const QColor &c)
+{
+    if (c == m_fillColor)
+        return;
+    m_fillColor = c;
+    m_dirtyContents = true;
+}
+
+void QSGSoftwarePainterNode::setContentsScale(qreal s)
+{
+    if (s == m_contentsScale)
+        return;
+    m_contentsScale = s;
+    m_dirtyContents = true;
+}
+
+void QSGSoftwarePainterNode::setFastFBOResizing(bool)
+{
+}
+
+QImage QSGSoftwarePainterNode::toImage() const
+{
+    return m_image;
+}
+
+void QSGSoftwarePainterNode::update()
+{
+    if (m_dirtyImage) {
+        m_image = QImage(m_size, m_opaquePainting ? QImage::Format_RGB32 : QImage::Format_ARGB32_Premultiplied);
+        m_dirtyRect = QRect();
+        m_dirtyImage = false;
+        m_dirtyContents = true;
+    }
+
+    if (m_dirtyContents) {
+        paintContents();
+        m_dirtyContents = false;
+        m_dirtyTexture = true;
+        markDirty(DirtyMaterial);
+    }
+}
+
+QSGTexture *QSGSoftwarePainterNode::texture() const
+{
+    if (!m_texture) {
+        m_texture = new QSGSoftwarePixmapTexture(m_image);
+        m_dirtyTexture = false;
+    } else if (m_dirtyTexture) {
+        m_texture->setPixmap(QPixmap::fromImage(m_image));
+        m_dirtyTexture = false;
+    }
+    return m_texture;
+}
+
+void QSGSoftwarePainterNode::paintContents()
+{
+    if (m_image.isNull())
+        return;
+
+    const QRect dirtyRect = m_dirtyRect.isNull() ? QRect(QPoint(), m_size) : m_dirtyRect;
+
+    QPainter painter(&m_image);
+    if (m_smoothPainting)
+        painter.setRenderHints(QPainter::Antialiasing | QPainter::TextAntialiasing | QPainter::SmoothPixmapTransform);
+
+    painter.scale(m_contentsScale, m_contentsScale);
+
+    QRect sclip(qFloor(dirtyRect.x()/m_contentsScale),
+                qFloor(dirtyRect.y()/m_contentsScale),
+                qCeil(dirtyRect.width()/m_contentsScale+dirtyRect.x()/m_contentsScale-qFloor(dirtyRect.x()/m_contentsScale)),
+                qCeil(dirtyRect.height()/m_contentsScale+dirtyRect.y()/m_contentsScale-qFloor(dirtyRect.y()/m_contentsScale)));
+
+    if (!m_dirtyRect.isNull())
+        painter.setClipRect(sclip);
+
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+    painter.fillRect(sclip, m_fillColor);
+    painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+
+    m_item->paint(&painter);
+    painter.end();
+
+    m_dirtyRect = QRect();
+}
+
+void QSGSoftwarePainterNode::paint(QPainter *painter)
+{
+    painter->setRenderHint(QPainter::SmoothPixmapTransform, m_linear_filtering);
+    painter->drawImage(QPointF(), m_image);
+}
+
+QT_END_NAMESPACE
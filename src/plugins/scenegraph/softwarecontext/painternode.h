@@ -0,0 +1,92 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef PAINTERNODE_H
+#define PAINTERNODE_H
+
+#include <private/qsgadaptationlayer_p.h>
+
+#include <QtGui/qimage.h>
+
+QT_BEGIN_NAMESPACE
+
+class QSGSoftwarePixmapTexture;
+
+class QSGSoftwarePainterNode : public QSGPainterNode
+{
+public:
+    QSGSoftwarePainterNode(QQuickPaintedItem *item);
+    ~QSGSoftwarePainterNode();
+
+    void setPreferredRenderTarget(QQuickPaintedItem::RenderTarget target) Q_DECL_OVERRIDE;
+    void setSize(const QSize &size) Q_DECL_OVERRIDE;
+    QSize size() const { return m_size; }
+
+    void setDirty(const QRect &dirtyRect = QRect()) Q_DECL_OVERRIDE;
+    void setOpaquePainting(bool opaque) Q_DECL_OVERRIDE;
+    void setLinearFiltering(bool linearFiltering) Q_DECL_OVERRIDE;
+    void setMipmapping(bool mipmapping) Q_DECL_OVERRIDE;
+    void setSmoothPainting(bool s) Q_DECL_OVERRIDE;
+    void setFillColor(const QColor &c) Q_DECL_OVERRIDE;
+    void setContentsScale(qreal s) Q_DECL_OVERRIDE;
+    void setFastFBOResizing(bool dynamic) Q_DECL_OVERRIDE;
+
+    QImage toImage() const Q_DECL_OVERRIDE;
+    void update() Q_DECL_OVERRIDE;
+    QSGTexture *texture() const Q_DECL_OVERRIDE;
+
+    void paint(QPainter *painter);
+
+private:
+    void paintContents();
+
+    QQuickPaintedItem *m_item;
+    QImage m_image;
+    mutable QSGSoftwarePixmapTexture *m_texture;
+
+    QSize m_size;
+    QRect m_dirtyRect;
+    QColor m_fillColor;
+    qreal m_contentsScale;
+
+    bool m_dirtyContents : 1;
+    bool m_dirtyImage : 1;
+    mutable bool m_dirtyTexture : 1;
+    bool m_opaquePainting : 1;
+    bool m_linear_filtering : 1;
+    bool m_smoothPainting : 1;
+};
+
+QT_END_NAMESPACE
+
+#endif // PAINTERNODE_H
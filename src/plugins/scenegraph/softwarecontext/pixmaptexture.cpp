@@ -0,0 +1,90 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "pixmaptexture.h"
+#include "softwarelayer.h"
+
+QT_BEGIN_NAMESPACE
+
+QSGSoftwarePixmapTexture::QSGSoftwarePixmapTexture(const QImage &image)
+    : m_pixmap(QPixmap::fromImage(image))
+{
+}
+
+QSGSoftwarePixmapTexture::QSGSoftwarePixmapTexture(const QPixmap &pixmap)
+    : m_pixmap(pixmap)
+{
+}
+
+int QSGSoftwarePixmapTexture::textureId() const
+{
+    return 0;
+}
+
+QSize QSGSoftwarePixmapTexture::textureSize() const
+{
+    return m_pixmap.size();
+}
+
+bool QSGSoftwarePixmapTexture::hasAlphaChannel() const
+{
+    return m_pixmap.hasAlphaChannel();
+}
+
+bool QSGSoftwarePixmapTexture::hasMipmaps() const
+{
+    return false;
+}
+
+void QSGSoftwarePixmapTexture::bind()
+{
+    // There is no OpenGL texture; nodes draw pixmap() directly.
+}
+
+QPixmap qsgSoftwarePixmap(QSGTexture *texture)
+{
+    if (QSGSoftwarePixmapTexture *pt = qobject_cast<QSGSoftwarePixmapTexture *>(texture))
+        return pt->pixmap();
+    if (QSGSoftwareLayer *layer = qobject_cast<QSGSoftwareLayer *>(texture))
+        return layer->pixmap();
+    return QPixmap();
+}
+
+quint64 qsgSoftwareContentKey(QSGTexture *texture)
+{
+    if (QSGSoftwareLayer *layer = qobject_cast<QSGSoftwareLayer *>(texture))
+        return layer->generation();
+    return 0;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,71 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef PIXMAPTEXTURE_H
+#define PIXMAPTEXTURE_H
+
+#include <QtQuick/qsgtexture.h>
+#include <QtGui/qpixmap.h>
+
+QT_BEGIN_NAMESPACE
+
+class QSGSoftwarePixmapTexture : public QSGTexture
+{
+    Q_OBJECT
+public:
+    QSGSoftwarePixmapTexture(const QImage &image);
+    QSGSoftwarePixmapTexture(const QPixmap &pixmap);
+
+    int textureId() const Q_DECL_OVERRIDE;
+    QSize textureSize() const Q_DECL_OVERRIDE;
+    bool hasAlphaChannel() const Q_DECL_OVERRIDE;
+    bool hasMipmaps() const Q_DECL_OVERRIDE;
+    void bind() Q_DECL_OVERRIDE;
+
+    const QPixmap &pixmap() const { return m_pixmap; }
+    void setPixmap(const QPixmap &pixmap) { m_pixmap = pixmap; }
+
+private:
+    QPixmap m_pixmap;
+};
+
+// Returns the pixmap backing a texture created by the software context, or a
+// null pixmap for textures that only exist in OpenGL.
+QPixmap qsgSoftwarePixmap(QSGTexture *texture);
+
+// Identifies the current contents of a texture; changes when a layer is regrabbed.
+quint64 qsgSoftwareContentKey(QSGTexture *texture);
+
+QT_END_NAMESPACE
+
+#endif // PIXMAPTEXTURE_H
@@ -0,0 +1,143 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "rectanglenode.h"
+
+#include <QtGui/qpainter.h>
+
+QT_BEGIN_NAMESPACE
+
+QSGSoftwareRectangleNode::QSGSoftwareRectangleNode()
+    : m_penWidth(0)
+    , m_radius(0)
+    , m_antialiasing(false)
+    , m_aligned(true)
+{
+}
+
+void QSGSoftwareRectangleNode::setRect(const QRectF &rect)
+{
+    m_rect = rect;
+}
+
+void QSGSoftwareRectangleNode::setColor(const QColor &color)
+{
+    m_color = color;
+}
+
+void QSGSoftwareRectangleNode::setPenColor(const QColor &color)
+{
+    m_penColor = color;
+}
+
+void QSGSoftwareRectangleNode::setPenWidth(qreal width)
+{
+    m_penWidth = width;
+}
+
+void QSGSoftwareRectangleNode::setGradientStops(const QGradientStops &stops)
+{
+    m_stops = stops;
+}
+
+void QSGSoftwareRectangleNode::setRadius(qreal radius)
+{
+    m_radius = radius;
+}
+
+void QSGSoftwareRectangleNode::setAntialiasing(bool antialiasing)
+{
+    m_antialiasing = antialiasing;
+}
+
+void QSGSoftwareRectangleNode::setAligned(bool aligned)
+{
+    m_aligned = aligned;
+}
+
+void QSGSoftwareRectangleNode::update()
+{
+    if (m_penWidth > 0 && m_penColor.alpha() > 0) {
+        m_pen = QPen(m_penColor, m_penWidth);
+        m_pen.setJoinStyle(Qt::MiterJoin);
+    } else {
+        m_pen = QPen(Qt::NoPen);
+    }
+
+    if (!m_stops.isEmpty()) {
+        QLinearGradient gradient(m_rect.topLeft(), m_rect.bottomLeft());
+        gradient.setStops(m_stops);
+        m_brush = QBrush(gradient);
+    } else if (m_color.alpha() > 0) {
+        m_brush = QBrush(m_color);
+    } else {
+        m_brush = QBrush();
+    }
+
+    markDirty(DirtyMaterial);
+}
+
+void QSGSoftwareRectangleNode::paint(QPainter *painter)
+{
+    const bool hasPen = m_pen.style() != Qt::NoPen;
+
+    // The common case of a plain, square filled rectangle maps onto a span fill.
+    if (!hasPen && m_radius <= 0 && m_stops.isEmpty()) {
+        if (m_brush.style() != Qt::NoBrush)
+            painter->fillRect(m_rect, m_color);
+        return;
+    }
+
+    painter->setRenderHint(QPainter::Antialiasing, m_antialiasing || m_radius > 0);
+
+    // The border is drawn inside the rectangle, as with the default node.
+    const qreal halfPen = hasPen ? m_penWidth / 2 : 0;
+    const QRectF innerRect = m_rect.adjusted(halfPen, halfPen, -halfPen, -halfPen);
+    if (hasPen && (innerRect.width() <= 0 || innerRect.height() <= 0)) {
+        // The border covers the whole rectangle.
+        painter->setPen(Qt::NoPen);
+        painter->setBrush(m_penColor);
+    } else {
+        painter->setPen(m_pen);
+        painter->setBrush(m_brush);
+    }
+
+    const QRectF rect = innerRect.width() > 0 && innerRect.height() > 0 ? innerRect : m_rect;
+    const qreal radius = qMin(m_radius, qMin(m_rect.width(), m_rect.height()) / 2) - halfPen;
+    if (radius > 0)
+        painter->drawRoundedRect(rect, radius, radius);
+    else
+        painter->drawRect(rect);
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,79 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef RECTANGLENODE_H
+#define RECTANGLENODE_H
+
+#include <private/qsgadaptationlayer_p.h>
+
+#include <QtGui/qbrush.h>
+#include <QtGui/qpen.h>
+
+QT_BEGIN_NAMESPACE
+
+class QSGSoftwareRectangleNode : public QSGRectangleNode
+{
+public:
+    QSGSoftwareRectangleNode();
+
+    void setRect(const QRectF &rect) Q_DECL_OVERRIDE;
+    void setColor(const QColor &color) Q_DECL_OVERRIDE;
+    void setPenColor(const QColor &color) Q_DECL_OVERRIDE;
+    void setPenWidth(qreal width) Q_DECL_OVERRIDE;
+    void setGradientStops(const QGradientStops &stops) Q_DECL_OVERRIDE;
+    void setRadius(qreal radius) Q_DECL_OVERRIDE;
+    void setAntialiasing(bool antialiasing) Q_DECL_OVERRIDE;
+    void setAligned(bool aligned) Q_DECL_OVERRIDE;
+
+    void update() Q_DECL_OVERRIDE;
+
+    QRectF rect() const { return m_rect; }
+    void paint(QPainter *painter);
+
+private:
+    QRectF m_rect;
+    QColor m_color;
+    QColor m_penColor;
+    qreal m_penWidth;
+    QGradientStops m_stops;
+    qreal m_radius;
+    QPen m_pen;
+    QBrush m_brush;
+
+    bool m_antialiasing;
+    bool m_aligned;
+};
+
+QT_END_NAMESPACE
+
+#endif // RECTANGLENODE_H
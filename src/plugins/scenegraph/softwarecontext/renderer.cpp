@@ -0,0 +1,541 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "renderer.h"
+#include "rectanglenode.h"
+#include "imagenode.h"
+#include "ninepatchnode.h"
+#include "glyphnode.h"
+#include "painternode.h"
+#include "pixmaptexture.h"
+
+#include <QtQuick/qsgflatcolormaterial.h>
+#include <QtQuick/qsgtexturematerial.h>
+#include <QtGui/qbackingstore.h>
+#include <QtGui/qpainter.h>
+#include <QtCore/qbitarray.h>
+
+QT_BEGIN_NAMESPACE
+
+// Beyond this many rectangles the dirty region is painted as its bounding rect.
+static const int maxDirtyRects = 16;
+
+namespace {
+
+class NoBindable : public QSGBindable
+{
+public:
+    void bind() const Q_DECL_OVERRIDE { }
+    void clear(QSGAbstractRenderer::ClearMode) const Q_DECL_OVERRIDE { }
+    void reactivate() const Q_DECL_OVERRIDE { }
+};
+
+}
+
+static QSGMaterialType *flatColorMaterialType()
+{
+    static QSGMaterialType *type = QSGFlatColorMaterial().type();
+    return type;
+}
+
+static QSGMaterialType *opaqueTextureMaterialType()
+{
+    static QSGMaterialType *type = QSGOpaqueTextureMaterial().type();
+    return type;
+}
+
+static QSGMaterialType *textureMaterialType()
+{
+    static QSGMaterialType *type = QSGTextureMaterial().type();
+    return type;
+}
+
+// Only axis aligned quads, as produced by QSGGeometry::updateRectGeometry() and
+// updateTexturedRectGeometry(), have a QPainter equivalent.
+static bool isRectGeometry(const QSGGeometry *g)
+{
+    return g->drawingMode() == GL_TRIANGLE_STRIP && g->vertexCount() == 4 && g->indexCount() == 0
+            && g->attributeCount() >= 1 && g->attributes()[0].tupleSize == 2
+            && g->attributes()[0].type == GL_FLOAT;
+}
+
+static QRectF geometryBounds(const QSGGeometry *g)
+{
+    const char *data = static_cast<const char *>(g->vertexData());
+    const int stride = g->sizeOfVertex();
+    qreal left = 0, top = 0, right = 0, bottom = 0;
+    for (int i = 0; i < g->vertexCount(); ++i) {
+        const float *v = reinterpret_cast<const float *>(data + i * stride);
+        if (i == 0 || v[0] < left)
+            left = v[0];
+        if (i == 0 || v[0] > right)
+            right = v[0];
+        if (i == 0 || v[1] < top)
+            top = v[1];
+        if (i == 0 || v[1] > bottom)
+            bottom = v[1];
+    }
+    return QRectF(QPointF(left, top), QPointF(right, bottom));
+}
+
+static QRectF textureSourceRect(const QSGGeometry *g, const QSize &textureSize)
+{
+    const QSGGeometry::TexturedPoint2D *v = g->vertexDataAsTexturedPoint2D();
+    qreal left = v[0].tx, top = v[0].ty, right = v[0].tx, bottom = v[0].ty;
+    for (int i = 1; i < g->vertexCount(); ++i) {
+        left = qMin<qreal>(left, v[i].tx);
+        right = qMax<qreal>(right, v[i].tx);
+        top = qMin<qreal>(top, v[i].ty);
+        bottom = qMax<qreal>(bottom, v[i].ty);
+    }
+    return QRectF(left * textureSize.width(), top * textureSize.height(),
+                  (right - left) * textureSize.width(), (bottom - top) * textureSize.height());
+}
+
+/*!
+    \class QSGSoftwareRenderer
+    \internal
+
+    Paints the scene graph with QPainter, repainting only what changed.
+
+    Each frame the tree is flattened into a list of renderables holding the
+    combined transform, opacity and clip of each drawable node together with
+    its bounding rect in target coordinates. The list is compared against the
+    previous frame's: nodes that were added, removed, moved, clipped
+    differently or whose content was marked dirty contribute their old and new
+    bounding rects to the dirty region. Only renderables intersecting that
+    region are painted, clipped to it, and only it needs to be flushed.
+ */
+
+QSGSoftwareRenderer::QSGSoftwareRenderer(QSGRenderContext *context)
+    : QSGRenderer(context)
+    , m_dirtySubtreeDepth(0)
+    , m_backingStore(0)
+    , m_paintDevice(0)
+    , m_fullRepaint(true)
+{
+}
+
+QSGSoftwareRenderer::~QSGSoftwareRenderer()
+{
+}
+
+void QSGSoftwareRenderer::renderScene(GLuint fboId)
+{
+    Q_UNUSED(fboId);
+    m_flushRegion = QRegion();
+    QSGRenderer::renderScene(NoBindable());
+}
+
+void QSGSoftwareRenderer::nodeChanged(QSGNode *node, QSGNode::DirtyState state)
+{
+    // Matrix, opacity and clip changes show up when comparing against the previous
+    // frame; content changes and reinsertions have to be remembered here. Removed
+    // nodes may already be half destroyed and are only found missing next frame.
+    if (state & QSGNode::DirtyNodeRemoved)
+        m_dirtyNodes.remove(node);
+    if (state & (QSGNode::DirtyMaterial | QSGNode::DirtyGeometry | QSGNode::DirtyNodeAdded))
+        m_dirtyNodes.insert(node);
+
+    QSGRenderer::nodeChanged(node, state);
+}
+
+void QSGSoftwareRenderer::enterNode(QSGNode *node)
+{
+    if (!m_dirtyNodes.isEmpty() && m_dirtyNodes.contains(node))
+        ++m_dirtySubtreeDepth;
+}
+
+void QSGSoftwareRenderer::leaveNode(QSGNode *node)
+{
+    if (!m_dirtyNodes.isEmpty() && m_dirtyNodes.contains(node))
+        --m_dirtySubtreeDepth;
+}
+
+void QSGSoftwareRenderer::pushState()
+{
+    m_stateStack.push(m_state);
+}
+
+void QSGSoftwareRenderer::popState()
+{
+    m_state = m_stateStack.pop();
+}
+
+void QSGSoftwareRenderer::addRenderable(QSGNode *node, RenderableType type, const QRectF &bounds, quint64 contentKey)
+{
+    if (bounds.isEmpty())
+        return;
+
+    // One pixel of slack for antialiased and subpixel positioned edges.
+    QRect boundingRect = m_state.transform.mapRect(bounds).toAlignedRect().adjusted(-1, -1, 1, 1);
+    boundingRect &= m_state.clipped ? m_state.clip.boundingRect() & m_targetRect : m_targetRect;
+    if (boundingRect.isEmpty())
+        return;
+
+    Renderable r;
+    r.node = node;
+    r.type = type;
+    r.transform = m_state.transform;
+    r.boundingRect = boundingRect;
+    r.clip = m_state.clip;
+    r.opacity = m_state.opacity;
+    r.contentKey = contentKey;
+    r.clipped = m_state.clipped;
+    r.dirty = m_dirtySubtreeDepth > 0;
+    m_renderables.append(r);
+}
+
+bool QSGSoftwareRenderer::Renderable::isSameState(const Renderable &other) const
+{
+    return type == other.type
+            && boundingRect == other.boundingRect
+            && opacity == other.opacity
+            && contentKey == other.contentKey
+            && clipped == other.clipped
+            && transform == other.transform
+            && (!clipped || clip == other.clip);
+}
+
+bool QSGSoftwareRenderer::visit(QSGTransformNode *node)
+{
+    enterNode(node);
+    pushState();
+    m_state.transform = node->matrix().toTransform() * m_state.transform;
+    return true;
+}
+
+void QSGSoftwareRenderer::endVisit(QSGTransformNode *node)
+{
+    popState();
+    leaveNode(node);
+}
+
+bool QSGSoftwareRenderer::visit(QSGClipNode *node)
+{
+    enterNode(node);
+    pushState();
+
+    QRegion clip;
+    if (node->isRectangular()) {
+        if (m_state.transform.type() <= QTransform::TxScale)
+            clip = QRegion(m_state.transform.mapRect(node->clipRect()).toAlignedRect());
+        else
+            clip = QRegion(m_state.transform.map(QPolygonF(node->clipRect())).toPolygon());
+    } else if (node->geometry()) {
+        // Arbitrary clip shapes are approximated by their bounds.
+        clip = QRegion(m_state.transform.mapRect(geometryBounds(node->geometry())).toAlignedRect());
+    }
+
+    m_state.clip = m_state.clipped ? m_state.clip & clip : clip;
+    m_state.clipped = true;
+    return !m_state.clip.isEmpty();
+}
+
+void QSGSoftwareRenderer::endVisit(QSGClipNode *node)
+{
+    popState();
+    leaveNode(node);
+}
+
+bool QSGSoftwareRenderer::visit(QSGGeometryNode *node)
+{
+    enterNode(node);
+
+    const QSGGeometry *g = node->geometry();
+    QSGMaterial *material = node->material();
+    if (!g || !material || !isRectGeometry(g))
+        return true;
+
+    // Custom materials need OpenGL and are skipped.
+    QSGMaterialType *type = material->type();
+    if (type == flatColorMaterialType()) {
+        addRenderable(node, FlatColorType, geometryBounds(g));
+    } else if ((type == opaqueTextureMaterialType() || type == textureMaterialType())
+               && g->attributeCount() == 2 && g->sizeOfVertex() == int(sizeof(QSGGeometry::TexturedPoint2D))) {
+        QSGTexture *texture = static_cast<QSGOpaqueTextureMaterial *>(material)->texture();
+        addRenderable(node, TextureType, geometryBounds(g), qsgSoftwareContentKey(texture));
+    }
+    return true;
+}
+
+void QSGSoftwareRenderer::endVisit(QSGGeometryNode *node)
+{
+    leaveNode(node);
+}
+
+bool QSGSoftwareRenderer::visit(QSGOpacityNode *node)
+{
+    enterNode(node);
+    pushState();
+    m_state.opacity *= node->opacity();
+    return m_state.opacity >= 0.001;
+}
+
+void QSGSoftwareRenderer::endVisit(QSGOpacityNode *node)
+{
+    popState();
+    leaveNode(node);
+}
+
+bool QSGSoftwareRenderer::visit(QSGImageNode *node)
+{
+    enterNode(node);
+    QSGSoftwareImageNode *image = static_cast<QSGSoftwareImageNode *>(node);
+    addRenderable(node, ImageType, image->rect(), qsgSoftwareContentKey(image->texture()));
+    return true;
+}
+
+void QSGSoftwareRenderer::endVisit(QSGImageNode *node)
+{
+    leaveNode(node);
+}
+
+bool QSGSoftwareRenderer::visit(QSGPainterNode *node)
+{
+    enterNode(node);
+    addRenderable(node, PainterType, QRectF(QPointF(), static_cast<QSGSoftwarePainterNode *>(node)->size()));
+    return true;
+}
+
+void QSGSoftwareRenderer::endVisit(QSGPainterNode *node)
+{
+    leaveNode(node);
+}
+
+bool QSGSoftwareRenderer::visit(QSGRectangleNode *node)
+{
+    enterNode(node);
+    addRenderable(node, RectangleType, static_cast<QSGSoftwareRectangleNode *>(node)->rect());
+    return true;
+}
+
+void QSGSoftwareRenderer::endVisit(QSGRectangleNode *node)
+{
+    leaveNode(node);
+}
+
+bool QSGSoftwareRenderer::visit(QSGGlyphNode *node)
+{
+    enterNode(node);
+    addRenderable(node, GlyphType, node->boundingRect());
+    return true;
+}
+
+void QSGSoftwareRenderer::endVisit(QSGGlyphNode *node)
+{
+    leaveNode(node);
+}
+
+bool QSGSoftwareRenderer::visit(QSGNinePatchNode *node)
+{
+    enterNode(node);
+    QSGSoftwareNinePatchNode *ninePatch = static_cast<QSGSoftwareNinePatchNode *>(node);
+    addRenderable(node, NinePatchType, ninePatch->bounds(), qsgSoftwareContentKey(ninePatch->texture()));
+    return true;
+}
+
+void QSGSoftwareRenderer::endVisit(QSGNinePatchNode *node)
+{
+    leaveNode(node);
+}
+
+bool QSGSoftwareRenderer::visit(QSGRootNode *node)
+{
+    enterNode(node);
+    return true;
+}
+
+void QSGSoftwareRenderer::endVisit(QSGRootNode *node)
+{
+    leaveNode(node);
+}
+
+QRegion QSGSoftwareRenderer::computeDirtyRegion(const QRect &targetRect)
+{
+    if (m_fullRepaint || targetRect != m_previousTargetRect || clearColor() != m_previousClearColor)
+        return QRegion(targetRect);
+
+    QRegion dirty;
+    QBitArray seen(m_previousRenderables.size());
+    for (int i = 0; i < m_renderables.size(); ++i) {
+        const Renderable &r = m_renderables.at(i);
+        QHash<QSGNode *, int>::const_iterator it = m_previousIndex.constFind(r.node);
+        if (it == m_previousIndex.constEnd()) {
+            dirty += r.boundingRect;
+            continue;
+        }
+        const Renderable &previous = m_previousRenderables.at(*it);
+        seen.setBit(*it);
+        if (r.dirty || !r.isSameState(previous)) {
+            dirty += previous.boundingRect;
+            dirty += r.boundingRect;
+        }
+    }
+
+    for (int i = 0; i < m_previousRenderables.size(); ++i) {
+        if (!seen.testBit(i))
+            dirty += m_previousRenderables.at(i).boundingRect;
+    }
+
+    if (dirty.rectCount() > maxDirtyRects)
+        dirty = dirty.boundingRect();
+    return dirty & targetRect;
+}
+
+void QSGSoftwareRenderer::render()
+{
+    if (!m_backingStore && !m_paintDevice)
+        return;
+
+    // The projection maps the scene onto normalized device coordinates; map those
+    // onto the target, in device independent pixels as QPainter handles the ratio.
+    const QRect targetRect(QPoint(), deviceRect().size() / devicePixelRatio());
+    const QTransform toTarget(targetRect.width() / 2.0, 0, 0, -targetRect.height() / 2.0,
+                              targetRect.width() / 2.0, targetRect.height() / 2.0);
+
+    qSwap(m_renderables, m_previousRenderables);
+    m_renderables.resize(0);
+    m_renderables.reserve(m_previousRenderables.size());
+
+    m_state.transform = projectionMatrix().toTransform() * toTarget;
+    m_state.clip = QRegion();
+    m_state.opacity = 1;
+    m_state.clipped = false;
+    m_targetRect = targetRect;
+    m_dirtySubtreeDepth = 0;
+
+    QSGRootNode *root = rootNode();
+    if (visit(root))
+        visitChildren(root);
+    endVisit(root);
+    Q_ASSERT(m_stateStack.isEmpty());
+
+    const QRegion dirty = computeDirtyRegion(targetRect);
+
+    m_dirtyNodes.clear();
+    m_previousIndex.clear();
+    m_previousIndex.reserve(m_renderables.size());
+    for (int i = 0; i < m_renderables.size(); ++i)
+        m_previousIndex.insert(m_renderables.at(i).node, i);
+    m_previousTargetRect = targetRect;
+    m_previousClearColor = clearColor();
+    m_fullRepaint = false;
+
+    m_flushRegion = dirty;
+    if (dirty.isEmpty())
+        return;
+
+    QPaintDevice *device = m_paintDevice;
+    if (m_backingStore) {
+        m_backingStore->beginPaint(dirty);
+        device = m_backingStore->paintDevice();
+    }
+
+    QPainter painter(device);
+    painter.setClipRegion(dirty);
+    if (clearMode() & ClearColorBuffer) {
+        painter.setCompositionMode(QPainter::CompositionMode_Source);
+        painter.fillRect(dirty.boundingRect(), clearColor());
+        painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+    }
+
+    const QRect dirtyBounds = dirty.boundingRect();
+    const bool dirtyIsRect = dirty.rectCount() == 1;
+    QRegion clip;
+    bool clipped = false;
+    for (int i = 0; i < m_renderables.size(); ++i) {
+        const Renderable &r = m_renderables.at(i);
+        if (!r.boundingRect.intersects(dirtyBounds) || (!dirtyIsRect && !dirty.intersects(r.boundingRect)))
+            continue;
+
+        // Clip regions are in target coordinates, set them before the node's transform.
+        if (r.clipped != clipped || (clipped && r.clip != clip)) {
+            clipped = r.clipped;
+            clip = r.clip;
+            painter.resetTransform();
+            painter.setClipRegion(clipped ? dirty & clip : dirty);
+        }
+        painter.setTransform(r.transform);
+        painter.setOpacity(r.opacity);
+        paintRenderable(&painter, r);
+    }
+    painter.end();
+
+    if (m_backingStore)
+        m_backingStore->endPaint();
+}
+
+void QSGSoftwareRenderer::paintRenderable(QPainter *painter, const Renderable &renderable)
+{
+    switch (renderable.type) {
+    case RectangleType:
+        static_cast<QSGSoftwareRectangleNode *>(renderable.node)->paint(painter);
+        break;
+    case ImageType:
+        static_cast<QSGSoftwareImageNode *>(renderable.node)->paint(painter);
+        break;
+    case PainterType:
+        static_cast<QSGSoftwarePainterNode *>(renderable.node)->paint(painter);
+        break;
+    case GlyphType:
+        static_cast<QSGSoftwareGlyphNode *>(renderable.node)->paint(painter);
+        break;
+    case NinePatchType:
+        static_cast<QSGSoftwareNinePatchNode *>(renderable.node)->paint(painter);
+        break;
+    case FlatColorType: {
+        QSGGeometryNode *node = static_cast<QSGGeometryNode *>(renderable.node);
+        painter->fillRect(geometryBounds(node->geometry()),
+                          static_cast<QSGFlatColorMaterial *>(node->material())->color());
+        break;
+    }
+    case TextureType: {
+        QSGGeometryNode *node = static_cast<QSGGeometryNode *>(renderable.node);
+        QSGOpaqueTextureMaterial *material = static_cast<QSGOpaqueTextureMaterial *>(node->material());
+        const QPixmap pixmap = qsgSoftwarePixmap(material->texture());
+        if (pixmap.isNull())
+            break;
+        // Like their shaders, QSGTextureMaterial applies the inherited opacity and
+        // QSGOpaqueTextureMaterial ignores it.
+        if (material->type() != textureMaterialType())
+            painter->setOpacity(1);
+        painter->setRenderHint(QPainter::SmoothPixmapTransform, material->filtering() == QSGTexture::Linear);
+        painter->drawPixmap(geometryBounds(node->geometry()), pixmap,
+                            textureSourceRect(node->geometry(), pixmap.size()));
+        break;
+    }
+    }
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,154 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef RENDERER_H
+#define RENDERER_H
+
+#include <private/qsgrenderer_p.h>
+#include <private/qsgadaptationlayer_p.h>
+
+#include <QtCore/qhash.h>
+#include <QtCore/qset.h>
+#include <QtCore/qstack.h>
+#include <QtCore/qvector.h>
+#include <QtGui/qregion.h>
+#include <QtGui/qtransform.h>
+
+QT_BEGIN_NAMESPACE
+
+class QBackingStore;
+class QPaintDevice;
+
+class QSGSoftwareRenderer : public QSGRenderer, public QSGNodeVisitorEx
+{
+public:
+    QSGSoftwareRenderer(QSGRenderContext *context);
+    ~QSGSoftwareRenderer();
+
+    // Frames are painted into the backing store when one is set, otherwise into the paint device.
+    void setBackingStore(QBackingStore *backingStore) { m_backingStore = backingStore; }
+    void setPaintDevice(QPaintDevice *device) { m_paintDevice = device; }
+
+    void markFullRepaint() { m_fullRepaint = true; }
+    QRegion flushRegion() const { return m_flushRegion; }
+
+    using QSGRenderer::renderScene;
+    void renderScene(GLuint fboId = 0) Q_DECL_OVERRIDE;
+    void nodeChanged(QSGNode *node, QSGNode::DirtyState state) Q_DECL_OVERRIDE;
+
+    bool visit(QSGTransformNode *) Q_DECL_OVERRIDE;
+    void endVisit(QSGTransformNode *) Q_DECL_OVERRIDE;
+    bool visit(QSGClipNode *) Q_DECL_OVERRIDE;
+    void endVisit(QSGClipNode *) Q_DECL_OVERRIDE;
+    bool visit(QSGGeometryNode *) Q_DECL_OVERRIDE;
+    void endVisit(QSGGeometryNode *) Q_DECL_OVERRIDE;
+    bool visit(QSGOpacityNode *) Q_DECL_OVERRIDE;
+    void endVisit(QSGOpacityNode *) Q_DECL_OVERRIDE;
+    bool visit(QSGImageNode *) Q_DECL_OVERRIDE;
+    void endVisit(QSGImageNode *) Q_DECL_OVERRIDE;
+    bool visit(QSGPainterNode *) Q_DECL_OVERRIDE;
+    void endVisit(QSGPainterNode *) Q_DECL_OVERRIDE;
+    bool visit(QSGRectangleNode *) Q_DECL_OVERRIDE;
+    void endVisit(QSGRectangleNode *) Q_DECL_OVERRIDE;
+    bool visit(QSGGlyphNode *) Q_DECL_OVERRIDE;
+    void endVisit(QSGGlyphNode *) Q_DECL_OVERRIDE;
+    bool visit(QSGNinePatchNode *) Q_DECL_OVERRIDE;
+    void endVisit(QSGNinePatchNode *) Q_DECL_OVERRIDE;
+    bool visit(QSGRootNode *) Q_DECL_OVERRIDE;
+    void endVisit(QSGRootNode *) Q_DECL_OVERRIDE;
+
+protected:
+    void render() Q_DECL_OVERRIDE;
+
+private:
+    enum RenderableType {
+        RectangleType,
+        ImageType,
+        PainterType,
+        GlyphType,
+        NinePatchType,
+        FlatColorType,
+        TextureType
+    };
+
+    struct Renderable {
+        QSGNode *node;
+        RenderableType type;
+        QTransform transform;
+        QRect boundingRect;
+        QRegion clip;
+        qreal opacity;
+        quint64 contentKey;
+        bool clipped;
+        bool dirty;
+
+        bool isSameState(const Renderable &other) const;
+    };
+
+    struct State {
+        QTransform transform;
+        QRegion clip;
+        qreal opacity;
+        bool clipped;
+    };
+
+    void enterNode(QSGNode *node);
+    void leaveNode(QSGNode *node);
+    void pushState();
+    void popState();
+    void addRenderable(QSGNode *node, RenderableType type, const QRectF &bounds, quint64 contentKey = 0);
+
+    QRegion computeDirtyRegion(const QRect &targetRect);
+    void paintRenderable(QPainter *painter, const Renderable &renderable);
+
+    QVector<Renderable> m_renderables;
+    QVector<Renderable> m_previousRenderables;
+    QHash<QSGNode *, int> m_previousIndex;
+    QSet<QSGNode *> m_dirtyNodes;
+
+    QStack<State> m_stateStack;
+    State m_state;
+    QRect m_targetRect;
+    int m_dirtySubtreeDepth;
+
+    QBackingStore *m_backingStore;
+    QPaintDevice *m_paintDevice;
+    QRegion m_flushRegion;
+    QRect m_previousTargetRect;
+    QColor m_previousClearColor;
+    bool m_fullRepaint;
+};
+
+QT_END_NAMESPACE
+
+#endif // RENDERER_H
@@ -0,0 +1,249 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "renderloop.h"
+#include "renderer.h"
+
+#include <QtCore/qcoreevent.h>
+#include <QtGui/qbackingstore.h>
+#include <QtQuick/private/qquickwindow_p.h>
+#include <QtQuick/private/qsgcontext_p.h>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QSGSoftwareRenderLoop
+    \internal
+
+    Renders on the GUI thread, like the basic render loop, but paints with
+    the software renderer into a QBackingStore per window. Only the region
+    that changed since the previous frame is painted and flushed.
+ */
+
+QSGSoftwareRenderLoop::QSGSoftwareRenderLoop()
+    : m_update_timer(0)
+    , eventPending(false)
+{
+    sg = QSGContext::createDefaultContext();
+    rc = sg->createRenderContext();
+}
+
+QSGSoftwareRenderLoop::~QSGSoftwareRenderLoop()
+{
+    delete rc;
+    delete sg;
+}
+
+void QSGSoftwareRenderLoop::show(QQuickWindow *window)
+{
+    // A window shown again keeps its backing store, only the contents are stale.
+    QHash<QQuickWindow *, WindowData>::iterator it = m_windows.find(window);
+    if (it == m_windows.end()) {
+        WindowData data;
+        data.backingStore = 0;
+        data.updatePending = false;
+        data.grabOnly = false;
+        it = m_windows.insert(window, data);
+    }
+    it->repaintAll = true;
+
+    maybeUpdate(window);
+}
+
+void QSGSoftwareRenderLoop::hide(QQuickWindow *window)
+{
+    QQuickWindowPrivate *cd = QQuickWindowPrivate::get(window);
+    cd->fireAboutToStop();
+}
+
+void QSGSoftwareRenderLoop::windowDestroyed(QQuickWindow *window)
+{
+    if (m_windows.contains(window))
+        delete m_windows.value(window).backingStore;
+    m_windows.remove(window);
+    hide(window);
+
+    QQuickWindowPrivate *d = QQuickWindowPrivate::get(window);
+    d->cleanupNodesOnShutdown();
+
+    if (m_windows.size() == 0)
+        rc->invalidate();
+}
+
+void QSGSoftwareRenderLoop::renderWindow(QQuickWindow *window)
+{
+    QQuickWindowPrivate *cd = QQuickWindowPrivate::get(window);
+    if (!cd->isRenderable() || !m_windows.contains(window))
+        return;
+
+    WindowData &data = const_cast<WindowData &>(m_windows[window]);
+
+    if (!rc->isValid())
+        rc->initialize(0);
+
+    if (!data.backingStore) {
+        data.backingStore = new QBackingStore(window);
+        data.repaintAll = true;
+    }
+
+    bool alsoSwap = data.updatePending;
+    data.updatePending = false;
+
+    if (!data.grabOnly) {
+        cd->flushDelayedTouchEvent();
+        // Event delivery/processing triggered the window to be deleted or stop rendering.
+        if (!m_windows.contains(window))
+            return;
+    }
+
+    cd->polishItems();
+
+    emit window->afterAnimating();
+
+    cd->syncSceneGraph();
+
+    QSGSoftwareRenderer *renderer = static_cast<QSGSoftwareRenderer *>(cd->renderer);
+    if (!renderer)
+        return;
+
+    QBackingStore *backingStore = data.backingStore;
+    if (backingStore->size() != window->size()) {
+        backingStore->resize(window->size());
+        data.repaintAll = true;
+    }
+    if (data.repaintAll) {
+        renderer->markFullRepaint();
+        data.repaintAll = false;
+    }
+
+    const qreal devicePixelRatio = window->effectiveDevicePixelRatio();
+    if (data.grabOnly) {
+        grabContent = QImage(window->size() * devicePixelRatio, QImage::Format_ARGB32_Premultiplied);
+        grabContent.setDevicePixelRatio(devicePixelRatio);
+        renderer->setBackingStore(0);
+        renderer->setPaintDevice(&grabContent);
+        renderer->markFullRepaint();
+    } else {
+        renderer->setBackingStore(backingStore);
+        renderer->setPaintDevice(0);
+    }
+
+    cd->renderSceneGraph(window->size());
+
+    if (data.grabOnly) {
+        // The backing store did not see this frame, bring it up to date next time.
+        renderer->setPaintDevice(0);
+        data.repaintAll = true;
+        data.grabOnly = false;
+    } else if (window->isVisible()) {
+        // Whatever was painted has to reach the screen, the renderer considers it done.
+        const QRegion flushRegion = renderer->flushRegion();
+        if (!flushRegion.isEmpty())
+            backingStore->flush(flushRegion);
+        if (alsoSwap)
+            cd->fireFrameSwapped();
+    }
+
+    // Might have been set during syncSceneGraph()
+    if (data.updatePending)
+        maybeUpdate(window);
+}
+
+void QSGSoftwareRenderLoop::exposureChanged(QQuickWindow *window)
+{
+    if (window->isExposed()) {
+        // The window system may have discarded what was on screen.
+        m_windows[window].repaintAll = true;
+        m_windows[window].updatePending = true;
+        renderWindow(window);
+    }
+}
+
+QImage QSGSoftwareRenderLoop::grab(QQuickWindow *window)
+{
+    if (!m_windows.contains(window))
+        return QImage();
+
+    m_windows[window].grabOnly = true;
+
+    renderWindow(window);
+
+    QImage grabbed = grabContent;
+    grabContent = QImage();
+    return grabbed;
+}
+
+void QSGSoftwareRenderLoop::maybeUpdate(QQuickWindow *window)
+{
+    if (!m_windows.contains(window))
+        return;
+
+    m_windows[window].updatePending = true;
+
+    if (!eventPending) {
+        const int exhaust_delay = 5;
+        m_update_timer = startTimer(exhaust_delay, Qt::PreciseTimer);
+        eventPending = true;
+    }
+}
+
+QSGContext *QSGSoftwareRenderLoop::sceneGraphContext() const
+{
+    return sg;
+}
+
+QSurface::SurfaceType QSGSoftwareRenderLoop::windowSurfaceType() const
+{
+    return QSurface::RasterSurface;
+}
+
+bool QSGSoftwareRenderLoop::event(QEvent *e)
+{
+    if (e->type() == QEvent::Timer) {
+        eventPending = false;
+        killTimer(m_update_timer);
+        m_update_timer = 0;
+        // Rendering a window can end up destroying it, or another one, so
+        // iterate over a copy and skip windows which are gone.
+        const QList<QQuickWindow *> windows = m_windows.keys();
+        foreach (QQuickWindow *window, windows) {
+            QHash<QQuickWindow *, WindowData>::const_iterator it = m_windows.constFind(window);
+            if (it != m_windows.constEnd() && it.value().updatePending)
+                renderWindow(window);
+        }
+        return true;
+    }
+    return QObject::event(e);
+}
+
+QT_END_NAMESPACE
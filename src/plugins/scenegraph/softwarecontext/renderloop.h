@@ -0,0 +1,93 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef RENDERLOOP_H
+#define RENDERLOOP_H
+
+#include <private/qsgrenderloop_p.h>
+
+QT_BEGIN_NAMESPACE
+
+class QBackingStore;
+
+class QSGSoftwareRenderLoop : public QSGRenderLoop
+{
+    Q_OBJECT
+public:
+    QSGSoftwareRenderLoop();
+    ~QSGSoftwareRenderLoop();
+
+    void show(QQuickWindow *window) Q_DECL_OVERRIDE;
+    void hide(QQuickWindow *window) Q_DECL_OVERRIDE;
+
+    void windowDestroyed(QQuickWindow *window) Q_DECL_OVERRIDE;
+
+    void renderWindow(QQuickWindow *window);
+    void exposureChanged(QQuickWindow *window) Q_DECL_OVERRIDE;
+    QImage grab(QQuickWindow *window) Q_DECL_OVERRIDE;
+
+    void maybeUpdate(QQuickWindow *window) Q_DECL_OVERRIDE;
+    void update(QQuickWindow *window) Q_DECL_OVERRIDE { maybeUpdate(window); } // identical for this implementation.
+
+    void releaseResources(QQuickWindow *) Q_DECL_OVERRIDE { }
+
+    QAnimationDriver *animationDriver() const Q_DECL_OVERRIDE { return 0; }
+
+    QSGContext *sceneGraphContext() const Q_DECL_OVERRIDE;
+    QSGRenderContext *createRenderContext(QSGContext *) const Q_DECL_OVERRIDE { return rc; }
+
+    QSurface::SurfaceType windowSurfaceType() const Q_DECL_OVERRIDE;
+
+    bool event(QEvent *) Q_DECL_OVERRIDE;
+
+    struct WindowData {
+        QBackingStore *backingStore;
+        bool updatePending : 1;
+        bool grabOnly : 1;
+        bool repaintAll : 1;
+    };
+
+    QHash<QQuickWindow *, WindowData> m_windows;
+
+    QSGContext *sg;
+    QSGRenderContext *rc;
+
+    QImage grabContent;
+    int m_update_timer;
+
+    bool eventPending;
+};
+
+QT_END_NAMESPACE
+
+#endif // RENDERLOOP_H
@@ -0,0 +1,34 @@
+TARGET = qsgsoftwarecontext
+QT += core-private gui-private qml-private quick-private
+
+PLUGIN_TYPE = scenegraph
+PLUGIN_CLASS_NAME = QSGSoftwareContextPlugin
+load(qt_plugin)
+
+SOURCES += \
+    pluginmain.cpp \
+    context.cpp \
+    renderloop.cpp \
+    renderer.cpp \
+    pixmaptexture.cpp \
+    rectanglenode.cpp \
+    imagenode.cpp \
+    ninepatchnode.cpp \
+    glyphnode.cpp \
+    painternode.cpp \
+    softwarelayer.cpp
+
+HEADERS += \
+    pluginmain.h \
+    context.h \
+    renderloop.h \
+    renderer.h \
+    pixmaptexture.h \
+    rectanglenode.h \
+    imagenode.h \
+    ninepatchnode.h \
+    glyphnode.h \
+    painternode.h \
+    softwarelayer.h
+
+OTHER_FILES += softwarecontext.json
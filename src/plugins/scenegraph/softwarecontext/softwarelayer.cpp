@@ -0,0 +1,235 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "softwarelayer.h"
+#include "renderer.h"
+
+QT_BEGIN_NAMESPACE
+
+QSGSoftwareLayer::QSGSoftwareLayer(QSGRenderContext *renderContext)
+    : m_item(0)
+    , m_context(renderContext)
+    , m_renderer(0)
+    , m_device_pixel_ratio(1)
+    , m_generation(0)
+    , m_live(true)
+    , m_grab(false)
+    , m_recursive(false)
+    , m_dirtyTexture(true)
+{
+}
+
+QSGSoftwareLayer::~QSGSoftwareLayer()
+{
+    invalidated();
+}
+
+int QSGSoftwareLayer::textureId() const
+{
+    return 0;
+}
+
+QSize QSGSoftwareLayer::textureSize() const
+{
+    return m_size;
+}
+
+bool QSGSoftwareLayer::hasAlphaChannel() const
+{
+    return true;
+}
+
+bool QSGSoftwareLayer::hasMipmaps() const
+{
+    return false;
+}
+
+void QSGSoftwareLayer::bind()
+{
+}
+
+bool QSGSoftwareLayer::updateTexture()
+{
+    bool doGrab = (m_live || m_grab) && m_dirtyTexture;
+    if (doGrab)
+        grab();
+    if (m_grab)
+        emit scheduledUpdateCompleted();
+    m_grab = false;
+    return doGrab;
+}
+
+void QSGSoftwareLayer::setItem(QSGNode *item)
+{
+    if (item == m_item)
+        return;
+    m_item = item;
+
+    if (m_live && !m_item)
+        m_pixmap = QPixmap();
+
+    markDirtyTexture();
+}
+
+void QSGSoftwareLayer::setRect(const QRectF &rect)
+{
+    if (rect == m_rect)
+        return;
+    m_rect = rect;
+    markDirtyTexture();
+}
+
+void QSGSoftwareLayer::setSize(const QSize &size)
+{
+    if (size == m_size)
+        return;
+    m_size = size;
+
+    if (m_live && m_size.isNull())
+        m_pixmap = QPixmap();
+
+    markDirtyTexture();
+}
+
+void QSGSoftwareLayer::scheduleUpdate()
+{
+    if (m_grab)
+        return;
+    m_grab = true;
+    if (m_dirtyTexture)
+        emit updateRequested();
+}
+
+QImage QSGSoftwareLayer::toImage() const
+{
+    return m_pixmap.toImage();
+}
+
+void QSGSoftwareLayer::setLive(bool live)
+{
+    if (live == m_live)
+        return;
+    m_live = live;
+
+    if (m_live && (!m_item || m_size.isNull()))
+        m_pixmap = QPixmap();
+
+    markDirtyTexture();
+}
+
+void QSGSoftwareLayer::setRecursive(bool recursive)
+{
+    m_recursive = recursive;
+}
+
+void QSGSoftwareLayer::setFormat(GLenum)
+{
+    // The pixmap always carries an alpha channel.
+}
+
+void QSGSoftwareLayer::setHasMipmaps(bool)
+{
+}
+
+void QSGSoftwareLayer::setDevicePixelRatio(qreal ratio)
+{
+    m_device_pixel_ratio = ratio;
+}
+
+void QSGSoftwareLayer::markDirtyTexture()
+{
+    m_dirtyTexture = true;
+    if (m_live || m_grab)
+        emit updateRequested();
+}
+
+void QSGSoftwareLayer::invalidated()
+{
+    delete m_renderer;
+    m_renderer = 0;
+    m_pixmap = QPixmap();
+}
+
+void QSGSoftwareLayer::grab()
+{
+    if (!m_item || m_size.isNull()) {
+        m_pixmap = QPixmap();
+        m_dirtyTexture = false;
+        return;
+    }
+    QSGNode *root = m_item;
+    while (root->firstChild() && root->type() != QSGNode::RootNodeType)
+        root = root->firstChild();
+    if (root->type() != QSGNode::RootNodeType)
+        return;
+
+    if (!m_renderer) {
+        m_renderer = new QSGSoftwareRenderer(m_context);
+        connect(m_renderer, SIGNAL(sceneGraphChanged()), this, SLOT(markDirtyTexture()));
+    }
+    m_renderer->setRootNode(static_cast<QSGRootNode *>(root));
+
+    if (m_pixmap.size() != m_size) {
+        m_pixmap = QPixmap(m_size);
+        m_renderer->markFullRepaint();
+    }
+
+    m_dirtyTexture = false;
+
+    // m_size is already in device pixels, so the renderer maps m_rect onto it 1:1.
+    m_renderer->setDevicePixelRatio(1);
+    m_renderer->setDeviceRect(m_size);
+    m_renderer->setViewportRect(m_size);
+    m_renderer->setProjectionMatrixToRect(m_rect);
+    m_renderer->setClearColor(Qt::transparent);
+
+    if (m_recursive) {
+        // The subtree may draw this layer, so don't read and write the same pixels.
+        QPixmap target = m_pixmap.copy();
+        m_renderer->setPaintDevice(&target);
+        m_renderer->renderScene();
+        m_pixmap = target;
+    } else {
+        m_renderer->setPaintDevice(&m_pixmap);
+        m_renderer->renderScene();
+    }
+    m_renderer->setPaintDevice(0);
+
+    if (!m_renderer->flushRegion().isEmpty())
+        ++m_generation;
+
+    if (m_recursive)
+        markDirtyTexture(); // Continuously update if 'live' and 'recursive'.
+}
+
+QT_END_NAMESPACE
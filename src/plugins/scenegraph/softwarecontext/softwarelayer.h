@@ -0,0 +1,100 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef SOFTWARELAYER_H
+#define SOFTWARELAYER_H
+
+#include <private/qsgadaptationlayer_p.h>
+
+#include <QtGui/qpixmap.h>
+
+QT_BEGIN_NAMESPACE
+
+class QSGSoftwareRenderer;
+
+class QSGSoftwareLayer : public QSGLayer
+{
+    Q_OBJECT
+public:
+    QSGSoftwareLayer(QSGRenderContext *renderContext);
+    ~QSGSoftwareLayer();
+
+    const QPixmap &pixmap() const { return m_pixmap; }
+    quint64 generation() const { return m_generation; }
+
+    // QSGTexture interface
+    int textureId() const Q_DECL_OVERRIDE;
+    QSize textureSize() const Q_DECL_OVERRIDE;
+    bool hasAlphaChannel() const Q_DECL_OVERRIDE;
+    bool hasMipmaps() const Q_DECL_OVERRIDE;
+    void bind() Q_DECL_OVERRIDE;
+
+    // QSGDynamicTexture interface
+    bool updateTexture() Q_DECL_OVERRIDE;
+
+    // QSGLayer interface
+    void setItem(QSGNode *item) Q_DECL_OVERRIDE;
+    void setRect(const QRectF &rect) Q_DECL_OVERRIDE;
+    void setSize(const QSize &size) Q_DECL_OVERRIDE;
+    void scheduleUpdate() Q_DECL_OVERRIDE;
+    QImage toImage() const Q_DECL_OVERRIDE;
+    void setLive(bool live) Q_DECL_OVERRIDE;
+    void setRecursive(bool recursive) Q_DECL_OVERRIDE;
+    void setFormat(GLenum format) Q_DECL_OVERRIDE;
+    void setHasMipmaps(bool) Q_DECL_OVERRIDE;
+    void setDevicePixelRatio(qreal ratio) Q_DECL_OVERRIDE;
+
+public Q_SLOTS:
+    void markDirtyTexture() Q_DECL_OVERRIDE;
+    void invalidated() Q_DECL_OVERRIDE;
+
+private:
+    void grab();
+
+    QSGNode *m_item;
+    QSGRenderContext *m_context;
+    QSGSoftwareRenderer *m_renderer;
+    QRectF m_rect;
+    QSize m_size;
+    QPixmap m_pixmap;
+    qreal m_device_pixel_ratio;
+    quint64 m_generation;
+    bool m_live;
+    bool m_grab;
+    bool m_recursive;
+    bool m_dirtyTexture;
+};
+
+QT_END_NAMESPACE
+
+#endif // SOFTWARELAYER_H
@@ -128,6 +128,12 @@ public:
                                        1 << Compiling, name, 1, 1));
     }
 
+    void startImportResolution(const QString &uri)
+    {
+        m_data.append(QQmlProfilerData(m_timer.nsecsElapsed(),
+                                       (1 << RangeStart | 1 << RangeData), 1 << ImportResolution, uri));
+    }
+
     void startHandlingSignal(const QQmlSourceLocation &location)
     {
         m_data.append(QQmlProfilerData(m_timer.nsecsElapsed(),
@@ -243,6 +249,21 @@ struct QQmlCompilingProfiler : public QQmlProfilerHelper {
     }
 };
 
+struct QQmlImportResolutionProfiler : public QQmlProfilerHelper {
+    QQmlImportResolutionProfiler(QQmlProfiler *profiler, const QString &uri) :
+        QQmlProfilerHelper(profiler)
+    {
+        Q_QML_PROFILE(QQmlProfilerDefinitions::ProfileImportResolution, profiler,
+                      startImportResolution(uri));
+    }
+
+    ~QQmlImportResolutionProfiler()
+    {
+        Q_QML_PROFILE(QQmlProfilerDefinitions::ProfileImportResolution, profiler,
+                      endRange<ImportResolution>());
+    }
+};
+
 struct QQmlVmeProfiler : public QQmlProfilerDefinitions {
 public:
 
@@ -83,6 +83,7 @@ struct QQmlProfilerDefinitions {
         Binding,            //running a binding
         HandlingSignal,     //running a signal handler
         Javascript,
+        ImportResolution,   //locating qmldir files and loading plugins for an import
 
         MaximumRangeType
     };
@@ -137,6 +138,7 @@ struct QQmlProfilerDefinitions {
         ProfileBinding,
         ProfileHandlingSignal,
         ProfileInputEvents,
+        ProfileImportResolution,
 
         MaximumProfileFeature
     };
@@ -116,6 +116,21 @@ QByteArray ArrayBuffer::asByteArray() const
     return QByteArray(ba);
 }
 
+// Moves the contents out of the buffer without copying them, leaving it with
+// a byteLength of 0. Used to hand a buffer over to a worker thread; contents
+// that are shared with someone else are copied first, so that the receiver
+// ends up as the sole owner.
+QByteArray ArrayBuffer::transfer()
+{
+    detach();
+    if (!d()->data)
+        return QByteArray();
+
+    QByteArrayDataPtr ba = { d()->data };
+    d()->data = QTypedArrayData<char>::sharedNull();
+    return QByteArray(ba);
+}
+
 void ArrayBuffer::detach() {
     if (!d()->data->ref.isShared())
         return;
@@ -128,6 +143,7 @@ void ArrayBuffer::detach() {
         return;
     }
 
+    d()->data->size = oldData->size;
     memcpy(d()->data->data(), oldData->data(), oldData->size + 1);
 
     if (!oldData->ref.deref())
@@ -78,6 +78,8 @@ struct Q_QML_PRIVATE_EXPORT ArrayBuffer : Object
     char *data() { detach(); return d()->data ? d()->data->data() : 0; }
     const char *constData() { detach(); return d()->data ? d()->data->data() : 0; }
 
+    QByteArray transfer();
+
 private:
     void detach();
 };
@@ -138,7 +138,7 @@ ReturnedValue DataViewPrototype::method_get_byteLength(CallContext *ctx)
     if (!v)
         return scope.engine->throwTypeError();
 
-    return Encode(v->d()->byteLength);
+    return Encode(v->byteLength());
 }
 
 ReturnedValue DataViewPrototype::method_get_byteOffset(CallContext *ctx)
@@ -148,7 +148,7 @@ ReturnedValue DataViewPrototype::method_get_byteOffset(CallContext *ctx)
     if (!v)
         return scope.engine->throwTypeError();
 
-    return Encode(v->d()->byteOffset);
+    return Encode(v->byteOffset());
 }
 
 template <typename T>
@@ -160,7 +160,7 @@ ReturnedValue DataViewPrototype::method_getChar(CallContext *ctx)
         return scope.engine->throwTypeError();
     double l = ctx->args()[0].toNumber();
     uint idx = (uint)l;
-    if (l != idx || idx + sizeof(T) > v->d()->byteLength)
+    if (l != idx || idx + sizeof(T) > v->byteLength())
         return scope.engine->throwTypeError();
     idx += v->d()->byteOffset;
 
@@ -178,7 +178,7 @@ ReturnedValue DataViewPrototype::method_get(CallContext *ctx)
         return scope.engine->throwTypeError();
     double l = ctx->args()[0].toNumber();
     uint idx = (uint)l;
-    if (l != idx || idx + sizeof(T) > v->d()->byteLength)
+    if (l != idx || idx + sizeof(T) > v->byteLength())
         return scope.engine->throwTypeError();
     idx += v->d()->byteOffset;
 
@@ -200,7 +200,7 @@ ReturnedValue DataViewPrototype::method_getFloat(CallContext *ctx)
         return scope.engine->throwTypeError();
     double l = ctx->args()[0].toNumber();
     uint idx = (uint)l;
-    if (l != idx || idx + sizeof(T) > v->d()->byteLength)
+    if (l != idx || idx + sizeof(T) > v->byteLength())
         return scope.engine->throwTypeError();
     idx += v->d()->byteOffset;
 
@@ -238,7 +238,7 @@ ReturnedValue DataViewPrototype::method_setChar(CallContext *ctx)
         return scope.engine->throwTypeError();
     double l = ctx->args()[0].toNumber();
     uint idx = (uint)l;
-    if (l != idx || idx + sizeof(T) > v->d()->byteLength)
+    if (l != idx || idx + sizeof(T) > v->byteLength())
         return scope.engine->throwTypeError();
     idx += v->d()->byteOffset;
 
@@ -257,7 +257,7 @@ ReturnedValue DataViewPrototype::method_set(CallContext *ctx)
         return scope.engine->throwTypeError();
     double l = ctx->args()[0].toNumber();
     uint idx = (uint)l;
-    if (l != idx || idx + sizeof(T) > v->d()->byteLength)
+    if (l != idx || idx + sizeof(T) > v->byteLength())
         return scope.engine->throwTypeError();
     idx += v->d()->byteOffset;
 
@@ -282,7 +282,7 @@ ReturnedValue DataViewPrototype::method_setFloat(CallContext *ctx)
         return scope.engine->throwTypeError();
     double l = ctx->args()[0].toNumber();
     uint idx = (uint)l;
-    if (l != idx || idx + sizeof(T) > v->d()->byteLength)
+    if (l != idx || idx + sizeof(T) > v->byteLength())
         return scope.engine->throwTypeError();
     idx += v->d()->byteOffset;
 
@@ -35,6 +35,7 @@
 
 #include "qv4object_p.h"
 #include "qv4functionobject_p.h"
+#include "qv4arraybuffer_p.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -51,6 +52,9 @@ struct DataView : Object {
     Pointer<ArrayBuffer> buffer;
     uint byteLength;
     uint byteOffset;
+
+    // A transferred buffer is left empty, so the range of its views no longer fits into it.
+    bool isDetached() const { return byteOffset + byteLength > buffer->byteLength(); }
 };
 
 }
@@ -67,6 +71,9 @@ struct DataView : Object
 {
     V4_OBJECT2(DataView, Object)
 
+    uint byteLength() const { return d()->isDetached() ? 0 : d()->byteLength; }
+    uint byteOffset() const { return d()->isDetached() ? 0 : d()->byteOffset; }
+
     static void markObjects(Heap::Base *that, ExecutionEngine *e);
 };
 
@@ -42,6 +42,9 @@
 #include <private/qv4regexpobject_p.h>
 #include <private/qv4sequenceobject_p.h>
 #include <private/qv4objectproto_p.h>
+#include <private/qv4arraybuffer_p.h>
+#include <private/qv4typedarray_p.h>
+#include <private/qv4mm_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -59,7 +62,13 @@ using namespace QV4;
 //    + Number
 //    + Date
 //    + RegExp
+//    + ArrayBuffer and typed arrays
 // <quint8 type><quint24 size><data>
+//
+// ArrayBuffers are copied unless they are listed in the transfer list passed
+// to serialize(). Transferred buffers are not written into the stream; their
+// contents are moved into a side list without copying, the stream only
+// records their index, and the buffers are left empty in the sending thread.
 
 enum Type {
     WorkerUndefined,
@@ -76,7 +85,10 @@ enum Type {
     WorkerDate,
     WorkerRegexp,
     WorkerListModel,
-    WorkerSequence
+    WorkerSequence,
+    WorkerArrayBuffer,
+    WorkerTransferredArrayBuffer,
+    WorkerTypedArray
 };
 
 static inline quint32 valueheader(Type type, quint32 size = 0)
@@ -139,7 +151,8 @@ static inline void *popPtr(const char *&data)
 // serialization/deserialization failures
 
 #define ALIGN(size) (((size) + 3) & ~3)
-void Serialize::serialize(QByteArray &data, const QV4::Value &v, ExecutionEngine *engine)
+void Serialize::serialize(QByteArray &data, const QV4::Value &v, ExecutionEngine *engine,
+                          const QVector<Heap::ArrayBuffer *> &transfer)
 {
     QV4::Scope scope(engine);
 
@@ -182,7 +195,7 @@ void Serialize::serialize(QByteArray &data, const QV4::Value &v, ExecutionEngine
         push(data, valueheader(WorkerArray, length));
         ScopedValue val(scope);
         for (uint ii = 0; ii < length; ++ii)
-            serialize(data, (val = array->getIndexed(ii)), engine);
+            serialize(data, (val = array->getIndexed(ii)), engine, transfer);
     } else if (v.isInteger()) {
         reserve(data, 2 * sizeof(quint32));
         push(data, valueheader(WorkerInt32));
@@ -218,6 +231,32 @@ void Serialize::serialize(QByteArray &data, const QV4::Value &v, ExecutionEngine
         char *buffer = data.data() + offset;
 
         memcpy(buffer, pattern.constData(), length*sizeof(QChar));
+    } else if (v.as<ArrayBuffer>()) {
+        Scoped<ArrayBuffer> buffer(scope, v);
+        int index = transfer.indexOf(buffer->d());
+        if (index != -1) {
+            reserve(data, 2 * sizeof(quint32));
+            push(data, valueheader(WorkerTransferredArrayBuffer));
+            push(data, (quint32)index);
+            return;
+        }
+
+        quint32 length = buffer->byteLength();
+        int size = ALIGN(length);
+        reserve(data, 2 * sizeof(quint32) + size);
+        push(data, valueheader(WorkerArrayBuffer));
+        push(data, length);
+
+        int offset = data.size();
+        data.resize(data.size() + size);
+        memcpy(data.data() + offset, buffer->d()->data->data(), length);
+    } else if (const TypedArray *typedArray = v.as<TypedArray>()) {
+        reserve(data, 3 * sizeof(quint32));
+        push(data, valueheader(WorkerTypedArray, typedArray->arrayType()));
+        push(data, (quint32)typedArray->byteOffset());
+        push(data, (quint32)typedArray->byteLength());
+        ScopedValue arrayBuffer(scope, typedArray->d()->buffer);
+        serialize(data, arrayBuffer, engine, transfer);
     } else if (const QObjectWrapper *qobjectWrapper = v.as<QV4::QObjectWrapper>()) {
         // XXX TODO: Generalize passing objects between the main thread and worker scripts so
         // that others can trivially plug in their elements.
@@ -242,10 +281,10 @@ void Serialize::serialize(QByteArray &data, const QV4::Value &v, ExecutionEngine
             }
             reserve(data, sizeof(quint32) + length * sizeof(quint32));
             push(data, valueheader(WorkerSequence, length));
-            serialize(data, QV4::Primitive::fromInt32(QV4::SequencePrototype::metaTypeForSequence(o)), engine); // sequence type
+            serialize(data, QV4::Primitive::fromInt32(QV4::SequencePrototype::metaTypeForSequence(o)), engine, transfer); // sequence type
             ScopedValue val(scope);
             for (uint ii = 0; ii < seqLength; ++ii)
-                serialize(data, (val = o->getIndexed(ii)), engine); // sequence elements
+                serialize(data, (val = o->getIndexed(ii)), engine, transfer); // sequence elements
 
             return;
         }
@@ -263,14 +302,14 @@ void Serialize::serialize(QByteArray &data, const QV4::Value &v, ExecutionEngine
         QV4::ScopedValue s(scope);
         for (quint32 ii = 0; ii < length; ++ii) {
             s = properties->getIndexed(ii);
-            serialize(data, s, engine);
+            serialize(data, s, engine, transfer);
 
             QV4::String *str = s->as<String>();
             val = o->get(str);
             if (scope.hasException())
                 scope.engine->catchException();
 
-            serialize(data, val, engine);
+            serialize(data, val, engine, transfer);
         }
         return;
     } else {
@@ -278,7 +317,7 @@ void Serialize::serialize(QByteArray &data, const QV4::Value &v, ExecutionEngine
     }
 }
 
-ReturnedValue Serialize::deserialize(const char *&data, ExecutionEngine *engine)
+ReturnedValue Serialize::deserialize(const char *&data, ExecutionEngine *engine, const Value *transferred)
 {
     quint32 header = popUint32(data);
     Type type = headertype(header);
@@ -310,7 +349,7 @@ ReturnedValue Serialize::deserialize(const char *&data, ExecutionEngine *engine)
         ScopedArrayObject a(scope, engine->newArrayObject());
         ScopedValue v(scope);
         for (quint32 ii = 0; ii < size; ++ii) {
-            v = deserialize(data, engine);
+            v = deserialize(data, engine, transferred);
             a->putIndexed(ii, v);
         }
         return a.asReturnedValue();
@@ -323,8 +362,8 @@ ReturnedValue Serialize::deserialize(const char *&data, ExecutionEngine *engine)
         ScopedString n(scope);
         ScopedValue value(scope);
         for (quint32 ii = 0; ii < size; ++ii) {
-            name = deserialize(data, engine);
-            value = deserialize(data, engine);
+            name = deserialize(data, engine, transferred);
+            value = deserialize(data, engine, transferred);
             n = name->asReturnedValue();
             o->put(n, value);
         }
@@ -368,18 +407,51 @@ ReturnedValue Serialize::deserialize(const char *&data, ExecutionEngine *engine)
         bool succeeded = false;
         quint32 length = headersize(header);
         quint32 seqLength = length - 1;
-        value = deserialize(data, engine);
+        value = deserialize(data, engine, transferred);
         int sequenceType = value->integerValue();
         ScopedArrayObject array(scope, engine->newArrayObject());
         array->arrayReserve(seqLength);
         for (quint32 ii = 0; ii < seqLength; ++ii) {
-            value = deserialize(data, engine);
+            value = deserialize(data, engine, transferred);
             array->arrayPut(ii, value);
         }
         array->setArrayLengthUnchecked(seqLength);
         QVariant seqVariant = QV4::SequencePrototype::toVariant(array, sequenceType, &succeeded);
         return QV4::SequencePrototype::fromVariant(engine, seqVariant, &succeeded);
     }
+    case WorkerArrayBuffer:
+    {
+        quint32 length = popUint32(data);
+        Scoped<ArrayBuffer> buffer(scope, engine->memoryManager->alloc<ArrayBuffer>(engine, length));
+        if (scope.hasException())
+            return Encode::undefined();
+        memcpy(buffer->d()->data->data(), data, length);
+        data += ALIGN(length);
+        return buffer.asReturnedValue();
+    }
+    case WorkerTransferredArrayBuffer:
+    {
+        quint32 index = popUint32(data);
+        Q_ASSERT(transferred);
+        return transferred[index].asReturnedValue();
+    }
+    case WorkerTypedArray:
+    {
+        Heap::TypedArray::Type arrayType = Heap::TypedArray::Type(headersize(header));
+        quint32 byteOffset = popUint32(data);
+        quint32 byteLength = popUint32(data);
+        Scoped<ArrayBuffer> buffer(scope, deserialize(data, engine, transferred));
+        if (!buffer)
+            return Encode::undefined();
+        // The view must fit into the buffer it arrives with
+        if (byteOffset > buffer->byteLength() || byteLength > buffer->byteLength() - byteOffset)
+            byteOffset = byteLength = 0;
+        Scoped<TypedArray> array(scope, engine->memoryManager->alloc<TypedArray>(engine, arrayType));
+        array->d()->buffer = buffer->d();
+        array->d()->byteOffset = byteOffset;
+        array->d()->byteLength = byteLength;
+        return array.asReturnedValue();
+    }
     }
     Q_ASSERT(!"Unreachable");
     return QV4::Encode::undefined();
@@ -388,14 +460,66 @@ ReturnedValue Serialize::deserialize(const char *&data, ExecutionEngine *engine)
 QByteArray Serialize::serialize(const QV4::Value &value, ExecutionEngine *engine)
 {
     QByteArray rv;
-    serialize(rv, value, engine);
+    serialize(rv, value, engine, QVector<Heap::ArrayBuffer *>());
     return rv;
 }
 
-ReturnedValue Serialize::deserialize(const QByteArray &data, ExecutionEngine *engine)
+// Serializes \a value like the function above, but moves the ArrayBuffers found in
+// \a transferList (directly, or as the buffer of a typed array) into \a transferred
+// instead of copying them. The buffers are left empty afterwards.
+QByteArray Serialize::serialize(const QV4::Value &value, const QV4::Value &transferList,
+                                ExecutionEngine *engine, QVector<QByteArray> *transferred)
 {
+    Scope scope(engine);
+    QVector<Heap::ArrayBuffer *> transfer;
+
+    ScopedObject list(scope, transferList);
+    if (list) {
+        uint length = ScopedValue(scope, list->get(engine->id_length))->toUInt32();
+        ScopedValue val(scope);
+        Scoped<ArrayBuffer> buffer(scope);
+        for (uint ii = 0; ii < length; ++ii) {
+            val = list->getIndexed(ii);
+            if (const TypedArray *typedArray = val->as<TypedArray>())
+                buffer = typedArray->d()->buffer;
+            else
+                buffer = val;
+            if (buffer && !transfer.contains(buffer->d()))
+                transfer.append(buffer->d());
+        }
+    }
+
+    QByteArray rv;
+    serialize(rv, value, engine, transfer);
+
+    transferred->reserve(transferred->size() + transfer.size());
+    Scoped<ArrayBuffer> buffer(scope);
+    for (int ii = 0; ii < transfer.size(); ++ii) {
+        buffer = transfer.at(ii);
+        transferred->append(buffer->transfer());
+    }
+    return rv;
+}
+
+// The contents of \a transferred are moved into new ArrayBuffers, so that the
+// receiving thread owns them exclusively; the list is cleared.
+ReturnedValue Serialize::deserialize(const QByteArray &data, ExecutionEngine *engine,
+                                     QVector<QByteArray> *transferred)
+{
+    Scope scope(engine);
+    Value *buffers = 0;
+    if (transferred && !transferred->isEmpty()) {
+        buffers = scope.alloc(transferred->size());
+        for (int ii = 0; ii < transferred->size(); ++ii) {
+            QByteArray contents;
+            qSwap(contents, (*transferred)[ii]);
+            buffers[ii] = engine->newArrayBuffer(contents);
+        }
+        transferred->clear();
+    }
+
     const char *stream = data.constData();
-    return deserialize(stream, engine);
+    return deserialize(stream, engine, buffers);
 }
 
 QT_END_NAMESPACE
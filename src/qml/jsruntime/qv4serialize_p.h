@@ -46,6 +46,7 @@
 //
 
 #include <QtCore/qbytearray.h>
+#include <QtCore/qvector.h>
 #include <private/qv4value_p.h>
 
 QT_BEGIN_NAMESPACE
@@ -58,11 +59,15 @@ class Serialize {
 public:
 
     static QByteArray serialize(const Value &, ExecutionEngine *);
-    static ReturnedValue deserialize(const QByteArray &, ExecutionEngine *);
+    static QByteArray serialize(const Value &, const Value &transferList, ExecutionEngine *,
+                                QVector<QByteArray> *transferred);
+    static ReturnedValue deserialize(const QByteArray &, ExecutionEngine *,
+                                     QVector<QByteArray> *transferred = 0);
 
 private:
-    static void serialize(QByteArray &, const Value &, ExecutionEngine *);
-    static ReturnedValue deserialize(const char *&, ExecutionEngine *);
+    static void serialize(QByteArray &, const Value &, ExecutionEngine *,
+                          const QVector<Heap::ArrayBuffer *> &transfer);
+    static ReturnedValue deserialize(const char *&, ExecutionEngine *, const Value *transferred);
 };
 
 }
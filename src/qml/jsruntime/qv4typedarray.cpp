@@ -233,7 +233,7 @@ ReturnedValue TypedArrayCtor::construct(const Managed *m, CallData *callData)
         Scoped<ArrayBuffer> buffer(scope, typedArray->d()->buffer);
         uint srcElementSize = typedArray->d()->type->bytesPerElement;
         uint destElementSize = operations[that->d()->type].bytesPerElement;
-        uint byteLength = typedArray->d()->byteLength;
+        uint byteLength = typedArray->byteLength();
         uint destByteLength = byteLength*destElementSize/srcElementSize;
 
         Scoped<ArrayBuffer> newBuffer(scope, scope.engine->memoryManager->alloc<ArrayBuffer>(scope.engine, destByteLength));
@@ -245,7 +245,7 @@ ReturnedValue TypedArrayCtor::construct(const Managed *m, CallData *callData)
         array->d()->byteLength = destByteLength;
         array->d()->byteOffset = 0;
 
-        const char *src = buffer->d()->data->data() + typedArray->d()->byteOffset;
+        const char *src = buffer->d()->data->data() + typedArray->byteOffset();
         char *dest = newBuffer->d()->data->data();
 
         // check if src and new type have the same size. In that case we can simply memcpy the data
@@ -422,7 +422,7 @@ ReturnedValue TypedArrayPrototype::method_get_byteLength(CallContext *ctx)
     if (!v)
         return scope.engine->throwTypeError();
 
-    return Encode(v->d()->byteLength);
+    return Encode(v->byteLength());
 }
 
 ReturnedValue TypedArrayPrototype::method_get_byteOffset(CallContext *ctx)
@@ -432,7 +432,7 @@ ReturnedValue TypedArrayPrototype::method_get_byteOffset(CallContext *ctx)
     if (!v)
         return scope.engine->throwTypeError();
 
-    return Encode(v->d()->byteOffset);
+    return Encode(v->byteOffset());
 }
 
 ReturnedValue TypedArrayPrototype::method_get_length(CallContext *ctx)
@@ -442,7 +442,7 @@ ReturnedValue TypedArrayPrototype::method_get_length(CallContext *ctx)
     if (!v)
         return scope.engine->throwTypeError();
 
-    return Encode(v->d()->byteLength/v->d()->type->bytesPerElement);
+    return Encode(v->length());
 }
 
 ReturnedValue TypedArrayPrototype::method_set(CallContext *ctx)
@@ -480,7 +480,7 @@ ReturnedValue TypedArrayPrototype::method_set(CallContext *ctx)
             return scope.engine->throwRangeError(QStringLiteral("TypedArray.set: out of range"));
 
         uint idx = 0;
-        char *b = buffer->d()->data->data() + a->d()->byteOffset + offset*elementSize;
+        char *b = buffer->d()->data->data() + a->byteOffset() + offset*elementSize;
         ScopedValue val(scope);
         while (idx < l) {
             val = o->getIndexed(idx);
@@ -502,19 +502,19 @@ ReturnedValue TypedArrayPrototype::method_set(CallContext *ctx)
     if (offset + l > a->length())
         return scope.engine->throwRangeError(QStringLiteral("TypedArray.set: out of range"));
 
-    char *dest = buffer->d()->data->data() + a->d()->byteOffset + offset*elementSize;
-    const char *src = srcBuffer->d()->data->data() + srcTypedArray->d()->byteOffset;
+    char *dest = buffer->d()->data->data() + a->byteOffset() + offset*elementSize;
+    const char *src = srcBuffer->d()->data->data() + srcTypedArray->byteOffset();
     if (srcTypedArray->d()->type == a->d()->type) {
         // same type of typed arrays, use memmove (as srcbuffer and buffer could be the same)
-        memmove(dest, src, srcTypedArray->d()->byteLength);
+        memmove(dest, src, srcTypedArray->byteLength());
         return Encode::undefined();
     }
 
     char *srcCopy = 0;
     if (buffer->d() == srcBuffer->d()) {
         // same buffer, need to take a temporary copy, to not run into problems
-        srcCopy = new char[srcTypedArray->d()->byteLength];
-        memcpy(srcCopy, src, srcTypedArray->d()->byteLength);
+        srcCopy = new char[srcTypedArray->byteLength()];
+        memcpy(srcCopy, src, srcTypedArray->byteLength());
         src = srcCopy;
     }
 
@@ -570,7 +570,7 @@ ReturnedValue TypedArrayPrototype::method_subarray(CallContext *ctx)
 
     ScopedCallData callData(scope, 3);
     callData->args[0] = buffer;
-    callData->args[1] = Encode(a->d()->byteOffset + begin*a->d()->type->bytesPerElement);
+    callData->args[1] = Encode(a->byteOffset() + begin*a->d()->type->bytesPerElement);
     callData->args[2] = Encode(newLen);
     return constructor->construct(callData);
 }
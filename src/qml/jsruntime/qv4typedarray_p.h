@@ -76,6 +76,9 @@ struct TypedArray : Object {
     uint byteLength;
     uint byteOffset;
     Type arrayType;
+
+    // A transferred buffer is left empty, so the range of its views no longer fits into it.
+    bool isDetached() const { return byteOffset + byteLength > buffer->byteLength(); }
 };
 
 struct TypedArrayCtor : FunctionObject {
@@ -97,11 +100,15 @@ struct Q_QML_PRIVATE_EXPORT TypedArray : Object
     V4_OBJECT2(TypedArray, Object)
 
     uint byteLength() const {
-        return d()->byteLength;
+        return d()->isDetached() ? 0 : d()->byteLength;
+    }
+
+    uint byteOffset() const {
+        return d()->isDetached() ? 0 : d()->byteOffset;
     }
 
     uint length() const {
-        return d()->byteLength/d()->type->bytesPerElement;
+        return byteLength()/d()->type->bytesPerElement;
     }
 
     QTypedArrayData<char> *arrayData() {
@@ -38,11 +38,14 @@
 #include "qqmlcontext.h"
 #include "qqmlcontext_p.h"
 #include "qqmlpropertymap.h"
+#include "qqmlobjectcreator_p.h"
 #ifdef QML_THREADED_VME_INTERPRETER
 #include "qqmlvme_p.h"
 #endif
 
 #include <QtCore/qdebug.h>
+#include <QtCore/qrunnable.h>
+#include <QtCore/qthreadpool.h>
 
 #include <private/qobject_p.h>
 
@@ -50,7 +53,7 @@ QT_BEGIN_NAMESPACE
 
 QQmlCompiledData::QQmlCompiledData(QQmlEngine *engine)
 : engine(engine), importCache(0), metaTypeId(-1), listMetaTypeId(-1), isRegisteredWithEngine(false),
-  rootPropertyCache(0), totalBindingsCount(0), totalParserStatusCount(0)
+  rootPropertyCache(0), totalBindingsCount(0), totalParserStatusCount(0), instantiationPlan(0)
 {
     Q_ASSERT(engine);
 }
@@ -92,6 +95,9 @@ QQmlCompiledData::~QQmlCompiledData()
 
     if (rootPropertyCache)
         rootPropertyCache->release();
+
+    delete decodedLiterals.load();
+    delete instantiationPlan;
 }
 
 void QQmlCompiledData::clear()
@@ -156,4 +162,60 @@ void QQmlCompiledData::initialize(QQmlEngine *engine)
         compilationUnit->linkToEngine(v4);
 }
 
+namespace {
+class QQmlLiteralDecodingJob : public QRunnable
+{
+public:
+    QQmlLiteralDecodingJob(QQmlCompiledData *compiledData)
+        : compiledData(compiledData)
+    {
+        compiledData->addref();
+    }
+
+    // Also runs for jobs that are cancelled by the engine before they start.
+    // The last reference may be dropped here, in which case destroy() defers
+    // the deletion to the engine thread; the engine waits for its pool before
+    // it is torn down, so that is still possible.
+    ~QQmlLiteralDecodingJob()
+    {
+        compiledData->release();
+    }
+
+    void run() Q_DECL_OVERRIDE
+    {
+        QQmlDecodedLiterals *literals = QQmlDecodedLiterals::decode(compiledData);
+        if (!compiledData->decodedLiterals.testAndSetRelease(0, literals))
+            delete literals;
+    }
+
+private:
+    QQmlCompiledData *compiledData;
+};
+}
+
+/*!
+Decodes the literal property values of this type, and of all composite types
+it instantiates, on a worker thread. Object creation on the engine thread picks
+the decoded values up through QQmlObjectCreator as soon as they are published,
+and falls back to decoding them inline until then.
+
+Must be called from the engine thread.
+*/
+void QQmlCompiledData::scheduleLiteralDecoding()
+{
+    if (!literalDecodingScheduled.testAndSetRelaxed(0, 1))
+        return;
+
+    if (!isInitialized())
+        initialize(engine);
+
+    QQmlEnginePrivate::get(engine)->literalDecodingThreadPool()->start(new QQmlLiteralDecodingJob(this));
+
+    for (QHash<int, TypeReference*>::ConstIterator resolvedType = resolvedTypes.constBegin(), end = resolvedTypes.constEnd();
+         resolvedType != end; ++resolvedType) {
+        if ((*resolvedType)->component)
+            (*resolvedType)->component->scheduleLiteralDecoding();
+    }
+}
+
 QT_END_NAMESPACE
@@ -73,6 +73,8 @@ class QQmlEngine;
 class QQmlComponent;
 class QQmlContext;
 class QQmlContextData;
+struct QQmlDecodedLiterals;
+struct QQmlInstantiationPlan;
 
 // ### Merge with QV4::CompiledData::CompilationUnit
 class Q_AUTOTEST_EXPORT QQmlCompiledData : public QQmlRefCount, public QQmlCleanup
@@ -140,6 +142,15 @@ public:
     bool isInitialized() const { return hasEngine(); }
     void initialize(QQmlEngine *);
 
+    // Literal binding values decoded ahead of instantiation, published once by
+    // the thread that decoded them.
+    QAtomicPointer<QQmlDecodedLiterals> decodedLiterals;
+    QAtomicInt literalDecodingScheduled;
+    void scheduleLiteralDecoding();
+
+    // Created by the first QQmlObjectCreator instantiating this type.
+    QQmlInstantiationPlan *instantiationPlan;
+
 protected:
     virtual void destroy(); // From QQmlRefCount
     virtual void clear(); // From QQmlCleanup
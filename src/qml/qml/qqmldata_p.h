@@ -76,7 +76,7 @@ public:
     QQmlData()
         : ownedByQml1(false), ownMemory(true), ownContext(false), indestructible(true), explicitIndestructibleSet(false),
           hasTaintedV8Object(false), isQueuedForDeletion(false), rootObjectInCreation(false),
-          hasVMEMetaObject(false), parentFrozen(false), bindingBitsSize(0), bindingBits(0), notifyList(0), context(0), outerContext(0),
+          hasVMEMetaObject(false), parentFrozen(false), arenaAllocated(false), bindingBitsSize(0), bindingBits(0), notifyList(0), context(0), outerContext(0),
           bindings(0), signalHandlers(0), nextContextObject(0), prevContextObject(0),
           lineNumber(0), columnNumber(0), jsEngineId(0), compiledData(0), deferredData(0),
           propertyCache(0), guards(0), extendedData(0) {
@@ -122,7 +122,8 @@ public:
     quint32 rootObjectInCreation:1;
     quint32 hasVMEMetaObject:1;
     quint32 parentFrozen:1;
-    quint32 dummy:22;
+    quint32 arenaAllocated:1; // memory is owned by a QQmlDataArena
+    quint32 dummy:21;
 
     // When bindingBitsSize < 32, we store the binding bit flags inside
     // bindingBitsValue. When we need more than 32 bits, we allocated
@@ -233,6 +234,46 @@ private:
     void flushPendingBindingImpl(int coreIndex);
 };
 
+// A block of QQmlData instances for the objects of one component instance,
+// allocated with a single malloc. Each QQmlData handed out keeps the arena
+// alive, so objects that outlive the root object of the instance stay valid.
+// The memory is released when the creator and all those objects are gone.
+class Q_QML_PRIVATE_EXPORT QQmlDataArena
+{
+public:
+    static QQmlDataArena *create(int capacity);
+
+    // Returns 0 once all slots are in use.
+    QQmlData *allocate();
+
+    void addref() { refCount.ref(); }
+    void release();
+
+    // Called instead of deleting an arena allocated QQmlData.
+    static void destroy(QQmlData *data);
+
+private:
+    QQmlDataArena(int capacity) : refCount(1), capacity(capacity), used(0) {}
+
+    struct Slot {
+        QQmlDataArena *arena;
+        union {
+            char data[sizeof(QQmlData)];
+            void *alignment;
+            quint64 alignment64;
+        };
+    };
+
+    // The slots follow the header, rounded up so that every Slot is properly aligned.
+    static size_t headerSize()
+    { return (sizeof(QQmlDataArena) + Q_ALIGNOF(Slot) - 1) & ~size_t(Q_ALIGNOF(Slot) - 1); }
+    Slot *slots() { return reinterpret_cast<Slot *>(reinterpret_cast<char *>(this) + headerSize()); }
+
+    QAtomicInt refCount;
+    int capacity;
+    int used;
+};
+
 bool QQmlData::wasDeleted(QObject *object)
 {
     if (!object)
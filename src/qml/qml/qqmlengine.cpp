@@ -73,6 +73,7 @@
 #include <QtCore/qdir.h>
 #include <QtCore/qmutex.h>
 #include <QtCore/qthread.h>
+#include <QtCore/qthreadpool.h>
 #include <private/qthread_p.h>
 #include <QtNetwork/qnetworkconfigmanager.h>
 
@@ -589,11 +590,11 @@ QQmlEnginePrivate::QQmlEnginePrivate(QQmlEngine *e)
 : propertyCapture(0), rootContext(0), isDebugging(false),
   profiler(0), outputWarningsToMsgLog(true),
   cleanup(0), erroredBindings(0), inProgressCreations(0),
-  workerScriptEngine(0),
+  maxWorkerScriptThreads(qMax(1, qEnvironmentVariableIntValue("QML_WORKER_SCRIPT_THREADS"))),
   activeObjectCreator(0),
   networkAccessManager(0), networkAccessManagerFactory(0), urlInterceptor(0),
   scarceResourcesRefCount(0), typeLoader(e), importDatabase(e), uniqueId(1),
-  incubatorCount(0), incubationController(0)
+  incubatorCount(0), incubationController(0), literalDecodingPool(0)
 {
 }
 
@@ -616,6 +617,8 @@ QQmlEnginePrivate::~QQmlEnginePrivate()
 
     doDeleteInEngineThread();
 
+    delete literalDecodingPool;
+
     if (incubationController) incubationController->d = 0;
     incubationController = 0;
 
@@ -865,12 +868,39 @@ void QQmlEnginePrivate::init()
     }
 }
 
+/*
+    Returns the thread pool decoding literal property values for asynchronous
+    incubation, creating it on first use.
+*/
+QThreadPool *QQmlEnginePrivate::literalDecodingThreadPool()
+{
+    if (!literalDecodingPool)
+        literalDecodingPool = new QThreadPool;
+    return literalDecodingPool;
+}
+
+/*
+    Returns the worker thread a new WorkerScript should be pinned to. Up to
+    QML_WORKER_SCRIPT_THREADS threads (one by default), as set when the engine
+    was created, are started; a new one is
+    only created once every existing thread has a script on it, otherwise the
+    least busy thread is reused.
+*/
 QQuickWorkerScriptEngine *QQmlEnginePrivate::getWorkerScriptEngine()
 {
     Q_Q(QQmlEngine);
-    if (!workerScriptEngine)
-        workerScriptEngine = new QQuickWorkerScriptEngine(q);
-    return workerScriptEngine;
+    QQuickWorkerScriptEngine *engine = 0;
+    for (int ii = 0; ii < workerScriptEngines.count(); ++ii) {
+        QQuickWorkerScriptEngine *candidate = workerScriptEngines.at(ii);
+        if (!engine || candidate->scriptCount() < engine->scriptCount())
+            engine = candidate;
+    }
+
+    if (!engine || (engine->scriptCount() > 0 && workerScriptEngines.count() < maxWorkerScriptThreads)) {
+        engine = new QQuickWorkerScriptEngine(q);
+        workerScriptEngines.append(engine);
+    }
+    return engine;
 }
 
 /*!
@@ -942,6 +972,13 @@ QQmlEngine::~QQmlEngine()
     if (d->isDebugging)
         QQmlDebugServer::instance()->removeEngine(this);
 
+    // Literal decoding jobs release their compiled data when they finish, which
+    // must happen while the engine can still take care of it.
+    if (d->literalDecodingPool) {
+        d->literalDecodingPool->clear();
+        d->literalDecodingPool->waitForDone();
+    }
+
     d->typeLoader.invalidate();
 
     // Emit onDestruction signals for the root context before
@@ -1725,6 +1762,44 @@ void QQmlData::destroyed(QObject *object)
 
     if (ownMemory)
         delete this;
+    else if (arenaAllocated)
+        QQmlDataArena::destroy(this);
+}
+
+QQmlDataArena *QQmlDataArena::create(int capacity)
+{
+    void *memory = malloc(headerSize() + capacity * sizeof(Slot));
+    return new (memory) QQmlDataArena(capacity);
+}
+
+QQmlData *QQmlDataArena::allocate()
+{
+    if (used == capacity)
+        return 0;
+    Slot *slot = slots() + used++;
+    slot->arena = this;
+    addref();
+    QQmlData *data = new (slot->data) QQmlData;
+    data->ownMemory = false;
+    data->arenaAllocated = true;
+    return data;
+}
+
+void QQmlDataArena::release()
+{
+    if (!refCount.deref()) {
+        this->~QQmlDataArena();
+        free(this);
+    }
+}
+
+void QQmlDataArena::destroy(QQmlData *data)
+{
+    Q_ASSERT(data->arenaAllocated);
+    Slot *slot = reinterpret_cast<Slot *>(reinterpret_cast<char *>(data) - offsetof(Slot, data));
+    QQmlDataArena *arena = slot->arena;
+    data->~QQmlData();
+    arena->release();
 }
 
 DEFINE_BOOL_CONFIG_OPTION(parentTest, QML_PARENT_TEST);
@@ -66,6 +66,7 @@
 #include <QtCore/qlist.h>
 #include <QtCore/qpair.h>
 #include <QtCore/qstack.h>
+#include <QtCore/qvector.h>
 #include <QtCore/qmutex.h>
 #include <QtCore/qstring.h>
 #include <QtCore/qthread.h>
@@ -95,6 +96,7 @@ class QQmlObjectCreator;
 class QDir;
 class QQmlIncubator;
 class QQmlProfiler;
+class QThreadPool;
 
 // This needs to be declared here so that the pool for it can live in QQmlEnginePrivate.
 // The inline method definitions are in qqmljavascriptexpression_p.h
@@ -154,7 +156,8 @@ public:
     QV4::ExecutionEngine *v4engine() const { return QV8Engine::getV4(q_func()->handle()); }
 
     QQuickWorkerScriptEngine *getWorkerScriptEngine();
-    QQuickWorkerScriptEngine *workerScriptEngine;
+    QVector<QQuickWorkerScriptEngine *> workerScriptEngines;
+    int maxWorkerScriptThreads;
 
     QUrl baseUrl;
 
@@ -199,6 +202,11 @@ public:
     QQmlIncubationController *incubationController;
     void incubate(QQmlIncubator &, QQmlContextData *);
 
+    // Decodes literal property values for asynchronous incubation.  Its jobs
+    // reference compiled data, so it is drained before the engine goes away.
+    QThreadPool *literalDecodingThreadPool();
+    QThreadPool *literalDecodingPool;
+
     // These methods may be called from any thread
     inline bool isEngineThread() const;
     inline static bool isEngineThread(const QQmlEngine *);
@@ -40,6 +40,9 @@
 #include <QtCore/qpluginloader.h>
 #include <QtCore/qlibraryinfo.h>
 #include <QtCore/qreadwritelock.h>
+#include <QtCore/qdatastream.h>
+#include <QtCore/qdatetime.h>
+#include <QtCore/qsavefile.h>
 #include <QtQml/qqmlextensioninterface.h>
 #include <QtQml/qqmlextensionplugin.h>
 #include <private/qqmlextensionplugin_p.h>
@@ -1092,6 +1095,25 @@ bool QQmlImportsPrivate::locateQmldir(const QString &uri, int vmaj, int vmin, QQ
 
     QStringList localImportPaths = database->importPathList(QQmlImportDatabase::Local);
 
+    // Then the persistent index, which saves probing the import paths
+    if (const QQmlImportDatabase::ImportIndexEntry *entry = database->indexedQmldir(uri, vmaj, vmin, localImportPaths)) {
+        if (!database->engine->urlInterceptor())
+            typeLoader.setQmldirContent(entry->qmldirFilePath, entry->qmldirContent);
+
+        QQmlImportDatabase::QmldirCache *cache = new QQmlImportDatabase::QmldirCache;
+        cache->versionMajor = vmaj;
+        cache->versionMinor = vmin;
+        cache->qmldirFilePath = entry->qmldirFilePath;
+        cache->qmldirPathUrl = entry->qmldirPathUrl;
+        cache->next = cacheHead;
+        database->qmldirCache.insert(uri, cache);
+
+        *outQmldirFilePath = entry->qmldirFilePath;
+        *outQmldirPathUrl = entry->qmldirPathUrl;
+
+        return true;
+    }
+
     // Search local import paths for a matching version
     for (int version = QQmlImports::FullyVersioned; version <= QQmlImports::Unversioned; ++version) {
         foreach (const QString &path, localImportPaths) {
@@ -1114,6 +1136,8 @@ bool QQmlImportsPrivate::locateQmldir(const QString &uri, int vmaj, int vmin, QQ
                 cache->next = cacheHead;
                 database->qmldirCache.insert(uri, cache);
 
+                database->indexQmldir(uri, vmaj, vmin, localImportPaths, absoluteFilePath, url);
+
                 *outQmldirFilePath = absoluteFilePath;
                 *outQmldirPathUrl = url;
 
@@ -1538,7 +1562,8 @@ void QQmlImports::setDesignerSupportRequired(bool b)
 \internal
 */
 QQmlImportDatabase::QQmlImportDatabase(QQmlEngine *e)
-: engine(e)
+: importIndexPath(QFile::decodeName(qgetenv("QML_IMPORT_INDEX"))),
+  importIndexLoaded(false), importIndexDirty(false), engine(e)
 {
     filePluginPath << QLatin1String(".");
 
@@ -1565,6 +1590,8 @@ QQmlImportDatabase::QQmlImportDatabase(QQmlEngine *e)
 
 QQmlImportDatabase::~QQmlImportDatabase()
 {
+    if (importIndexDirty)
+        saveImportIndex();
     clearDirCache();
 }
 
@@ -2013,6 +2040,129 @@ bool QQmlImportDatabase::importDynamicPlugin(const QString &filePath, const QStr
 #endif
 }
 
+static QString importIndexKey(const QString &uri, int vmaj, int vmin)
+{
+    return uri + QLatin1Char(' ') + QString::number(vmaj) + QLatin1Char('.') + QString::number(vmin);
+}
+
+/*!
+    \internal
+
+    Returns the entry of the persistent import index for \a uri version \a vmaj.vmin, or
+    null if there is none or if it is out of date.  An entry is out of date if it was
+    recorded for other \a importPaths or if its qmldir file has been modified since, so
+    validating it costs a single stat() instead of probing every import path.
+
+    Modules that are newly installed into an import path searched before the indexed one
+    are not noticed until the index file is removed.
+*/
+const QQmlImportDatabase::ImportIndexEntry *QQmlImportDatabase::indexedQmldir(const QString &uri, int vmaj, int vmin,
+                                                                             const QStringList &importPaths)
+{
+    if (importIndexPath.isEmpty())
+        return 0;
+    if (!importIndexLoaded)
+        loadImportIndex();
+
+    QHash<QString, ImportIndexEntry>::iterator it = importIndex.find(importIndexKey(uri, vmaj, vmin));
+    if (it == importIndex.end())
+        return 0;
+
+    QFileInfo info(it->qmldirFilePath);
+    if (it->importPaths != importPaths
+            || !info.isFile() || info.lastModified().toMSecsSinceEpoch() != it->lastModified) {
+        if (qmlImportTrace())
+            qDebug().nospace() << "QQmlImportDatabase::indexedQmldir: " << uri << ' ' << vmaj << '.' << vmin
+                               << " is out of date";
+        importIndex.erase(it);
+        importIndexDirty = true;
+        return 0;
+    }
+
+    return &*it;
+}
+
+/*!
+    \internal
+
+    Records the qmldir file found for \a uri version \a vmaj.vmin in the persistent import
+    index, together with its content.  Resources are not recorded as they are cheap to
+    locate.
+*/
+void QQmlImportDatabase::indexQmldir(const QString &uri, int vmaj, int vmin, const QStringList &importPaths,
+                                     const QString &qmldirFilePath, const QString &qmldirPathUrl)
+{
+    if (importIndexPath.isEmpty() || qmldirFilePath.at(0) == Colon)
+        return;
+
+    QFile file(qmldirFilePath);
+    if (!file.open(QFile::ReadOnly))
+        return;
+
+    ImportIndexEntry entry;
+    entry.importPaths = importPaths;
+    entry.lastModified = QFileInfo(file).lastModified().toMSecsSinceEpoch();
+    entry.qmldirFilePath = qmldirFilePath;
+    entry.qmldirPathUrl = qmldirPathUrl;
+    entry.qmldirContent = QString::fromUtf8(file.readAll());
+
+    importIndex.insert(importIndexKey(uri, vmaj, vmin), entry);
+    importIndexDirty = true;
+}
+
+static const quint32 ImportIndexMagic = 0x716d6c69; // "qmli"
+static const quint32 ImportIndexVersion = 2;
+
+void QQmlImportDatabase::loadImportIndex()
+{
+    importIndexLoaded = true;
+
+    QFile file(importIndexPath);
+    if (!file.open(QFile::ReadOnly))
+        return;
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_6);
+
+    quint32 magic, version, count;
+    stream >> magic >> version >> count;
+    if (stream.status() != QDataStream::Ok || magic != ImportIndexMagic || version != ImportIndexVersion)
+        return;
+
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        QString key;
+        ImportIndexEntry entry;
+        stream >> key >> entry.importPaths >> entry.lastModified
+               >> entry.qmldirFilePath >> entry.qmldirPathUrl >> entry.qmldirContent;
+        if (stream.status() == QDataStream::Ok)
+            importIndex.insert(key, entry);
+    }
+
+    if (qmlImportTrace())
+        qDebug().nospace() << "QQmlImportDatabase::loadImportIndex: " << importIndex.count()
+                           << " entries from " << importIndexPath;
+}
+
+void QQmlImportDatabase::saveImportIndex()
+{
+    QSaveFile file(importIndexPath);
+    if (!file.open(QFile::WriteOnly))
+        return;
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_6);
+    stream << ImportIndexMagic << ImportIndexVersion << quint32(importIndex.count());
+
+    for (QHash<QString, ImportIndexEntry>::ConstIterator it = importIndex.constBegin(), end = importIndex.constEnd();
+         it != end; ++it) {
+        stream << it.key() << it->importPaths << it->lastModified
+               << it->qmldirFilePath << it->qmldirPathUrl << it->qmldirContent;
+    }
+
+    if (file.commit())
+        importIndexDirty = false;
+}
+
 void QQmlImportDatabase::clearDirCache()
 {
     QStringHash<QmldirCache *>::ConstIterator itr = qmldirCache.begin();
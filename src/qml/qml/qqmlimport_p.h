@@ -181,6 +181,29 @@ private:
     // Used in QQmlImportsPrivate::locateQmldir()
     QStringHash<QmldirCache *> qmldirCache;
 
+    // Persistent index of located qmldir files, kept across runs in the file
+    // named by QML_IMPORT_INDEX.  Entries are validated against the import
+    // path list they were located with and the modification time of the
+    // qmldir file.
+    struct ImportIndexEntry {
+        QStringList importPaths;
+        qint64 lastModified;
+        QString qmldirFilePath;
+        QString qmldirPathUrl;
+        QString qmldirContent;
+    };
+    const ImportIndexEntry *indexedQmldir(const QString &uri, int vmaj, int vmin,
+                                          const QStringList &importPaths);
+    void indexQmldir(const QString &uri, int vmaj, int vmin, const QStringList &importPaths,
+                     const QString &qmldirFilePath, const QString &qmldirPathUrl);
+    void loadImportIndex();
+    void saveImportIndex();
+
+    QHash<QString, ImportIndexEntry> importIndex;
+    QString importIndexPath;
+    bool importIndexLoaded;
+    bool importIndexDirty;
+
     // XXX thread
     QStringList filePluginPath;
     QStringList fileImportPath;
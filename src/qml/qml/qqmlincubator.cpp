@@ -87,6 +87,10 @@ void QQmlEnginePrivate::incubate(QQmlIncubator &i, QQmlContextData *forContext)
             p->incubate(i);
         }
     } else {
+        // Parse literal values on a worker thread while the incubation
+        // waits for its first time slice.
+        p->compiledData->scheduleLiteralDecoding();
+
         incubatorList.insert(p.data());
         incubatorCount++;
 
@@ -38,6 +38,7 @@
 #include <private/qqmlcustomparser_p.h>
 #include <private/qhashedstring_p.h>
 #include <private/qqmlimport_p.h>
+#include <private/qqmlpropertycache_p.h>
 
 #include <QtCore/qdebug.h>
 #include <QtCore/qstringlist.h>
@@ -76,6 +77,8 @@ struct QQmlMetaTypeData
                                   // a module via qmlRegisterCompositeType.
     typedef QHash<const QMetaObject *, QQmlType *> MetaObjects;
     MetaObjects metaObjectToType;
+    typedef QHash<const QMetaObject *, QQmlMetaObjectMembers *> MetaObjectMembers;
+    MetaObjectMembers metaObjectMembers; // shared by the property caches of all engines
     typedef QHash<int, QQmlMetaType::StringConverter> StringConverters;
     StringConverters stringConverters;
 
@@ -145,6 +148,9 @@ QQmlMetaTypeData::~QQmlMetaTypeData()
 
     for (TypeModules::const_iterator i = uriToModule.constBegin(), cend = uriToModule.constEnd(); i != cend; ++i)
         delete *i;
+
+    for (MetaObjectMembers::const_iterator i = metaObjectMembers.constBegin(), cend = metaObjectMembers.constEnd(); i != cend; ++i)
+        (*i)->release();
 }
 
 class QQmlTypePrivate
@@ -1106,6 +1112,10 @@ void qmlClearTypeRegistrations() // Declared in qqml.h
     data->metaObjectToType.clear();
     data->uriToModule.clear();
 
+    for (QQmlMetaTypeData::MetaObjectMembers::const_iterator i = data->metaObjectMembers.constBegin(), cend = data->metaObjectMembers.constEnd(); i != cend; ++i)
+        (*i)->release();
+    data->metaObjectMembers.clear();
+
     QQmlEnginePrivate::baseModulesUninitialized = true; //So the engine re-registers its types
     qmlClearEnginePlugins();
 }
@@ -1725,6 +1735,30 @@ QQmlType *QQmlMetaType::qmlType(const QHashedStringRef &name, const QHashedStrin
     return 0;
 }
 
+/*!
+    Returns the member description of \a metaObject that the property caches of all engines
+    share, or null if \a metaObject does not belong to a registered type.  Only the static
+    meta objects of registered C++ types are shared, as they outlive all engines.
+
+    The returned description is referenced for the caller.
+*/
+QQmlMetaObjectMembers *QQmlMetaType::metaObjectMembers(const QMetaObject *metaObject)
+{
+    QMutexLocker lock(metaTypeDataLock());
+    QQmlMetaTypeData *data = metaTypeData();
+
+    QQmlMetaObjectMembers *members = data->metaObjectMembers.value(metaObject);
+    if (!members) {
+        if (!data->metaObjectToType.contains(metaObject))
+            return 0;
+        members = QQmlMetaObjectMembers::create(metaObject);
+        data->metaObjectMembers.insert(metaObject, members);
+    }
+
+    members->addref();
+    return members;
+}
+
 /*!
     Returns the type (if any) that corresponds to the \a metaObject.  Returns null if no
     type is registered.
@@ -60,6 +60,7 @@ class QQmlEngine;
 class QQmlCustomParser;
 class QQmlTypePrivate;
 class QQmlTypeModule;
+class QQmlMetaObjectMembers;
 class QHashedString;
 class QHashedStringRef;
 class QMutex;
@@ -82,6 +83,8 @@ public:
     static QQmlType *qmlType(const QUrl &url, bool includeNonFileImports = false);
     static QQmlType *qmlTypeFromIndex(int);
 
+    static QQmlMetaObjectMembers *metaObjectMembers(const QMetaObject *);
+
     static QMetaProperty defaultProperty(const QMetaObject *);
     static QMetaProperty defaultProperty(QObject *);
     static QMetaMethod defaultMethod(const QMetaObject *);
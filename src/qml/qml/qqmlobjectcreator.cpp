@@ -47,9 +47,12 @@
 #include <private/qqmlscriptstring_p.h>
 #include <private/qqmlpropertyvalueinterceptor_p.h>
 #include <private/qqmlvaluetypeproxybinding_p.h>
+#include <private/qqmlglobal_p.h>
 
 QT_USE_NAMESPACE
 
+DEFINE_BOOL_CONFIG_OPTION(useCreationArena, QML_CREATION_ARENA)
+
 namespace {
 struct ActiveOCRestorer
 {
@@ -81,6 +84,7 @@ QQmlObjectCreator::QQmlObjectCreator(QQmlContextData *parentContext, QQmlCompile
     sharedState->allJavaScriptObjects = 0;
     sharedState->creationContext = creationContext;
     sharedState->rootContext = 0;
+    sharedState->dataArena = useCreationArena() ? QQmlDataArena::create(compiledData->totalObjectCount) : 0;
 
     QQmlProfiler *profiler = QQmlEnginePrivate::get(engine)->profiler;
     Q_QML_PROFILE_IF_ENABLED(QQmlProfilerDefinitions::ProfileCreating, profiler,
@@ -110,6 +114,10 @@ void QQmlObjectCreator::init(QQmlContextData *providedParentContext)
     if (!compiledData->isInitialized())
         compiledData->initialize(engine);
 
+    if (!compiledData->instantiationPlan)
+        compiledData->instantiationPlan = QQmlInstantiationPlan::create(compiledData);
+    plan = compiledData->instantiationPlan;
+
     qmlUnit = compiledData->compilationUnit->data;
     context = 0;
     _qobject = 0;
@@ -143,6 +151,8 @@ QQmlObjectCreator::~QQmlObjectCreator()
             QQmlComponentAttached *a = sharedState->componentAttached;
             a->rem();
         }
+        if (sharedState->dataArena)
+            sharedState->dataArena->release();
     }
 }
 
@@ -280,6 +290,136 @@ bool QQmlObjectCreator::populateDeferredProperties(QObject *instance)
     return errors.isEmpty();
 }
 
+static QVariant decodeLiteral(int propertyType, const QString &string, const QUrl &baseUrl)
+{
+    bool ok = false;
+    QVariant value;
+    switch (propertyType) {
+    case QVariant::String:
+        value = string;
+        ok = true;
+        break;
+    case QVariant::Url: {
+        QString urlString = string;
+        // Encoded dir-separators defeat QUrl processing - decode them first
+        urlString.replace(QLatin1String("%2f"), QLatin1String("/"), Qt::CaseInsensitive);
+        value = urlString.isEmpty() ? QUrl() : baseUrl.resolved(QUrl(urlString));
+        ok = true;
+        break;
+    }
+    case QVariant::Color:
+        value = QQmlStringConverters::rgbaFromString(string, &ok);
+        break;
+#ifndef QT_NO_DATESTRING
+    case QVariant::Date:
+        value = QQmlStringConverters::dateFromString(string, &ok);
+        break;
+    case QVariant::Time:
+        value = QQmlStringConverters::timeFromString(string, &ok);
+        break;
+    case QVariant::DateTime: {
+        QDateTime dateTime = QQmlStringConverters::dateTimeFromString(string, &ok);
+        // ### VME compatibility :(
+        {
+            const qint64 date = dateTime.date().toJulianDay();
+            const int msecsSinceStartOfDay = dateTime.time().msecsSinceStartOfDay();
+            dateTime = QDateTime(QDate::fromJulianDay(date), QTime::fromMSecsSinceStartOfDay(msecsSinceStartOfDay));
+        }
+        value = dateTime;
+        break;
+    }
+#endif // QT_NO_DATESTRING
+    case QVariant::Point:
+        value = QQmlStringConverters::pointFFromString(string, &ok).toPoint();
+        break;
+    case QVariant::PointF:
+        value = QQmlStringConverters::pointFFromString(string, &ok);
+        break;
+    case QVariant::Size:
+        value = QQmlStringConverters::sizeFFromString(string, &ok).toSize();
+        break;
+    case QVariant::SizeF:
+        value = QQmlStringConverters::sizeFFromString(string, &ok);
+        break;
+    case QVariant::Rect:
+        value = QQmlStringConverters::rectFFromString(string, &ok).toRect();
+        break;
+    case QVariant::RectF:
+        value = QQmlStringConverters::rectFFromString(string, &ok);
+        break;
+    default:
+        break;
+    }
+    return ok ? value : QVariant();
+}
+
+QQmlDecodedLiterals *QQmlDecodedLiterals::decode(const QQmlCompiledData *compiledData)
+{
+    const QV4::CompiledData::Unit *qmlUnit = compiledData->compilationUnit->data;
+    const QVector<QV4::CompiledData::BindingPropertyData> &bindingPropertyData = compiledData->compilationUnit->bindingPropertyDataPerObject;
+    // Not compiledData->url(), which caches the url lazily and is therefore not thread-safe.
+    const QUrl baseUrl(compiledData->compilationUnit->fileName());
+
+    QQmlDecodedLiterals *literals = new QQmlDecodedLiterals;
+    literals->objectOffsets.resize(qmlUnit->nObjects);
+    int bindingCount = 0;
+    for (quint32 i = 0; i < qmlUnit->nObjects; ++i) {
+        literals->objectOffsets[i] = bindingCount;
+        bindingCount += qmlUnit->objectAt(i)->nBindings;
+    }
+    literals->values.resize(bindingCount);
+
+    for (quint32 i = 0; i < qmlUnit->nObjects && int(i) < bindingPropertyData.count(); ++i) {
+        const QV4::CompiledData::Object *obj = qmlUnit->objectAt(i);
+        const QV4::CompiledData::BindingPropertyData &propertyData = bindingPropertyData.at(i);
+        const QV4::CompiledData::Binding *binding = obj->bindingTable();
+        for (quint32 j = 0; j < obj->nBindings && int(j) < propertyData.count(); ++j, ++binding) {
+            const QQmlPropertyData *property = propertyData.at(j);
+            if (!property || property->isEnum() || binding->type != QV4::CompiledData::Binding::Type_String)
+                continue;
+            literals->values[literals->objectOffsets.at(i) + j] = decodeLiteral(property->propType, binding->valueAsString(qmlUnit), baseUrl);
+        }
+    }
+
+    return literals;
+}
+
+const QVariant *QQmlObjectCreator::decodedLiteral(const QV4::CompiledData::Binding *binding) const
+{
+    const QQmlDecodedLiterals *literals = compiledData->decodedLiterals.loadAcquire();
+    if (!literals)
+        return 0;
+    const QV4::CompiledData::Binding *firstBinding = _compiledObject->bindingTable();
+    // Synthesized bindings, such as the one for the id property, live outside the table.
+    if (binding < firstBinding || binding >= firstBinding + _compiledObject->nBindings)
+        return 0;
+    return literals->value(_compiledObjectIndex, binding - firstBinding);
+}
+
+QQmlInstantiationPlan *QQmlInstantiationPlan::create(QQmlCompiledData *compiledData)
+{
+    const QV4::CompiledData::Unit *qmlUnit = compiledData->compilationUnit->data;
+
+    QQmlInstantiationPlan *plan = new QQmlInstantiationPlan;
+    plan->objects.resize(qmlUnit->nObjects);
+    for (quint32 i = 0; i < qmlUnit->nObjects; ++i) {
+        if (compiledData->isComponent(i))
+            continue;
+        const QV4::CompiledData::Object *obj = qmlUnit->objectAt(i);
+        plan->objects[i].typeRef = compiledData->resolvedTypes.value(obj->inheritedTypeNameIndex);
+    }
+
+    // Unless a worker thread is already at it, decode the literal values now so
+    // that this and all following instantiations can share them.
+    if (!compiledData->decodedLiterals.loadAcquire() && !compiledData->literalDecodingScheduled.load()) {
+        QQmlDecodedLiterals *literals = QQmlDecodedLiterals::decode(compiledData);
+        if (!compiledData->decodedLiterals.testAndSetRelease(0, literals))
+            delete literals;
+    }
+
+    return plan;
+}
+
 void QQmlObjectCreator::setPropertyValue(const QQmlPropertyData *property, const QV4::CompiledData::Binding *binding)
 {
     QQmlPropertyPrivate::WriteFlags propertyWriteFlags = QQmlPropertyPrivate::BypassInterceptor |
@@ -304,6 +444,25 @@ void QQmlObjectCreator::setPropertyValue(const QQmlPropertyData *property, const
         }
     }
 
+    if (const QVariant *decoded = decodedLiteral(binding)) {
+        if (propertyType == QVariant::Color) {
+            uint colorValue = decoded->toUInt();
+            struct { void *data[4]; } buffer;
+            if (QQml_valueTypeProvider()->storeValueType(property->propType, &colorValue, &buffer, sizeof(buffer))) {
+                argv[0] = reinterpret_cast<void *>(&buffer);
+                QMetaObject::metacall(_qobject, QMetaObject::WriteProperty, property->coreIndex, argv);
+            }
+        } else if (propertyType == QVariant::Url && engine->urlInterceptor()) {
+            QUrl value = engine->urlInterceptor()->intercept(decoded->toUrl(), QQmlAbstractUrlInterceptor::UrlString);
+            argv[0] = &value;
+            QMetaObject::metacall(_qobject, QMetaObject::WriteProperty, property->coreIndex, argv);
+        } else {
+            argv[0] = const_cast<void *>(decoded->constData());
+            QMetaObject::metacall(_qobject, QMetaObject::WriteProperty, property->coreIndex, argv);
+        }
+        return;
+    }
+
     switch (propertyType) {
     case QMetaType::QVariant: {
         if (binding->type == QV4::CompiledData::Binding::Type_Number) {
@@ -629,6 +788,16 @@ static QQmlType *qmlTypeForObject(QObject *object)
     return type;
 }
 
+QQmlType *QQmlObjectCreator::createdTypeForObject(int objectIndex, QObject *instance)
+{
+    QQmlInstantiationPlan::ObjectPlan &objectPlan = plan->objects[objectIndex];
+    if (!objectPlan.createdTypeResolved) {
+        objectPlan.createdType = qmlTypeForObject(instance);
+        objectPlan.createdTypeResolved = true;
+    }
+    return objectPlan.createdType;
+}
+
 void QQmlObjectCreator::setupBindings(const QBitArray &bindingsToSkip)
 {
     QQmlListProperty<void> savedList;
@@ -840,7 +1009,7 @@ bool QQmlObjectCreator::setPropertyBinding(const QQmlPropertyData *property, con
     if (binding->type == QV4::CompiledData::Binding::Type_Object) {
         if (binding->flags & QV4::CompiledData::Binding::IsOnAssignment) {
             // ### determine value source and interceptor casts ahead of time.
-            QQmlType *type = qmlTypeForObject(createdSubObject);
+            QQmlType *type = createdTypeForObject(binding->value.objectIndex, createdSubObject);
             Q_ASSERT(type);
 
             QQmlPropertyData targetCorePropertyData = *property;
@@ -1022,9 +1191,9 @@ QObject *QQmlObjectCreator::createInstance(int index, QObject *parent, bool isCo
                 context->url(), obj->location.line, obj->location.column));
         QQmlComponentPrivate::get(component)->creationContext = context;
         instance = component;
-        ddata = QQmlData::get(instance, /*create*/true);
+        ddata = createDeclarativeData(instance);
     } else {
-        QQmlCompiledData::TypeReference *typeRef = resolvedTypes.value(obj->inheritedTypeNameIndex);
+        QQmlCompiledData::TypeReference *typeRef = plan->objects.at(index).typeRef;
         Q_ASSERT(typeRef);
         installPropertyCache = !typeRef->isFullyDynamicType;
         QQmlType *type = typeRef->type;
@@ -1037,6 +1206,8 @@ QObject *QQmlObjectCreator::createInstance(int index, QObject *parent, bool isCo
                 return 0;
             }
 
+            createDeclarativeData(instance);
+
             const int parserStatusCast = type->parserStatusCast();
             if (parserStatusCast != -1)
                 parserStatus = reinterpret_cast<QQmlParserStatus*>(reinterpret_cast<char *>(instance) + parserStatusCast);
@@ -1158,6 +1329,18 @@ QObject *QQmlObjectCreator::createInstance(int index, QObject *parent, bool isCo
     return result ? instance : 0;
 }
 
+QQmlData *QQmlObjectCreator::createDeclarativeData(QObject *instance)
+{
+    QObjectPrivate *p = QObjectPrivate::get(instance);
+    if (!p->declarativeData && sharedState->dataArena) {
+        if (QQmlData *ddata = sharedState->dataArena->allocate()) {
+            p->declarativeData = ddata;
+            return ddata;
+        }
+    }
+    return QQmlData::get(instance, /*create*/true);
+}
+
 QQmlContextData *QQmlObjectCreator::finalize(QQmlInstantiationInterrupt &interrupt)
 {
     Q_ASSERT(phase == ObjectsCreated || phase == Finalizing);
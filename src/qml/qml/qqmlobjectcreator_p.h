@@ -51,6 +51,41 @@ struct QQmlTypeCompiler;
 class QQmlInstantiationInterrupt;
 struct QQmlVmeProfiler;
 
+// Values of literal bindings whose string representation is expensive to parse
+// (colors, geometry, dates), decoded once per compilation unit. The decoding
+// only reads immutable compiled data and may therefore run on any thread.
+struct QQmlDecodedLiterals
+{
+    QVector<int> objectOffsets; // index is object index, value is offset of its first binding in values
+    QVector<QVariant> values; // invalid for bindings that are not decoded ahead of time
+
+    const QVariant *value(int objectIndex, int bindingIndex) const
+    {
+        const QVariant &v = values.at(objectOffsets.at(objectIndex) + bindingIndex);
+        return v.isValid() ? &v : 0;
+    }
+
+    static QQmlDecodedLiterals *decode(const QQmlCompiledData *compiledData);
+};
+
+// Per-object data of a compilation unit that is resolved when the unit is
+// instantiated for the first time and reused by all later instantiations.
+// Only accessed from the engine thread.
+struct QQmlInstantiationPlan
+{
+    struct ObjectPlan
+    {
+        ObjectPlan() : typeRef(0), createdType(0), createdTypeResolved(false) {}
+
+        QQmlCompiledData::TypeReference *typeRef; // 0 for components, group and attached property objects
+        QQmlType *createdType; // QML type of the instantiated object, used for "on" assignments
+        bool createdTypeResolved;
+    };
+    QVector<ObjectPlan> objects; // index is object index
+
+    static QQmlInstantiationPlan *create(QQmlCompiledData *compiledData);
+};
+
 struct QQmlObjectCreatorSharedState : public QSharedData
 {
     QQmlContextData *rootContext;
@@ -63,6 +98,7 @@ struct QQmlObjectCreatorSharedState : public QSharedData
     QList<QQmlEnginePrivate::FinalizeCallback> finalizeCallbacks;
     QQmlVmeProfiler profiler;
     QRecursionNode recursionNode;
+    QQmlDataArena *dataArena; // 0 unless QML_CREATION_ARENA is set
 };
 
 class QQmlObjectCreator
@@ -92,6 +128,7 @@ private:
     void init(QQmlContextData *parentContext);
 
     QObject *createInstance(int index, QObject *parent = 0, bool isContextObject = false);
+    QQmlData *createDeclarativeData(QObject *instance);
 
     bool populateInstance(int index, QObject *instance,
                           QObject *bindingTarget, const QQmlPropertyData *valueTypeProperty,
@@ -100,6 +137,8 @@ private:
     void setupBindings(const QBitArray &bindingsToSkip);
     bool setPropertyBinding(const QQmlPropertyData *property, const QV4::CompiledData::Binding *binding);
     void setPropertyValue(const QQmlPropertyData *property, const QV4::CompiledData::Binding *binding);
+    const QVariant *decodedLiteral(const QV4::CompiledData::Binding *binding) const;
+    QQmlType *createdTypeForObject(int objectIndex, QObject *instance);
     void setupFunctions();
 
     QString stringAt(int idx) const { return qmlUnit->stringAt(idx); }
@@ -127,6 +166,7 @@ private:
     const QHash<int, QQmlCompiledData::TypeReference*> &resolvedTypes;
     const QVector<QQmlPropertyCache *> &propertyCaches;
     const QVector<QByteArray> &vmeMetaObjectData;
+    QQmlInstantiationPlan *plan;
     QHash<int, int> objectIndexToId;
     QExplicitlySharedDataPointer<QQmlObjectCreatorSharedState> sharedState;
     bool topLevelCreator;
@@ -574,19 +574,11 @@ QQmlPropertyCache::copyAndAppend(const QMetaObject *metaObject,
     return rv;
 }
 
-void QQmlPropertyCache::append(const QMetaObject *metaObject,
-                                       int revision,
-                                       QQmlPropertyData::Flag propertyFlags,
-                                       QQmlPropertyData::Flag methodFlags,
-                                       QQmlPropertyData::Flag signalFlags)
+QQmlMetaObjectMembers *QQmlMetaObjectMembers::create(const QMetaObject *metaObject)
 {
-    Q_UNUSED(revision);
-
-    _metaObject = metaObject;
-
-    bool dynamicMetaObject = isDynamicMetaObject(metaObject);
+    QQmlMetaObjectMembers *members = new QQmlMetaObjectMembers;
 
-    allowedRevisionCache.append(0);
+    bool dynamicMetaObject = QQmlPropertyCache::isDynamicMetaObject(metaObject);
 
     int methodCount = metaObject->methodCount();
     Q_ASSERT(QMetaObjectPrivate::get(metaObject)->revision >= 4);
@@ -604,7 +596,7 @@ void QQmlPropertyCache::append(const QMetaObject *metaObject,
             if (0 == qstrcmp(metaObject->classInfo(idx).name(), "qt_HasQmlAccessors")) {
                 hasFastProperty = true;
             } else if (0 == qstrcmp(metaObject->classInfo(idx).name(), "DefaultProperty")) {
-                _defaultPropertyName = QString::fromUtf8(metaObject->classInfo(idx).value());
+                members->defaultPropertyName = QString::fromUtf8(metaObject->classInfo(idx).value());
             }
         }
 
@@ -631,13 +623,13 @@ void QQmlPropertyCache::append(const QMetaObject *metaObject,
     const bool preventDestruction = metaObject->superClass() || metaObject == &QObject::staticMetaObject;
 
     int methodOffset = metaObject->methodOffset();
-    int signalOffset = signalCount - QMetaObjectPrivate::get(metaObject)->signalCount;
 
-    // update() should have reserved enough space in the vector that this doesn't cause a realloc
-    // and invalidate the stringCache.
-    methodIndexCache.resize(methodCount - methodIndexCacheStart);
-    signalHandlerIndexCache.resize(signalCount - signalHandlerIndexCacheStart);
-    int signalHandlerIndex = signalOffset;
+    members->methodOffset = methodOffset;
+    members->methodCount = methodCount;
+    members->signalCount = signalCount;
+    members->ownSignalCount = QMetaObjectPrivate::get(metaObject)->signalCount;
+
+    members->methods.reserve(methodCount - methodOffset);
     for (int ii = methodOffset; ii < methodCount; ++ii) {
         if (preventDestruction && (ii == destroyedIdx1 || ii == destroyedIdx2 || ii == deleteLaterIdx))
             continue;
@@ -656,19 +648,148 @@ void QQmlPropertyCache::append(const QMetaObject *metaObject,
             ++cptr;
         }
 
+        members->methods.append(Member());
+        Member &member = members->methods.last();
+
+        QQmlPropertyData *data = &member.data;
+        data->lazyLoad(m);
+
+        if (!dynamicMetaObject)
+            data->flags |= QQmlPropertyData::IsDirect;
+
+        // Compute all hashes up front, the description is read concurrently later on.
+        if (utf8) {
+            member.name = 0;
+            member.nameLength = 0;
+            member.nameHash = 0;
+            member.utf8Name = QHashedString(QString::fromUtf8(rawName, cptr - rawName));
+            member.utf8Name.hash();
+
+            if (data->isSignal()) {
+                const QHashedString &methodName = member.utf8Name;
+                member.handlerName = QHashedString(QStringLiteral("on") % methodName.at(0).toUpper() % methodName.midRef(1));
+                member.handlerName.hash();
+            }
+        } else {
+            member.name = rawName;
+            member.nameLength = cptr - rawName;
+            member.nameHash = QHashedCStringRef(rawName, member.nameLength).hash();
+
+            if (data->isSignal()) {
+                int length = member.nameLength;
+
+                QVarLengthArray<char, 128> str(length+3);
+                str[0] = 'o';
+                str[1] = 'n';
+                str[2] = toupper(rawName[0]);
+                if (length > 1)
+                    memcpy(&str[3], &rawName[1], length - 1);
+                str[length + 2] = '\0';
+
+                member.handlerName = QHashedString(QString::fromLatin1(str.data()));
+                member.handlerName.hash();
+            }
+        }
+    }
+
+    int propCount = metaObject->propertyCount();
+    int propOffset = metaObject->propertyOffset();
+
+    members->propertyOffset = propOffset;
+    members->propertyCount = propCount;
+
+    members->properties.reserve(propCount - propOffset);
+    for (int ii = propOffset; ii < propCount; ++ii) {
+        QMetaProperty p = metaObject->property(ii);
+        if (!p.isScriptable())
+            continue;
+
+        const char *str = p.name();
+        char utf8 = 0;
+        const char *cptr = str;
+        while (*cptr != 0) {
+            utf8 |= *cptr & 0x80;
+            ++cptr;
+        }
+
+        members->properties.append(Member());
+        Member &member = members->properties.last();
+
+        QQmlPropertyData *data = &member.data;
+        data->lazyLoad(p);
+
+        if (!dynamicMetaObject)
+            data->flags |= QQmlPropertyData::IsDirect;
+
+        if (utf8) {
+            member.name = 0;
+            member.nameLength = 0;
+            member.nameHash = 0;
+            member.utf8Name = QHashedString(QString::fromUtf8(str, cptr - str));
+            member.utf8Name.hash();
+        } else {
+            member.name = str;
+            member.nameLength = cptr - str;
+            member.nameHash = QHashedCStringRef(str, member.nameLength).hash();
+        }
+
+        QQmlAccessorProperties::Property *accessorProperty = accessorProperties.property(str);
+
+        // Fast properties may not be revisioned
+        Q_ASSERT(accessorProperty == 0 || data->revision == 0);
+
+        if (accessorProperty) {
+            data->flags |= QQmlPropertyData::HasAccessors;
+            data->accessors = accessorProperty->accessors;
+            data->accessorData = accessorProperty->data;
+        }
+    }
+
+    return members;
+}
+
+void QQmlPropertyCache::append(const QMetaObject *metaObject,
+                                       int revision,
+                                       QQmlPropertyData::Flag propertyFlags,
+                                       QQmlPropertyData::Flag methodFlags,
+                                       QQmlPropertyData::Flag signalFlags)
+{
+    Q_UNUSED(revision);
+
+    _metaObject = metaObject;
+
+    QQmlRefPointer<QQmlMetaObjectMembers> members;
+    members.take(QQmlMetaType::metaObjectMembers(metaObject));
+    if (members.isNull())
+        members.take(QQmlMetaObjectMembers::create(metaObject));
+
+    allowedRevisionCache.append(0);
+
+    if (!members->defaultPropertyName.isEmpty())
+        _defaultPropertyName = members->defaultPropertyName;
+
+    int methodOffset = members->methodOffset;
+    int signalOffset = members->signalCount - members->ownSignalCount;
+
+    // update() should have reserved enough space in the vector that this doesn't cause a realloc
+    // and invalidate the stringCache.
+    methodIndexCache.resize(members->methodCount - methodIndexCacheStart);
+    signalHandlerIndexCache.resize(members->signalCount - signalHandlerIndexCacheStart);
+    int signalHandlerIndex = signalOffset;
+    for (QVector<QQmlMetaObjectMembers::Member>::ConstIterator member = members->methods.constBegin(), end = members->methods.constEnd();
+         member != end; ++member) {
+        const int ii = member->data.coreIndex;
+
         QQmlPropertyData *data = &methodIndexCache[ii - methodIndexCacheStart];
         QQmlPropertyData *sigdata = 0;
 
-        data->lazyLoad(m);
+        *data = member->data;
 
         if (data->isSignal())
             data->flags |= signalFlags;
         else
             data->flags |= methodFlags;
 
-        if (!dynamicMetaObject)
-            data->flags |= QQmlPropertyData::IsDirect;
-
         Q_ASSERT((allowedRevisionCache.count() - 1) < Q_INT16_MAX);
         data->metaObjectOffset = allowedRevisionCache.count() - 1;
 
@@ -680,36 +801,25 @@ void QQmlPropertyCache::append(const QMetaObject *metaObject,
 
         QQmlPropertyData *old = 0;
 
-        if (utf8) {
-            QHashedString methodName(QString::fromUtf8(rawName, cptr - rawName));
+        if (member->name) {
+            QHashedCStringRef methodName(member->name, member->nameLength, member->nameHash);
             if (StringCache::mapped_type *it = stringCache.value(methodName))
                 old = it->second;
             setNamedProperty(methodName, ii, data, (old != 0));
 
             if (data->isSignal()) {
-                QHashedString on(QStringLiteral("on") % methodName.at(0).toUpper() % methodName.midRef(1));
-                setNamedProperty(on, ii, sigdata, (old != 0));
+                // Latin-1 handler names have always mapped to the signal itself.
+                setNamedProperty(member->handlerName, ii, data, (old != 0));
                 ++signalHandlerIndex;
             }
         } else {
-            QHashedCStringRef methodName(rawName, cptr - rawName);
+            const QHashedString &methodName = member->utf8Name;
             if (StringCache::mapped_type *it = stringCache.value(methodName))
                 old = it->second;
             setNamedProperty(methodName, ii, data, (old != 0));
 
             if (data->isSignal()) {
-                int length = methodName.length();
-
-                QVarLengthArray<char, 128> str(length+3);
-                str[0] = 'o';
-                str[1] = 'n';
-                str[2] = toupper(rawName[0]);
-                if (length > 1)
-                    memcpy(&str[3], &rawName[1], length - 1);
-                str[length + 2] = '\0';
-
-                QHashedString on(QString::fromLatin1(str.data()));
-                setNamedProperty(on, ii, data, (old != 0));
+                setNamedProperty(member->handlerName, ii, sigdata, (old != 0));
                 ++signalHandlerIndex;
             }
         }
@@ -723,62 +833,43 @@ void QQmlPropertyCache::append(const QMetaObject *metaObject,
         }
     }
 
-    int propCount = metaObject->propertyCount();
-    int propOffset = metaObject->propertyOffset();
-
     // update() should have reserved enough space in the vector that this doesn't cause a realloc
     // and invalidate the stringCache.
-    propertyIndexCache.resize(propCount - propertyIndexCacheStart);
-    for (int ii = propOffset; ii < propCount; ++ii) {
-        QMetaProperty p = metaObject->property(ii);
-        if (!p.isScriptable())
-            continue;
-
-        const char *str = p.name();
-        char utf8 = 0;
-        const char *cptr = str;
-        while (*cptr != 0) {
-            utf8 |= *cptr & 0x80;
-            ++cptr;
-        }
+    propertyIndexCache.resize(members->propertyCount - propertyIndexCacheStart);
+    for (QVector<QQmlMetaObjectMembers::Member>::ConstIterator member = members->properties.constBegin(), end = members->properties.constEnd();
+         member != end; ++member) {
+        const int ii = member->data.coreIndex;
 
         QQmlPropertyData *data = &propertyIndexCache[ii - propertyIndexCacheStart];
 
-        data->lazyLoad(p);
+        *data = member->data;
         data->flags |= propertyFlags;
 
-        if (!dynamicMetaObject)
-            data->flags |= QQmlPropertyData::IsDirect;
-
-        Q_ASSERT((allowedRevisionCache.count() - 1) < Q_INT16_MAX);
-        data->metaObjectOffset = allowedRevisionCache.count() - 1;
+        // The offset shares its storage with the accessors of fast properties.
+        if (!data->hasAccessors()) {
+            Q_ASSERT((allowedRevisionCache.count() - 1) < Q_INT16_MAX);
+            data->metaObjectOffset = allowedRevisionCache.count() - 1;
+        }
 
         QQmlPropertyData *old = 0;
 
-        if (utf8) {
-            QHashedString propName(QString::fromUtf8(str, cptr - str));
+        if (member->name) {
+            QHashedCStringRef propName(member->name, member->nameLength, member->nameHash);
             if (StringCache::mapped_type *it = stringCache.value(propName))
                 old = it->second;
             setNamedProperty(propName, ii, data, (old != 0));
         } else {
-            QHashedCStringRef propName(str, cptr - str);
+            const QHashedString &propName = member->utf8Name;
             if (StringCache::mapped_type *it = stringCache.value(propName))
                 old = it->second;
             setNamedProperty(propName, ii, data, (old != 0));
         }
 
-        QQmlAccessorProperties::Property *accessorProperty = accessorProperties.property(str);
-
-        // Fast properties may not be overrides or revisioned
-        Q_ASSERT(accessorProperty == 0 || (old == 0 && data->revision == 0));
+        // Fast properties may not be overrides
+        Q_ASSERT(!data->hasAccessors() || old == 0);
 
-        if (accessorProperty) {
-            data->flags |= QQmlPropertyData::HasAccessors;
-            data->accessors = accessorProperty->accessors;
-            data->accessorData = accessorProperty->data;
-        } else if (old) {
+        if (!data->hasAccessors() && old)
             data->markAsOverrideOf(old);
-        }
     }
 }
 
@@ -212,6 +212,7 @@ public:
 private:
     friend class QQmlPropertyData;
     friend class QQmlPropertyCache;
+    friend class QQmlMetaObjectMembers;
     quint32 flags;
 };
 Q_DECLARE_OPERATORS_FOR_FLAGS(QQmlPropertyRawData::Flags)
@@ -234,11 +235,46 @@ public:
 
 private:
     friend class QQmlPropertyCache;
+    friend class QQmlMetaObjectMembers;
     void lazyLoad(const QMetaProperty &);
     void lazyLoad(const QMetaMethod &);
     bool notFullyResolved() const { return flags & NotFullyResolved; }
 };
 
+// The members a QMetaObject adds to its super class, preprocessed for
+// QQmlPropertyCache::append(). The description does not depend on any engine
+// and is immutable once created, so QQmlMetaType shares the descriptions of
+// the meta objects of registered C++ types between all engines.
+class Q_QML_PRIVATE_EXPORT QQmlMetaObjectMembers : public QQmlRefCount
+{
+public:
+    static QQmlMetaObjectMembers *create(const QMetaObject *);
+
+    struct Member
+    {
+        QQmlPropertyData data; // lazily loaded, without the flags passed to append()
+
+        // Latin-1 names are referenced in the meta object's string data.
+        const char *name;
+        int nameLength;
+        quint32 nameHash;
+        QHashedString utf8Name; // set instead of name for non Latin-1 names
+
+        QHashedString handlerName; // signals only
+    };
+
+    QVector<Member> methods;
+    QVector<Member> properties;
+
+    int methodOffset;
+    int methodCount;
+    int signalCount; // including the signals of all super classes
+    int ownSignalCount;
+    int propertyOffset;
+    int propertyCount;
+    QString defaultPropertyName;
+};
+
 class QQmlPropertyCacheMethodArguments;
 class Q_QML_PRIVATE_EXPORT QQmlPropertyCache : public QQmlRefCount, public QQmlCleanup
 {
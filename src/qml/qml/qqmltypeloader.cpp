@@ -1315,6 +1315,8 @@ bool QQmlTypeLoader::Blob::addImport(const QV4::CompiledData::Import *import, QL
 
         scriptImported(blob, import->location, importQualifier, QString());
     } else if (import->type == QV4::CompiledData::Import::ImportLibrary) {
+        QQmlImportResolutionProfiler prof(QQmlEnginePrivate::get(typeLoader()->engine())->profiler, importUri);
+
         QString qmldirFilePath;
         QString qmldirUrl;
 
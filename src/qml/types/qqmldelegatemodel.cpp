@@ -48,6 +48,11 @@
 #include <private/qv4functionobject_p.h>
 #include <qv4objectiterator_p.h>
 
+#include <QtCore/qbitarray.h>
+#include <QtCore/qdatetime.h>
+
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
 class QQmlDelegateModelItem;
@@ -197,6 +202,10 @@ QQmlDelegateModelPrivate::QQmlDelegateModelPrivate(QQmlContext *ctxt)
     , m_filterGroup(QStringLiteral("items"))
     , m_count(0)
     , m_groupCount(Compositor::MinimumGroupCount)
+    , m_filteredOutGroup(-1)
+    , m_sortRoleId(-1)
+    , m_filterRoleId(-1)
+    , m_sortOrder(Qt::AscendingOrder)
     , m_compositorGroup(Compositor::Cache)
     , m_complete(false)
     , m_delegateValidated(false)
@@ -246,7 +255,7 @@ QQmlDelegateModel::~QQmlDelegateModel()
 {
     Q_D(QQmlDelegateModel);
 
-    foreach (QQmlDelegateModelItem *cacheItem, d->m_cache) {
+    foreach (QQmlDelegateModelItem *cacheItem, d->m_cache + d->m_reusableItemsPool) {
         if (cacheItem->object) {
             delete cacheItem->object;
 
@@ -309,7 +318,15 @@ void QQmlDelegateModel::componentComplete()
     d->m_cacheMetaType = new QQmlDelegateModelItemMetaType(
             QQmlEnginePrivate::getV8Engine(d->m_context->engine()), this, groupNames);
 
-    d->m_compositor.setGroupCount(d->m_groupCount);
+    // Items rejected by the filter are kept in an extra group after the named ones.
+    if (d->m_groupCount < Compositor::MaximumGroupCount) {
+        d->m_filteredOutGroup = d->m_groupCount;
+        d->m_compositor.setGroupCount(d->m_groupCount + 1);
+    } else {
+        if (d->m_filter.isCallable())
+            qmlInfo(this) << tr("filter: A DelegateModel with %1 groups cannot be filtered").arg(d->m_groupCount - 1);
+        d->m_compositor.setGroupCount(d->m_groupCount);
+    }
     d->m_compositor.setDefaultGroups(defaultGroups);
     d->updateFilterGroup();
 
@@ -325,6 +342,8 @@ void QQmlDelegateModel::componentComplete()
             defaultGroups | Compositor::AppendFlag | Compositor::PrependFlag,
             &inserts);
     d->itemsInserted(inserts);
+    if (d->isSortedOrFiltered())
+        d->sortAndFilter(0, d->m_count);
     d->emitChanges();
 
     if (d->m_adaptorModel.canFetchMore())
@@ -358,6 +377,7 @@ void QQmlDelegateModel::setModel(const QVariant &model)
     if (d->m_complete)
         _q_itemsRemoved(0, d->m_count);
 
+    d->drainReusableItemsPool(0);
     d->m_adaptorModel.setModel(model, this, d->m_context->engine());
     d->m_adaptorModel.replaceWatchedRoles(QList<QByteArray>(), d->m_watchedRoles);
     for (int i = 0; d->m_parts && i < d->m_parts->models.count(); ++i) {
@@ -393,6 +413,7 @@ void QQmlDelegateModel::setDelegate(QQmlComponent *delegate)
         return;
     }
     bool wasValid = d->m_delegate != 0;
+    d->drainReusableItemsPool(0);
     d->m_delegate = delegate;
     d->m_delegateValidated = false;
     if (wasValid && d->m_complete) {
@@ -453,6 +474,7 @@ void QQmlDelegateModel::setRootIndex(const QVariant &root)
     const bool changed = d->m_adaptorModel.rootIndex != modelIndex;
     if (changed || !d->m_adaptorModel.isValid()) {
         const int oldCount = d->m_count;
+        d->drainReusableItemsPool(0);
         d->m_adaptorModel.rootIndex = modelIndex;
         if (!d->m_adaptorModel.isValid() && d->m_adaptorModel.aim())  // The previous root index was invalidated, so we need to reconnect the model.
             d->m_adaptorModel.setModel(d->m_adaptorModel.list.list(), this, d->m_context->engine());
@@ -518,7 +540,8 @@ int QQmlDelegateModel::count() const
     return d->m_compositor.count(d->m_compositorGroup);
 }
 
-QQmlDelegateModel::ReleaseFlags QQmlDelegateModelPrivate::release(QObject *object)
+QQmlDelegateModel::ReleaseFlags QQmlDelegateModelPrivate::release(
+        QObject *object, QQmlInstanceModel::ReusableFlag reusableFlag)
 {
     QQmlDelegateModel::ReleaseFlags stat = 0;
     if (!object)
@@ -526,6 +549,10 @@ QQmlDelegateModel::ReleaseFlags QQmlDelegateModelPrivate::release(QObject *objec
 
     if (QQmlDelegateModelItem *cacheItem = QQmlDelegateModelItem::dataForObject(object)) {
         if (cacheItem->releaseObject()) {
+            if (reusableFlag == QQmlInstanceModel::Reusable && isReusable(cacheItem)) {
+                addReusableItem(cacheItem);
+                return QQmlInstanceModel::Pooled;
+            }
             cacheItem->destroyObject();
             emitDestroyingItem(object);
             if (cacheItem->incubationTask) {
@@ -543,12 +570,17 @@ QQmlDelegateModel::ReleaseFlags QQmlDelegateModelPrivate::release(QObject *objec
 
 /*
   Returns ReleaseStatus flags.
+
+  If \a reusableFlag is Reusable and the item is no longer referenced, it may be kept in
+  a pool instead of being destroyed, in which case Pooled is returned and itemPooled() is
+  emitted.  A later call to object() for any index may then return the same item again
+  with its model data updated, emitting itemReused().
 */
 
-QQmlDelegateModel::ReleaseFlags QQmlDelegateModel::release(QObject *item)
+QQmlDelegateModel::ReleaseFlags QQmlDelegateModel::release(QObject *item, ReusableFlag reusableFlag)
 {
     Q_D(QQmlDelegateModel);
-    QQmlInstanceModel::ReleaseFlags stat = d->release(item);
+    QQmlInstanceModel::ReleaseFlags stat = d->release(item, reusableFlag);
     return stat;
 }
 
@@ -755,6 +787,519 @@ void QQmlDelegateModelPrivate::updateFilterGroup()
     }
 }
 
+/*!
+    \qmlproperty string QtQml.Models::DelegateModel::sortRole
+    \since 5.7
+
+    This property holds the name of the model role used to sort the \l items group.
+
+    When set, the items of the model are presented in the order of the values of the
+    role rather than the order of the source model.  Changes to the model only re-sort
+    the items which were inserted, moved or changed, so a large model can stay sorted
+    while it is being edited.  Setting an empty string restores the source order.
+
+    Items inserted into the \l items group with DelegateModelGroup::insert() are placed
+    after the items of the model, and items of the \l items group cannot be moved
+    with DelegateModelGroup::move() while a sort role is set.
+
+    By default this is an empty string.
+
+    \sa sortOrder, lessThan, invalidate()
+*/
+
+QString QQmlDelegateModel::sortRole() const
+{
+    Q_D(const QQmlDelegateModel);
+    return d->m_sortRole;
+}
+
+void QQmlDelegateModel::setSortRole(const QString &role)
+{
+    Q_D(QQmlDelegateModel);
+    if (d->m_sortRole != role) {
+        d->m_sortRole = role;
+        d->m_sortKeys.clear();
+        invalidate();
+        emit sortRoleChanged();
+    }
+}
+
+/*!
+    \qmlproperty enumeration QtQml.Models::DelegateModel::sortOrder
+    \since 5.7
+
+    This property holds the order in which items are sorted by the \l sortRole.
+
+    \list
+    \li Qt.AscendingOrder (default)
+    \li Qt.DescendingOrder
+    \endlist
+*/
+
+Qt::SortOrder QQmlDelegateModel::sortOrder() const
+{
+    Q_D(const QQmlDelegateModel);
+    return d->m_sortOrder;
+}
+
+void QQmlDelegateModel::setSortOrder(Qt::SortOrder order)
+{
+    Q_D(QQmlDelegateModel);
+    if (d->m_sortOrder != order) {
+        d->m_sortOrder = order;
+        if (!d->m_sortRole.isEmpty())
+            invalidate();
+        emit sortOrderChanged();
+    }
+}
+
+/*!
+    \qmlproperty function QtQml.Models::DelegateModel::lessThan
+    \since 5.7
+
+    This property holds a function comparing two values of the \l sortRole.
+
+    The function is called with the values of two items and should return true if
+    the first sorts before the second.  If no function is set numbers and dates are
+    compared by value, and other values are compared as locale aware strings.
+*/
+
+QJSValue QQmlDelegateModel::lessThan() const
+{
+    Q_D(const QQmlDelegateModel);
+    return d->m_lessThan;
+}
+
+void QQmlDelegateModel::setLessThan(const QJSValue &lessThan)
+{
+    Q_D(QQmlDelegateModel);
+    if (!d->m_lessThan.strictlyEquals(lessThan)) {
+        d->m_lessThan = lessThan;
+        if (!d->m_sortRole.isEmpty())
+            invalidate();
+        emit lessThanChanged();
+    }
+}
+
+/*!
+    \qmlproperty string QtQml.Models::DelegateModel::filterRole
+    \since 5.7
+
+    This property holds the name of the model role whose value is passed to the
+    \l filter function.
+
+    If this is an empty string the filter function is passed the index of the
+    item in the source model instead.
+*/
+
+QString QQmlDelegateModel::filterRole() const
+{
+    Q_D(const QQmlDelegateModel);
+    return d->m_filterRole;
+}
+
+void QQmlDelegateModel::setFilterRole(const QString &role)
+{
+    Q_D(QQmlDelegateModel);
+    if (d->m_filterRole != role) {
+        d->m_filterRole = role;
+        if (d->m_filter.isCallable())
+            invalidate();
+        emit filterRoleChanged();
+    }
+}
+
+/*!
+    \qmlproperty function QtQml.Models::DelegateModel::filter
+    \since 5.7
+
+    This property holds a function deciding which items of the model are members of
+    the \l items group.
+
+    The function is called with the value of the \l filterRole of an item and should
+    return true if the item is to be shown.  Items which are rejected are removed from
+    the \l items group, but keep their membership of any other group.  The filter is
+    re-evaluated for items which are inserted or changed; call invalidate() if the
+    filter depends on other state.
+*/
+
+QJSValue QQmlDelegateModel::filter() const
+{
+    Q_D(const QQmlDelegateModel);
+    return d->m_filter;
+}
+
+void QQmlDelegateModel::setFilter(const QJSValue &filter)
+{
+    Q_D(QQmlDelegateModel);
+    if (!d->m_filter.strictlyEquals(filter)) {
+        d->m_filter = filter;
+        if (d->m_complete && d->m_filteredOutGroup == -1 && filter.isCallable())
+            qmlInfo(this) << tr("filter: A DelegateModel with %1 groups cannot be filtered").arg(d->m_groupCount - 1);
+        invalidate();
+        emit filterChanged();
+    }
+}
+
+/*!
+    \qmlmethod QtQml.Models::DelegateModel::invalidate()
+    \since 5.7
+
+    Re-evaluates the \l filter and \l sortRole of every item in the model.
+*/
+
+void QQmlDelegateModel::invalidate()
+{
+    Q_D(QQmlDelegateModel);
+    if (!d->m_complete)
+        return;
+
+    if (d->m_transaction) {
+        qmlInfo(this) << tr("The sort order of a DelegateModel cannot be changed within onChanged");
+        return;
+    }
+
+    if (d->sortAndFilter(0, d->m_count))
+        d->emitChanges();
+}
+
+QVariant QQmlDelegateModelPrivate::roleValue(int row, const QString &role, int roleId)
+{
+    if (roleId != -1)
+        return m_adaptorModel.aim()->index(row, 0, m_adaptorModel.rootIndex).data(roleId);
+    return m_adaptorModel.value(row, role);
+}
+
+bool QQmlDelegateModelPrivate::filterAccepts(int row)
+{
+    Q_Q(QQmlDelegateModel);
+    QJSEngine *engine = m_context->engine();
+    const QVariant value = m_filterRole.isEmpty()
+            ? QVariant(row)
+            : roleValue(row, m_filterRole, m_filterRoleId);
+
+    const QJSValue result = m_filter.call(QJSValueList() << engine->toScriptValue(value));
+    if (result.isError()) {
+        qmlInfo(q) << result.toString();
+        return true;
+    }
+    return result.toBool();
+}
+
+static bool isNumericSortKey(const QVariant &value)
+{
+    switch (value.userType()) {
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::LongLong:
+    case QMetaType::ULongLong:
+    case QMetaType::Double:
+    case QMetaType::Float:
+    case QMetaType::Long:
+    case QMetaType::ULong:
+    case QMetaType::Short:
+    case QMetaType::UShort:
+        return true;
+    default:
+        return false;
+    }
+}
+
+static bool isDateSortKey(const QVariant &value)
+{
+    return value.userType() == QMetaType::QDateTime || value.userType() == QMetaType::QDate;
+}
+
+bool QQmlDelegateModelPrivate::sortLessThan(const QVariant &left, const QVariant &right)
+{
+    Q_Q(QQmlDelegateModel);
+    const QVariant &first = m_sortOrder == Qt::AscendingOrder ? left : right;
+    const QVariant &second = m_sortOrder == Qt::AscendingOrder ? right : left;
+
+    if (m_lessThan.isCallable()) {
+        QJSEngine *engine = m_context->engine();
+        const QJSValue result = m_lessThan.call(QJSValueList()
+                << engine->toScriptValue(first)
+                << engine->toScriptValue(second));
+        if (result.isError()) {
+            qmlInfo(q) << result.toString();
+            return false;
+        }
+        return result.toBool();
+    }
+
+    // Items without a value sort before everything else.
+    if (!first.isValid() || !second.isValid())
+        return !first.isValid() && second.isValid();
+    if (isNumericSortKey(first) && isNumericSortKey(second))
+        return first.toDouble() < second.toDouble();
+    if (isDateSortKey(first) && isDateSortKey(second))
+        return first.toDateTime() < second.toDateTime();
+    return QString::localeAwareCompare(first.toString(), second.toString()) < 0;
+}
+
+namespace {
+
+struct SortEntry
+{
+    int row;        // -1 for items which aren't from the model.
+    int position;   // Index of the item in the items group before sorting.
+};
+
+struct SortEntryLessThan
+{
+    SortEntryLessThan(QQmlDelegateModelPrivate *d) : d(d) {}
+
+    bool operator ()(const SortEntry &left, const SortEntry &right) const
+    {
+        if (left.row == -1 || right.row == -1)
+            return left.row != -1;
+        if (d->m_sortRole.isEmpty())
+            return left.row < right.row;
+        return d->sortLessThan(d->m_sortKeys.at(left.row), d->m_sortKeys.at(right.row));
+    }
+
+    QQmlDelegateModelPrivate *d;
+};
+
+// Merges the sorted ranges [begin, middle) and [middle, end) of from into to.  Only the
+// bounds are relied upon, so a comparison which is not a strict weak ordering results in an
+// unspecified order rather than undefined behavior.
+static void mergeSortEntries(
+        const SortEntry *from, int begin, int middle, int end, SortEntry *to,
+        const SortEntryLessThan &lessThan)
+{
+    int left = begin;
+    int right = middle;
+    for (int i = begin; i < end; ++i) {
+        if (left < middle && (right == end || !lessThan(from[right], from[left])))
+            to[i] = from[left++];
+        else
+            to[i] = from[right++];
+    }
+}
+
+// A bottom up merge sort in place of std::stable_sort, which may read outside of the range
+// for a user supplied lessThan that is inconsistent.
+static void sortEntries(QVector<SortEntry> *entries, const SortEntryLessThan &lessThan)
+{
+    const int count = entries->count();
+    QVector<SortEntry> buffer(count);
+    SortEntry *from = entries->data();
+    SortEntry *to = buffer.data();
+    for (int width = 1; width < count; width *= 2) {
+        for (int begin = 0; begin < count; begin += 2 * width) {
+            const int middle = qMin(begin + width, count);
+            const int end = qMin(begin + 2 * width, count);
+            mergeSortEntries(from, begin, middle, end, to, lessThan);
+        }
+        std::swap(from, to);
+    }
+    if (from != entries->data())
+        *entries = buffer;
+}
+
+}
+
+/*
+    Applies the filter and sort order to the model rows \a dirtyIndex to
+    \a dirtyIndex + \a dirtyCount - 1, assuming the remaining items are already filtered
+    and in order.  Rows rejected by the filter are moved from the items group to an
+    internal group which isn't visible to the rest of the model, and back again when
+    they're accepted.
+
+    Returns true if any changes were made to the groups; the changes are not emitted.
+*/
+
+bool QQmlDelegateModelPrivate::sortAndFilter(int dirtyIndex, int dirtyCount)
+{
+    if (!m_complete || !m_context || !m_context->isValid())
+        return false;
+
+    m_sortRoleId = -1;
+    m_filterRoleId = -1;
+    if (const QAbstractItemModel *model = qobject_cast<const QAbstractItemModel *>(m_adaptorModel.object())) {
+        const QHash<int, QByteArray> roleNames = model->roleNames();
+        m_sortRoleId = roleNames.key(m_sortRole.toUtf8(), -1);
+        m_filterRoleId = roleNames.key(m_filterRole.toUtf8(), -1);
+    }
+
+    const bool sorting = !m_sortRole.isEmpty();
+    if (!sorting) {
+        m_sortKeys.clear();
+    } else if (m_sortKeys.count() != m_count) {
+        m_sortKeys.resize(m_count);
+        dirtyIndex = 0;
+        dirtyCount = m_count;
+    }
+    const bool full = dirtyIndex == 0 && dirtyCount >= m_count;
+
+    QBitArray dirty(m_count);
+    if (dirtyCount > 0)
+        dirty.fill(true, dirtyIndex, dirtyIndex + dirtyCount);
+
+    const bool filtering = m_filteredOutGroup != -1 && m_filter.isCallable();
+    QBitArray accepted(m_count, true);
+    for (int row = dirtyIndex; row < dirtyIndex + dirtyCount; ++row) {
+        if (sorting)
+            m_sortKeys[row] = roleValue(row, m_sortRole, m_sortRoleId);
+        if (filtering)
+            accepted.setBit(row, filterAccepts(row));
+    }
+
+    bool changed = false;
+    bool shown = false;
+
+    if (m_filteredOutGroup != -1) {
+        const Compositor::Group hiddenGroup = Compositor::Group(m_filteredOutGroup);
+        const int hiddenFlag = 1 << m_filteredOutGroup;
+
+        // Return accepted items to the items group, working backwards so the indexes of
+        // the remaining hidden items are unaffected.
+        const int hiddenCount = m_compositor.count(hiddenGroup);
+        QVector<int> hiddenRows(hiddenCount);
+        Compositor::iterator hiddenIt = m_compositor.find(hiddenGroup, 0);
+        for (int i = 0; i < hiddenCount; ++i) {
+            if (i > 0)
+                hiddenIt += 1;
+            hiddenRows[i] = hiddenIt.modelIndex();
+        }
+        for (int end = hiddenCount; end > 0;) {
+            const int row = hiddenRows.at(end - 1);
+            if (filtering && !(dirty.testBit(row) && accepted.testBit(row))) {
+                --end;
+                continue;
+            }
+            int start = end - 1;
+            for (; start > 0; --start) {
+                const int previous = hiddenRows.at(start - 1);
+                if (filtering && !(dirty.testBit(previous) && accepted.testBit(previous)))
+                    break;
+            }
+            for (int i = start; i < end; ++i)
+                dirty.setBit(hiddenRows.at(i));
+
+            QVector<Compositor::Insert> inserts;
+            m_compositor.setFlags(hiddenGroup, start, end - start, Compositor::DefaultFlag, &inserts);
+            itemsInserted(inserts);
+            m_compositor.clearFlags(hiddenGroup, start, end - start, hiddenFlag);
+            changed = true;
+            shown = true;
+            end = start;
+        }
+
+        // Move rejected items out of the items group.
+        if (filtering) {
+            const int itemCount = m_compositor.count(Compositor::Default);
+            QVector<int> rejected;
+            Compositor::iterator it = m_compositor.find(Compositor::Default, 0);
+            for (int i = 0; i < itemCount; ++i) {
+                if (i > 0)
+                    it += 1;
+                if (it.list<QQmlAdaptorModel>() != &m_adaptorModel)
+                    continue;
+                const int row = it.modelIndex();
+                if (dirty.testBit(row) && !accepted.testBit(row))
+                    rejected.append(i);
+            }
+            for (int end = rejected.count(); end > 0;) {
+                int start = end - 1;
+                while (start > 0 && rejected.at(start - 1) == rejected.at(start) - 1)
+                    --start;
+                const int index = rejected.at(start);
+                const int rangeCount = end - start;
+
+                QVector<Compositor::Remove> removes;
+                m_compositor.setFlags(Compositor::Default, index, rangeCount, hiddenFlag);
+                m_compositor.clearFlags(Compositor::Default, index, rangeCount, Compositor::DefaultFlag, &removes);
+                itemsRemoved(removes);
+                changed = true;
+                end = start;
+            }
+        }
+    }
+
+    if (!sorting && !full && !shown)
+        return changed;
+
+    const int count = m_compositor.count(Compositor::Default);
+    if (count < 2)
+        return changed;
+
+    QVector<SortEntry> cleanEntries;
+    QVector<SortEntry> dirtyEntries;
+    Compositor::iterator it = m_compositor.find(Compositor::Default, 0);
+    for (int i = 0; i < count; ++i) {
+        if (i > 0)
+            it += 1;
+        SortEntry entry;
+        entry.row = it.list<QQmlAdaptorModel>() == &m_adaptorModel ? it.modelIndex() : -1;
+        entry.position = i;
+        if (full || entry.row == -1 || dirty.testBit(entry.row))
+            dirtyEntries.append(entry);
+        else
+            cleanEntries.append(entry);
+    }
+
+    const SortEntryLessThan lessThan(this);
+    if (sorting && m_lessThan.isCallable() && !dirtyEntries.isEmpty()
+            && dirtyEntries.first().row != -1) {
+        const QVariant &key = m_sortKeys.at(dirtyEntries.first().row);
+        if (sortLessThan(key, key)) {
+            Q_Q(QQmlDelegateModel);
+            qmlInfo(q) << QQmlDelegateModel::tr("lessThan: The function does not define a strict weak ordering");
+        }
+    }
+    sortEntries(&dirtyEntries, lessThan);
+
+    // Merge the re-sorted items with the items which are already in order.
+    QVector<int> order(count);
+    {
+        const int cleanCount = cleanEntries.count();
+        cleanEntries += dirtyEntries;
+        QVector<SortEntry> merged(count);
+        mergeSortEntries(cleanEntries.constData(), 0, cleanCount, count, merged.data(), lessThan);
+        for (int i = 0; i < count; ++i)
+            order[i] = merged.at(i).position;
+    }
+
+    // Apply the permutation in one pass over the compositor.  Only the items which are not
+    // part of the longest run already in order are moved.
+    QVector<Compositor::Remove> removes;
+    QVector<Compositor::Insert> inserts;
+    m_compositor.reorder(Compositor::Default, order, &removes, &inserts);
+    if (removes.isEmpty())
+        return changed;
+
+    int movedCount = 0;
+    foreach (const Compositor::Remove &remove, removes)
+        movedCount += remove.count;
+
+    // Reporting a large number of moves costs more than having views rebuild their contents.
+    if (movedCount > count / 4) {
+        QHash<int, QList<QQmlDelegateModelItem *> > movedItems;
+        QVarLengthArray<QVector<QQmlChangeSet::Change>, Compositor::MaximumGroupCount> translatedRemoves(m_groupCount);
+        QVarLengthArray<QVector<QQmlChangeSet::Change>, Compositor::MaximumGroupCount> translatedInserts(m_groupCount);
+        itemsRemoved(removes, &translatedRemoves, &movedItems);
+        itemsInserted(inserts, &translatedInserts, &movedItems);
+        Q_ASSERT(movedItems.isEmpty());
+        Q_ASSERT(m_cache.count() == m_compositor.count(Compositor::Cache));
+
+        // The groups are told to refresh all their items whether or not there is a delegate,
+        // as their order may have changed with that of the items group.
+        for (int i = 1; i < m_groupCount; ++i) {
+            QQmlChangeSet &changeSet = QQmlDelegateModelGroupPrivate::get(m_groups[i])->changeSet;
+            const int groupCount = m_compositor.count(Compositor::Group(i));
+            changeSet.remove(0, groupCount);
+            changeSet.insert(0, groupCount);
+        }
+        m_reset = true;
+    } else {
+        itemsMoved(removes, inserts);
+    }
+    return true;
+}
+
 /*!
     \qmlproperty object QtQml.Models::DelegateModel::parts
 
@@ -855,6 +1400,73 @@ void QQmlDelegateModelPrivate::removeCacheItem(QQmlDelegateModelItem *cacheItem)
     Q_ASSERT(m_cache.count() == m_compositor.count(Compositor::Cache));
 }
 
+/*
+    Items can only be reused if nothing but the released object references them and if
+    all of their state can be rebound to another index, which excludes packages, items
+    inserted from script and models that expose their data through a proxy object.
+*/
+bool QQmlDelegateModelPrivate::isReusable(QQmlDelegateModelItem *cacheItem) const
+{
+    return cacheItem->object
+            && !cacheItem->incubationTask
+            && cacheItem->scriptRef == 1
+            && cacheItem->index >= 0
+            && !(cacheItem->groups & Compositor::UnresolvedFlag)
+            && !m_adaptorModel.hasProxyObject()
+            && !qmlobject_cast<QQuickPackage *>(cacheItem->object);
+}
+
+static const int MinimumReusableItemsPoolSize = 16;
+
+void QQmlDelegateModelPrivate::addReusableItem(QQmlDelegateModelItem *cacheItem)
+{
+    Q_Q(QQmlDelegateModel);
+
+    const int index = cacheItem->groupIndex(m_compositorGroup);
+    removeCacheItem(cacheItem);
+    m_reusableItemsPool.append(cacheItem);
+
+    emit q->itemPooled(index, cacheItem->object);
+
+    // Keep about as many pooled items as there are live ones, enough to refill a view
+    // that scrolled by a page, and destroy the items that were pooled the longest.
+    drainReusableItemsPool(qMax(m_cache.count(), MinimumReusableItemsPoolSize));
+}
+
+QQmlDelegateModelItem *QQmlDelegateModelPrivate::takeReusableItem(Compositor::iterator it)
+{
+    if (m_reusableItemsPool.isEmpty() || it.modelIndex() < 0 || !it.list<QQmlAdaptorModel>())
+        return 0;
+
+    QQmlDelegateModelItem *cacheItem = m_reusableItemsPool.takeLast();
+    cacheItem->groups = it->flags;
+
+    m_cache.insert(it.cacheIndex, cacheItem);
+    m_compositor.setFlags(it, 1, Compositor::CacheFlag);
+    Q_ASSERT(m_cache.count() == m_compositor.count(Compositor::Cache));
+
+    cacheItem->rebindIndex(m_adaptorModel, it.modelIndex());
+
+    if (QQmlDelegateModelAttached *attached = cacheItem->attached) {
+        for (int i = 1; i < m_groupCount; ++i)
+            attached->m_currentIndex[i] = it.index[i];
+        attached->emitChanges();
+    }
+
+    return cacheItem;
+}
+
+void QQmlDelegateModelPrivate::drainReusableItemsPool(int maximumCount)
+{
+    while (m_reusableItemsPool.count() > maximumCount) {
+        QQmlDelegateModelItem *cacheItem = m_reusableItemsPool.takeFirst();
+        QObject *object = cacheItem->object;
+        cacheItem->destroyObject();
+        emitDestroyingItem(object);
+        cacheItem->Dispose();
+    }
+}
+
 void QQmlDelegateModelPrivate::incubatorStatusChanged(QQDMIncubationTask *incubationTask, QQmlIncubator::Status status)
 {
     Q_Q(QQmlDelegateModel);
@@ -925,8 +1537,11 @@ QObject *QQmlDelegateModelPrivate::object(Compositor::Group group, int index, bo
     Compositor::iterator it = m_compositor.find(group, index);
 
     QQmlDelegateModelItem *cacheItem = it->inCache() ? m_cache.at(it.cacheIndex) : 0;
+    bool reused = false;
 
-    if (!cacheItem) {
+    if (!cacheItem && (cacheItem = takeReusableItem(it))) {
+        reused = true;
+    } else if (!cacheItem) {
         cacheItem = m_adaptorModel.createItem(m_cacheMetaType, m_context->engine(), it.modelIndex());
         if (!cacheItem)
             return 0;
@@ -986,8 +1601,11 @@ QObject *QQmlDelegateModelPrivate::object(Compositor::Group group, int index, bo
 
     // Remove the temporary reference count.
     cacheItem->scriptRef -= 1;
-    if (cacheItem->object && (!cacheItem->incubationTask || isDoneIncubating(cacheItem->incubationTask->status())))
+    if (cacheItem->object && (!cacheItem->incubationTask || isDoneIncubating(cacheItem->incubationTask->status()))) {
+        if (reused)
+            emit q->itemReused(index, cacheItem->object);
         return cacheItem->object;
+    }
 
     cacheItem->releaseObject();
     if (!cacheItem->isReferenced()) {
@@ -1090,7 +1708,9 @@ void QQmlDelegateModelPrivate::setGroups(
 
     m_compositor.setFlags(from, count, group, groupFlags, &inserts);
     itemsInserted(inserts);
-    const int removeFlags = ~groupFlags & Compositor::GroupMask;
+    int removeFlags = ~groupFlags & Compositor::GroupMask;
+    if (m_filteredOutGroup != -1)
+        removeFlags &= ~(1 << m_filteredOutGroup);
 
     from = m_compositor.find(from.group, from.index[from.group]);
     m_compositor.clearFlags(from, count, group, removeFlags, &removes);
@@ -1136,12 +1756,17 @@ void QQmlDelegateModel::_q_itemsChanged(int index, int count, const QVector<int>
     if (count <= 0 || !d->m_complete)
         return;
 
+    bool changed = false;
     if (d->m_adaptorModel.notify(d->m_cache, index, count, roles)) {
         QVector<Compositor::Change> changes;
         d->m_compositor.listItemsChanged(&d->m_adaptorModel, index, count, &changes);
         d->itemsChanged(changes);
-        d->emitChanges();
+        changed = true;
     }
+    if (d->isSortedOrFiltered() && d->sortAndFilter(index, count))
+        changed = true;
+    if (changed)
+        d->emitChanges();
 }
 
 static void incrementIndexes(QQmlDelegateModelItem *cacheItem, int count, const int *deltas)
@@ -1244,6 +1869,11 @@ void QQmlDelegateModel::_q_itemsInserted(int index, int count)
     QVector<Compositor::Insert> inserts;
     d->m_compositor.listItemsInserted(&d->m_adaptorModel, index, count, &inserts);
     d->itemsInserted(inserts);
+    if (d->isSortedOrFiltered()) {
+        if (d->m_sortKeys.count() == d->m_count - count)
+            d->m_sortKeys.insert(index, count, QVariant());
+        d->sortAndFilter(index, count);
+    }
     d->emitChanges();
 }
 
@@ -1367,6 +1997,8 @@ void QQmlDelegateModel::_q_itemsRemoved(int index, int count)
     QVector<Compositor::Remove> removes;
     d->m_compositor.listItemsRemoved(&d->m_adaptorModel, index, count, &removes);
     d->itemsRemoved(removes);
+    if (d->m_sortKeys.count() == d->m_count + count)
+        d->m_sortKeys.remove(index, count);
 
     d->emitChanges();
 }
@@ -1416,6 +2048,16 @@ void QQmlDelegateModel::_q_itemsMoved(int from, int to, int count)
     QVector<Compositor::Insert> inserts;
     d->m_compositor.listItemsMoved(&d->m_adaptorModel, from, to, count, &removes, &inserts);
     d->itemsMoved(removes, inserts);
+    if (!d->m_sortRole.isEmpty()) {
+        if (d->m_sortKeys.count() == d->m_count) {
+            QVector<QVariant>::iterator keys = d->m_sortKeys.begin();
+            if (from < to)
+                std::rotate(keys + from, keys + from + count, keys + to + count);
+            else
+                std::rotate(keys + to, keys + from, keys + from + count);
+        }
+        d->sortAndFilter(to, count);
+    }
     d->emitChanges();
 }
 
@@ -1457,6 +2099,7 @@ void QQmlDelegateModel::_q_modelReset()
 
     int oldCount = d->m_count;
     d->m_adaptorModel.rootIndex = QModelIndex();
+    d->drainReusableItemsPool(0);
 
     if (d->m_complete) {
         d->m_count = d->m_adaptorModel.count();
@@ -1476,6 +2119,9 @@ void QQmlDelegateModel::_q_modelReset()
             d->m_compositor.listItemsInserted(&d->m_adaptorModel, 0, d->m_count, &inserts);
         d->itemsMoved(removes, inserts);
         d->m_reset = true;
+        d->m_sortKeys.clear();
+        if (d->isSortedOrFiltered())
+            d->sortAndFilter(0, d->m_count);
 
         if (d->m_adaptorModel.canFetchMore())
             d->m_adaptorModel.fetchMore();
@@ -2000,7 +2646,9 @@ int QQmlDelegateModelItem::groupIndex(Compositor::Group group)
     if (QQmlDelegateModelPrivate * const model = metaType->model
             ? QQmlDelegateModelPrivate::get(metaType->model)
             : 0) {
-        return model->m_compositor.find(Compositor::Cache, model->m_cache.indexOf(this)).index[group];
+        const int cacheIndex = model->m_cache.indexOf(this);
+        if (cacheIndex != -1)
+            return model->m_compositor.find(Compositor::Cache, cacheIndex).index[group];
     }
     return -1;
 }
@@ -3162,7 +3810,7 @@ QObject *QQmlPartsModel::object(int index, bool asynchronous)
     return 0;
 }
 
-QQmlInstanceModel::ReleaseFlags QQmlPartsModel::release(QObject *item)
+QQmlInstanceModel::ReleaseFlags QQmlPartsModel::release(QObject *item, ReusableFlag)
 {
     QQmlInstanceModel::ReleaseFlags flags = 0;
 
@@ -40,6 +40,7 @@
 
 #include <QtCore/qabstractitemmodel.h>
 #include <QtCore/qstringlist.h>
+#include <QtQml/qjsvalue.h>
 
 #include <private/qv8engine_p.h>
 #include <private/qqmlglobal_p.h>
@@ -68,6 +69,11 @@ class Q_QML_PRIVATE_EXPORT QQmlDelegateModel : public QQmlInstanceModel, public
     Q_PROPERTY(QQmlListProperty<QQmlDelegateModelGroup> groups READ groups CONSTANT)
     Q_PROPERTY(QObject *parts READ parts CONSTANT)
     Q_PROPERTY(QVariant rootIndex READ rootIndex WRITE setRootIndex NOTIFY rootIndexChanged)
+    Q_PROPERTY(QString sortRole READ sortRole WRITE setSortRole NOTIFY sortRoleChanged REVISION 1)
+    Q_PROPERTY(Qt::SortOrder sortOrder READ sortOrder WRITE setSortOrder NOTIFY sortOrderChanged REVISION 1)
+    Q_PROPERTY(QJSValue lessThan READ lessThan WRITE setLessThan NOTIFY lessThanChanged REVISION 1)
+    Q_PROPERTY(QString filterRole READ filterRole WRITE setFilterRole NOTIFY filterRoleChanged REVISION 1)
+    Q_PROPERTY(QJSValue filter READ filter WRITE setFilter NOTIFY filterChanged REVISION 1)
     Q_CLASSINFO("DefaultProperty", "delegate")
     Q_INTERFACES(QQmlParserStatus)
 public:
@@ -93,7 +99,7 @@ public:
     int count() const;
     bool isValid() const { return delegate() != 0; }
     QObject *object(int index, bool asynchronous=false);
-    ReleaseFlags release(QObject *object);
+    ReleaseFlags release(QObject *object, ReusableFlag reusableFlag = NotReusable);
     void cancel(int index);
     virtual QString stringValue(int index, const QString &role);
     virtual void setWatchedRoles(QList<QByteArray> roles);
@@ -104,6 +110,19 @@ public:
     void setFilterGroup(const QString &group);
     void resetFilterGroup();
 
+    QString sortRole() const;
+    void setSortRole(const QString &role);
+    Qt::SortOrder sortOrder() const;
+    void setSortOrder(Qt::SortOrder order);
+    QJSValue lessThan() const;
+    void setLessThan(const QJSValue &lessThan);
+    QString filterRole() const;
+    void setFilterRole(const QString &role);
+    QJSValue filter() const;
+    void setFilter(const QJSValue &filter);
+
+    Q_REVISION(1) Q_INVOKABLE void invalidate();
+
     QQmlDelegateModelGroup *items();
     QQmlDelegateModelGroup *persistedItems();
     QQmlListProperty<QQmlDelegateModelGroup> groups();
@@ -117,6 +136,11 @@ Q_SIGNALS:
     void filterGroupChanged();
     void defaultGroupsChanged();
     void rootIndexChanged();
+    Q_REVISION(1) void sortRoleChanged();
+    Q_REVISION(1) void sortOrderChanged();
+    Q_REVISION(1) void lessThanChanged();
+    Q_REVISION(1) void filterRoleChanged();
+    Q_REVISION(1) void filterChanged();
 
 private Q_SLOTS:
     void _q_itemsChanged(int index, int count, const QVector<int> &roles);
@@ -119,6 +119,8 @@ public:
 
     int modelIndex() const { return index; }
     void setModelIndex(int idx) { index = idx; Q_EMIT modelIndexChanged(); }
+    // Moves a pooled item to another model index, refreshing any data cached for the old one.
+    virtual void rebindIndex(const QQmlAdaptorModel &, int idx) { setModelIndex(idx); }
 
     virtual QV4::ReturnedValue get() { return QV4::QObjectWrapper::wrap(v4, this); }
 
@@ -256,7 +258,8 @@ public:
     void connectModel(QQmlAdaptorModel *model);
 
     QObject *object(Compositor::Group group, int index, bool asynchronous);
-    QQmlDelegateModel::ReleaseFlags release(QObject *object);
+    QQmlDelegateModel::ReleaseFlags release(
+            QObject *object, QQmlInstanceModel::ReusableFlag reusableFlag = QQmlInstanceModel::NotReusable);
     QString stringValue(Compositor::Group group, int index, const QString &name);
     void emitCreatedPackage(QQDMIncubationTask *incubationTask, QQuickPackage *package);
     void emitInitPackage(QQDMIncubationTask *incubationTask, QQuickPackage *package);
@@ -268,8 +271,21 @@ public:
     void emitDestroyingItem(QObject *item) { Q_EMIT q_func()->destroyingItem(item); }
     void removeCacheItem(QQmlDelegateModelItem *cacheItem);
 
+    bool isReusable(QQmlDelegateModelItem *cacheItem) const;
+    void addReusableItem(QQmlDelegateModelItem *cacheItem);
+    QQmlDelegateModelItem *takeReusableItem(Compositor::iterator it);
+    void drainReusableItemsPool(int maximumCount);
+
     void updateFilterGroup();
 
+    bool isSortedOrFiltered() const {
+        return !m_sortRole.isEmpty() || m_filter.isCallable()
+                || (m_filteredOutGroup != -1 && m_compositor.count(Compositor::Group(m_filteredOutGroup)) > 0); }
+    QVariant roleValue(int row, const QString &role, int roleId);
+    bool filterAccepts(int row);
+    bool sortLessThan(const QVariant &left, const QVariant &right);
+    bool sortAndFilter(int dirtyIndex, int dirtyCount);
+
     void addGroups(Compositor::iterator from, int count, Compositor::Group group, int groupFlags);
     void removeGroups(Compositor::iterator from, int count, Compositor::Group group, int groupFlags);
     void setGroups(Compositor::iterator from, int count, Compositor::Group group, int groupFlags);
@@ -309,13 +325,24 @@ public:
     QQmlDelegateModelGroupEmitterList m_pendingParts;
 
     QList<QQmlDelegateModelItem *> m_cache;
+    QList<QQmlDelegateModelItem *> m_reusableItemsPool;
     QList<QQDMIncubationTask *> m_finishedIncubating;
     QList<QByteArray> m_watchedRoles;
 
     QString m_filterGroup;
 
+    QString m_sortRole;
+    QString m_filterRole;
+    QJSValue m_lessThan;
+    QJSValue m_filter;
+    QVector<QVariant> m_sortKeys;
+
     int m_count;
     int m_groupCount;
+    int m_filteredOutGroup;
+    int m_sortRoleId;
+    int m_filterRoleId;
+    Qt::SortOrder m_sortOrder;
 
     QQmlListCompositor::Group m_compositorGroup;
     bool m_complete : 1;
@@ -353,7 +380,7 @@ public:
     int count() const;
     bool isValid() const;
     QObject *object(int index, bool asynchronous=false);
-    ReleaseFlags release(QObject *item);
+    ReleaseFlags release(QObject *item, ReusableFlag reusableFlag = NotReusable);
     QString stringValue(int index, const QString &role);
     QList<QByteArray> watchedRoles() const { return m_watchedRoles; }
     void setWatchedRoles(QList<QByteArray> roles);
@@ -53,6 +53,9 @@
 #include <QXmlStreamReader>
 #include <QtCore/qdatetime.h>
 
+#include <algorithm>
+#include <limits>
+
 QT_BEGIN_NAMESPACE
 
 // Set to 1024 as a debugging aid - easier to distinguish uids from indices of elements/models.
@@ -1424,6 +1427,441 @@ void DynamicRoleModelNodeMetaObject::propertyWritten(int index)
     }
 }
 
+template <typename T>
+static void moveColumnRange(QVector<T> &v, int from, int to, int n)
+{
+    if (v.isEmpty())
+        return;
+    typename QVector<T>::iterator b = v.begin();
+    if (from < to)
+        std::rotate(b + from, b + from + n, b + to + n);
+    else
+        std::rotate(b + to, b + from, b + from + n);
+}
+
+static ColumnarListModel::Column::DataType columnTypeOf(const QVariant &data)
+{
+    switch (data.userType()) {
+    case QMetaType::Int:
+    case QMetaType::Short:
+    case QMetaType::UShort:
+    case QMetaType::Char:
+    case QMetaType::SChar:
+    case QMetaType::UChar:
+        return ColumnarListModel::Column::Int;
+    case QMetaType::UInt:
+    case QMetaType::Long:
+    case QMetaType::ULong:
+    case QMetaType::LongLong:
+    case QMetaType::ULongLong:
+    case QMetaType::Float:
+    case QMetaType::Double:
+        return ColumnarListModel::Column::Double;
+    case QMetaType::Bool:
+        return ColumnarListModel::Column::Bool;
+    case QMetaType::QString:
+        return ColumnarListModel::Column::String;
+    default:
+        return ColumnarListModel::Column::Variant;
+    }
+}
+
+static QVariant columnValueFromJS(const QV4::Value &value, QV4::ExecutionEngine *v4)
+{
+    if (const QV4::String *s = value.as<QV4::String>())
+        return s->toQString();
+    if (value.isInteger())
+        return value.integerValue();
+    if (value.isNumber()) {
+        // Numbers computed in JS are often doubles holding an integral value;
+        // keep those in an integer column as long as they fit.
+        const double d = value.asDouble();
+        if (d >= std::numeric_limits<int>::min() && d <= std::numeric_limits<int>::max()
+                && double(int(d)) == d)
+            return int(d);
+        return d;
+    }
+    if (value.isBoolean())
+        return value.booleanValue();
+    if (value.isNullOrUndefined())
+        return QVariant();
+    return v4->toVariant(value, -1, /*createJSValueForObjects*/false);
+}
+
+// The string table is compacted when it holds this many strings more than
+// twice the number of string cells.
+static const int qmlColumnarStringSlack = 64;
+
+ColumnarListModel::ColumnarListModel()
+    : m_stringCompactionLimit(qmlColumnarStringSlack)
+    , m_count(0)
+{
+    // String index 0 is the empty string, which is what new string cells hold.
+    m_strings.append(QString());
+    m_stringHash.insert(QString(), 0);
+}
+
+QVariant ColumnarListModel::cellValue(const Column &column, int row) const
+{
+    switch (column.type) {
+    case Column::Int:
+        return column.ints.at(row);
+    case Column::Double:
+        return column.doubles.at(row);
+    case Column::Bool:
+        return column.bools.at(row);
+    case Column::String:
+        return m_strings.at(column.ints.at(row));
+    case Column::Variant:
+        return column.variants.at(row);
+    default:
+        return QVariant();
+    }
+}
+
+QVariant ColumnarListModel::value(int row, int role) const
+{
+    if (role < 0 || role >= m_columns.count())
+        return QVariant();
+    return cellValue(m_columns.at(role), row);
+}
+
+QV4::ReturnedValue ColumnarListModel::get(int row, QV4::ExecutionEngine *v4) const
+{
+    QV4::Scope scope(v4);
+    QV4::ScopedObject o(scope, v4->newObject());
+    QV4::ScopedValue value(scope);
+
+    for (int i = 0; i < m_columns.count(); ++i) {
+        const Column &column = m_columns.at(i);
+        switch (column.type) {
+        case Column::Int:
+            value = QV4::Primitive::fromInt32(column.ints.at(row));
+            break;
+        case Column::Double:
+            value = QV4::Primitive::fromDouble(column.doubles.at(row));
+            break;
+        case Column::Bool:
+            value = QV4::Primitive::fromBoolean(column.bools.at(row));
+            break;
+        case Column::String:
+            value = v4->newString(m_strings.at(column.ints.at(row)));
+            break;
+        case Column::Variant:
+            value = v4->fromVariant(column.variants.at(row));
+            break;
+        default:
+            continue;
+        }
+        o->put(v4, column.name, value);
+    }
+
+    return o.asReturnedValue();
+}
+
+int ColumnarListModel::getOrCreateColumn(const QString &key)
+{
+    QHash<QString, int>::const_iterator it = m_columnHash.constFind(key);
+    if (it != m_columnHash.constEnd())
+        return it.value();
+
+    const int index = m_columns.count();
+    Column column;
+    column.name = key;
+    m_columns.append(column);
+    m_columnHash.insert(key, index);
+    return index;
+}
+
+int ColumnarListModel::stringIndex(const QString &s)
+{
+    QHash<QString, int>::const_iterator it = m_stringHash.constFind(s);
+    if (it != m_stringHash.constEnd())
+        return it.value();
+
+    // Strings are never released one by one.  Instead the table is rebuilt from
+    // the cells once it has grown well past what they can reference.
+    if (m_strings.count() >= m_stringCompactionLimit)
+        compactStrings();
+
+    const int index = m_strings.count();
+    m_strings.append(s);
+    m_stringHash.insert(s, index);
+    return index;
+}
+
+void ColumnarListModel::compactStrings()
+{
+    QVector<int> remap(m_strings.count(), -1);
+    QVector<QString> strings;
+    strings.append(QString());
+    remap[0] = 0;
+    int stringCells = 0;
+
+    for (int i = 0; i < m_columns.count(); ++i) {
+        Column &column = m_columns[i];
+        if (column.type != Column::String)
+            continue;
+        stringCells += m_count;
+        for (int row = 0; row < m_count; ++row) {
+            int &index = column.ints[row];
+            if (remap.at(index) == -1) {
+                remap[index] = strings.count();
+                strings.append(m_strings.at(index));
+            }
+            index = remap.at(index);
+        }
+    }
+
+    m_strings = strings;
+    m_stringHash.clear();
+    for (int i = 0; i < m_strings.count(); ++i)
+        m_stringHash.insert(m_strings.at(i), i);
+    m_stringCompactionLimit = qMax(m_strings.count(), stringCells) * 2 + qmlColumnarStringSlack;
+}
+
+void ColumnarListModel::convertColumn(Column &column, Column::DataType type)
+{
+    if (column.type == type)
+        return;
+
+    switch (type) {
+    case Column::Int:
+        column.ints.fill(0, m_count);
+        break;
+    case Column::Double:
+        column.doubles.resize(m_count);
+        for (int i = 0; i < m_count; ++i)
+            column.doubles[i] = column.type == Column::Int ? column.ints.at(i) : 0.0;
+        column.ints = QVector<int>();
+        break;
+    case Column::Bool:
+        column.bools.fill(false, m_count);
+        break;
+    case Column::String:
+        column.ints.fill(0, m_count);
+        break;
+    case Column::Variant:
+        column.variants.resize(m_count);
+        for (int i = 0; i < m_count; ++i)
+            column.variants[i] = cellValue(column, i);
+        column.ints = QVector<int>();
+        column.doubles = QVector<double>();
+        column.bools = QVector<bool>();
+        break;
+    default:
+        Q_UNREACHABLE();
+    }
+
+    column.type = type;
+}
+
+bool ColumnarListModel::setCell(Column &column, int row, const QVariant &data)
+{
+    if (!data.isValid()) {
+        // null and undefined reset the cell to the column's default value
+        switch (column.type) {
+        case Column::Int:
+        case Column::String:
+            if (column.ints.at(row) == 0)
+                return false;
+            column.ints[row] = 0;
+            return true;
+        case Column::Double:
+            if (column.doubles.at(row) == 0.0)
+                return false;
+            column.doubles[row] = 0.0;
+            return true;
+        case Column::Bool:
+            if (!column.bools.at(row))
+                return false;
+            column.bools[row] = false;
+            return true;
+        case Column::Variant:
+            if (!column.variants.at(row).isValid())
+                return false;
+            column.variants[row] = QVariant();
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    Column::DataType type = columnTypeOf(data);
+    if (column.type == Column::Invalid) {
+        convertColumn(column, type);
+    } else if (column.type != type) {
+        if (column.type == Column::Int && type == Column::Double)
+            convertColumn(column, Column::Double);
+        else if (column.type != Column::Double || type != Column::Int)
+            convertColumn(column, Column::Variant);
+    }
+
+    switch (column.type) {
+    case Column::Int: {
+        const int v = data.toInt();
+        if (column.ints.at(row) == v)
+            return false;
+        column.ints[row] = v;
+        return true;
+    }
+    case Column::Double: {
+        const double v = data.toDouble();
+        if (column.doubles.at(row) == v)
+            return false;
+        column.doubles[row] = v;
+        return true;
+    }
+    case Column::Bool: {
+        const bool v = data.toBool();
+        if (column.bools.at(row) == v)
+            return false;
+        column.bools[row] = v;
+        return true;
+    }
+    case Column::String: {
+        const int v = stringIndex(data.toString());
+        if (column.ints.at(row) == v)
+            return false;
+        column.ints[row] = v;
+        return true;
+    }
+    default:
+        if (column.variants.at(row) == data)
+            return false;
+        column.variants[row] = data;
+        return true;
+    }
+}
+
+int ColumnarListModel::setValue(int row, const QString &key, const QVariant &data)
+{
+    const int role = getOrCreateColumn(key);
+    return setCell(m_columns[role], row, data) ? role : -1;
+}
+
+void ColumnarListModel::set(int row, QV4::Object *object, QVector<int> *roles)
+{
+    QV4::ExecutionEngine *v4 = object->engine();
+    QV4::Scope scope(v4);
+
+    QV4::ObjectIterator it(scope, object, QV4::ObjectIterator::WithProtoChain|QV4::ObjectIterator::EnumerableOnly);
+    QV4::ScopedString propertyName(scope);
+    QV4::ScopedValue propertyValue(scope);
+    while (1) {
+        propertyName = it.nextPropertyNameAsString(propertyValue);
+        if (!propertyName)
+            break;
+
+        const int role = setValue(row, propertyName->toQString(), columnValueFromJS(propertyValue, v4));
+        if (role != -1 && roles)
+            roles->append(role);
+    }
+}
+
+void ColumnarListModel::insertRows(int row, int count)
+{
+    for (int i = 0; i < m_columns.count(); ++i) {
+        Column &column = m_columns[i];
+        switch (column.type) {
+        case Column::Int:
+        case Column::String:
+            column.ints.insert(row, count, 0);
+            break;
+        case Column::Double:
+            column.doubles.insert(row, count, 0.0);
+            break;
+        case Column::Bool:
+            column.bools.insert(row, count, false);
+            break;
+        case Column::Variant:
+            column.variants.insert(row, count, QVariant());
+            break;
+        default:
+            break;
+        }
+    }
+    m_count += count;
+}
+
+void ColumnarListModel::removeRows(int row, int count)
+{
+    for (int i = 0; i < m_columns.count(); ++i) {
+        Column &column = m_columns[i];
+        switch (column.type) {
+        case Column::Int:
+        case Column::String:
+            column.ints.remove(row, count);
+            break;
+        case Column::Double:
+            column.doubles.remove(row, count);
+            break;
+        case Column::Bool:
+            column.bools.remove(row, count);
+            break;
+        case Column::Variant:
+            column.variants.remove(row, count);
+            break;
+        default:
+            break;
+        }
+    }
+    m_count -= count;
+}
+
+void ColumnarListModel::moveRows(int from, int to, int n)
+{
+    for (int i = 0; i < m_columns.count(); ++i) {
+        Column &column = m_columns[i];
+        moveColumnRange(column.ints, from, to, n);
+        moveColumnRange(column.doubles, from, to, n);
+        moveColumnRange(column.bools, from, to, n);
+        moveColumnRange(column.variants, from, to, n);
+    }
+}
+
+void ColumnarListModel::clear()
+{
+    // Roles and their types survive a clear(), as they do for the other storage modes.
+    for (int i = 0; i < m_columns.count(); ++i) {
+        Column &column = m_columns[i];
+        column.ints.clear();
+        column.doubles.clear();
+        column.bools.clear();
+        column.variants.clear();
+    }
+    m_strings.resize(1);
+    m_stringHash.clear();
+    m_stringHash.insert(QString(), 0);
+    m_stringCompactionLimit = qmlColumnarStringSlack;
+    m_count = 0;
+}
+
+int ColumnarListModel::bytesPerRow() const
+{
+    int bytes = 0;
+    for (int i = 0; i < m_columns.count(); ++i) {
+        switch (m_columns.at(i).type) {
+        case Column::Int:
+        case Column::String:
+            bytes += sizeof(int);
+            break;
+        case Column::Double:
+            bytes += sizeof(double);
+            break;
+        case Column::Bool:
+            bytes += sizeof(bool);
+            break;
+        case Column::Variant:
+            bytes += sizeof(QVariant);
+            break;
+        default:
+            break;
+        }
+    }
+    return bytes;
+}
+
 /*!
     \qmltype ListModel
     \instantiates QQmlListModel
@@ -1515,6 +1953,14 @@ void DynamicRoleModelNodeMetaObject::propertyWritten(int index)
     You must call sync() or else the changes made to the list from that
     thread will not be reflected in the list model in the main thread.
 
+    All the changes a worker makes to a model between two calls to sync() are
+    merged before they are delivered, so views are updated once per sync
+    rather than once per modification. For large models that are filled or
+    updated from a worker, enable \l columnarStorage: the worker then shares
+    the model's columns with the main thread and only copies the columns it
+    writes to, and sync() hands them back without copying any rows, so the
+    main thread is not blocked in proportion to the size of the model.
+
     \sa {qml-data-models}{Data Models}, {Qt Quick Examples - Threading}, {Qt QML}
 */
 
@@ -1529,6 +1975,10 @@ QQmlListModel::QQmlListModel(QObject *parent)
 
     m_layout = new ListLayout;
     m_listModel = new ListModel(m_layout, this, -1);
+    m_columnarModel = 0;
+    m_batchDepth = 0;
+    m_batchCount = 0;
+    m_flushCount = -1;
 
     m_engine = 0;
 }
@@ -1544,6 +1994,10 @@ QQmlListModel::QQmlListModel(const QQmlListModel *owner, ListModel *data, QV4::E
     m_dynamicRoles = false;
     m_layout = 0;
     m_listModel = data;
+    m_columnarModel = 0;
+    m_batchDepth = 0;
+    m_batchCount = 0;
+    m_flushCount = -1;
 
     m_engine = engine;
 }
@@ -1558,11 +2012,20 @@ QQmlListModel::QQmlListModel(QQmlListModel *orig, QQmlListModelWorkerAgent *agen
 
     m_layout = new ListLayout(orig->m_layout);
     m_listModel = new ListModel(m_layout, this, orig->m_listModel->getUid());
-
-    if (m_dynamicRoles)
+    m_columnarModel = 0;
+    m_batchDepth = 0;
+    m_batchCount = 0;
+    m_flushCount = -1;
+
+    if (orig->m_columnarModel) {
+        // The columns are implicitly shared, so this copy is cheap until either side writes.
+        m_columnarModel = new ColumnarListModel(*orig->m_columnarModel);
+        m_uid = orig->m_uid;
+    } else if (m_dynamicRoles) {
         sync(orig, this, 0);
-    else
+    } else {
         ListModel::sync(orig->m_listModel, m_listModel, 0);
+    }
 
     m_engine = 0;
 }
@@ -1584,6 +2047,9 @@ QQmlListModel::~QQmlListModel()
 
     m_listModel = 0;
 
+    delete m_columnarModel;
+    m_columnarModel = 0;
+
     delete m_layout;
     m_layout = 0;
 }
@@ -1680,17 +2146,23 @@ void QQmlListModel::emitItemsChanged(int index, int count, const QVector<int> &r
     if (count <= 0)
         return;
 
-    if (m_mainThread) {
+    if (m_mainThread && m_batchDepth) {
+        m_batchChanges.change(index, count);
+        for (int i = 0; i < roles.count(); ++i) {
+            if (!m_batchRoles.contains(roles.at(i)))
+                m_batchRoles.append(roles.at(i));
+        }
+    } else if (m_mainThread) {
         emit dataChanged(createIndex(index, 0), createIndex(index + count - 1, 0), roles);;
     } else {
-        int uid = m_dynamicRoles ? getUid() : m_listModel->getUid();
+        int uid = (m_dynamicRoles || m_columnarModel) ? getUid() : m_listModel->getUid();
         m_agent->data.changedChange(uid, index, count, roles);
     }
 }
 
 void QQmlListModel::emitItemsAboutToBeRemoved(int index, int count)
 {
-    if (count <= 0 || !m_mainThread)
+    if (count <= 0 || !m_mainThread || m_batchDepth)
         return;
 
     beginRemoveRows(QModelIndex(), index, index + count - 1);
@@ -1701,11 +2173,13 @@ void QQmlListModel::emitItemsRemoved(int index, int count)
     if (count <= 0)
         return;
 
-    if (m_mainThread) {
+    if (m_mainThread && m_batchDepth) {
+        m_batchChanges.remove(index, count);
+    } else if (m_mainThread) {
             endRemoveRows();
             emit countChanged();
     } else {
-        int uid = m_dynamicRoles ? getUid() : m_listModel->getUid();
+        int uid = (m_dynamicRoles || m_columnarModel) ? getUid() : m_listModel->getUid();
         if (index == 0 && count == this->count())
             m_agent->data.clearChange(uid);
         m_agent->data.removeChange(uid, index, count);
@@ -1714,7 +2188,7 @@ void QQmlListModel::emitItemsRemoved(int index, int count)
 
 void QQmlListModel::emitItemsAboutToBeInserted(int index, int count)
 {
-    if (count <= 0 || !m_mainThread)
+    if (count <= 0 || !m_mainThread || m_batchDepth)
         return;
 
     beginInsertRows(QModelIndex(), index, index + count - 1);
@@ -1725,11 +2199,13 @@ void QQmlListModel::emitItemsInserted(int index, int count)
     if (count <= 0)
         return;
 
-    if (m_mainThread) {
+    if (m_mainThread && m_batchDepth) {
+        m_batchChanges.insert(index, count);
+    } else if (m_mainThread) {
         endInsertRows();
         emit countChanged();
     } else {
-        int uid = m_dynamicRoles ? getUid() : m_listModel->getUid();
+        int uid = (m_dynamicRoles || m_columnarModel) ? getUid() : m_listModel->getUid();
         m_agent->data.insertChange(uid, index, count);
     }
 }
@@ -1739,6 +2215,11 @@ void QQmlListModel::emitItemsAboutToBeMoved(int from, int to, int n)
     if (n <= 0 || !m_mainThread)
         return;
 
+    // Moves are not batched; the changes recorded so far are delivered first so
+    // that the move indexes are meaningful to the receiver.
+    if (m_batchDepth)
+        flushBatch();
+
     beginMoveRows(QModelIndex(), from, from + n - 1, QModelIndex(), to > from ? to + n : to);
 }
 
@@ -1750,11 +2231,54 @@ void QQmlListModel::emitItemsMoved(int from, int to, int n)
     if (m_mainThread) {
         endMoveRows();
     } else {
-        int uid = m_dynamicRoles ? getUid() : m_listModel->getUid();
+        int uid = (m_dynamicRoles || m_columnarModel) ? getUid() : m_listModel->getUid();
         m_agent->data.moveChange(uid, from, n, to);
     }
 }
 
+void QQmlListModel::flushBatch()
+{
+    if (m_batchChanges.isEmpty())
+        return;
+
+    const QQmlChangeSet changes = m_batchChanges;
+    const QVector<int> roles = m_batchRoles;
+    m_batchChanges.clear();
+    m_batchRoles.clear();
+
+    // The storage already holds the final rows, but each remove and insert of the change set
+    // is relative to the list as left by the previous ones. rowCount() reports the size of
+    // that intermediate list while the notifications are delivered, so the rows given to
+    // begin*Rows() are always valid for the model as the view last saw it.
+    m_flushCount = count();
+    foreach (const QQmlChangeSet::Change &remove, changes.removes())
+        m_flushCount += remove.count;
+    foreach (const QQmlChangeSet::Change &insert, changes.inserts())
+        m_flushCount -= insert.count;
+
+    foreach (const QQmlChangeSet::Change &remove, changes.removes()) {
+        beginRemoveRows(QModelIndex(), remove.index, remove.index + remove.count - 1);
+        m_flushCount -= remove.count;
+        endRemoveRows();
+    }
+    foreach (const QQmlChangeSet::Change &insert, changes.inserts()) {
+        beginInsertRows(QModelIndex(), insert.index, insert.index + insert.count - 1);
+        m_flushCount += insert.count;
+        endInsertRows();
+    }
+    Q_ASSERT(m_flushCount == count());
+    m_flushCount = -1;
+
+    foreach (const QQmlChangeSet::Change &change, changes.changes())
+        emit dataChanged(createIndex(change.index, 0), createIndex(change.end() - 1, 0), roles);
+
+    const int newCount = count();
+    if (newCount != m_batchCount) {
+        m_batchCount = newCount;
+        emit countChanged();
+    }
+}
+
 QQmlListModelWorkerAgent *QQmlListModel::agent()
 {
     if (m_agent)
@@ -1766,14 +2290,16 @@ QQmlListModelWorkerAgent *QQmlListModel::agent()
 
 QModelIndex QQmlListModel::index(int row, int column, const QModelIndex &parent) const
 {
-    return row >= 0 && row < count() && column == 0 && !parent.isValid()
+    return row >= 0 && row < rowCount(QModelIndex()) && column == 0 && !parent.isValid()
             ? createIndex(row, column)
             : QModelIndex();
 }
 
 int QQmlListModel::rowCount(const QModelIndex &parent) const
 {
-    return !parent.isValid() ? count() : 0;
+    if (parent.isValid())
+        return 0;
+    return m_flushCount >= 0 ? m_flushCount : count();
 }
 
 QVariant QQmlListModel::data(const QModelIndex &index, int role) const
@@ -1788,7 +2314,9 @@ QVariant QQmlListModel::data(int index, int role) const
     if (index >= count() || index < 0)
         return v;
 
-    if (m_dynamicRoles)
+    if (m_columnarModel)
+        v = m_columnarModel->value(index, role);
+    else if (m_dynamicRoles)
         v = m_modelObjects[index]->getValue(m_roles[role]);
     else
         v = m_listModel->getProperty(index, role, this, engine());
@@ -1800,7 +2328,10 @@ QHash<int, QByteArray> QQmlListModel::roleNames() const
 {
     QHash<int, QByteArray> roleNames;
 
-    if (m_dynamicRoles) {
+    if (m_columnarModel) {
+        for (int i = 0 ; i < m_columnarModel->roleCount() ; ++i)
+            roleNames.insert(i, m_columnarModel->roleName(i).toUtf8());
+    } else if (m_dynamicRoles) {
         for (int i = 0 ; i < m_roles.count() ; ++i)
             roleNames.insert(i, m_roles.at(i).toUtf8());
     } else {
@@ -1843,7 +2374,7 @@ void QQmlListModel::setDynamicRoles(bool enableDynamicRoles)
 {
     if (m_mainThread && m_agent == 0) {
         if (enableDynamicRoles) {
-            if (m_layout->roleCount())
+            if (m_layout->roleCount() || m_columnarModel)
                 qmlInfo(this) << tr("unable to enable dynamic roles as this model is not empty!");
             else
                 m_dynamicRoles = true;
@@ -1859,6 +2390,78 @@ void QQmlListModel::setDynamicRoles(bool enableDynamicRoles)
     }
 }
 
+/*!
+    \qmlproperty bool ListModel::columnarStorage
+    \since 5.7
+
+    By default, each element of a ListModel is stored as a separate
+    block of role values. When the columnarStorage property is enabled,
+    the model instead keeps one contiguous, typed array per role, which
+    makes large models of flat records much cheaper: a cell takes 4 bytes
+    for integers and strings, 8 bytes for other numbers, 1 byte for
+    booleans, and \c{sizeof(QVariant)} for any other value. Strings are
+    stored once per model and shared between all cells holding them.
+
+    Appending an array of objects with append() grows every role in a
+    single step, so populating a large model from JavaScript costs one
+    allocation per role rather than one per element.
+
+    A role's type is chosen by the first value assigned to it. A role
+    holding integers becomes a floating point role when a fractional
+    number is assigned, and a role that is given a value of another type
+    falls back to storing variants. Elements that do not set a role read
+    its default value: \c 0, \c false or an empty string.
+
+    Columnar storage has the following restrictions:
+
+    \list
+    \li Array and object values are stored as plain data; they are not
+        converted into nested ListModels.
+    \li get() returns a copy of the element. Use set() or setProperty()
+        to modify it.
+    \li It cannot be combined with \l dynamicRoles.
+    \endlist
+
+    Columns are implicitly shared. When the model is used from a WorkerScript,
+    sync() passes the worker's columns to the main thread without copying
+    them, which keeps syncing large models cheap.
+
+    Like dynamicRoles, the columnarStorage property must be set before any
+    data is added to the ListModel, and must be set from the main thread.
+    A ListModel that has data statically defined (via the ListElement QML
+    syntax) cannot have columnar storage enabled.
+*/
+void QQmlListModel::setColumnarStorage(bool enableColumnarStorage)
+{
+    if (enableColumnarStorage == (m_columnarModel != 0))
+        return;
+
+    if (!m_mainThread || m_agent) {
+        qmlInfo(this) << tr("columnar storage setting must be made from the main thread, before any worker scripts are created");
+    } else if (count() || m_layout->roleCount() || m_roles.count()
+               || (m_columnarModel && m_columnarModel->roleCount())) {
+        qmlInfo(this) << tr("unable to change the storage of this model as it is not empty!");
+    } else if (m_dynamicRoles) {
+        qmlInfo(this) << tr("unable to enable columnar storage together with dynamic roles");
+    } else if (enableColumnarStorage) {
+        m_columnarModel = new ColumnarListModel;
+    } else {
+        delete m_columnarModel;
+        m_columnarModel = 0;
+    }
+}
+
+/*!
+    \internal
+
+    Returns the number of entries in the string table of the columnar storage,
+    including the empty string, or 0 if the model doesn't use columnar storage.
+*/
+int QQmlListModel::columnarStringCount() const
+{
+    return m_columnarModel ? m_columnarModel->stringCount() : 0;
+}
+
 /*!
     \qmlproperty int ListModel::count
     The number of data entries in the model.
@@ -1867,7 +2470,9 @@ int QQmlListModel::count() const
 {
     int count;
 
-    if (m_dynamicRoles)
+    if (m_columnarModel)
+        count = m_columnarModel->count();
+    else if (m_dynamicRoles)
         count = m_modelObjects.count();
     else {
         count = m_listModel->elementCount();
@@ -1889,7 +2494,9 @@ void QQmlListModel::clear()
 
     emitItemsAboutToBeRemoved(0, cleared);
 
-    if (m_dynamicRoles) {
+    if (m_columnarModel) {
+        m_columnarModel->clear();
+    } else if (m_dynamicRoles) {
         for (int i=0 ; i < m_modelObjects.count() ; ++i)
             delete m_modelObjects[i];
         m_modelObjects.clear();
@@ -1923,7 +2530,9 @@ void QQmlListModel::remove(QQmlV4Function *args)
 
         emitItemsAboutToBeRemoved(index, removeCount);
 
-        if (m_dynamicRoles) {
+        if (m_columnarModel) {
+            m_columnarModel->removeRows(index, removeCount);
+        } else if (m_dynamicRoles) {
             for (int i=0 ; i < removeCount ; ++i)
                 delete m_modelObjects[index+i];
             m_modelObjects.remove(index, removeCount);
@@ -1972,10 +2581,15 @@ void QQmlListModel::insert(QQmlV4Function *args)
 
             int objectArrayLength = objectArray->getLength();
             emitItemsAboutToBeInserted(index, objectArrayLength);
+            if (m_columnarModel)
+                m_columnarModel->insertRows(index, objectArrayLength);
             for (int i=0 ; i < objectArrayLength ; ++i) {
                 argObject = objectArray->getIndexed(i);
 
-                if (m_dynamicRoles) {
+                if (m_columnarModel) {
+                    if (argObject)
+                        m_columnarModel->set(index+i, argObject, 0);
+                } else if (m_dynamicRoles) {
                     m_modelObjects.insert(index+i, DynamicRoleModelNode::create(scope.engine->variantMapFromJS(argObject), this));
                 } else {
                     m_listModel->insert(index+i, argObject);
@@ -1985,7 +2599,10 @@ void QQmlListModel::insert(QQmlV4Function *args)
         } else if (argObject) {
             emitItemsAboutToBeInserted(index, 1);
 
-            if (m_dynamicRoles) {
+            if (m_columnarModel) {
+                m_columnarModel->insertRows(index, 1);
+                m_columnarModel->set(index, argObject, 0);
+            } else if (m_dynamicRoles) {
                 m_modelObjects.insert(index, DynamicRoleModelNode::create(scope.engine->variantMapFromJS(argObject), this));
             } else {
                 m_listModel->insert(index, argObject);
@@ -2025,7 +2642,9 @@ void QQmlListModel::move(int from, int to, int n)
 
     emitItemsAboutToBeMoved(from, to, n);
 
-    if (m_dynamicRoles) {
+    if (m_columnarModel) {
+        m_columnarModel->moveRows(from, to, n);
+    } else if (m_dynamicRoles) {
 
         int realFrom = from;
         int realTo = to;
@@ -2082,10 +2701,17 @@ void QQmlListModel::append(QQmlV4Function *args)
             int index = count();
             emitItemsAboutToBeInserted(index, objectArrayLength);
 
+            // Grow every column once for the whole array, then fill the rows in place
+            if (m_columnarModel)
+                m_columnarModel->insertRows(index, objectArrayLength);
+
             for (int i=0 ; i < objectArrayLength ; ++i) {
                 argObject = objectArray->getIndexed(i);
 
-                if (m_dynamicRoles) {
+                if (m_columnarModel) {
+                    if (argObject)
+                        m_columnarModel->set(index+i, argObject, 0);
+                } else if (m_dynamicRoles) {
                     m_modelObjects.append(DynamicRoleModelNode::create(scope.engine->variantMapFromJS(argObject), this));
                 } else {
                     m_listModel->append(argObject);
@@ -2096,7 +2722,12 @@ void QQmlListModel::append(QQmlV4Function *args)
         } else if (argObject) {
             int index;
 
-            if (m_dynamicRoles) {
+            if (m_columnarModel) {
+                index = m_columnarModel->count();
+                emitItemsAboutToBeInserted(index, 1);
+                m_columnarModel->insertRows(index, 1);
+                m_columnarModel->set(index, argObject, 0);
+            } else if (m_dynamicRoles) {
                 index = m_modelObjects.count();
                 emitItemsAboutToBeInserted(index, 1);
                 m_modelObjects.append(DynamicRoleModelNode::create(scope.engine->variantMapFromJS(argObject), this));
@@ -2153,7 +2784,9 @@ QQmlV4Handle QQmlListModel::get(int index) const
 
     if (index >= 0 && index < count()) {
 
-        if (m_dynamicRoles) {
+        if (m_columnarModel) {
+            result = m_columnarModel->get(index, scope.engine);
+        } else if (m_dynamicRoles) {
             DynamicRoleModelNode *object = m_modelObjects[index];
             result = QV4::QObjectWrapper::wrap(scope.engine, object);
         } else {
@@ -2199,7 +2832,10 @@ void QQmlListModel::set(int index, const QQmlV4Handle &handle)
     if (index == count()) {
         emitItemsAboutToBeInserted(index, 1);
 
-        if (m_dynamicRoles) {
+        if (m_columnarModel) {
+            m_columnarModel->insertRows(index, 1);
+            m_columnarModel->set(index, object, 0);
+        } else if (m_dynamicRoles) {
             m_modelObjects.append(DynamicRoleModelNode::create(scope.engine->variantMapFromJS(object), this));
         } else {
             m_listModel->insert(index, object);
@@ -2210,7 +2846,9 @@ void QQmlListModel::set(int index, const QQmlV4Handle &handle)
 
         QVector<int> roles;
 
-        if (m_dynamicRoles) {
+        if (m_columnarModel) {
+            m_columnarModel->set(index, object, &roles);
+        } else if (m_dynamicRoles) {
             m_modelObjects[index]->updateValues(scope.engine->variantMapFromJS(object), roles);
         } else {
             m_listModel->set(index, object, &roles);
@@ -2241,7 +2879,17 @@ void QQmlListModel::setProperty(int index, const QString& property, const QVaria
         return;
     }
 
-    if (m_dynamicRoles) {
+    if (m_columnarModel) {
+        QVariant v = value;
+        if (v.userType() == qMetaTypeId<QJSValue>())
+            v = v.value<QJSValue>().toVariant();
+        int roleIndex = m_columnarModel->setValue(index, property, v);
+        if (roleIndex != -1) {
+            QVector<int> roles;
+            roles << roleIndex;
+            emitItemsChanged(index, 1, roles);
+        }
+    } else if (m_dynamicRoles) {
         int roleIndex = m_roles.indexOf(property);
         if (roleIndex == -1) {
             roleIndex = m_roles.count();
@@ -2278,6 +2926,66 @@ void QQmlListModel::sync()
     qmlInfo(this) << "List sync() can only be called from a WorkerScript";
 }
 
+/*!
+    \qmlmethod ListModel::beginBatch()
+    \since 5.7
+
+    Starts a batch of modifications. Until the matching endBatch() call,
+    append(), insert(), remove(), set(), setProperty() and clear() update the
+    model's content but do not notify views; the notifications are merged
+    into a single, compressed set of changes that is delivered by endBatch().
+
+    Populating or updating a model from a JavaScript loop inside a batch
+    therefore costs views one update instead of one per call:
+
+    \code
+        fruitModel.beginBatch()
+        for (var i = 0; i < data.length; ++i)
+            fruitModel.append(data[i])
+        fruitModel.endBatch()
+    \endcode
+
+    Batches may be nested; only the outermost endBatch() delivers the changes.
+    A move() inside a batch first delivers the changes recorded so far.
+
+    Batching only applies to modifications made from the main thread. Views
+    are not updated while a batch is open, so a batch should be ended before
+    control returns to the event loop.
+
+    \sa endBatch()
+*/
+void QQmlListModel::beginBatch()
+{
+    if (!m_mainThread)
+        return;
+
+    if (m_batchDepth++ == 0)
+        m_batchCount = count();
+}
+
+/*!
+    \qmlmethod ListModel::endBatch()
+    \since 5.7
+
+    Ends a batch of modifications started with beginBatch(), and notifies
+    views of all changes made during the batch.
+
+    \sa beginBatch()
+*/
+void QQmlListModel::endBatch()
+{
+    if (!m_mainThread)
+        return;
+
+    if (m_batchDepth == 0) {
+        qmlInfo(this) << tr("endBatch: no batch in progress");
+        return;
+    }
+
+    if (--m_batchDepth == 0)
+        flushBatch();
+}
+
 bool QQmlListModelParser::verifyProperty(const QV4::CompiledData::Unit *qmlUnit, const QV4::CompiledData::Binding *binding)
 {
     if (binding->type >= QV4::CompiledData::Binding::Type_Object) {
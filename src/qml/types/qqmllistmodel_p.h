@@ -46,6 +46,7 @@
 
 #include <private/qv4engine_p.h>
 #include <private/qpodvector_p.h>
+#include <private/qqmlchangeset_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -53,12 +54,14 @@ QT_BEGIN_NAMESPACE
 class QQmlListModelWorkerAgent;
 class ListModel;
 class ListLayout;
+class ColumnarListModel;
 
 class Q_QML_PRIVATE_EXPORT QQmlListModel : public QAbstractListModel
 {
     Q_OBJECT
     Q_PROPERTY(int count READ count NOTIFY countChanged)
     Q_PROPERTY(bool dynamicRoles READ dynamicRoles WRITE setDynamicRoles)
+    Q_PROPERTY(bool columnarStorage READ columnarStorage WRITE setColumnarStorage)
 
 public:
     QQmlListModel(QObject *parent=0);
@@ -81,12 +84,18 @@ public:
     Q_INVOKABLE void setProperty(int index, const QString& property, const QVariant& value);
     Q_INVOKABLE void move(int from, int to, int count);
     Q_INVOKABLE void sync();
+    Q_INVOKABLE void beginBatch();
+    Q_INVOKABLE void endBatch();
 
     QQmlListModelWorkerAgent *agent();
 
     bool dynamicRoles() const { return m_dynamicRoles; }
     void setDynamicRoles(bool enableDynamicRoles);
 
+    bool columnarStorage() const { return m_columnarModel != 0; }
+    void setColumnarStorage(bool enableColumnarStorage);
+    int columnarStringCount() const;
+
 Q_SIGNALS:
     void countChanged();
 
@@ -117,6 +126,13 @@ private:
 
     ListLayout *m_layout;
     ListModel *m_listModel;
+    ColumnarListModel *m_columnarModel;
+
+    int m_batchDepth;
+    int m_batchCount;
+    int m_flushCount;
+    QQmlChangeSet m_batchChanges;
+    QVector<int> m_batchRoles;
 
     QVector<class DynamicRoleModelNode *> m_modelObjects;
     QVector<QString> m_roles;
@@ -142,6 +158,7 @@ private:
     void emitItemsInserted(int index, int count);
     void emitItemsAboutToBeMoved(int from, int to, int n);
     void emitItemsMoved(int from, int to, int n);
+    void flushBatch();
 };
 
 // ### FIXME
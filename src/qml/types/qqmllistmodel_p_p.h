@@ -368,6 +368,81 @@ private:
     friend class QQmlListModelWorkerAgent;
 };
 
+/*!
+\internal
+
+Column oriented storage used by a ListModel with columnarStorage enabled.
+Each role is held in one contiguous typed array, so role access by row is a
+single indexed load and no per-row object is ever created.
+*/
+class ColumnarListModel
+{
+public:
+    ColumnarListModel();
+
+    class Column
+    {
+    public:
+        enum DataType
+        {
+            Invalid = -1,
+
+            Int,
+            Double,
+            Bool,
+            String,
+            Variant,
+
+            MaxDataType
+        };
+
+        Column() : type(Invalid) {}
+
+        QString name;
+        DataType type;
+
+        // Only the vector matching type is populated. String columns store
+        // indices into the model's string table in ints.
+        QVector<int> ints;
+        QVector<double> doubles;
+        QVector<bool> bools;
+        QVector<QVariant> variants;
+    };
+
+    int count() const { return m_count; }
+    int roleCount() const { return m_columns.count(); }
+    const QString &roleName(int role) const { return m_columns.at(role).name; }
+
+    QVariant value(int row, int role) const;
+    QV4::ReturnedValue get(int row, QV4::ExecutionEngine *v4) const;
+
+    int setValue(int row, const QString &key, const QVariant &data);
+    void set(int row, QV4::Object *object, QVector<int> *roles);
+
+    void insertRows(int row, int count);
+    void removeRows(int row, int count);
+    void moveRows(int from, int to, int n);
+    void clear();
+
+    int bytesPerRow() const;
+    int stringCount() const { return m_strings.count(); }
+
+private:
+    int getOrCreateColumn(const QString &key);
+    bool setCell(Column &column, int row, const QVariant &data);
+    QVariant cellValue(const Column &column, int row) const;
+    void convertColumn(Column &column, Column::DataType type);
+    int stringIndex(const QString &s);
+    void compactStrings();
+
+    QVector<Column> m_columns;
+    QHash<QString, int> m_columnHash;
+    QVector<QString> m_strings;
+    QHash<QString, int> m_stringHash;
+    int m_stringCompactionLimit;
+    int m_count;
+};
+
 QT_END_NAMESPACE
 
 Q_DECLARE_METATYPE(ListModel *);
@@ -38,6 +38,7 @@
 #include <qqmlinfo.h>
 
 #include <QtCore/qcoreevent.h>
+#include <QtCore/qset.h>
 #include <QtCore/qcoreapplication.h>
 #include <QtCore/qdebug.h>
 
@@ -187,16 +188,33 @@ bool QQmlListModelWorkerAgent::event(QEvent *e)
             QHash<int, ListModel *> targetModelStaticHash;
 
             Q_ASSERT(m_orig->m_dynamicRoles == s->list->m_dynamicRoles);
-            if (m_orig->m_dynamicRoles)
+            Q_ASSERT(m_orig->columnarStorage() == s->list->columnarStorage());
+            if (m_orig->m_columnarModel)
+                *m_orig->m_columnarModel = *s->list->m_columnarModel;
+            else if (m_orig->m_dynamicRoles)
                 QQmlListModel::sync(s->list, m_orig, &targetModelDynamicHash);
             else
                 ListModel::sync(s->list->m_listModel, m_orig->m_listModel, &targetModelStaticHash);
 
+            // The changes of each model are merged into a single compressed change set, so a
+            // sync notifies views once per model however many calls the worker made. Moves
+            // cannot be expressed as model signals once merged with other changes, so the
+            // changes of a model that was moved are delivered as they were recorded.
+            QSet<int> movedModels;
+            for (int ii = 0; ii < changes.count(); ++ii) {
+                if (changes.at(ii).type == Change::Moved)
+                    movedModels.insert(changes.at(ii).modelUid);
+            }
+            QVector<QQmlListModel *> batchedModels;
+
             for (int ii = 0; ii < changes.count(); ++ii) {
                 const Change &change = changes.at(ii);
 
                 QQmlListModel *model = 0;
-                if (m_orig->m_dynamicRoles) {
+                if (m_orig->m_columnarModel) {
+                    if (change.modelUid == m_orig->getUid())
+                        model = m_orig;
+                } else if (m_orig->m_dynamicRoles) {
                     model = targetModelDynamicHash.value(change.modelUid);
                 } else {
                     ListModel *lm = targetModelStaticHash.value(change.modelUid);
@@ -204,7 +222,31 @@ bool QQmlListModelWorkerAgent::event(QEvent *e)
                         model = lm->m_modelCache;
                 }
 
-                if (model) {
+                if (model && !movedModels.contains(change.modelUid)) {
+                    if (!batchedModels.contains(model)) {
+                        batchedModels.append(model);
+                        if (!model->m_batchDepth)
+                            model->m_batchCount = model->count();
+                    }
+                    switch (change.type) {
+                    case Change::Inserted:
+                        model->m_batchChanges.insert(change.index, change.count);
+                        break;
+                    case Change::Removed:
+                        model->m_batchChanges.remove(change.index, change.count);
+                        break;
+                    case Change::Changed:
+                        model->m_batchChanges.change(change.index, change.count);
+                        for (int i = 0; i < change.roles.count(); ++i) {
+                            if (!model->m_batchRoles.contains(change.roles.at(i)))
+                                model->m_batchRoles.append(change.roles.at(i));
+                        }
+                        break;
+                    case Change::Moved:
+                        Q_UNREACHABLE();
+                        break;
+                    }
+                } else if (model) {
                     switch (change.type) {
                     case Change::Inserted:
                         model->beginInsertRows(
@@ -234,6 +276,13 @@ bool QQmlListModelWorkerAgent::event(QEvent *e)
                     }
                 }
             }
+
+            // A model still inside a batch started on this thread delivers the merged
+            // changes when that batch ends.
+            for (int i = 0; i < batchedModels.count(); ++i) {
+                if (!batchedModels.at(i)->m_batchDepth)
+                    batchedModels.at(i)->flushBatch();
+            }
         }
 
         syncDone.wakeAll();
@@ -50,6 +50,8 @@ void QQmlModelsModule::defineModule()
     qmlRegisterType<QQmlObjectModel>(uri, 2, 1, "ObjectModel");
 
     qmlRegisterType<QItemSelectionModel>(uri, 2, 2, "ItemSelectionModel");
+
+    qmlRegisterType<QQmlDelegateModel, 1>(uri, 2, 3, "DelegateModel");
 }
 
 QT_END_NAMESPACE
@@ -66,15 +66,18 @@ class WorkerDataEvent : public QEvent
 public:
     enum Type { WorkerData = QEvent::User };
 
-    WorkerDataEvent(int workerId, const QByteArray &data);
+    WorkerDataEvent(int workerId, const QByteArray &data,
+                    const QVector<QByteArray> &transferred = QVector<QByteArray>());
     virtual ~WorkerDataEvent();
 
     int workerId() const;
     QByteArray data() const;
+    QVector<QByteArray> *transferred();
 
 private:
     int m_id;
     QByteArray m_data;
+    QVector<QByteArray> m_transferred;
 };
 
 class WorkerLoadEvent : public QEvent
@@ -182,7 +185,7 @@ protected:
     virtual bool event(QEvent *);
 
 private:
-    void processMessage(int, const QByteArray &);
+    void processMessage(int, const QByteArray &, QVector<QByteArray> *);
     void processLoad(int, const QUrl &);
     void reportScriptException(WorkerScript *, const QQmlError &error);
 };
@@ -214,8 +217,8 @@ void QQuickWorkerScriptEnginePrivate::WorkerEngine::init()
 #define SEND_MESSAGE_CREATE_SCRIPT \
     "(function(method, engine) { "\
         "return (function(id) { "\
-            "return (function(message) { "\
-                "if (arguments.length) method(engine, id, message); "\
+            "return (function(message, transfer) { "\
+                "if (arguments.length) method(engine, id, message, transfer); "\
             "}); "\
         "}); "\
     "})"
@@ -281,12 +284,14 @@ QV4::ReturnedValue QQuickWorkerScriptEnginePrivate::method_sendMessage(QV4::Call
 
     QV4::Scope scope(ctx);
     QV4::ScopedValue v(scope, ctx->argument(2));
-    QByteArray data = QV4::Serialize::serialize(v, scope.engine);
+    QV4::ScopedValue transfer(scope, ctx->argument(3));
+    QVector<QByteArray> transferred;
+    QByteArray data = QV4::Serialize::serialize(v, transfer, scope.engine, &transferred);
 
     QMutexLocker locker(&engine->p->m_lock);
     WorkerScript *script = engine->p->workers.value(id);
     if (script && script->owner)
-        QCoreApplication::postEvent(script->owner, new WorkerDataEvent(0, data));
+        QCoreApplication::postEvent(script->owner, new WorkerDataEvent(0, data, transferred));
 
     return QV4::Encode::undefined();
 }
@@ -321,7 +326,7 @@ bool QQuickWorkerScriptEnginePrivate::event(QEvent *event)
 {
     if (event->type() == (QEvent::Type)WorkerDataEvent::WorkerData) {
         WorkerDataEvent *workerEvent = static_cast<WorkerDataEvent *>(event);
-        processMessage(workerEvent->workerId(), workerEvent->data());
+        processMessage(workerEvent->workerId(), workerEvent->data(), workerEvent->transferred());
         return true;
     } else if (event->type() == (QEvent::Type)WorkerLoadEvent::WorkerLoad) {
         WorkerLoadEvent *workerEvent = static_cast<WorkerLoadEvent *>(event);
@@ -343,7 +348,8 @@ bool QQuickWorkerScriptEnginePrivate::event(QEvent *event)
     }
 }
 
-void QQuickWorkerScriptEnginePrivate::processMessage(int id, const QByteArray &data)
+void QQuickWorkerScriptEnginePrivate::processMessage(int id, const QByteArray &data,
+                                                     QVector<QByteArray> *transferred)
 {
     WorkerScript *script = workers.value(id);
     if (!script)
@@ -353,7 +359,7 @@ void QQuickWorkerScriptEnginePrivate::processMessage(int id, const QByteArray &d
     QV4::Scope scope(v4);
     QV4::ScopedFunctionObject f(scope, workerEngine->onmessage.value());
 
-    QV4::ScopedValue value(scope, QV4::Serialize::deserialize(data, v4));
+    QV4::ScopedValue value(scope, QV4::Serialize::deserialize(data, v4, transferred));
 
     QV4::ScopedCallData callData(scope, 2);
     callData->thisObject = workerEngine->global();
@@ -423,8 +429,9 @@ void QQuickWorkerScriptEnginePrivate::reportScriptException(WorkerScript *script
         QCoreApplication::postEvent(script->owner, new WorkerErrorEvent(error));
 }
 
-WorkerDataEvent::WorkerDataEvent(int workerId, const QByteArray &data)
-: QEvent((QEvent::Type)WorkerData), m_id(workerId), m_data(data)
+WorkerDataEvent::WorkerDataEvent(int workerId, const QByteArray &data,
+                                 const QVector<QByteArray> &transferred)
+: QEvent((QEvent::Type)WorkerData), m_id(workerId), m_data(data), m_transferred(transferred)
 {
 }
 
@@ -442,6 +449,11 @@ QByteArray WorkerDataEvent::data() const
     return m_data;
 }
 
+QVector<QByteArray> *WorkerDataEvent::transferred()
+{
+    return &m_transferred;
+}
+
 WorkerLoadEvent::WorkerLoadEvent(int workerId, const QUrl &url)
 : QEvent((QEvent::Type)WorkerLoad), m_id(workerId), m_url(url)
 {
@@ -478,7 +490,7 @@ QQmlError WorkerErrorEvent::error() const
 }
 
 QQuickWorkerScriptEngine::QQuickWorkerScriptEngine(QQmlEngine *parent)
-: QThread(parent), d(new QQuickWorkerScriptEnginePrivate(parent))
+: QThread(parent), d(new QQuickWorkerScriptEnginePrivate(parent)), m_scriptCount(0)
 {
     d->m_lock.lock();
     connect(d, SIGNAL(stopThread()), this, SLOT(quit()), Qt::DirectConnection);
@@ -528,6 +540,7 @@ int QQuickWorkerScriptEngine::registerWorkerScript(QQuickWorkerScript *owner)
     d->workers.insert(script->id, script);
     d->m_lock.unlock();
 
+    ++m_scriptCount;
     return script->id;
 }
 
@@ -536,6 +549,7 @@ void QQuickWorkerScriptEngine::removeWorkerScript(int id)
     QQuickWorkerScriptEnginePrivate::WorkerScript* script = d->workers.value(id);
     if (script) {
         script->owner = 0;
+        --m_scriptCount;
         QCoreApplication::postEvent(d, new WorkerRemoveEvent(id));
     }
 }
@@ -545,9 +559,10 @@ void QQuickWorkerScriptEngine::executeUrl(int id, const QUrl &url)
     QCoreApplication::postEvent(d, new WorkerLoadEvent(id, url));
 }
 
-void QQuickWorkerScriptEngine::sendMessage(int id, const QByteArray &data)
+void QQuickWorkerScriptEngine::sendMessage(int id, const QByteArray &data,
+                                           const QVector<QByteArray> &transferred)
 {
-    QCoreApplication::postEvent(d, new WorkerDataEvent(id, data));
+    QCoreApplication::postEvent(d, new WorkerDataEvent(id, data, transferred));
 }
 
 void QQuickWorkerScriptEngine::run()
@@ -611,6 +626,15 @@ void QQuickWorkerScriptEngine::run()
     Additionally, there are restrictions on the types of values that can be passed to and
     from the worker script. See the sendMessage() documentation for details.
 
+    \section3 Worker Threads
+
+    By default all WorkerScript instances created by one QQmlEngine share a single
+    thread, so a long running handler delays the messages of every other worker.
+    Setting the \c QML_WORKER_SCRIPT_THREADS environment variable to a number
+    greater than one allows up to that many threads, each with its own JavaScript
+    engine. A WorkerScript is assigned to the least busy thread when it is created
+    and stays on it for its lifetime.
+
     Worker script can not use \l {qtqml-javascript-imports.html}{.import} syntax.
 
     \sa {Qt Quick Examples - Threading},
@@ -651,7 +675,7 @@ void QQuickWorkerScript::setSource(const QUrl &source)
 }
 
 /*!
-    \qmlmethod WorkerScript::sendMessage(jsobject message)
+    \qmlmethod WorkerScript::sendMessage(jsobject message, array transferList)
 
     Sends the given \a message to a worker script handler in another
     thread. The other worker script handler can receive this message
@@ -663,12 +687,27 @@ void QQuickWorkerScript::setSource(const QUrl &source)
     \list
     \li boolean, number, string
     \li JavaScript objects and arrays
+    \li ArrayBuffer and typed array objects
     \li ListModel objects (any other type of QObject* is not allowed)
     \endlist
 
     All objects and arrays are copied to the \c message. With the exception
     of ListModel objects, any modifications by the other thread to an object
     passed in \c message will not be reflected in the original object.
+
+    The optional \a transferList is an array of ArrayBuffer objects (or typed
+    arrays, standing for their buffer) whose contents are moved to the other
+    thread instead of being copied. This avoids copying large binary payloads,
+    but leaves the transferred buffers empty in the sending thread. The
+    worker side's \c WorkerScript.sendMessage() accepts the same second
+    argument.
+
+    \code
+    var pixels = new Uint8Array(width * height * 4);
+    worker.sendMessage({ 'width': width, 'height': height, 'pixels': pixels }, [pixels.buffer]);
+    \endcode
+
+    The \a transferList argument was introduced in Qt 5.7.
 */
 void QQuickWorkerScript::sendMessage(QQmlV4Function *args)
 {
@@ -679,10 +718,15 @@ void QQuickWorkerScript::sendMessage(QQmlV4Function *args)
 
     QV4::Scope scope(args->v4engine());
     QV4::ScopedValue argument(scope, QV4::Primitive::undefinedValue());
+    QV4::ScopedValue transfer(scope, QV4::Primitive::undefinedValue());
     if (args->length() != 0)
         argument = (*args)[0];
+    if (args->length() > 1)
+        transfer = (*args)[1];
 
-    m_engine->sendMessage(m_scriptId, QV4::Serialize::serialize(argument, scope.engine));
+    QVector<QByteArray> transferred;
+    QByteArray data = QV4::Serialize::serialize(argument, transfer, scope.engine, &transferred);
+    m_engine->sendMessage(m_scriptId, data, transferred);
 }
 
 void QQuickWorkerScript::classBegin()
@@ -734,7 +778,8 @@ bool QQuickWorkerScript::event(QEvent *event)
             WorkerDataEvent *workerEvent = static_cast<WorkerDataEvent *>(event);
             QV8Engine *v8engine = QQmlEnginePrivate::get(engine)->v8engine();
             QV4::Scope scope(QV8Engine::getV4(v8engine));
-            QV4::ScopedValue value(scope, QV4::Serialize::deserialize(workerEvent->data(), scope.engine));
+            QV4::ScopedValue value(scope, QV4::Serialize::deserialize(workerEvent->data(), scope.engine,
+                                                                      workerEvent->transferred()));
             emit message(QQmlV4Handle(value));
         }
         return true;
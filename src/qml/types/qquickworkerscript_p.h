@@ -51,6 +51,7 @@
 #include <QtCore/qthread.h>
 #include <QtQml/qjsvalue.h>
 #include <QtCore/qurl.h>
+#include <QtCore/qvector.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -67,13 +68,17 @@ public:
     int registerWorkerScript(QQuickWorkerScript *);
     void removeWorkerScript(int);
     void executeUrl(int, const QUrl &);
-    void sendMessage(int, const QByteArray &);
+    void sendMessage(int, const QByteArray &,
+                     const QVector<QByteArray> &transferred = QVector<QByteArray>());
+
+    int scriptCount() const { return m_scriptCount; }
 
 protected:
     virtual void run();
 
 private:
     QQuickWorkerScriptEnginePrivate *d;
+    int m_scriptCount;
 };
 
 class QQmlV4Function;
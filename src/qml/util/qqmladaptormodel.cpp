@@ -38,6 +38,8 @@
 #include <private/qqmlproperty_p.h>
 #include <private/qv8engine_p.h>
 
+#include <QtCore/qbitarray.h>
+
 #include <private/qv4value_p.h>
 #include <private/qv4functionobject_p.h>
 
@@ -96,15 +98,24 @@ public:
 
     virtual QVariant value(int role) const = 0;
     virtual void setValue(int role, const QVariant &value) = 0;
+    virtual void fetchValues(const QBitArray &properties);
 
     void setValue(const QString &role, const QVariant &value);
     bool resolveIndex(const QQmlAdaptorModel &model, int idx);
+    void rebindIndex(const QQmlAdaptorModel &model, int idx);
+
+    QVariant propertyValue(int propertyId);
+    void invalidateValues() { roleValues.clear(); fetchedRoles.clear(); }
+    void invalidateValue(int propertyId);
+    void notifyChangedValues();
 
     static QV4::ReturnedValue get_property(QV4::CallContext *ctx, uint propertyId);
     static QV4::ReturnedValue set_property(QV4::CallContext *ctx, uint propertyId);
 
     VDMModelDelegateDataType *type;
     QVector<QVariant> cachedData;
+    QVector<QVariant> roleValues;
+    QBitArray fetchedRoles;
 };
 
 class VDMModelDelegateDataType
@@ -148,7 +159,7 @@ public:
             const_cast<VDMModelDelegateDataType *>(this)->watchedRoleIds = roleIds;
         }
 
-        QVector<int> signalIndexes;
+        QVector<int> propertyIds;
         for (int i = 0; i < roles.count(); ++i) {
             const int role = roles.at(i);
             if (!changed && watchedRoleIds.contains(role))
@@ -156,19 +167,22 @@ public:
 
             int propertyId = propertyRoles.indexOf(role);
             if (propertyId != -1)
-                signalIndexes.append(propertyId + signalOffset);
-        }
-        if (roles.isEmpty()) {
-            for (int propertyId = 0; propertyId < propertyRoles.count(); ++propertyId)
-                signalIndexes.append(propertyId + signalOffset);
+                propertyIds.append(propertyId);
         }
 
         for (int i = 0, c = items.count();  i < c; ++i) {
-            QQmlDelegateModelItem *item = items.at(i);
+            QQmlDMCachedModelData *item = static_cast<QQmlDMCachedModelData *>(items.at(i));
             const int idx = item->modelIndex();
-            if (idx >= index && idx < index + count) {
-                for (int i = 0; i < signalIndexes.count(); ++i)
-                    QMetaObject::activate(item, signalIndexes.at(i), 0);
+            if (idx < index || idx >= index + count)
+                continue;
+            if (roles.isEmpty()) {
+                // Without a list of roles only the values that actually differ are notified.
+                item->notifyChangedValues();
+            } else {
+                for (int i = 0; i < propertyIds.count(); ++i) {
+                    item->invalidateValue(propertyIds.at(i));
+                    QMetaObject::activate(item, propertyIds.at(i) + signalOffset, 0);
+                }
             }
         }
         return changed;
@@ -246,6 +260,7 @@ public:
     QList<int> watchedRoleIds;
     QList<QByteArray> watchedRoles;
     QHash<QByteArray, int> roleNames;
+    QBitArray usedRoles;
     QQmlAdaptorModel *model;
     QMetaObject *metaObject;
     QQmlPropertyCache *propertyCache;
@@ -281,7 +296,7 @@ int QQmlDMCachedModelData::metaCall(QMetaObject::Call call, int id, void **argum
                     type->hasModelData ? 0 : propertyIndex);
             }
         } else  if (*type->model) {
-            *static_cast<QVariant *>(arguments[0]) = value(type->propertyRoles.at(propertyIndex));
+            *static_cast<QVariant *>(arguments[0]) = propertyValue(propertyIndex);
         }
         return -1;
     } else if (call == QMetaObject::WriteProperty && id >= type->propertyOffset) {
@@ -298,6 +313,7 @@ int QQmlDMCachedModelData::metaCall(QMetaObject::Call call, int id, void **argum
             }
         } else if (*type->model) {
             setValue(type->propertyRoles.at(propertyIndex), *static_cast<QVariant *>(arguments[0]));
+            invalidateValue(propertyIndex);
         }
         return -1;
     } else {
@@ -318,12 +334,89 @@ void QQmlDMCachedModelData::setValue(const QString &role, const QVariant &value)
     }
 }
 
+void QQmlDMCachedModelData::fetchValues(const QBitArray &properties)
+{
+    for (int i = 0; i < properties.count(); ++i) {
+        if (properties.testBit(i) && !fetchedRoles.testBit(i)) {
+            roleValues[i] = value(type->propertyRoles.at(i));
+            fetchedRoles.setBit(i);
+        }
+    }
+}
+
+/*
+    Returns the value of the role exposed as \a propertyId, fetching it from the
+    model only the first time it is read.  The first read after the item is bound
+    to a row also fetches every role that delegates of this model have read
+    before, so the model is queried once per item instead of once per binding.
+*/
+QVariant QQmlDMCachedModelData::propertyValue(int propertyId)
+{
+    if (fetchedRoles.isEmpty()) {
+        const int propertyCount = type->propertyRoles.count();
+        roleValues.resize(propertyCount);
+        fetchedRoles.resize(propertyCount);
+        if (type->usedRoles.count(true))
+            fetchValues(type->usedRoles);
+    }
+    if (!fetchedRoles.testBit(propertyId)) {
+        roleValues[propertyId] = value(type->propertyRoles.at(propertyId));
+        fetchedRoles.setBit(propertyId);
+        type->usedRoles.setBit(propertyId);
+    }
+    return roleValues.at(propertyId);
+}
+
+void QQmlDMCachedModelData::invalidateValue(int propertyId)
+{
+    if (fetchedRoles.isEmpty())
+        return;
+    if (type->hasModelData) {
+        // modelData is an alias of the only role.
+        fetchedRoles.fill(false);
+    } else {
+        fetchedRoles.clearBit(propertyId);
+    }
+}
+
+/*
+    Refreshes the cached values after the model reported a change without naming
+    the roles affected, and emits the change signals only for values that differ.
+    Roles that have never been read are notified only if something is connected
+    to their change signal.
+*/
+void QQmlDMCachedModelData::notifyChangedValues()
+{
+    const QBitArray fetched = fetchedRoles;
+    const QVector<QVariant> previousValues = roleValues;
+    if (!fetched.isEmpty()) {
+        fetchedRoles.fill(false);
+        fetchValues(fetched);
+    }
+
+    const QMetaObject *meta = metaObject();
+    QVarLengthArray<int, 16> signalIndexes;
+    for (int propertyId = 0; propertyId < type->propertyRoles.count(); ++propertyId) {
+        const int signalIndex = propertyId + type->signalOffset;
+        if (propertyId < fetched.count() && fetched.testBit(propertyId)) {
+            if (roleValues.at(propertyId) == previousValues.at(propertyId))
+                continue;
+        } else if (!isSignalConnected(meta->method(signalIndex))) {
+            continue;
+        }
+        signalIndexes.append(signalIndex);
+    }
+    for (int i = 0; i < signalIndexes.count(); ++i)
+        QMetaObject::activate(this, signalIndexes.at(i), 0);
+}
+
 bool QQmlDMCachedModelData::resolveIndex(const QQmlAdaptorModel &, int idx)
 {
     if (index == -1) {
         Q_ASSERT(idx >= 0);
         index = idx;
         cachedData.clear();
+        invalidateValues();
         emit modelIndexChanged();
         const QMetaObject *meta = metaObject();
         const int propertyCount = type->propertyRoles.count();
@@ -335,6 +428,15 @@ bool QQmlDMCachedModelData::resolveIndex(const QQmlAdaptorModel &, int idx)
     }
 }
 
+void QQmlDMCachedModelData::rebindIndex(const QQmlAdaptorModel &, int idx)
+{
+    index = idx;
+    invalidateValues();
+    emit modelIndexChanged();
+    for (int propertyId = 0; propertyId < type->propertyRoles.count(); ++propertyId)
+        QMetaObject::activate(this, propertyId + type->signalOffset, 0);
+}
+
 QV4::ReturnedValue QQmlDMCachedModelData::get_property(QV4::CallContext *ctx, uint propertyId)
 {
     QV4::Scope scope(ctx);
@@ -349,8 +451,7 @@ QV4::ReturnedValue QQmlDMCachedModelData::get_property(QV4::CallContext *ctx, ui
                     modelData->cachedData.at(modelData->type->hasModelData ? 0 : propertyId));
         }
     } else if (*modelData->type->model) {
-        return scope.engine->fromVariant(
-                modelData->value(modelData->type->propertyRoles.at(propertyId)));
+        return scope.engine->fromVariant(modelData->propertyValue(propertyId));
     }
     return QV4::Encode::undefined();
 }
@@ -418,6 +519,17 @@ public:
                 type->model->aim()->index(index, 0, type->model->rootIndex), value, role);
     }
 
+    void fetchValues(const QBitArray &properties)
+    {
+        const QModelIndex modelIndex = type->model->aim()->index(index, 0, type->model->rootIndex);
+        for (int i = 0; i < properties.count(); ++i) {
+            if (properties.testBit(i) && !fetchedRoles.testBit(i)) {
+                roleValues[i] = modelIndex.data(type->propertyRoles.at(i));
+                fetchedRoles.setBit(i);
+            }
+        }
+    }
+
     QV4::ReturnedValue get()
     {
         if (type->prototype.isUndefined()) {
@@ -542,6 +654,7 @@ public:
             roleNames.insert(propertyName, role);
             addProperty(&builder, 1, propertyName, propertyType);
         }
+        usedRoles.resize(propertyRoles.count());
 
         metaObject = builder.toMetaObject();
         *static_cast<QMetaObject *>(this) = *metaObject;
@@ -630,6 +743,14 @@ public:
         }
     }
 
+    void rebindIndex(const QQmlAdaptorModel &model, int idx)
+    {
+        index = idx;
+        cachedData = model.list.at(idx);
+        emit modelIndexChanged();
+        emit modelDataChanged();
+    }
+
 
 Q_SIGNALS:
     void modelDataChanged();
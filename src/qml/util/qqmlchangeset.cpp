@@ -103,6 +103,17 @@ QQmlChangeSet &QQmlChangeSet::operator =(const QQmlChangeSet &changeSet)
 
 void QQmlChangeSet::insert(int index, int count)
 {
+    // Extending the last insert is by far the most common case, e.g. when a list is
+    // populated one item at a time, and needs none of the bookkeeping below.
+    if (count > 0 && m_changes.isEmpty() && !m_inserts.isEmpty()) {
+        Change &last = m_inserts.last();
+        if (!last.isMove() && index == last.end()) {
+            last.count += count;
+            m_difference += count;
+            return;
+        }
+    }
+
     insert(QVector<Change>() << Change(index, count));
 }
 
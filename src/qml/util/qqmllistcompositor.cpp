@@ -35,6 +35,8 @@
 
 #include <QtCore/qvarlengtharray.h>
 
+#include <algorithm>
+
 //#define QT_QML_VERIFY_MINIMAL
 //#define QT_QML_VERIFY_INTEGRITY
 
@@ -90,8 +92,13 @@ QT_BEGIN_NAMESPACE
     for a specific index, each time a lookup is done the range and its indexes are cached and the
     next lookup is done relative to this.   This works out to near constant time in most relevant
     use cases because successive index lookups are most frequently adjacent.  The total number of
-    ranges is often quite small, which helps as well. If there is a need for faster random access
-    then a skip list like index may be an appropriate addition.
+    ranges is often quite small, which helps as well.
+
+    For heavily fragmented compositors random access is served by an index holding every range
+    with the group indexes of its first item, which find() binary searches in logarithmic time.
+    The index is discarded by any change to the ranges and only rebuilt once several lookups
+    have been made without an intervening change, so that workloads which alternate between
+    modifying the compositor and looking up adjacent items don't pay for rebuilding it.
 
     \sa VisualDataModel
 */
@@ -285,6 +292,9 @@ QQmlListCompositor::QQmlListCompositor()
     , m_defaultFlags(PrependFlag | DefaultFlag)
     , m_removeFlags(AppendFlag | PrependFlag | GroupMask)
     , m_moveId(0)
+    , m_rangeCount(0)
+    , m_indexLookups(0)
+    , m_indexValid(false)
 {
 }
 
@@ -308,6 +318,8 @@ QQmlListCompositor::~QQmlListCompositor()
 inline QQmlListCompositor::Range *QQmlListCompositor::insert(
         Range *before, void *list, int index, int count, uint flags)
 {
+    invalidateIndex();
+    ++m_rangeCount;
     return new Range(before, list, index, count, flags);
 }
 
@@ -320,6 +332,8 @@ inline QQmlListCompositor::Range *QQmlListCompositor::insert(
 inline QQmlListCompositor::Range *QQmlListCompositor::erase(
         Range *range)
 {
+    invalidateIndex();
+    --m_rangeCount;
     Range *next = range->next;
     next->previous = range->previous;
     next->previous->next = range->next;
@@ -333,6 +347,7 @@ inline QQmlListCompositor::Range *QQmlListCompositor::erase(
 
 void QQmlListCompositor::setGroupCount(int count)
 {
+    invalidateIndex();
     m_groupCount = count;
     m_end = iterator(&m_ranges, 0, Default, m_groupCount);
     m_cacheIt = m_end;
@@ -347,6 +362,72 @@ int QQmlListCompositor::count(Group group) const
     return m_end.index[group];
 }
 
+/*
+    Returns true if lookups should use the range index, building it if a number of lookups have
+    been made since the ranges were last changed.
+
+    Rebuilding the index visits every range, so it only pays off once enough lookups are made
+    without an intervening change; the number required grows with the number of ranges.  Until
+    then, and when lookups are interleaved with changes such as delegates being created and
+    released, lookups walk the list from the cached iterator.
+*/
+
+bool QQmlListCompositor::useIndex()
+{
+    // Below this number of ranges walking the list from the cached iterator is as fast.
+    enum { MinimumIndexedRanges = 32, RangesPerLookup = 16 };
+
+    if (m_indexValid)
+        return true;
+    if (m_rangeCount < MinimumIndexedRanges || ++m_indexLookups < m_rangeCount / RangesPerLookup)
+        return false;
+
+    m_indexRanges.resize(m_rangeCount);
+    m_indexCounts.resize(m_rangeCount * m_groupCount);
+
+    int *counts = m_indexCounts.data();
+    iterator it(m_ranges.next, 0, Default, m_groupCount);
+    for (int i = 0; *it != &m_ranges; *it = it->next, ++i, counts += m_groupCount) {
+        m_indexRanges[i] = *it;
+        for (int j = 0; j < m_groupCount; ++j)
+            counts[j] = it.index[j];
+        it.incrementIndexes(it->count);
+    }
+    m_indexValid = true;
+    return true;
+}
+
+/*
+    Returns an iterator representing the item at \a index in a \a group by binary searching the
+    range index for the last range which starts at or before \a index.  Ranges which aren't
+    members of the group have the same start index as the next range in the group so the last
+    range is always a member.
+*/
+
+QQmlListCompositor::iterator QQmlListCompositor::findIndexed(Group group, int index)
+{
+    const int *counts = m_indexCounts.constData();
+    int low = 0;
+    int high = m_indexRanges.count();
+    while (low < high) {
+        const int middle = (low + high) / 2;
+        if (counts[middle * m_groupCount + group] <= index)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    Q_ASSERT(low > 0);
+
+    const int position = low - 1;
+    Range *range = m_indexRanges.at(position);
+    const int offset = index - counts[position * m_groupCount + group];
+
+    iterator it(range, offset, group, m_groupCount);
+    for (int i = 0; i < m_groupCount; ++i)
+        it.index[i] = counts[position * m_groupCount + i] + (range->inGroup(i) ? offset : 0);
+    return it;
+}
+
 /*!
     Returns an iterator representing the item at \a index in a \a group.
 
@@ -357,7 +438,9 @@ QQmlListCompositor::iterator QQmlListCompositor::find(Group group, int index)
 {
     QT_QML_TRACE_LISTCOMPOSITOR(<< group << index)
     Q_ASSERT(index >=0 && index < count(group));
-    if (m_cacheIt == m_end) {
+    if (useIndex()) {
+        m_cacheIt = findIndexed(group, index);
+    } else if (m_cacheIt == m_end) {
         m_cacheIt = iterator(m_ranges.next, 0, group, m_groupCount);
         m_cacheIt += index;
     } else {
@@ -399,7 +482,12 @@ QQmlListCompositor::insert_iterator QQmlListCompositor::findInsertPosition(Group
     QT_QML_TRACE_LISTCOMPOSITOR(<< group << index)
     Q_ASSERT(index >=0 && index <= count(group));
     insert_iterator it;
-    if (m_cacheIt == m_end) {
+    if (index > 0 && useIndex()) {
+        // Step forward from the preceding item so the insert position is resolved the same way
+        // as when iterating from the start.
+        it = findIndexed(group, index - 1);
+        it += 1;
+    } else if (m_cacheIt == m_end) {
         it = iterator(m_ranges.next, 0, group, m_groupCount);
         it += index;
     } else {
@@ -454,6 +542,7 @@ QQmlListCompositor::iterator QQmlListCompositor::insert(
         iterator before, void *list, int index, int count, uint flags, QVector<Insert> *inserts)
 {
     QT_QML_TRACE_LISTCOMPOSITOR(<< before << list << index << count << flags)
+    invalidateIndex();
     if (inserts) {
         inserts->append(Insert(before, count, flags & GroupMask));
     }
@@ -525,6 +614,13 @@ void QQmlListCompositor::setFlags(
     if (!flags || !count)
         return;
 
+    if (from == group && (from->flags & flags) == flags && count <= from->count - from.offset) {
+        // The items already have the flags, so nothing changes.
+        m_cacheIt = from;
+        return;
+    }
+
+    invalidateIndex();
     if (from != group) {
         // Skip to the next full range if the start one is not a member of the target group.
         from.incrementIndexes(from->count - from.offset);
@@ -637,6 +733,16 @@ void QQmlListCompositor::clearFlags(
 
     const bool clearCache = flags & CacheFlag;
 
+    if (from == group && !(from->flags & (flags | UnresolvedFlag))
+            && (from->flags & ~AppendFlag) != CacheFlag && count <= from->count - from.offset) {
+        // The items don't have the flags, so nothing changes.  Unresolved and cache only items
+        // are left to the loop below, which also resolves or merges them.
+        m_cacheIt = from;
+        return;
+    }
+
+    invalidateIndex();
+
     if (from != group) {
         // Skip to the next full range if the start one is not a member of the target group.
         from.incrementIndexes(from->count - from.offset);
@@ -774,6 +880,7 @@ void QQmlListCompositor::move(
 
     // Find the position of the first item to move.
     iterator fromIt = find(fromGroup, from);
+    invalidateIndex();
 
     if (fromIt != moveGroup) {
         // If the range at the from index doesn't contain items from the move group; skip
@@ -928,6 +1035,216 @@ void QQmlListCompositor::move(
     QT_QML_VERIFY_LISTCOMPOSITOR
 }
 
+namespace {
+
+struct ReorderItem
+{
+    void *list;
+    int index;
+    uint flags;
+    bool appendEnd;     // The item ends a range with the AppendFlag set.
+    int groupIndex;     // The index of the item in the reordered group, or -1.
+    int moveId;         // The move the item is part of, or -1 if it stays in place.
+};
+
+// Lays out the items of a compositor in their new order, generating the insert notifications
+// of the moved items.
+struct ReorderLayout
+{
+    ReorderLayout(
+            const QVector<ReorderItem> &items,
+            const QVector<int> &positions,
+            const QVector<int> &moveCounts,
+            int firstMoveId,
+            const QQmlListCompositor::iterator &begin,
+            QVector<QQmlListCompositor::Insert> *inserts)
+        : items(items), positions(positions), moveCounts(moveCounts), firstMoveId(firstMoveId)
+        , insertIt(begin), inserts(inserts), nextTarget(0)
+    {
+        reordered.reserve(items.count());
+    }
+
+    void append(const ReorderItem &item)
+    {
+        insertIt.incrementIndexes(1, item.flags);
+        reordered.append(item);
+    }
+
+    // Places the moved items with a target index less than end.
+    void appendMoved(int end)
+    {
+        for (; nextTarget < end; ++nextTarget) {
+            ReorderItem item = items.at(positions.at(nextTarget));
+            item.flags &= ~QQmlListCompositor::PrependFlag;
+            item.appendEnd = false;
+            if (inserts && (nextTarget == 0
+                    || items.at(positions.at(nextTarget - 1)).moveId != item.moveId)) {
+                inserts->append(QQmlListCompositor::Insert(
+                        insertIt, moveCounts.at(item.moveId - firstMoveId), item.flags, item.moveId));
+            }
+            append(item);
+        }
+    }
+
+    const QVector<ReorderItem> &items;
+    const QVector<int> &positions;
+    const QVector<int> &moveCounts;
+    const int firstMoveId;
+    QQmlListCompositor::iterator insertIt;
+    QVector<QQmlListCompositor::Insert> *inserts;
+    QVector<ReorderItem> reordered;
+    int nextTarget;
+};
+
+}
+
+/*!
+    Reorders the items of a \a group so that the item which is at index \c{order.at(i)} in the
+    group is at index \c i afterwards.
+
+    The items forming a longest increasing subsequence of \a order keep their place and only
+    the others are moved, each in front of the next item of the group which isn't moved.  Items
+    which are not members of \a group keep their position relative to the items which aren't
+    moved.  The result is the same as moving the items one range at a time with move(), but the
+    ranges are rebuilt once instead of being searched for every move.
+
+    If \a removals and \a inserts are not null they will be populated with per group
+    notifications of the items moved, in the same form as those of move().
+*/
+
+void QQmlListCompositor::reorder(
+        Group group, const QVector<int> &order, QVector<Remove> *removals, QVector<Insert> *inserts)
+{
+    QT_QML_TRACE_LISTCOMPOSITOR(<< group << order.count())
+    const int count = order.count();
+    Q_ASSERT(count == this->count(group));
+    if (count < 2)
+        return;
+
+    // Find a longest increasing subsequence of the current indexes.  tails[k] is the target
+    // index of the smallest end of an increasing subsequence of length k + 1.
+    QVector<int> tails;
+    QVector<int> predecessors(count);
+    for (int i = 0; i < count; ++i) {
+        const int value = order.at(i);
+        int low = 0;
+        int high = tails.count();
+        while (low < high) {
+            const int middle = (low + high) / 2;
+            if (order.at(tails.at(middle)) < value)
+                low = middle + 1;
+            else
+                high = middle;
+        }
+        predecessors[i] = low > 0 ? tails.at(low - 1) : -1;
+        if (low == tails.count())
+            tails.append(i);
+        else
+            tails[low] = i;
+    }
+    if (tails.count() == count)
+        return;
+
+    QVector<int> targets(count);
+    for (int i = 0; i < count; ++i)
+        targets[order.at(i)] = i;
+    QVector<bool> moved(count, true);
+    for (int i = tails.last(); i != -1; i = predecessors.at(i))
+        moved[order.at(i)] = false;
+    const int lastFixedTarget = tails.last();
+
+    // Expand the ranges into single items, numbering the moves and generating the removals.
+    // Moved items which are adjacent both before and after the move are moved together.
+    QVector<ReorderItem> items;
+    QVector<int> positions(count);
+    QVector<int> moveCounts;
+    iterator removeIt(m_ranges.next, 0, group, m_groupCount);
+    const int firstMoveId = m_moveId + 1;
+    int groupIndex = 0;
+    int moveId = -1;
+    int previousTarget = -1;
+    uint previousFlags = 0;
+    for (Range *range = m_ranges.next; range != &m_ranges; range = range->next) {
+        const uint flags = range->flags & ~(PrependFlag | AppendFlag);
+        for (int i = 0; i < range->count; ++i) {
+            ReorderItem item = {
+                range->list, range->index + i, range->flags & ~AppendFlag,
+                range->append() && i == range->count - 1, -1, -1 };
+            if (range->inGroup(group) && moved.at(groupIndex)) {
+                const int target = targets.at(groupIndex);
+                if (moveId == -1 || target != previousTarget + 1 || flags != previousFlags) {
+                    moveId = ++m_moveId;
+                    moveCounts.append(0);
+                    if (removals)
+                        removals->append(Remove(removeIt, 0, range->flags, moveId));
+                }
+                ++moveCounts.last();
+                if (removals)
+                    ++removals->last().count;
+                item.groupIndex = groupIndex++;
+                item.moveId = moveId;
+                previousTarget = target;
+                previousFlags = flags;
+                positions[target] = items.count();
+            } else {
+                if (range->inGroup(group))
+                    item.groupIndex = groupIndex++;
+                moveId = -1;
+                removeIt.incrementIndexes(1, range->flags);
+            }
+            items.append(item);
+        }
+    }
+
+    // Lay out the items in their new order.  As with move() a placeholder for items inserted
+    // into the source list is left where a moved item was prepended to.
+    ReorderLayout layout(
+            items, positions, moveCounts, firstMoveId,
+            iterator(m_ranges.next, 0, group, m_groupCount), inserts);
+    for (int i = 0; i < items.count(); ++i) {
+        const ReorderItem &item = items.at(i);
+        if (item.moveId != -1) {
+            if (item.flags & PrependFlag) {
+                const ReorderItem placeholder = { item.list, item.index, PrependFlag, false, -1, -1 };
+                layout.append(placeholder);
+            }
+            if (item.appendEnd && !layout.reordered.isEmpty())
+                layout.reordered.last().appendEnd = true;
+        } else if (item.groupIndex != -1) {
+            const int target = targets.at(item.groupIndex);
+            layout.appendMoved(target);
+            layout.append(item);
+            layout.nextTarget = target + 1;
+            // The items moved past the last item which stays follow it directly.
+            if (target == lastFixedTarget)
+                layout.appendMoved(count);
+        } else {
+            layout.append(item);
+        }
+    }
+    Q_ASSERT(layout.nextTarget == count);
+
+    // Replace the ranges, joining adjacent items where possible.
+    clear();
+    Range *last = 0;
+    foreach (const ReorderItem &item, layout.reordered) {
+        if (last && !last->append()
+                && last->list == item.list
+                && last->flags == item.flags
+                && (!item.list || last->end() == item.index)) {
+            ++last->count;
+        } else {
+            last = insert(&m_ranges, item.list, item.index, 1, item.flags);
+        }
+        if (item.appendEnd)
+            last->flags |= AppendFlag;
+        m_end.incrementIndexes(1, item.flags);
+    }
+    m_cacheIt = m_end;
+
+    QT_QML_VERIFY_LISTCOMPOSITOR
+}
+
 /*!
     Clears the contents of a compositor.
 */
@@ -947,6 +1264,7 @@ void QQmlListCompositor::listItemsInserted(
         const QVector<MovedFlags> *movedFlags)
 {
     QT_QML_TRACE_LISTCOMPOSITOR(<< list << insertions)
+    invalidateIndex();
     for (iterator it(m_ranges.next, 0, Default, m_groupCount); *it != &m_ranges; *it = it->next) {
         if (it->list != list || it->flags == CacheFlag) {
             // Skip ranges that don't reference list.
@@ -1070,6 +1388,7 @@ void QQmlListCompositor::listItemsRemoved(
         QVector<MovedFlags> *movedFlags)
 {
     QT_QML_TRACE_LISTCOMPOSITOR(<< list << *removals)
+    invalidateIndex();
 
     for (iterator it(m_ranges.next, 0, Default, m_groupCount); *it != &m_ranges; *it = it->next) {
         if (it->list != list || it->flags == CacheFlag) {
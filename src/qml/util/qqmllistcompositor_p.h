@@ -245,6 +245,11 @@ public:
             Group group,
             QVector<Remove> *removals = 0,
             QVector<Insert> *inserts = 0);
+    void reorder(
+            Group group,
+            const QVector<int> &order,
+            QVector<Remove> *removals = 0,
+            QVector<Insert> *inserts = 0);
     void clear();
 
     void listItemsInserted(void *list, int index, int count, QVector<Insert> *inserts);
@@ -262,14 +267,23 @@ private:
     Range m_ranges;
     iterator m_end;
     iterator m_cacheIt;
+    QVector<Range *> m_indexRanges;
+    QVector<int> m_indexCounts;
     int m_groupCount;
     int m_defaultFlags;
     int m_removeFlags;
     int m_moveId;
+    int m_rangeCount;
+    int m_indexLookups;
+    bool m_indexValid;
 
     inline Range *insert(Range *before, void *list, int index, int count, uint flags);
     inline Range *erase(Range *range);
 
+    inline void invalidateIndex() { m_indexValid = false; m_indexLookups = 0; }
+    bool useIndex();
+    iterator findIndexed(Group group, int index);
+
     struct MovedFlags
     {
         MovedFlags() {}
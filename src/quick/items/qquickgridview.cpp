@@ -177,6 +177,7 @@ public:
     bool removeNonVisibleItems(qreal bufferFrom, qreal bufferTo) Q_DECL_OVERRIDE;
 
     FxViewItem *newViewItem(int index, QQuickItem *item) Q_DECL_OVERRIDE;
+    QQuickItemViewAttached *getAttachedObject(const QObject *object) const Q_DECL_OVERRIDE;
     void initializeViewItem(FxViewItem *item) Q_DECL_OVERRIDE;
     void repositionItemAt(FxViewItem *item, int index, qreal sizeBuffer) Q_DECL_OVERRIDE;
     void repositionPackageItemAt(QQuickItem *item, int index) Q_DECL_OVERRIDE;
@@ -446,6 +447,11 @@ void QQuickGridViewPrivate::resetColumns()
     columns = qMax(1, qFloor(length / colSize()));
 }
 
+QQuickItemViewAttached *QQuickGridViewPrivate::getAttachedObject(const QObject *object) const
+{
+    return static_cast<QQuickItemViewAttached *>(qmlAttachedPropertiesObject<QQuickGridView>(object, false));
+}
+
 FxViewItem *QQuickGridViewPrivate::newViewItem(int modelIndex, QQuickItem *item)
 {
     Q_Q(QQuickGridView);
@@ -504,7 +510,7 @@ bool QQuickGridViewPrivate::addVisibleItems(qreal fillFrom, qreal fillTo, qreal
 
     while (modelIndex < model->count() && rowPos <= fillTo + rowSize()*(columns - colNum)/(columns+1)) {
         qCDebug(lcItemViewDelegateLifecycle) << "refill: append item" << modelIndex << colPos << rowPos;
-        if (!(item = static_cast<FxGridItemSG*>(createItem(modelIndex, doBuffer))))
+        if (!(item = static_cast<FxGridItemSG*>(createItem(modelIndex, doBuffer || incubateVisibleItems()))))
             break;
         if (!transitioner || !transitioner->canTransition(QQuickItemViewTransitioner::PopulateTransition, true)) // pos will be set by layoutVisibleItems()
             item->setPosition(colPos, rowPos, true);
@@ -539,7 +545,7 @@ bool QQuickGridViewPrivate::addVisibleItems(qreal fillFrom, qreal fillTo, qreal
     colPos = colNum * colSize();
     while (visibleIndex > 0 && rowPos + rowSize() - 1 >= fillFrom - rowSize()*(colNum+1)/(columns+1)){
         qCDebug(lcItemViewDelegateLifecycle) << "refill: prepend item" << visibleIndex-1 << "top pos" << rowPos << colPos;
-        if (!(item = static_cast<FxGridItemSG*>(createItem(visibleIndex-1, doBuffer))))
+        if (!(item = static_cast<FxGridItemSG*>(createItem(visibleIndex-1, doBuffer || incubateVisibleItems()))))
             break;
         --visibleIndex;
         if (!transitioner || !transitioner->canTransition(QQuickItemViewTransitioner::PopulateTransition, true)) // pos will be set by layoutVisibleItems()
@@ -1498,6 +1504,40 @@ void QQuickGridView::setHighlightFollowsCurrentItem(bool autoHighlight)
 
     By default, key navigation is not wrapped.
 */
+/*!
+    \qmlproperty bool QtQuick::GridView::reuseItems
+    \since QtQuick 2.7
+
+    This property holds whether delegate items that leave the view (including
+    its cacheBuffer) are kept by the model and reused for other indexes,
+    instead of being destroyed and created again. The default value is \c false.
+
+    A reused delegate keeps its state; only its model data and \c index are
+    updated. Use the \l{GridView::pooled}{GridView.pooled} and
+    \l{GridView::reused}{GridView.reused} attached signals to reset any state
+    that depends on the item it previously showed.
+
+    Delegates are never reused across a change of \l model or \l delegate.
+*/
+
+/*!
+    \qmlattachedsignal QtQuick::GridView::pooled()
+    \since QtQuick 2.7
+    This attached signal is emitted when the item is released into the reuse
+    pool, if \l reuseItems is \c true.
+
+    The corresponding handler is \c onPooled.
+*/
+
+/*!
+    \qmlattachedsignal QtQuick::GridView::reused()
+    \since QtQuick 2.7
+    This attached signal is emitted when the item is taken from the reuse pool
+    to show a different index, if \l reuseItems is \c true.
+
+    The corresponding handler is \c onReused.
+*/
+
 /*!
     \qmlproperty int QtQuick::GridView::cacheBuffer
     This property determines whether delegates are retained outside the
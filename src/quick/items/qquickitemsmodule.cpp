@@ -263,6 +263,11 @@ static void qt_quickitems_defineModule(const char *uri, int major, int minor)
     qmlRegisterType<QQuickText, 6>(uri, 2, 6, "Text");
     qmlRegisterType<QQuickTextEdit, 6>(uri, 2, 6, "TextEdit");
     qmlRegisterType<QQuickTextInput, 6>(uri, 2, 6, "TextInput");
+
+    qmlRegisterUncreatableType<QQuickItemView, 3>(uri, 2, 7, "ItemView", QQuickItemView::tr("ItemView is an abstract base class"));
+    qmlRegisterType<QQuickListView, 2>(uri, 2, 7, "ListView");
+    qmlRegisterType<QQuickGridView, 1>(uri, 2, 7, "GridView");
+    qmlRegisterType<QQuickPathView, 1>(uri, 2, 7, "PathView");
 }
 
 static void initResources()
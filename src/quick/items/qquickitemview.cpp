@@ -33,7 +33,9 @@
 
 #include "qquickitemview_p_p.h"
 #include <QtQuick/private/qquicktransition_p.h>
+#include <QtQuick/private/qquickwindow_p.h>
 #include <QtQml/QQmlInfo>
+#include <QtCore/qelapsedtimer.h>
 #include "qplatformdefs.h"
 
 QT_BEGIN_NAMESPACE
@@ -288,6 +290,8 @@ void QQuickItemView::setModel(const QVariant &m)
         disconnect(d->model, SIGNAL(initItem(int,QObject*)), this, SLOT(initItem(int,QObject*)));
         disconnect(d->model, SIGNAL(createdItem(int,QObject*)), this, SLOT(createdItem(int,QObject*)));
         disconnect(d->model, SIGNAL(destroyingItem(QObject*)), this, SLOT(destroyingItem(QObject*)));
+        disconnect(d->model, SIGNAL(itemPooled(int,QObject*)), this, SLOT(itemPooled(int,QObject*)));
+        disconnect(d->model, SIGNAL(itemReused(int,QObject*)), this, SLOT(itemReused(int,QObject*)));
     }
 
     QQmlInstanceModel *oldModel = d->model;
@@ -323,6 +327,8 @@ void QQuickItemView::setModel(const QVariant &m)
         connect(d->model, SIGNAL(createdItem(int,QObject*)), this, SLOT(createdItem(int,QObject*)));
         connect(d->model, SIGNAL(initItem(int,QObject*)), this, SLOT(initItem(int,QObject*)));
         connect(d->model, SIGNAL(destroyingItem(QObject*)), this, SLOT(destroyingItem(QObject*)));
+        connect(d->model, SIGNAL(itemPooled(int,QObject*)), this, SLOT(itemPooled(int,QObject*)));
+        connect(d->model, SIGNAL(itemReused(int,QObject*)), this, SLOT(itemReused(int,QObject*)));
         if (isComponentComplete()) {
             d->updateSectionCriteria();
             d->refill();
@@ -503,6 +509,21 @@ void QQuickItemView::setDisplayMarginEnd(int margin)
     }
 }
 
+bool QQuickItemView::reuseItems() const
+{
+    Q_D(const QQuickItemView);
+    return d->reuseItems;
+}
+
+void QQuickItemView::setReuseItems(bool reuse)
+{
+    Q_D(QQuickItemView);
+    if (d->reuseItems != reuse) {
+        d->reuseItems = reuse;
+        emit reuseItemsChanged();
+    }
+}
+
 Qt::LayoutDirection QQuickItemView::layoutDirection() const
 {
     Q_D(const QQuickItemView);
@@ -1507,7 +1528,7 @@ QQuickItemViewPrivate::QQuickItemViewPrivate()
     , inLayout(false), inViewportMoved(false), forceLayout(false), currentIndexCleared(false)
     , haveHighlightRange(false), autoHighlight(true), highlightRangeStartValid(false), highlightRangeEndValid(false)
     , fillCacheBuffer(false), inRequest(false)
-    , runDelayedRemoveTransition(false), delegateValidated(false)
+    , runDelayedRemoveTransition(false), delegateValidated(false), reuseItems(false)
 {
     bufferPause.addAnimationChangeListener(this, QAbstractAnimationJob::Completion);
     bufferPause.setLoopCount(1);
@@ -1685,18 +1706,19 @@ void QQuickItemViewPrivate::clear()
     currentChanges.reset();
     timeline.clear();
 
+    // The model or the delegate is about to change, so nothing released here can be reused
     for (int i = 0; i < visibleItems.count(); ++i)
-        releaseItem(visibleItems.at(i));
+        releaseItem(visibleItems.at(i), QQmlInstanceModel::NotReusable);
     visibleItems.clear();
     visibleIndex = 0;
 
     for (int i = 0; i < releasePendingTransition.count(); ++i) {
         releasePendingTransition.at(i)->releaseAfterTransition = false;
-        releaseItem(releasePendingTransition.at(i));
+        releaseItem(releasePendingTransition.at(i), QQmlInstanceModel::NotReusable);
     }
     releasePendingTransition.clear();
 
-    releaseItem(currentItem);
+    releaseItem(currentItem, QQmlInstanceModel::NotReusable);
     currentItem = 0;
     createHighlight();
     trackedItem = 0;
@@ -1751,6 +1773,16 @@ void QQuickItemViewPrivate::refill(qreal from, qreal to)
     qreal fillFrom = from;
     qreal fillTo = to;
 
+    if (buffer) {
+        // Incubate further ahead in the direction of a flick so that its delegates are ready
+        // by the time they scroll into view.
+        const qreal lookAhead = flickLookAhead();
+        if (bufferMode == BufferAfter)
+            bufferTo += lookAhead;
+        else if (bufferMode == BufferBefore)
+            bufferFrom -= lookAhead;
+    }
+
     bool added = addVisibleItems(fillFrom, fillTo, bufferFrom, bufferTo, false);
     bool removed = removeNonVisibleItems(bufferFrom, bufferTo);
 
@@ -1951,6 +1983,7 @@ bool QQuickItemViewPrivate::applyModelChanges(ChangeResult *totalInsertionResult
     int removedCount = 0;
     for (int i=0; i<removals.count(); i++) {
         itemCount -= removals[i].count;
+        modelItemsRemoved(removals[i]);
         if (applyRemovalChange(removals[i], &removalResult, &removedCount))
             visibleAffected = true;
         if (!visibleAffected && needsRefillForAddedOrRemovedIndex(removals[i].index))
@@ -2248,6 +2281,40 @@ void QQuickItemViewPrivate::viewItemTransitionFinished(QQuickItemViewTransitiona
     }
 }
 
+/*
+  Returns true if delegates entering the visible area should be incubated
+  rather than created synchronously.  This happens while the view is moving
+  and the views in the window have used up their budget for synchronous
+  creation in the current frame, so that a fast flick leaves a gap for a frame
+  or two instead of dropping frames.  Delegates left pending are requested
+  synchronously again on the next refill, completing their incubation ahead
+  of any cache buffer items.
+*/
+bool QQuickItemViewPrivate::incubateVisibleItems() const
+{
+    Q_Q(const QQuickItemView);
+    if (!hData.moving && !vData.moving)
+        return false;
+    QQuickWindow *window = q->window();
+    return window && QQuickWindowPrivate::get(window)->delegateCreationBudgetSpent();
+}
+
+/*
+  Returns the distance the view is expected to travel while the delegates
+  about to enter it are incubated, which is added to the cache buffer in the
+  direction of a flick.
+*/
+qreal QQuickItemViewPrivate::flickLookAhead() const
+{
+    // The time to look ahead; a few frames of incubation.
+    static const qreal lookAheadTime = 0.1;
+
+    const AxisData &data = layoutOrientation() == Qt::Vertical ? vData : hData;
+    if (!data.flicking)
+        return 0;
+    return qMin(qAbs(data.smoothVelocity.value()) * lookAheadTime, size());
+}
+
 /*
   This may return 0 if the item is being created asynchronously.
   When the item becomes available, refill() will be called and the item
@@ -2272,7 +2339,12 @@ FxViewItem *QQuickItemViewPrivate::createItem(int modelIndex, bool asynchronous)
         requestedIndex = modelIndex;
     inRequest = true;
 
+    QElapsedTimer creationTimer;
+    if (!asynchronous)
+        creationTimer.start();
     QObject* object = model->object(modelIndex, asynchronous);
+    if (!asynchronous && q->window())
+        QQuickWindowPrivate::get(q->window())->delegateCreationTime += creationTimer.nsecsElapsed();
     QQuickItem *item = qmlobject_cast<QQuickItem*>(object);
     if (!item) {
         if (object) {
@@ -2342,7 +2414,21 @@ void QQuickItemView::destroyingItem(QObject *object)
     }
 }
 
-bool QQuickItemViewPrivate::releaseItem(FxViewItem *item)
+void QQuickItemView::itemPooled(int, QObject *object)
+{
+    Q_D(QQuickItemView);
+    if (QQuickItemViewAttached *attached = d->getAttachedObject(object))
+        attached->emitPooled();
+}
+
+void QQuickItemView::itemReused(int, QObject *object)
+{
+    Q_D(QQuickItemView);
+    if (QQuickItemViewAttached *attached = d->getAttachedObject(object))
+        attached->emitReused();
+}
+
+bool QQuickItemViewPrivate::releaseItem(FxViewItem *item, QQmlInstanceModel::ReusableFlag reusableFlag)
 {
     Q_Q(QQuickItemView);
     if (!item || !model)
@@ -2351,11 +2437,15 @@ bool QQuickItemViewPrivate::releaseItem(FxViewItem *item)
         trackedItem = 0;
     item->trackGeometry(false);
 
-    QQmlInstanceModel::ReleaseFlags flags = model->release(item->item);
+    QQmlInstanceModel::ReleaseFlags flags = model->release(
+            item->item, reuseItems ? reusableFlag : QQmlInstanceModel::NotReusable);
     if (flags == 0) {
         // item was not destroyed, and we no longer reference it.
         QQuickItemPrivate::get(item->item)->setCulled(true);
         unrequestedItems.insert(item->item, model->indexOf(item->item, q));
+    } else if (flags & QQmlInstanceModel::Pooled) {
+        // item was kept by the model to be reused for another index.
+        QQuickItemPrivate::get(item->item)->setCulled(true);
     } else if (flags & QQmlInstanceModel::Destroyed) {
         item->item->setParentItem(0);
     }
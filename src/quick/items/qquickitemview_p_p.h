@@ -184,7 +184,9 @@ public:
     void mirrorChange() Q_DECL_OVERRIDE;
 
     FxViewItem *createItem(int modelIndex, bool asynchronous = false);
-    virtual bool releaseItem(FxViewItem *item);
+    bool incubateVisibleItems() const;
+    qreal flickLookAhead() const;
+    virtual bool releaseItem(FxViewItem *item, QQmlInstanceModel::ReusableFlag reusableFlag = QQmlInstanceModel::Reusable);
 
     QQuickItem *createHighlightItem();
     QQuickItem *createComponentItem(QQmlComponent *component, qreal zValue, bool createDefault = false);
@@ -305,6 +307,7 @@ public:
     bool inRequest : 1;
     bool runDelayedRemoveTransition : 1;
     bool delegateValidated : 1;
+    bool reuseItems : 1;
 
 protected:
     virtual Qt::Orientation layoutOrientation() const = 0;
@@ -334,6 +337,7 @@ protected:
     virtual void visibleItemsChanged() {}
 
     virtual FxViewItem *newViewItem(int index, QQuickItem *item) = 0;
+    virtual QQuickItemViewAttached *getAttachedObject(const QObject *object) const = 0;
     virtual void repositionItemAt(FxViewItem *item, int index, qreal sizeBuffer) = 0;
     virtual void repositionPackageItemAt(QQuickItem *item, int index) = 0;
     virtual void resetFirstItemPosition(qreal pos = 0.0) = 0;
@@ -345,6 +349,7 @@ protected:
     virtual bool applyInsertionChange(const QQmlChangeSet::Change &insert, ChangeResult *changeResult,
                 QList<FxViewItem *> *newItems, QList<MovedItem> *movingIntoView) = 0;
 
+    virtual void modelItemsRemoved(const QQmlChangeSet::Change &) {}
     virtual bool needsRefillForAddedOrRemovedIndex(int) const { return false; }
     virtual void translateAndTransitionItemsAfter(int afterIndex, const ChangeResult &insertionResult, const ChangeResult &removalResult) = 0;
 
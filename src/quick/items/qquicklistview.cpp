@@ -41,6 +41,7 @@
 #include <QtGui/qevent.h>
 #include <QtCore/qcoreapplication.h>
 #include <QtCore/qmath.h>
+#include <QtCore/qhash.h>
 
 #include <private/qquicksmoothedanimation_p_p.h>
 #include "qplatformdefs.h"
@@ -53,6 +54,216 @@ QT_BEGIN_NAMESPACE
 
 class FxListItemSG;
 
+/*
+    Remembers the size of every delegate the view has laid out, so that the
+    position of an arbitrary row can be computed from the sizes seen so far
+    instead of assuming that every row is as large as the visible ones.
+
+    The known sizes are summed in a Fenwick (binary indexed) tree together with
+    the number of known rows, which makes both index-to-offset and
+    offset-to-index lookups O(log n).  Rows that have never been instantiated
+    are estimated with the average of the known sizes.  Inserting or removing
+    rows shifts the size array and marks the trees dirty; they are rebuilt in
+    a single pass on the next lookup.
+*/
+class QQuickListViewSizeCache
+{
+public:
+    QQuickListViewSizeCache() : m_knownSum(0), m_knownCount(0), m_dirty(false) {}
+
+    void clear()
+    {
+        m_sizes.clear();
+        m_sumTree.clear();
+        m_countTree.clear();
+        m_moved.clear();
+        m_knownSum = 0;
+        m_knownCount = 0;
+        m_dirty = false;
+    }
+
+    qreal estimate(qreal fallback) const
+    {
+        return m_knownCount ? qreal(qRound(m_knownSum / m_knownCount)) : fallback;
+    }
+
+    void setSize(int index, qreal size);
+    void insert(const QQmlChangeSet::Change &insert);
+    void remove(const QQmlChangeSet::Change &removal);
+
+    qreal offset(int index, qreal estimate, qreal spacing) const;
+    int indexAt(qreal offset, qreal estimate, qreal spacing) const;
+
+private:
+    void ensureTree() const { if (m_dirty) rebuild(); }
+    void rebuild() const;
+
+    QVector<qreal> m_sizes;     // -1 for rows whose size is not known
+    mutable QVector<qreal> m_sumTree;
+    mutable QVector<int> m_countTree;
+    QHash<int, QVector<qreal> > m_moved;
+    mutable qreal m_knownSum;
+    mutable int m_knownCount;
+    mutable bool m_dirty;
+};
+
+void QQuickListViewSizeCache::setSize(int index, qreal size)
+{
+    if (index < 0)
+        return;
+    size = qMax(qreal(0), size);
+
+    const int count = m_sizes.count();
+    if (index >= count) {
+        // grow geometrically, so that scrolling through a long model rebuilds
+        // the trees only a logarithmic number of times
+        m_sizes.insert(count, qMax(index + 1, 2 * count) - count, qreal(-1));
+        m_dirty = true;
+    }
+
+    qreal &oldSize = m_sizes[index];
+    if (oldSize == size)
+        return;
+
+    qreal sizeDelta = size;
+    int countDelta = 1;
+    if (oldSize >= 0) {
+        sizeDelta -= oldSize;
+        countDelta = 0;
+    }
+    oldSize = size;
+    m_knownSum += sizeDelta;
+    m_knownCount += countDelta;
+
+    if (!m_dirty) {
+        const int n = m_sizes.count();
+        for (int i = index + 1; i <= n; i += i & -i) {
+            m_sumTree[i] += sizeDelta;
+            m_countTree[i] += countDelta;
+        }
+    }
+}
+
+void QQuickListViewSizeCache::insert(const QQmlChangeSet::Change &insert)
+{
+    QVector<qreal> moved;
+    if (insert.isMove())
+        moved = m_moved.take(insert.moveId);
+    if (insert.index >= m_sizes.count())
+        return;
+
+    m_sizes.insert(insert.index, insert.count, qreal(-1));
+    for (int i = 0; i < insert.count && insert.offset + i < moved.count(); ++i) {
+        const qreal size = moved.at(insert.offset + i);
+        if (size >= 0) {
+            m_sizes[insert.index + i] = size;
+            m_knownSum += size;
+            ++m_knownCount;
+        }
+    }
+    // Other parts of a split move may still be pending.
+    if (insert.isMove() && insert.offset + insert.count < moved.count())
+        m_moved.insert(insert.moveId, moved);
+    m_dirty = true;
+}
+
+void QQuickListViewSizeCache::remove(const QQmlChangeSet::Change &removal)
+{
+    const int end = qMin(removal.index + removal.count, m_sizes.count());
+    if (removal.index >= end)
+        return;
+
+    QVector<qreal> *moved = 0;
+    if (removal.isMove()) {
+        moved = &m_moved[removal.moveId];
+        const int movedCount = removal.offset + removal.count;
+        if (moved->count() < movedCount)
+            moved->insert(moved->count(), movedCount - moved->count(), qreal(-1));
+    }
+
+    for (int i = removal.index; i < end; ++i) {
+        const qreal size = m_sizes.at(i);
+        if (size < 0)
+            continue;
+        m_knownSum -= size;
+        --m_knownCount;
+        if (moved)
+            (*moved)[removal.offset + i - removal.index] = size;
+    }
+    m_sizes.remove(removal.index, end - removal.index);
+    m_dirty = true;
+}
+
+void QQuickListViewSizeCache::rebuild() const
+{
+    const int n = m_sizes.count();
+    m_sumTree.fill(0, n + 1);
+    m_countTree.fill(0, n + 1);
+    m_knownSum = 0;
+    m_knownCount = 0;
+    for (int i = 1; i <= n; ++i) {
+        const qreal size = m_sizes.at(i - 1);
+        if (size >= 0) {
+            m_sumTree[i] += size;
+            m_countTree[i] += 1;
+            m_knownSum += size;
+            ++m_knownCount;
+        }
+        const int parent = i + (i & -i);
+        if (parent <= n) {
+            m_sumTree[parent] += m_sumTree.at(i);
+            m_countTree[parent] += m_countTree.at(i);
+        }
+    }
+    m_dirty = false;
+}
+
+// Returns the extent of the rows before \a index, each followed by \a spacing.
+qreal QQuickListViewSizeCache::offset(int index, qreal estimate, qreal spacing) const
+{
+    if (index <= 0)
+        return 0;
+    ensureTree();
+
+    qreal sum = 0;
+    int known = 0;
+    for (int i = qMin(index, m_sizes.count()); i > 0; i -= i & -i) {
+        sum += m_sumTree.at(i);
+        known += m_countTree.at(i);
+    }
+    return sum + (index - known) * estimate + index * spacing;
+}
+
+// Returns the row containing \a offset, which is relative to the start of the first row.
+int QQuickListViewSizeCache::indexAt(qreal offset, qreal estimate, qreal spacing) const
+{
+    if (offset <= 0)
+        return 0;
+    ensureTree();
+
+    const int n = m_sizes.count();
+    int step = 1;
+    while (step * 2 <= n)
+        step *= 2;
+
+    int index = 0;
+    qreal extent = 0;
+    for (; n && step > 0; step /= 2) {
+        const int next = index + step;
+        if (next > n)
+            continue;
+        const qreal nodeExtent = m_sumTree.at(next) + (step - m_countTree.at(next)) * estimate + step * spacing;
+        if (extent + nodeExtent <= offset) {
+            index = next;
+            extent += nodeExtent;
+        }
+    }
+
+    if (index == n && estimate + spacing > 0)
+        index += int((offset - extent) / (estimate + spacing));
+    return index;
+}
+
 class QQuickListViewPrivate : public QQuickItemViewPrivate
 {
     Q_DECLARE_PUBLIC(QQuickListView)
@@ -73,6 +284,7 @@ public:
     QString sectionAt(int modelIndex);
     qreal snapPosAt(qreal pos);
     FxViewItem *snapItemAt(qreal pos);
+    qreal rowsExtent(int from, int to) const;
 
     void init() Q_DECL_OVERRIDE;
     void clear() Q_DECL_OVERRIDE;
@@ -82,8 +294,9 @@ public:
     void visibleItemsChanged() Q_DECL_OVERRIDE;
 
     FxViewItem *newViewItem(int index, QQuickItem *item) Q_DECL_OVERRIDE;
+    QQuickItemViewAttached *getAttachedObject(const QObject *object) const Q_DECL_OVERRIDE;
     void initializeViewItem(FxViewItem *item) Q_DECL_OVERRIDE;
-    bool releaseItem(FxViewItem *item) Q_DECL_OVERRIDE;
+    bool releaseItem(FxViewItem *item, QQmlInstanceModel::ReusableFlag reusableFlag = QQmlInstanceModel::Reusable) Q_DECL_OVERRIDE;
     void repositionItemAt(FxViewItem *item, int index, qreal sizeBuffer) Q_DECL_OVERRIDE;
     void repositionPackageItemAt(QQuickItem *item, int index) Q_DECL_OVERRIDE;
     void resetFirstItemPosition(qreal pos = 0.0) Q_DECL_OVERRIDE;
@@ -98,6 +311,7 @@ public:
     void layoutVisibleItems(int fromModelIndex = 0) Q_DECL_OVERRIDE;
 
     bool applyInsertionChange(const QQmlChangeSet::Change &insert, ChangeResult *changeResult, QList<FxViewItem *> *addedItems, QList<MovedItem> *movingIntoView) Q_DECL_OVERRIDE;
+    void modelItemsRemoved(const QQmlChangeSet::Change &removal) Q_DECL_OVERRIDE;
     void translateAndTransitionItemsAfter(int afterIndex, const ChangeResult &insertionResult, const ChangeResult &removalResult) Q_DECL_OVERRIDE;
 
     void updateSectionCriteria() Q_DECL_OVERRIDE;
@@ -133,6 +347,7 @@ public:
     qreal visiblePos;
     qreal averageSize;
     qreal spacing;
+    QQuickListViewSizeCache sizeCache;
     QQuickListView::SnapMode snapMode;
 
     QQuickListView::HeaderPositioning headerPositioning;
@@ -418,7 +633,7 @@ qreal QQuickListViewPrivate::originPosition() const
     if (!visibleItems.isEmpty()) {
         pos = (*visibleItems.constBegin())->position();
         if (visibleIndex > 0)
-            pos -= visibleIndex * (averageSize + spacing);
+            pos -= rowsExtent(0, visibleIndex);
     }
     return pos;
 }
@@ -427,16 +642,16 @@ qreal QQuickListViewPrivate::lastPosition() const
 {
     qreal pos = 0;
     if (!visibleItems.isEmpty()) {
-        int invisibleCount = visibleItems.count() - visibleIndex;
+        qreal invisibleSize = (visibleItems.count() - visibleIndex) * (averageSize + spacing);
         for (int i = visibleItems.count()-1; i >= 0; --i) {
             if (visibleItems.at(i)->index != -1) {
-                invisibleCount = model->count() - visibleItems.at(i)->index - 1;
+                invisibleSize = rowsExtent(visibleItems.at(i)->index + 1, model->count());
                 break;
             }
         }
-        pos = (*(--visibleItems.constEnd()))->endPosition() + invisibleCount * (averageSize + spacing);
+        pos = (*(--visibleItems.constEnd()))->endPosition() + invisibleSize;
     } else if (model && model->count()) {
-        pos = (model->count() * averageSize + (model->count()-1) * spacing);
+        pos = rowsExtent(0, model->count()) - spacing;
     }
     return pos;
 }
@@ -448,16 +663,16 @@ qreal QQuickListViewPrivate::positionAt(int modelIndex) const
     }
     if (!visibleItems.isEmpty()) {
         if (modelIndex < visibleIndex) {
-            int count = visibleIndex - modelIndex;
+            int from = modelIndex;
             qreal cs = 0;
             if (modelIndex == currentIndex && currentItem) {
                 cs = currentItem->size() + spacing;
-                --count;
+                ++from;
             }
-            return (*visibleItems.constBegin())->position() - count * (averageSize + spacing) - cs;
+            return (*visibleItems.constBegin())->position() - rowsExtent(from, visibleIndex) - cs;
         } else {
-            int count = modelIndex - findLastVisibleIndex(visibleIndex) - 1;
-            return (*(--visibleItems.constEnd()))->endPosition() + spacing + count * (averageSize + spacing);
+            int from = findLastVisibleIndex(visibleIndex) + 1;
+            return (*(--visibleItems.constEnd()))->endPosition() + spacing + rowsExtent(from, modelIndex);
         }
     }
     return 0;
@@ -469,11 +684,10 @@ qreal QQuickListViewPrivate::endPositionAt(int modelIndex) const
         return item->endPosition();
     if (!visibleItems.isEmpty()) {
         if (modelIndex < visibleIndex) {
-            int count = visibleIndex - modelIndex;
-            return (*visibleItems.constBegin())->position() - (count - 1) * (averageSize + spacing) - spacing;
+            return (*visibleItems.constBegin())->position() - rowsExtent(modelIndex + 1, visibleIndex) - spacing;
         } else {
-            int count = modelIndex - findLastVisibleIndex(visibleIndex) - 1;
-            return (*(--visibleItems.constEnd()))->endPosition() + count * (averageSize + spacing);
+            int from = findLastVisibleIndex(visibleIndex) + 1;
+            return (*(--visibleItems.constEnd()))->endPosition() + rowsExtent(from, modelIndex);
         }
     }
     return 0;
@@ -508,6 +722,16 @@ qreal QQuickListViewPrivate::snapPosAt(qreal pos)
     return qRound((pos - originPosition()) / averageSize) * averageSize + originPosition();
 }
 
+// Returns the extent of the rows in [from, to), including the spacing after each row.
+// Rows that have been laid out before contribute their real size, others the average.
+qreal QQuickListViewPrivate::rowsExtent(int from, int to) const
+{
+    if (to <= from)
+        return 0;
+    const qreal estimate = sizeCache.estimate(averageSize);
+    return sizeCache.offset(to, estimate, spacing) - sizeCache.offset(from, estimate, spacing);
+}
+
 FxViewItem *QQuickListViewPrivate::snapItemAt(qreal pos)
 {
     FxViewItem *snapItem = 0;
@@ -550,9 +774,15 @@ void QQuickListViewPrivate::clear()
     releaseSectionItem(nextSectionItem);
     nextSectionItem = 0;
     lastVisibleSection = QString();
+    sizeCache.clear();
     QQuickItemViewPrivate::clear();
 }
 
+QQuickItemViewAttached *QQuickListViewPrivate::getAttachedObject(const QObject *object) const
+{
+    return static_cast<QQuickItemViewAttached *>(qmlAttachedPropertiesObject<QQuickListView>(object, false));
+}
+
 FxViewItem *QQuickListViewPrivate::newViewItem(int modelIndex, QQuickItem *item)
 {
     Q_Q(QQuickListView);
@@ -594,14 +824,14 @@ void QQuickListViewPrivate::initializeViewItem(FxViewItem *item)
     }
 }
 
-bool QQuickListViewPrivate::releaseItem(FxViewItem *item)
+bool QQuickListViewPrivate::releaseItem(FxViewItem *item, QQmlInstanceModel::ReusableFlag reusableFlag)
 {
     if (!item || !model)
         return true;
 
     QQuickListViewAttached *att = static_cast<QQuickListViewAttached*>(item->attached);
 
-    bool released = QQuickItemViewPrivate::releaseItem(item);
+    bool released = QQuickItemViewPrivate::releaseItem(item, reusableFlag);
     if (released && att && att->m_sectionItem) {
         // We hold no more references to this item
         int i = 0;
@@ -635,18 +865,18 @@ bool QQuickListViewPrivate::addVisibleItems(qreal fillFrom, qreal fillTo, qreal
 
     if (haveValidItems && (bufferFrom > itemEnd+averageSize+spacing
         || bufferTo < visiblePos - averageSize - spacing)) {
-        // We've jumped more than a page.  Estimate which items are now
-        // visible and fill from there.
-        int count = (fillFrom - itemEnd) / (averageSize + spacing);
-        int newModelIdx = qBound(0, modelIndex + count, model->count());
-        count = newModelIdx - modelIndex;
-        if (count) {
+        // We've jumped more than a page.  Look up which items are now
+        // visible from the sizes seen so far and fill from there.
+        const qreal estimate = sizeCache.estimate(averageSize);
+        const qreal origin = originPosition();
+        int newModelIdx = qBound(0, sizeCache.indexAt(fillFrom - origin, estimate, spacing), model->count());
+        if (newModelIdx != modelIndex) {
             for (int i = 0; i < visibleItems.count(); ++i)
                 releaseItem(visibleItems.at(i));
             visibleItems.clear();
             modelIndex = newModelIdx;
             visibleIndex = modelIndex;
-            visiblePos = itemEnd + count * (averageSize + spacing);
+            visiblePos = origin + sizeCache.offset(modelIndex, estimate, spacing);
             itemEnd = visiblePos;
         }
     }
@@ -655,9 +885,10 @@ bool QQuickListViewPrivate::addVisibleItems(qreal fillFrom, qreal fillTo, qreal
     FxListItemSG *item = 0;
     qreal pos = itemEnd;
     while (modelIndex < model->count() && pos <= fillTo) {
-        if (!(item = static_cast<FxListItemSG*>(createItem(modelIndex, doBuffer))))
+        if (!(item = static_cast<FxListItemSG*>(createItem(modelIndex, doBuffer || incubateVisibleItems()))))
             break;
         qCDebug(lcItemViewDelegateLifecycle) << "refill: append item" << modelIndex << "pos" << pos << "buffer" << doBuffer << "item" << item->item->objectName();
+        sizeCache.setSize(modelIndex, item->size());
         if (!transitioner || !transitioner->canTransition(QQuickItemViewTransitioner::PopulateTransition, true)) // pos will be set by layoutVisibleItems()
             item->setPosition(pos, true);
         QQuickItemPrivate::get(item->item)->setCulled(doBuffer);
@@ -671,10 +902,11 @@ bool QQuickListViewPrivate::addVisibleItems(qreal fillFrom, qreal fillTo, qreal
         return changed;
 
     while (visibleIndex > 0 && visibleIndex <= model->count() && visiblePos > fillFrom) {
-        if (!(item = static_cast<FxListItemSG*>(createItem(visibleIndex-1, doBuffer))))
+        if (!(item = static_cast<FxListItemSG*>(createItem(visibleIndex-1, doBuffer || incubateVisibleItems()))))
             break;
         qCDebug(lcItemViewDelegateLifecycle) << "refill: prepend item" << visibleIndex-1 << "current top pos" << visiblePos << "buffer" << doBuffer << "item" << item->item->objectName();
         --visibleIndex;
+        sizeCache.setSize(visibleIndex, item->size());
         visiblePos -= item->size() + spacing;
         if (!transitioner || !transitioner->canTransition(QQuickItemViewTransitioner::PopulateTransition, true)) // pos will be set by layoutVisibleItems()
             item->setPosition(visiblePos, true);
@@ -766,6 +998,8 @@ void QQuickListViewPrivate::layoutVisibleItems(int fromModelIndex)
         FxViewItem *firstItem = *visibleItems.constBegin();
         bool fixedCurrent = currentItem && firstItem->item == currentItem->item;
         qreal sum = firstItem->size();
+        if (firstItem->index != -1)
+            sizeCache.setSize(firstItem->index, firstItem->size());
         qreal pos = firstItem->position() + firstItem->size() + spacing;
         firstItem->setVisible(firstItem->endPosition() >= from && firstItem->position() <= to);
 
@@ -777,6 +1011,8 @@ void QQuickListViewPrivate::layoutVisibleItems(int fromModelIndex)
             }
             pos += item->size() + spacing;
             sum += item->size();
+            if (item->index != -1)
+                sizeCache.setSize(item->index, item->size());
             fixedCurrent = fixedCurrent || (currentItem && item->item == currentItem->item);
         }
         averageSize = qRound(sum / visibleItems.count());
@@ -1264,8 +1500,12 @@ void QQuickListViewPrivate::updateAverage()
     if (!visibleItems.count())
         return;
     qreal sum = 0.0;
-    for (int i = 0; i < visibleItems.count(); ++i)
-        sum += visibleItems.at(i)->size();
+    for (int i = 0; i < visibleItems.count(); ++i) {
+        FxViewItem *item = visibleItems.at(i);
+        sum += item->size();
+        if (item->index != -1)
+            sizeCache.setSize(item->index, item->size());
+    }
     averageSize = qRound(sum / visibleItems.count());
 }
 
@@ -2150,6 +2390,40 @@ void QQuickListView::setOrientation(QQuickListView::Orientation orientation)
 */
 
 
+/*!
+    \qmlproperty bool QtQuick::ListView::reuseItems
+    \since QtQuick 2.7
+
+    This property holds whether delegate items that leave the view (including
+    its cacheBuffer) are kept by the model and reused for other indexes,
+    instead of being destroyed and created again. The default value is \c false.
+
+    A reused delegate keeps its state; only its model data and \c index are
+    updated. Use the \l{ListView::pooled}{ListView.pooled} and
+    \l{ListView::reused}{ListView.reused} attached signals to reset any state
+    that depends on the item it previously showed.
+
+    Delegates are never reused across a change of \l model or \l delegate.
+*/
+
+/*!
+    \qmlattachedsignal QtQuick::ListView::pooled()
+    \since QtQuick 2.7
+    This attached signal is emitted when the item is released into the reuse
+    pool, if \l reuseItems is \c true.
+
+    The corresponding handler is \c onPooled.
+*/
+
+/*!
+    \qmlattachedsignal QtQuick::ListView::reused()
+    \since QtQuick 2.7
+    This attached signal is emitted when the item is taken from the reuse pool
+    to show a different index, if \l reuseItems is \c true.
+
+    The corresponding handler is \c onReused.
+*/
+
 /*!
     \qmlproperty int QtQuick::ListView::cacheBuffer
     This property determines whether delegates are retained outside the
@@ -3035,8 +3309,15 @@ void QQuickListViewPrivate::updateSectionCriteria()
     }
 }
 
+void QQuickListViewPrivate::modelItemsRemoved(const QQmlChangeSet::Change &removal)
+{
+    sizeCache.remove(removal);
+}
+
 bool QQuickListViewPrivate::applyInsertionChange(const QQmlChangeSet::Change &change, ChangeResult *insertResult, QList<FxViewItem *> *addedItems, QList<MovedItem> *movingIntoView)
 {
+    sizeCache.insert(change);
+
     int modelIndex = change.index;
     int count = change.count;
 
@@ -95,7 +95,7 @@ QQuickPathViewPrivate::QQuickPathViewPrivate()
     , stealMouse(false), ownModel(false), interactive(true), haveHighlightRange(true)
     , autoHighlight(true), highlightUp(false), layoutScheduled(false)
     , moving(false), flicking(false), dragging(false), inRequest(false), delegateValidated(false)
-    , inRefill(false)
+    , inRefill(false), reuseItems(false)
     , dragMargin(0), deceleration(100), maximumFlickVelocity(QML_FLICK_DEFAULTMAXVELOCITY)
     , moveOffset(this, &QQuickPathViewPrivate::setAdjustedOffset), flickDuration(0)
     , firstIndex(-1), pathItems(-1), requestedIndex(-1), cacheSize(0), requestedZ(0)
@@ -193,18 +193,24 @@ void QQuickPathView::initItem(int index, QObject *object)
     }
 }
 
-void QQuickPathViewPrivate::releaseItem(QQuickItem *item)
+void QQuickPathViewPrivate::releaseItem(QQuickItem *item, QQmlInstanceModel::ReusableFlag reusableFlag)
 {
     if (!item || !model)
         return;
     qCDebug(lcItemViewDelegateLifecycle) << "release" << item;
     QQuickItemPrivate *itemPrivate = QQuickItemPrivate::get(item);
     itemPrivate->removeItemChangeListener(this, QQuickItemPrivate::Geometry);
-    QQmlInstanceModel::ReleaseFlags flags = model->release(item);
+    QQmlInstanceModel::ReleaseFlags flags = model->release(
+            item, reuseItems ? reusableFlag : QQmlInstanceModel::NotReusable);
     if (!flags) {
         // item was not destroyed, and we no longer reference it.
         if (QQuickPathViewAttached *att = attached(item))
             att->setOnPath(false);
+    } else if (flags & QQmlInstanceModel::Pooled) {
+        // item was kept by the model to be reused for another index.
+        if (QQuickPathViewAttached *att = attached(item))
+            att->setOnPath(false);
+        itemPrivate->setCulled(true);
     } else if (flags & QQmlInstanceModel::Destroyed) {
         // but we still reference it
         item->setParentItem(0);
@@ -233,13 +239,14 @@ QQmlOpenMetaObjectType *QQuickPathViewPrivate::attachedType()
 
 void QQuickPathViewPrivate::clear()
 {
+    // The model or the delegate is about to change, so nothing released here can be reused
     if (currentItem) {
-        releaseItem(currentItem);
+        releaseItem(currentItem, QQmlInstanceModel::NotReusable);
         currentItem = 0;
     }
     for (int i=0; i<items.count(); i++){
         QQuickItem *p = items[i];
-        releaseItem(p);
+        releaseItem(p, QQmlInstanceModel::NotReusable);
     }
     if (requestedIndex >= 0) {
         if (model)
@@ -558,6 +565,24 @@ QQuickPathView::~QQuickPathView()
     It is attached to each instance of the delegate.
 */
 
+/*!
+    \qmlattachedsignal QtQuick::PathView::pooled()
+    \since QtQuick 2.7
+    This attached signal is emitted when the item is released into the reuse
+    pool, if \l reuseItems is \c true.
+
+    The corresponding handler is \c onPooled.
+*/
+
+/*!
+    \qmlattachedsignal QtQuick::PathView::reused()
+    \since QtQuick 2.7
+    This attached signal is emitted when the item is taken from the reuse pool
+    to show a different index, if \l reuseItems is \c true.
+
+    The corresponding handler is \c onReused.
+*/
+
 /*!
     \qmlattachedproperty bool QtQuick::PathView::onPath
     This attached property holds whether the item is currently on the path.
@@ -624,6 +649,10 @@ void QQuickPathView::setModel(const QVariant &m)
                              this, QQuickPathView, SLOT(createdItem(int,QObject*)));
         qmlobject_disconnect(d->model, QQmlInstanceModel, SIGNAL(initItem(int,QObject*)),
                              this, QQuickPathView, SLOT(initItem(int,QObject*)));
+        qmlobject_disconnect(d->model, QQmlInstanceModel, SIGNAL(itemPooled(int,QObject*)),
+                             this, QQuickPathView, SLOT(itemPooled(int,QObject*)));
+        qmlobject_disconnect(d->model, QQmlInstanceModel, SIGNAL(itemReused(int,QObject*)),
+                             this, QQuickPathView, SLOT(itemReused(int,QObject*)));
         d->clear();
     }
 
@@ -655,6 +684,10 @@ void QQuickPathView::setModel(const QVariant &m)
                           this, QQuickPathView, SLOT(createdItem(int,QObject*)));
         qmlobject_connect(d->model, QQmlInstanceModel, SIGNAL(initItem(int,QObject*)),
                           this, QQuickPathView, SLOT(initItem(int,QObject*)));
+        qmlobject_connect(d->model, QQmlInstanceModel, SIGNAL(itemPooled(int,QObject*)),
+                          this, QQuickPathView, SLOT(itemPooled(int,QObject*)));
+        qmlobject_connect(d->model, QQmlInstanceModel, SIGNAL(itemReused(int,QObject*)),
+                          this, QQuickPathView, SLOT(itemReused(int,QObject*)));
         d->modelCount = d->model->count();
     }
     if (isComponentComplete()) {
@@ -1332,6 +1365,37 @@ void QQuickPathView::setCacheItemCount(int i)
     emit cacheItemCountChanged();
 }
 
+/*!
+    \qmlproperty bool QtQuick::PathView::reuseItems
+    \since QtQuick 2.7
+
+    This property holds whether delegate items that move off the path are kept
+    by the model and reused for other indexes, instead of being destroyed and
+    created again. The default value is \c false.
+
+    A reused delegate keeps its state; only its model data and \c index are
+    updated. Use the \l{PathView::pooled}{PathView.pooled} and
+    \l{PathView::reused}{PathView.reused} attached signals to reset any state
+    that depends on the item it previously showed.
+
+    \sa cacheItemCount
+*/
+bool QQuickPathView::reuseItems() const
+{
+    Q_D(const QQuickPathView);
+    return d->reuseItems;
+}
+
+void QQuickPathView::setReuseItems(bool reuse)
+{
+    Q_D(QQuickPathView);
+    if (d->reuseItems == reuse)
+        return;
+
+    d->reuseItems = reuse;
+    emit reuseItemsChanged();
+}
+
 /*!
     \qmlproperty enumeration QtQuick::PathView::snapMode
 
@@ -2145,6 +2209,18 @@ void QQuickPathView::destroyingItem(QObject *item)
     Q_UNUSED(item);
 }
 
+void QQuickPathView::itemPooled(int, QObject *item)
+{
+    if (QQuickPathViewAttached *att = qobject_cast<QQuickPathViewAttached *>(qmlAttachedPropertiesObject<QQuickPathView>(item, false)))
+        emit att->pooled();
+}
+
+void QQuickPathView::itemReused(int, QObject *item)
+{
+    if (QQuickPathViewAttached *att = qobject_cast<QQuickPathViewAttached *>(qmlAttachedPropertiesObject<QQuickPathView>(item, false)))
+        emit att->reused();
+}
+
 void QQuickPathView::ticked()
 {
     Q_D(QQuickPathView);
@@ -77,6 +77,7 @@ class Q_AUTOTEST_EXPORT QQuickPathView : public QQuickItem
     Q_PROPERTY(SnapMode snapMode READ snapMode WRITE setSnapMode NOTIFY snapModeChanged)
 
     Q_PROPERTY(int cacheItemCount READ cacheItemCount WRITE setCacheItemCount NOTIFY cacheItemCountChanged)
+    Q_PROPERTY(bool reuseItems READ reuseItems WRITE setReuseItems NOTIFY reuseItemsChanged REVISION 1)
 
     Q_ENUMS(HighlightRangeMode)
     Q_ENUMS(SnapMode)
@@ -145,6 +146,9 @@ public:
     int cacheItemCount() const;
     void setCacheItemCount(int);
 
+    bool reuseItems() const;
+    void setReuseItems(bool reuse);
+
     enum SnapMode { NoSnap, SnapToItem, SnapOneItem };
     SnapMode snapMode() const;
     void setSnapMode(SnapMode mode);
@@ -191,6 +195,7 @@ Q_SIGNALS:
     void dragEnded();
     void snapModeChanged();
     void cacheItemCountChanged();
+    Q_REVISION(1) void reuseItemsChanged();
 
 protected:
     void updatePolish() Q_DECL_OVERRIDE;
@@ -210,6 +215,8 @@ private Q_SLOTS:
     void createdItem(int index, QObject *item);
     void initItem(int index, QObject *item);
     void destroyingItem(QObject *item);
+    void itemPooled(int index, QObject *item);
+    void itemReused(int index, QObject *item);
     void pathUpdated();
 
 private:
@@ -256,6 +263,8 @@ public:
 Q_SIGNALS:
     void currentItemChanged();
     void pathChanged();
+    void pooled();
+    void reused();
 
 private:
     friend class QQuickPathViewPrivate;
@@ -56,6 +56,7 @@
 #include <QtGui/qevent.h>
 #include <QtGui/qmatrix4x4.h>
 #include <QtGui/qstylehints.h>
+#include <QtGui/qscreen.h>
 #include <QtCore/qvarlengtharray.h>
 #include <QtCore/qabstractanimation.h>
 #include <QtCore/QLibraryInfo>
@@ -203,6 +204,7 @@ QQuickRootItem::QQuickRootItem()
 void QQuickWindow::exposeEvent(QExposeEvent *)
 {
     Q_D(QQuickWindow);
+    d->bufferContentsLost = true;
     if (d->windowManager)
         d->windowManager->exposureChanged(this);
 }
@@ -269,6 +271,9 @@ void QQuickWindowPrivate::polishItems()
         qWarning("QQuickWindow: possible QQuickItem::polish() loop");
 
     updateFocusItemTransform();
+
+    // Animations for the next frame start with a fresh budget for creating delegates.
+    delegateCreationTime = 0;
 }
 
 /*!
@@ -351,12 +356,29 @@ void QQuickWindowPrivate::syncSceneGraph()
 
     renderer->setCustomRenderMode(customRenderMode);
 
+    if (bufferContentsLost) {
+        renderer->invalidateBufferContents();
+        bufferContentsLost = false;
+    }
+
     emit q->afterSynchronizing();
     runAndClearJobs(&afterSynchronizingJobs);
     context->endSync();
 }
 
 
+/*
+    Only redraw what changed when the window surface is known to keep its contents
+    across frames. The platform has to be configured for that, for instance with
+    EGL_BUFFER_PRESERVED or a single buffered surface, so it is opt-in through
+    QSG_PRESERVED_SWAP.
+ */
+static bool qsg_surfacePreservesContents()
+{
+    static bool preservedSwap = qEnvironmentVariableIntValue("QSG_PRESERVED_SWAP");
+    return preservedSwap;
+}
+
 void QQuickWindowPrivate::renderSceneGraph(const QSize &size)
 {
     QML_MEMORY_SCOPE_STRING("SceneGraph");
@@ -379,6 +401,7 @@ void QQuickWindowPrivate::renderSceneGraph(const QSize &size)
         }
         renderer->setProjectionMatrixToRect(QRect(QPoint(0, 0), size));
         renderer->setDevicePixelRatio(devicePixelRatio);
+        renderer->setBufferPreserved(!fboId && qsg_surfacePreservesContents());
 
         context->renderNextFrame(renderer, fboId);
     }
@@ -407,6 +430,7 @@ QQuickWindowPrivate::QQuickWindowPrivate()
     , customRenderStage(0)
     , clearColor(Qt::white)
     , clearBeforeRendering(true)
+    , bufferContentsLost(true)
     , persistentGLContext(true)
     , persistentSceneGraph(true)
     , lastWheelEventAccepted(false)
@@ -416,6 +440,8 @@ QQuickWindowPrivate::QQuickWindowPrivate()
     , renderTargetId(0)
     , vaoHelper(0)
     , incubationController(0)
+    , delegateCreationTime(0)
+    , delegateCreationBudget(0)
 {
 #ifndef QT_NO_DRAGANDDROP
     dragGrabber = new QQuickDragGrabber;
@@ -442,6 +468,18 @@ void QQuickWindowPrivate::init(QQuickWindow *c, QQuickRenderControl *control)
     contentItem->setSize(q->size());
 
     customRenderMode = qgetenv("QSG_VISUALIZE");
+
+    // Like incubation, synchronous delegate creation gets a third of a frame by default.
+    bool budgetSet = false;
+    const int budget = qEnvironmentVariableIntValue("QML_ITEMVIEW_DELEGATE_BUDGET", &budgetSet);
+    if (budgetSet) {
+        delegateCreationBudget = qint64(qMax(0, budget)) * 1000000;
+    } else {
+        const QScreen *screen = QGuiApplication::primaryScreen();
+        const qreal refreshRate = screen && screen->refreshRate() > 0 ? screen->refreshRate() : 60;
+        delegateCreationBudget = qint64(qMax(1, int(1000 / refreshRate) / 3)) * 1000000;
+    }
+
     renderControl = control;
     if (renderControl)
         QQuickRenderControlPrivate::get(renderControl)->window = q;
@@ -3652,6 +3690,33 @@ QSGTexture *QQuickWindow::createTextureFromId(uint id, const QSize &size, Create
     return 0;
 }
 
+/*!
+    \since 5.7
+
+    Compiles and links the shaders of \a materials ahead of their first use,
+    for instance while a splash screen is shown, so that the first frame
+    showing them does not stall. Only the type of each material matters, so
+    one instance per QSGMaterialType is enough. Where OpenGL program binaries
+    are supported, the linked programs are also stored in the shader disk
+    cache for later runs.
+
+    This function must be called on the rendering thread while the window's
+    OpenGL context is current, for instance from a slot connected to
+    sceneGraphInitialized() with Qt::DirectConnection. The materials remain
+    owned by the caller.
+
+    \warning This function does nothing if the scenegraph has not yet been
+    initialized.
+
+    \sa sceneGraphInitialized(), QSGMaterial
+ */
+void QQuickWindow::precompileMaterials(const QVector<QSGMaterial *> &materials)
+{
+    Q_D(QQuickWindow);
+    if (d->context && d->context->openglContext())
+        d->context->precompileMaterials(materials);
+}
+
 /*!
     \qmlproperty color Window::color
 
@@ -36,6 +36,7 @@
 
 #include <QtQuick/qtquickglobal.h>
 #include <QtCore/qmetatype.h>
+#include <QtCore/qvector.h>
 #include <QtGui/qopengl.h>
 #include <QtGui/qwindow.h>
 #include <QtGui/qevent.h>
@@ -46,6 +47,7 @@ QT_BEGIN_NAMESPACE
 class QRunnable;
 class QQuickItem;
 class QSGTexture;
+class QSGMaterial;
 class QInputMethodEvent;
 class QQuickWindowPrivate;
 class QQuickWindowAttached;
@@ -123,6 +125,7 @@ public:
     QSGTexture *createTextureFromImage(const QImage &image) const;
     QSGTexture *createTextureFromImage(const QImage &image, CreateTextureOptions options) const;
     QSGTexture *createTextureFromId(uint id, const QSize &size, CreateTextureOptions options = CreateTextureOption(0)) const;
+    void precompileMaterials(const QVector<QSGMaterial *> &materials);
 
     void setClearBeforeRendering(bool enabled);
     bool clearBeforeRendering() const;
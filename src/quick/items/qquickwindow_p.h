@@ -226,6 +226,7 @@ public:
     QColor clearColor;
 
     uint clearBeforeRendering : 1;
+    uint bufferContentsLost : 1;
 
     // Currently unused in the default implementation, as we're not stopping
     // rendering when obscured as we should...
@@ -249,6 +250,12 @@ public:
 
     mutable QQuickWindowIncubationController *incubationController;
 
+    // Time item views in the window have spent creating delegates synchronously since the
+    // last polish, and the time they may spend while moving before incubating them instead.
+    qint64 delegateCreationTime;
+    qint64 delegateCreationBudget;
+    bool delegateCreationBudgetSpent() const { return delegateCreationTime >= delegateCreationBudget; }
+
     static bool defaultAlphaBuffer;
 
     static bool dragOverThreshold(qreal d, Qt::Axis axis, QMouseEvent *event, int startDragThreshold = -1);
@@ -3,6 +3,8 @@ TARGET = QtQuick
 QT = core-private gui-private qml-private
 QT_PRIVATE =  network
 
+CONFIG += simd
+
 DEFINES   += QT_NO_URL_CAST_FROM_STRING QT_NO_INTEGER_EVENT_COORDINATES
 win32-msvc*:DEFINES *= _CRT_SECURE_NO_WARNINGS
 solaris-cc*:QMAKE_CXXFLAGS_RELEASE -= -O2
@@ -33,6 +33,7 @@
 ****************************************************************************/
 
 #include "qsgbatchrenderer_p.h"
+#include "qsgvertextransform_p.h"
 #include <private/qsgshadersourcebuilder_p.h>
 
 #include <QQuickWindow>
@@ -40,6 +41,10 @@
 #include <qmath.h>
 
 #include <QtCore/QElapsedTimer>
+#include <QtCore/QRunnable>
+#include <QtCore/QSemaphore>
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
 #include <QtCore/QtNumeric>
 
 #include <QtGui/QGuiApplication>
@@ -57,6 +62,11 @@
    #define GL_DOUBLE 0x140A
 #endif
 
+#ifndef GL_COPY_READ_BUFFER
+   #define GL_COPY_READ_BUFFER 0x8F36
+   #define GL_COPY_WRITE_BUFFER 0x8F37
+#endif
+
 QT_BEGIN_NAMESPACE
 
 extern QByteArray qsgShaderRewriter_insertZAttributes(const char *input, QSurfaceFormat::OpenGLContextProfile profile);
@@ -76,6 +86,7 @@ DECLARE_DEBUG_VAR(dump)
 DECLARE_DEBUG_VAR(noalpha)
 DECLARE_DEBUG_VAR(noopaque)
 DECLARE_DEBUG_VAR(noclip)
+DECLARE_DEBUG_VAR(noculling)
 #undef DECLARE_DEBUG_VAR
 
 static QElapsedTimer qsg_renderer_timer;
@@ -83,6 +94,9 @@ static QElapsedTimer qsg_renderer_timer;
 #define QSGNODE_TRAVERSE(NODE) for (QSGNode *child = NODE->firstChild(); child; child = child->nextSibling())
 #define SHADOWNODE_TRAVERSE(NODE) for (QList<Node *>::const_iterator child = NODE->children.constBegin(); child != NODE->children.constEnd(); ++child)
 
+// Merged batches with fewer vertices than this are not worth handing to the upload workers
+#define QSG_RENDERER_PARALLEL_UPLOAD_VERTICES 8192
+
 static inline int size_of_type(GLenum type)
 {
     static int sizes[] = {
@@ -122,6 +136,21 @@ struct QMatrix4x4_Accessor
 
 const float OPAQUE_LIMIT                = 0.999f;
 
+/*
+ * The shader manager is shared by all renderers of a render context.
+ */
+ShaderManager *ShaderManager::forContext(QSGRenderContext *ctx)
+{
+    ShaderManager *manager = ctx->findChild<ShaderManager *>(QStringLiteral("__qt_ShaderManager"), Qt::FindDirectChildrenOnly);
+    if (!manager) {
+        manager = new ShaderManager(ctx);
+        manager->setObjectName(QStringLiteral("__qt_ShaderManager"));
+        manager->setParent(ctx);
+        QObject::connect(ctx, SIGNAL(invalidated()), manager, SLOT(invalidated()), Qt::DirectConnection);
+    }
+    return manager;
+}
+
 ShaderManager::Shader *ShaderManager::prepareMaterial(QSGMaterial *material)
 {
     QSGMaterialType *type = material->type();
@@ -196,6 +225,17 @@ ShaderManager::Shader *ShaderManager::prepareMaterialNoRewrite(QSGMaterial *mate
     return shader;
 }
 
+/*
+ * Prepares both variants of the material's shader, as it is not known up
+ * front whether it will be rendered merged with a depth buffer or not.
+ */
+void ShaderManager::precompile(QSGMaterial *material)
+{
+    if (!(material->flags() & QSGMaterial::CustomCompileStep))
+        prepareMaterial(material);
+    prepareMaterialNoRewrite(material);
+}
+
 void ShaderManager::invalidated()
 {
     qDeleteAll(stockShaders.values());
@@ -484,6 +524,7 @@ void Updater::visitGeometryNode(Node *n)
         }
         if (m_opacityChange) {
             Element *e = n->element();
+            renderer->markDamaged(e);
             if (e->batch)
                 renderer->invalidateBatchAndOverlappingRenderOrders(e->batch);
         }
@@ -576,12 +617,9 @@ void Element::computeBounds()
         return;
     }
 
-    bounds.set(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
-    char *vd = (char *) g->vertexData() + offset;
-    for (int i=0; i<g->vertexCount(); ++i) {
-        bounds |= *(Pt *) vd;
-        vd += g->sizeOfVertex();
-    }
+    float b[4] = { FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX };
+    qsg_vertexKernels().bounds((const char *) g->vertexData() + offset, g->vertexCount(), g->sizeOfVertex(), b);
+    bounds.set(b[0], b[1], b[2], b[3]);
     bounds.map(*node->matrix());
 
     if (!qIsFinite(bounds.tl.x) || bounds.tl.x == FLT_MAX)
@@ -631,7 +669,6 @@ bool Batch::geometryWasChanged(QSGGeometryNode *gn)
     while (e && (e->node == gn || e->removed))
         e = e->nextInBatch;
     if (!e || e->node->geometry()->attributes() == gn->geometry()->attributes()) {
-        needsUpload = true;
         return true;
     } else {
         return false;
@@ -755,6 +792,13 @@ Renderer::Renderer(QSGRenderContext *ctx)
     , m_zRange(0)
     , m_renderOrderRebuildLower(-1)
     , m_renderOrderRebuildUpper(-1)
+    , m_vertexHeap(GL_ARRAY_BUFFER)
+#ifdef QSG_SEPARATE_INDEX_BUFFER
+    , m_indexHeap(GL_ELEMENT_ARRAY_BUFFER)
+#endif
+    , m_uploadPool(0)
+    , m_uploadThreads(0)
+    , m_uploadJobs(64)
     , m_currentMaterial(0)
     , m_currentShader(0)
     , m_currentStencilValue(0)
@@ -766,18 +810,20 @@ Renderer::Renderer(QSGRenderContext *ctx)
     , m_indexUploadPool(64)
 #endif
     , m_vao(0)
+    , m_damagedElements(64)
+    , m_fullDamage(true)
+    , m_damageTracked(false)
+    , m_partialUpdate(false)
+    , m_occluderCount(0)
+    , m_occlusionCulling(qEnvironmentVariableIntValue("QSG_RENDERER_OCCLUSION_CULLING"))
+    , m_viewportCulledBatches(0)
+    , m_occlusionCulledBatches(0)
     , m_visualizeMode(VisualizeNothing)
 {
     initializeOpenGLFunctions();
     setNodeUpdater(new Updater(this));
 
-    m_shaderManager = ctx->findChild<ShaderManager *>(QStringLiteral("__qt_ShaderManager"), Qt::FindDirectChildrenOnly);
-    if (!m_shaderManager) {
-        m_shaderManager = new ShaderManager(ctx);
-        m_shaderManager->setObjectName(QStringLiteral("__qt_ShaderManager"));
-        m_shaderManager->setParent(ctx);
-        QObject::connect(ctx, SIGNAL(invalidated()), m_shaderManager, SLOT(invalidated()), Qt::DirectConnection);
-    }
+    m_shaderManager = ShaderManager::forContext(ctx);
 
     m_bufferStrategy = GL_STATIC_DRAW;
     QByteArray strategy = qgetenv("QSG_RENDERER_BUFFER_STRATEGY");
@@ -787,6 +833,18 @@ Renderer::Renderer(QSGRenderContext *ctx)
         m_bufferStrategy = GL_STREAM_DRAW;
     }
 
+    // Page size in kilobytes for sub-allocating batch buffers, 0 gives each
+    // batch a buffer object of its own.
+    m_bufferHeapPageSize = 1024 * 1024;
+    bool heapSizeSet = false;
+    const int heapSize = qEnvironmentVariableIntValue("QSG_RENDERER_BUFFER_HEAP_SIZE", &heapSizeSet);
+    if (heapSizeSet)
+        m_bufferHeapPageSize = qMax(0, heapSize) * 1024;
+    m_vertexHeap.initialize(this, m_bufferStrategy, m_bufferHeapPageSize);
+#ifdef QSG_SEPARATE_INDEX_BUFFER
+    m_indexHeap.initialize(this, m_bufferStrategy, m_bufferHeapPageSize);
+#endif
+
     m_batchNodeThreshold = 64;
     QByteArray alternateThreshold = qgetenv("QSG_RENDERER_BATCH_NODE_THRESHOLD");
     if (alternateThreshold.length() > 0) {
@@ -804,9 +862,20 @@ Renderer::Renderer(QSGRenderContext *ctx)
         if (ok)
             m_batchVertexThreshold = threshold;
     }
+    // One worker less than cores, as the render thread itself takes a share too.
+    m_uploadThreads = qBound(0, QThread::idealThreadCount() - 1, 3);
+    bool threadsSet = false;
+    const int threads = qEnvironmentVariableIntValue("QSG_RENDERER_UPLOAD_THREADS", &threadsSet);
+    if (threadsSet)
+        m_uploadThreads = qMax(0, threads);
+    if (m_uploadThreads > 0)
+        m_uploadPool = uploadPoolForContext(ctx, m_uploadThreads);
+
     if (Q_UNLIKELY(debug_build() || debug_render())) {
         qDebug() << "Batch thresholds: nodes:" << m_batchNodeThreshold << " vertices:" << m_batchVertexThreshold;
+        qDebug() << "Upload threads:" << m_uploadThreads;
         qDebug() << "Using buffer strategy:" << (m_bufferStrategy == GL_STATIC_DRAW ? "static" : (m_bufferStrategy == GL_DYNAMIC_DRAW ? "dynamic" : "stream"));
+        qDebug() << "Buffer heap page size:" << m_bufferHeapPageSize;
     }
 
     // If rendering with an OpenGL Core profile context, we need to create a VAO
@@ -821,7 +890,9 @@ Renderer::Renderer(QSGRenderContext *ctx)
 
 static void qsg_wipeBuffer(Buffer *buffer, QOpenGLFunctions *funcs)
 {
-    funcs->glDeleteBuffers(1, &buffer->id);
+    // Heap and stream storage goes away with the BufferHeap
+    if (buffer->storage == DedicatedStorage)
+        funcs->glDeleteBuffers(1, &buffer->id);
     // The free here is ok because we're in one of two situations.
     // 1. We're using the upload pool in which case unmap will have set the
     //    data pointer to 0 and calling free on 0 is ok.
@@ -846,6 +917,10 @@ Renderer::~Renderer()
         for (int i=0; i<m_opaqueBatches.size(); ++i) qsg_wipeBatch(m_opaqueBatches.at(i), this);
         for (int i=0; i<m_alphaBatches.size(); ++i) qsg_wipeBatch(m_alphaBatches.at(i), this);
         for (int i=0; i<m_batchPool.size(); ++i) qsg_wipeBatch(m_batchPool.at(i), this);
+        m_vertexHeap.destroy();
+#ifdef QSG_SEPARATE_INDEX_BUFFER
+        m_indexHeap.destroy();
+#endif
     }
 
     foreach (Node *n, m_nodes.values())
@@ -870,6 +945,227 @@ void Renderer::invalidateAndRecycleBatch(Batch *b)
     m_batchPool.add(b);
 }
 
+BufferHeap::BufferHeap(GLenum target)
+    : m_funcs(0)
+    , m_copyBufferSubData(0)
+    , m_target(target)
+    , m_usage(GL_STATIC_DRAW)
+    , m_pageSize(0)
+    , m_frame(0)
+    , m_streamUsed(0)
+    , m_streamPeak(0)
+{
+    for (int i=0; i<StreamFrames; ++i) {
+        m_streamBuffers[i] = 0;
+        m_streamSizes[i] = 0;
+    }
+}
+
+void BufferHeap::initialize(QOpenGLFunctions *funcs, GLenum usage, int pageSize)
+{
+    m_funcs = funcs;
+    m_usage = usage;
+    m_pageSize = pageSize;
+
+    // glCopyBufferSubData() is core in OpenGL 3.1 and OpenGL ES 3.0
+    QOpenGLContext *context = QOpenGLContext::currentContext();
+    const QPair<int, int> version = context->format().version();
+    const bool hasCopyBuffer = context->isOpenGLES()
+            ? version >= qMakePair(3, 0)
+            : version >= qMakePair(3, 1) || context->hasExtension(QByteArrayLiteral("GL_ARB_copy_buffer"));
+    if (hasCopyBuffer)
+        m_copyBufferSubData = (CopyBufferSubData) context->getProcAddress("glCopyBufferSubData");
+}
+
+void BufferHeap::destroy()
+{
+    for (int i=0; i<m_pages.size(); ++i)
+        m_funcs->glDeleteBuffers(1, &m_pages.at(i).id);
+    m_pages.clear();
+    m_retired.clear();
+    for (int i=0; i<StreamFrames; ++i) {
+        if (m_streamBuffers[i])
+            m_funcs->glDeleteBuffers(1, &m_streamBuffers[i]);
+        m_streamBuffers[i] = 0;
+        m_streamSizes[i] = 0;
+    }
+}
+
+void BufferHeap::beginFrame()
+{
+    ++m_frame;
+
+    // Ranges released StreamFrames ago are no longer read by the GPU
+    int kept = 0;
+    for (int i=0; i<m_retired.size(); ++i) {
+        const RetiredRange r = m_retired.at(i);
+        if (m_frame - r.frame >= StreamFrames)
+            freeRange(r.id, r.offset, r.size);
+        else
+            m_retired[kept++] = r;
+    }
+    m_retired.resize(kept);
+
+    // The ring buffer for this frame was last written StreamFrames ago. Grow it
+    // if the frames since then streamed more than it holds.
+    const int slot = m_frame % StreamFrames;
+    if (m_streamPeak > m_streamSizes[slot]) {
+        if (!m_streamBuffers[slot])
+            m_funcs->glGenBuffers(1, &m_streamBuffers[slot]);
+        m_streamSizes[slot] = m_streamPeak + m_streamPeak / 2;
+        m_funcs->glBindBuffer(m_target, m_streamBuffers[slot]);
+        m_funcs->glBufferData(m_target, m_streamSizes[slot], 0, GL_STREAM_DRAW);
+    }
+    m_streamUsed = 0;
+}
+
+static inline int qsg_alignBufferRange(int size)
+{
+    return (size + 15) & ~15;
+}
+
+void BufferHeap::upload(Buffer *buffer, bool streaming)
+{
+    const int size = qsg_alignBufferRange(qMax(buffer->size, 1));
+    if (!streaming || !stream(buffer, size)) {
+        release(buffer);
+        allocate(buffer, size);
+    }
+    buffer->frame = m_frame;
+    m_funcs->glBindBuffer(m_target, buffer->id);
+    m_funcs->glBufferSubData(m_target, buffer->offset, buffer->size, buffer->data);
+}
+
+void BufferHeap::release(Buffer *buffer)
+{
+    if (buffer->storage == HeapStorage) {
+        RetiredRange r = { buffer->id, buffer->offset, buffer->capacity, m_frame };
+        m_retired.append(r);
+    } else if (buffer->storage == DedicatedStorage && buffer->id) {
+        m_funcs->glDeleteBuffers(1, &buffer->id);
+    }
+    buffer->id = 0;
+    buffer->offset = 0;
+    buffer->capacity = 0;
+    buffer->storage = DedicatedStorage;
+}
+
+/*
+ * Moves a heap allocated buffer to a fresh range and copies its content
+ * there on the GPU. The old range is retired, so frames which are still in
+ * flight keep reading the old data while the new range is rewritten.
+ * Returns false when the buffer is not in the heap or buffer copies are
+ * not supported.
+ */
+bool BufferHeap::relocate(Buffer *buffer)
+{
+    if (buffer->storage != HeapStorage || !m_copyBufferSubData)
+        return false;
+
+    const GLuint oldId = buffer->id;
+    const int oldOffset = buffer->offset;
+    const int size = buffer->capacity;
+    release(buffer);
+    allocate(buffer, size);
+    buffer->frame = m_frame;
+
+    m_funcs->glBindBuffer(GL_COPY_READ_BUFFER, oldId);
+    m_funcs->glBindBuffer(GL_COPY_WRITE_BUFFER, buffer->id);
+    m_copyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, oldOffset, buffer->offset, buffer->size);
+    return true;
+}
+
+bool BufferHeap::stream(Buffer *buffer, int size)
+{
+    const int slot = m_frame % StreamFrames;
+    m_streamPeak = qMax(m_streamPeak, m_streamUsed + size);
+    if (m_streamUsed + size > m_streamSizes[slot])
+        return false;
+
+    release(buffer);
+    buffer->id = m_streamBuffers[slot];
+    buffer->offset = m_streamUsed;
+    buffer->capacity = size;
+    buffer->storage = StreamStorage;
+    m_streamUsed += size;
+    return true;
+}
+
+void BufferHeap::allocate(Buffer *buffer, int size)
+{
+    for (int p=0; p<m_pages.size(); ++p) {
+        Page &page = m_pages[p];
+        if (page.size - page.used < size)
+            continue;
+        for (int i=0; i<page.freeRanges.size(); ++i) {
+            Range &r = page.freeRanges[i];
+            if (r.size < size)
+                continue;
+            buffer->id = page.id;
+            buffer->offset = r.offset;
+            buffer->capacity = size;
+            buffer->storage = HeapStorage;
+            page.used += size;
+            r.offset += size;
+            r.size -= size;
+            if (r.size == 0)
+                page.freeRanges.remove(i);
+            return;
+        }
+    }
+
+    // Nothing fits, add a page. Oversized requests get a page of their own.
+    Page page;
+    page.size = qMax(m_pageSize, size);
+    page.used = size;
+    m_funcs->glGenBuffers(1, &page.id);
+    m_funcs->glBindBuffer(m_target, page.id);
+    m_funcs->glBufferData(m_target, page.size, 0, m_usage);
+    if (page.size > size) {
+        Range r = { size, page.size - size };
+        page.freeRanges.append(r);
+    }
+    m_pages.append(page);
+
+    buffer->id = page.id;
+    buffer->offset = 0;
+    buffer->capacity = size;
+    buffer->storage = HeapStorage;
+}
+
+void BufferHeap::freeRange(GLuint id, int offset, int size)
+{
+    for (int p=0; p<m_pages.size(); ++p) {
+        Page &page = m_pages[p];
+        if (page.id != id)
+            continue;
+
+        page.used -= size;
+        if (page.used == 0 && m_pages.size() > 1) {
+            m_funcs->glDeleteBuffers(1, &page.id);
+            m_pages.remove(p);
+            return;
+        }
+
+        // Keep the free list sorted and merge with the neighbours
+        QVector<Range> &ranges = page.freeRanges;
+        int i = 0;
+        while (i < ranges.size() && ranges.at(i).offset < offset)
+            ++i;
+        Range r = { offset, size };
+        ranges.insert(i, r);
+        if (i + 1 < ranges.size() && ranges.at(i).offset + ranges.at(i).size == ranges.at(i + 1).offset) {
+            ranges[i].size += ranges.at(i + 1).size;
+            ranges.remove(i + 1);
+        }
+        if (i > 0 && ranges.at(i - 1).offset + ranges.at(i - 1).size == ranges.at(i).offset) {
+            ranges[i - 1].size += ranges.at(i).size;
+            ranges.remove(i);
+        }
+        return;
+    }
+}
+
 /* The code here does a CPU-side allocation which might seem like a performance issue
  * compared to using glMapBuffer or glMapBufferRange which would give me back
  * potentially GPU allocated memory and saving me one deep-copy, but...
@@ -880,6 +1176,13 @@ void Renderer::invalidateAndRecycleBatch(Batch *b)
  *
  * ref: http://www.opengl.org/wiki/Buffer_Object
  */
+bool Renderer::useBufferHeap() const
+{
+    return m_bufferHeapPageSize > 0
+            && !m_context->hasBrokenIndexBufferObjects()
+            && m_visualizeMode == VisualizeNothing;
+}
+
 void Renderer::map(Buffer *buffer, int byteSize, bool isIndexBuf)
 {
     if (!m_context->hasBrokenIndexBufferObjects() && m_visualizeMode == VisualizeNothing) {
@@ -902,13 +1205,24 @@ void Renderer::map(Buffer *buffer, int byteSize, bool isIndexBuf)
 
 }
 
-void Renderer::unmap(Buffer *buffer, bool isIndexBuf)
+void Renderer::unmap(Buffer *buffer, bool isIndexBuf, bool streaming)
 {
-    if (buffer->id == 0)
-        glGenBuffers(1, &buffer->id);
-    GLenum target = isIndexBuf ? GL_ELEMENT_ARRAY_BUFFER : GL_ARRAY_BUFFER;
-    glBindBuffer(target, buffer->id);
-    glBufferData(target, buffer->size, buffer->data, m_bufferStrategy);
+#ifdef QSG_SEPARATE_INDEX_BUFFER
+    BufferHeap &heap = isIndexBuf ? m_indexHeap : m_vertexHeap;
+#else
+    BufferHeap &heap = m_vertexHeap;
+#endif
+    if (useBufferHeap()) {
+        heap.upload(buffer, streaming);
+    } else {
+        if (buffer->storage != DedicatedStorage)
+            heap.release(buffer);
+        if (buffer->id == 0)
+            glGenBuffers(1, &buffer->id);
+        GLenum target = isIndexBuf ? GL_ELEMENT_ARRAY_BUFFER : GL_ARRAY_BUFFER;
+        glBindBuffer(target, buffer->id);
+        glBufferData(target, buffer->size, buffer->data, m_bufferStrategy);
+    }
 
     if (!m_context->hasBrokenIndexBufferObjects() && m_visualizeMode == VisualizeNothing) {
         buffer->data = 0;
@@ -992,11 +1306,12 @@ void Renderer::nodeWasTransformed(Node *node, int *vertexCount)
         Element *e  = node->element();
         if (e) {
             e->boundsComputed = false;
+            markDamaged(e);
             if (e->batch) {
                 if (!e->batch->isOpaque) {
                     invalidateBatchAndOverlappingRenderOrders(e->batch);
                 } else if (e->batch->merged) {
-                    e->batch->needsUpload = true;
+                    markForUpload(e);
                 }
             }
         }
@@ -1023,6 +1338,7 @@ void Renderer::nodeWasAdded(QSGNode *node, Node *shadowParent)
     if (node->type() == QSGNode::GeometryNodeType) {
         snode->data = m_elementAllocator.allocate();
         snode->element()->setNode(static_cast<QSGGeometryNode *>(node));
+        markDamaged(snode->element());
 
     } else if (node->type() == QSGNode::ClipNodeType) {
         snode->data = new ClipBatchRootInfo;
@@ -1054,6 +1370,7 @@ void Renderer::nodeWasRemoved(Node *node)
             e->removed = true;
             m_elementsToDelete.add(e);
             e->node = 0;
+            addDamage(e->renderedRect);
             if (e->root) {
                 BatchRootInfo *info = batchRootInfo(e->root);
                 info->availableOrders++;
@@ -1095,6 +1412,7 @@ void Renderer::turnNodeIntoBatchRoot(Node *node)
 {
     if (Q_UNLIKELY(debug_change())) qDebug() << " - new batch root";
     m_rebuild |= FullRebuild;
+    m_fullDamage = true;
     node->isBatchRoot = true;
     node->becameBatchRoot = true;
 
@@ -1180,6 +1498,14 @@ void Renderer::nodeChanged(QSGNode *node, QSGNode::DirtyState state)
 
     shadowNode->dirtyState |= state;
 
+    // Moving a batch root only updates the root matrices, so the elements below it
+    // are never visited and we cannot tell where they used to be.
+    if (state & QSGNode::DirtyMatrix && shadowNode->isBatchRoot)
+        m_fullDamage = true;
+
+    if (state & QSGNode::DirtyGeometry && node->type() == QSGNode::ClipNodeType)
+        m_fullDamage = true;
+
     if (state & QSGNode::DirtyMatrix && !shadowNode->isBatchRoot) {
         Q_ASSERT(node->type() == QSGNode::TransformNodeType);
         if (node->m_subtreeRenderableCount > m_batchNodeThreshold) {
@@ -1198,12 +1524,13 @@ void Renderer::nodeChanged(QSGNode *node, QSGNode::DirtyState state)
         Element *e = shadowNode->element();
         if (e) {
             e->boundsComputed = false;
+            markDamaged(e);
             Batch *b = e->batch;
             if (b) {
                 if (!e->batch->geometryWasChanged(gn) || !e->batch->isOpaque) {
                     invalidateBatchAndOverlappingRenderOrders(e->batch);
                 } else {
-                    b->needsUpload = true;
+                    markForUpload(e);
                 }
             }
         }
@@ -1212,6 +1539,7 @@ void Renderer::nodeChanged(QSGNode *node, QSGNode::DirtyState state)
     if (state & QSGNode::DirtyMaterial && node->type() == QSGNode::GeometryNodeType) {
         Element *e = shadowNode->element();
         if (e) {
+            markDamaged(e);
             bool blended = hasMaterialWithBlending(static_cast<QSGGeometryNode *>(node));
             if (e->isMaterialBlended != blended) {
                 m_rebuild |= Renderer::FullRebuild;
@@ -1535,29 +1863,122 @@ void Renderer::prepareOpaqueBatches()
     }
 }
 
-bool Renderer::checkOverlap(int first, int last, const Rect &bounds)
+/*
+ * The unbatched elements between the start of an alpha batch and the next
+ * candidate for it. A candidate may only join the batch if it does not overlap
+ * any of them, as it would otherwise be drawn before them.
+ *
+ * Scanning them all for every candidate is quadratic, which hurts for long render
+ * lists with interleaved materials, such as text on top of rectangles in a big
+ * view. Once there are more than a handful, the elements are bucketed in a hash
+ * grid of OverlapCellSize units, so a candidate only looks at its neighbours.
+ * Elements spanning many cells are kept aside and always checked.
+ */
+class OverlapSet
 {
-    for (int i=first; i<=last; ++i) {
-        Element *e = m_alphaRenderList.at(i);
-        if (!e || e->batch)
-            continue;
+public:
+    OverlapSet() : m_elements(64), m_entries(64), m_large(16) { }
+
+    void reset()
+    {
+        m_elements.reset();
+        m_cells.clear();
+        m_entries.reset();
+        m_large.reset();
+    }
+
+    void add(Element *e)
+    {
         Q_ASSERT(e->boundsComputed);
-        if (e->bounds.intersects(bounds))
-            return true;
+        m_elements.add(e);
+        if (m_elements.size() == LinearLimit) {
+            for (int i=0; i<m_elements.size(); ++i)
+                addToGrid(m_elements.at(i));
+        } else if (m_elements.size() > LinearLimit) {
+            addToGrid(e);
+        }
     }
-    return false;
-}
 
-/*
- *
- * To avoid the O(n^2) checkOverlap check in most cases, we have the
- * overlapBounds which is the union of all bounding rects to check overlap
- * for. We know that if it does not overlap, then none of the individual
- * ones will either. For the typical list case, this results in no calls
- * to checkOverlap what-so-ever. This also ensures that when all consecutive
- * items are matching (such as a table of text), we don't build up an
- * overlap bounds and thus do not require full overlap checks.
- */
+    bool intersects(const Rect &bounds) const
+    {
+        int x1, y1, x2, y2;
+        if (m_elements.size() < LinearLimit || !cellRange(bounds, &x1, &y1, &x2, &y2)) {
+            for (int i=0; i<m_elements.size(); ++i) {
+                if (m_elements.at(i)->bounds.intersects(bounds))
+                    return true;
+            }
+            return false;
+        }
+
+        for (int i=0; i<m_large.size(); ++i) {
+            if (m_large.at(i)->bounds.intersects(bounds))
+                return true;
+        }
+        for (int y=y1; y<=y2; ++y) {
+            for (int x=x1; x<=x2; ++x) {
+                for (int i = m_cells.value(cellKey(x, y), -1); i >= 0; i = m_entries.at(i).next) {
+                    if (m_entries.at(i).element->bounds.intersects(bounds))
+                        return true;
+                }
+            }
+        }
+        return false;
+    }
+
+private:
+    enum {
+        LinearLimit = 32,
+        OverlapCellSize = 64,
+        MaxCellSpan = 16
+    };
+
+    struct Entry {
+        Element *element;
+        int next;
+    };
+
+    static bool cellRange(const Rect &r, int *x1, int *y1, int *x2, int *y2)
+    {
+        if (r.isOutsideFloatRange())
+            return false;
+        *x1 = qFloor(r.tl.x / OverlapCellSize);
+        *y1 = qFloor(r.tl.y / OverlapCellSize);
+        *x2 = qFloor(r.br.x / OverlapCellSize);
+        *y2 = qFloor(r.br.y / OverlapCellSize);
+        return *x2 - *x1 < MaxCellSpan && *y2 - *y1 < MaxCellSpan;
+    }
+
+    static quint64 cellKey(int x, int y)
+    {
+        return (quint64(quint32(x)) << 32) | quint32(y);
+    }
+
+    void addToGrid(Element *e)
+    {
+        int x1, y1, x2, y2;
+        if (!cellRange(e->bounds, &x1, &y1, &x2, &y2)) {
+            m_large.add(e);
+            return;
+        }
+        for (int y=y1; y<=y2; ++y) {
+            for (int x=x1; x<=x2; ++x) {
+                const quint64 key = cellKey(x, y);
+                QHash<quint64, int>::iterator it = m_cells.find(key);
+                Entry entry = { e, it != m_cells.end() ? it.value() : -1 };
+                if (it != m_cells.end())
+                    it.value() = m_entries.size();
+                else
+                    m_cells.insert(key, m_entries.size());
+                m_entries.add(entry);
+            }
+        }
+    }
+
+    QDataBuffer<Element *> m_elements;
+    QHash<quint64, int> m_cells;
+    QDataBuffer<Entry> m_entries;
+    QDataBuffer<Element *> m_large;
+};
 
 void Renderer::prepareAlphaBatches()
 {
@@ -1569,6 +1990,8 @@ void Renderer::prepareAlphaBatches()
         e->ensureBoundsValid();
     }
 
+    OverlapSet overlapping;
+
     for (int i=0; i<m_alphaRenderList.size(); ++i) {
         Element *ei = m_alphaRenderList.at(i);
         if (!ei || ei->batch)
@@ -1601,6 +2024,7 @@ void Renderer::prepareAlphaBatches()
 
         Rect overlapBounds;
         overlapBounds.set(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+        overlapping.reset();
 
         Element *next = ei;
 
@@ -1614,8 +2038,10 @@ void Renderer::prepareAlphaBatches()
                 continue;
 
             QSGGeometryNode *gnj = ej->node;
-            if (gnj->geometry()->vertexCount() == 0)
+            if (gnj->geometry()->vertexCount() == 0) {
+                overlapping.add(ej);
                 continue;
+            }
 
             if (gni->clipList() == gnj->clipList()
                     && gni->geometry()->drawingMode() == gnj->geometry()->drawingMode()
@@ -1623,7 +2049,7 @@ void Renderer::prepareAlphaBatches()
                     && gni->inheritedOpacity() == gnj->inheritedOpacity()
                     && gni->activeMaterial()->type() == gnj->activeMaterial()->type()
                     && gni->activeMaterial()->compare(gnj->activeMaterial()) == 0) {
-                if (!overlapBounds.intersects(ej->bounds) || !checkOverlap(i+1, j - 1, ej->bounds)) {
+                if (!overlapBounds.intersects(ej->bounds) || !overlapping.intersects(ej->bounds)) {
                     ej->batch = batch;
                     next->nextInBatch = ej;
                     next = ej;
@@ -1637,6 +2063,7 @@ void Renderer::prepareAlphaBatches()
                 }
             } else {
                 overlapBounds |= ej->bounds;
+                overlapping.add(ej);
             }
         }
 
@@ -1694,24 +2121,16 @@ void Renderer::uploadMergedElement(Element *e, int vaOffset, char **vertexData,
     // apply vertex transform..
     char *vdata = *vertexData + vaOffset;
     if (((const QMatrix4x4_Accessor &) localx).flagBits == 1) {
-        for (int i=0; i<vCount; ++i) {
-            Pt *p = (Pt *) vdata;
-            p->x += ((QMatrix4x4_Accessor &) localx).m[3][0];
-            p->y += ((QMatrix4x4_Accessor &) localx).m[3][1];
-            vdata += vSize;
-        }
+        qsg_vertexKernels().translate(vdata, vCount, vSize,
+                                      ((const QMatrix4x4_Accessor &) localx).m[3][0],
+                                      ((const QMatrix4x4_Accessor &) localx).m[3][1]);
     } else if (((const QMatrix4x4_Accessor &) localx).flagBits > 1) {
-        for (int i=0; i<vCount; ++i) {
-            ((Pt *) vdata)->map(localx);
-            vdata += vSize;
-        }
+        qsg_vertexKernels().map(vdata, vCount, vSize, localx.constData());
     }
 
     if (m_useDepthBuffer) {
         float *vzorder = (float *) *zData;
-        float zorder = 1.0f - e->order * m_zRange;
-        for (int i=0; i<vCount; ++i)
-            vzorder[i] = zorder;
+        std::fill(vzorder, vzorder + vCount, 1.0f - e->order * m_zRange);
         *zData += vCount * sizeof(float);
     }
 
@@ -1748,6 +2167,88 @@ void Renderer::uploadMergedElement(Element *e, int vaOffset, char **vertexData,
     *indexCount += iCount;
 }
 
+void Renderer::uploadMergedElements(const MergedUploadJob *jobs, int count, int vaOffset)
+{
+    for (int i=0; i<count; ++i) {
+        const MergedUploadJob &job = jobs[i];
+        char *vertexData = job.vertexData;
+        char *zData = job.zData;
+        char *indexData = job.indexData;
+        quint16 iBase = job.iBase;
+        int indexCount = 0;
+        uploadMergedElement(job.element, vaOffset, &vertexData, &zData, &indexData, &iBase, &indexCount);
+    }
+}
+
+class MergedUploadTask : public QRunnable
+{
+public:
+    MergedUploadTask(Renderer *renderer, const MergedUploadJob *jobs, int count, int vaOffset, QSemaphore *done)
+        : m_renderer(renderer)
+        , m_jobs(jobs)
+        , m_count(count)
+        , m_vaOffset(vaOffset)
+        , m_done(done)
+    {
+    }
+
+    void run() Q_DECL_OVERRIDE
+    {
+        m_renderer->uploadMergedElements(m_jobs, m_count, m_vaOffset);
+        m_done->release();
+    }
+
+private:
+    Renderer *m_renderer;
+    const MergedUploadJob *m_jobs;
+    int m_count;
+    int m_vaOffset;
+    QSemaphore *m_done;
+};
+
+/*
+ * All renderers of a render context, those of layers and effect sources
+ * included, share one pool of upload workers. Like the shader manager it
+ * lives as long as the context.
+ */
+QThreadPool *Renderer::uploadPoolForContext(QSGRenderContext *ctx, int threads)
+{
+    QThreadPool *pool = ctx->findChild<QThreadPool *>(QStringLiteral("__qt_UploadPool"), Qt::FindDirectChildrenOnly);
+    if (!pool) {
+        pool = new QThreadPool(ctx);
+        pool->setObjectName(QStringLiteral("__qt_UploadPool"));
+        pool->setMaxThreadCount(threads);
+    }
+    return pool;
+}
+
+/*
+ * Splits the laid out elements of a merged batch between the upload workers and
+ * the render thread and waits for all of them. Each element writes to its own
+ * part of the upload buffer and only reads its node, so no locking is needed.
+ */
+void Renderer::runUploadJobs(int vaOffset)
+{
+    const int count = m_uploadJobs.size();
+    const int chunks = m_uploadThreads + 1;
+    const int chunkSize = (count + chunks - 1) / chunks;
+    const MergedUploadJob *jobs = m_uploadJobs.data();
+
+    // The pool is shared, so only this renderer's tasks are waited for.
+    QSemaphore done;
+    int started = 0;
+    int first = chunkSize;
+    while (first < count) {
+        m_uploadPool->start(new MergedUploadTask(this, jobs + first, qMin(chunkSize, count - first), vaOffset, &done));
+        first += chunkSize;
+        ++started;
+    }
+    uploadMergedElements(jobs, qMin(chunkSize, count), vaOffset);
+    done.acquire(started);
+
+    m_uploadJobs.reset();
+}
+
 static QMatrix4x4 qsg_matrixForRoot(Node *node)
 {
     if (node->type() == QSGNode::TransformNodeType)
@@ -1757,8 +2258,137 @@ static QMatrix4x4 qsg_matrixForRoot(Node *node)
     return *c->matrix();
 }
 
+/*
+ * A change to a single element of an opaque merged batch only needs that
+ * element's range rewritten, as long as the batch layout stays the same.
+ */
+void Renderer::markForUpload(Element *e)
+{
+    Batch *b = e->batch;
+    if (b->merged) {
+        e->needsUpload = true;
+        b->hasDirtyElements = true;
+    } else {
+        b->needsUpload = true;
+    }
+}
+
+static bool qsg_isMergeable(const Batch *b)
+{
+    QSGGeometryNode *gn = b->first->node;
+    QSGGeometry *g =  gn->geometry();
+    QSGMaterial::Flags flags = gn->activeMaterial()->flags();
+    return (g->drawingMode() == GL_TRIANGLES || g->drawingMode() == GL_TRIANGLE_STRIP ||
+            g->drawingMode() == GL_LINES || g->drawingMode() == GL_POINTS)
+            && b->positionAttribute >= 0
+            && g->indexType() == GL_UNSIGNED_SHORT
+            && (flags & (QSGMaterial::CustomCompileStep | QSGMaterial_FullMatrix)) == 0
+            && ((flags & QSGMaterial::RequiresFullMatrixExceptTranslate) == 0 || b->isTranslateOnlyToRoot())
+            && b->isSafeToBatch();
+}
+
+/*
+ * Rewrites the vertex, z and index ranges of the elements marked with
+ * markForUpload() in place. Returns false if the batch needs a full
+ * upload instead, because an element changed size or the batch can
+ * no longer be merged.
+ */
+bool Renderer::uploadDirtyElements(Batch *b)
+{
+    if (!b->merged || !b->first || !b->vbo.id
+            || !useBufferHeap()
+            || b->vbo.storage != HeapStorage
+#ifdef QSG_SEPARATE_INDEX_BUFFER
+            || b->ibo.storage != HeapStorage
+#endif
+            || !m_vertexHeap.canRelocate()
+            || !qsg_isMergeable(b)) {
+        return false;
+    }
+
+    QSGGeometry *g = b->first->node->geometry();
+    const int vSize = g->sizeOfVertex();
+    const int zSize = m_useDepthBuffer ? sizeof(float) : 0;
+
+    int dirtySize = 0;
+    int largestSize = 0;
+    for (Element *e = b->first; e; e = e->nextInBatch) {
+        if (!e->needsUpload)
+            continue;
+        QSGGeometry *eg = e->node->geometry();
+        const int vCount = eg->vertexCount();
+        const int iCount = qsg_fixIndexCount(eg->indexCount() ? eg->indexCount() : vCount, eg->drawingMode());
+        if (vCount != e->uploadedVertexCount || iCount != e->uploadedIndexCount)
+            return false;
+        const int size = vCount * (vSize + zSize) + iCount * sizeof(quint16);
+        dirtySize += size;
+        largestSize = qMax(size, largestSize);
+    }
+
+    // Rewriting most of the batch piece by piece is slower than one upload
+    if (dirtySize * 2 > b->vbo.size)
+        return false;
+
+    if (largestSize > m_vertexUploadPool.size())
+        m_vertexUploadPool.resize(largestSize);
+
+    // Writing into the current range would stall on frames still reading it,
+    // so move the batch to a fresh range first, then patch the dirty elements.
+    m_vertexHeap.relocate(&b->vbo);
+#ifdef QSG_SEPARATE_INDEX_BUFFER
+    m_indexHeap.relocate(&b->ibo);
+#endif
+
+    const int zBase = b->vertexCount * vSize;
+    glBindBuffer(GL_ARRAY_BUFFER, b->vbo.id);
+#ifdef QSG_SEPARATE_INDEX_BUFFER
+    const GLenum indexTarget = GL_ELEMENT_ARRAY_BUFFER;
+    const int indexBase = b->ibo.offset;
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, b->ibo.id);
+#else
+    const GLenum indexTarget = GL_ARRAY_BUFFER;
+    const int indexBase = b->vbo.offset;
+#endif
+
+    for (Element *e = b->first; e; e = e->nextInBatch) {
+        if (!e->needsUpload)
+            continue;
+        const int vCount = e->uploadedVertexCount;
+        char *vertexStart = m_vertexUploadPool.data();
+        char *zStart = vertexStart + vCount * vSize;
+        char *indexStart = zStart + vCount * zSize;
+        char *vertexData = vertexStart;
+        char *zData = zStart;
+        char *indexData = indexStart;
+        quint16 iBase = e->uploadedIndexBase;
+        int indexCount = 0;
+        uploadMergedElement(e, b->positionAttribute, &vertexData, &zData, &indexData, &iBase, &indexCount);
+
+        glBufferSubData(GL_ARRAY_BUFFER, b->vbo.offset + e->vertexOffset, vCount * vSize, vertexStart);
+        if (m_useDepthBuffer) {
+            glBufferSubData(GL_ARRAY_BUFFER, b->vbo.offset + zBase + (e->vertexOffset / vSize) * sizeof(float),
+                            vCount * sizeof(float), zStart);
+        }
+        glBufferSubData(indexTarget, indexBase + e->indexOffset, indexCount * sizeof(quint16), indexStart);
+        e->needsUpload = false;
+    }
+    b->hasDirtyElements = false;
+
+    if (Q_UNLIKELY(debug_upload())) qDebug() << " Batch:" << b << "updated" << dirtySize << "bytes in place";
+    if (Q_UNLIKELY(debug_render()))
+        b->uploadedThisFrame = true;
+    return true;
+}
+
 void Renderer::uploadBatch(Batch *b)
 {
+        // Data in the streaming ring is only kept for a few frames
+        if (b->vbo.storage == StreamStorage && m_vertexHeap.frame() - b->vbo.frame >= BufferHeap::StreamFrames)
+            b->needsUpload = true;
+
+        if (!b->needsUpload && b->hasDirtyElements && !uploadDirtyElements(b))
+            b->needsUpload = true;
+
         // Early out if nothing has changed in this batch..
         if (!b->needsUpload) {
             if (Q_UNLIKELY(debug_upload())) qDebug() << " Batch:" << b << "already uploaded...";
@@ -1781,16 +2411,8 @@ void Renderer::uploadBatch(Batch *b)
 
         QSGGeometryNode *gn = b->first->node;
         QSGGeometry *g =  gn->geometry();
-        QSGMaterial::Flags flags = gn->activeMaterial()->flags();
-        bool canMerge = (g->drawingMode() == GL_TRIANGLES || g->drawingMode() == GL_TRIANGLE_STRIP ||
-                         g->drawingMode() == GL_LINES || g->drawingMode() == GL_POINTS)
-                        && b->positionAttribute >= 0
-                        && g->indexType() == GL_UNSIGNED_SHORT
-                        && (flags & (QSGMaterial::CustomCompileStep | QSGMaterial_FullMatrix)) == 0
-                        && ((flags & QSGMaterial::RequiresFullMatrixExceptTranslate) == 0 || b->isTranslateOnlyToRoot())
-                        && b->isSafeToBatch();
 
-        b->merged = canMerge;
+        b->merged = qsg_isMergeable(b);
 
         // Figure out how much memory we need...
         b->vertexCount = 0;
@@ -1799,6 +2421,7 @@ void Renderer::uploadBatch(Batch *b)
         Element *e = b->first;
 
         while (e) {
+            e->needsUpload = false;
             QSGGeometry *eg = e->node->geometry();
             b->vertexCount += eg->vertexCount();
             int iCount = eg->indexCount();
@@ -1818,6 +2441,12 @@ void Renderer::uploadBatch(Batch *b)
         if (b->vertexCount == 0 || (b->merged && b->indexCount == 0))
             return;
 
+        // Batches uploaded frame after frame go to the streaming ring
+        const int frame = m_vertexHeap.frame();
+        b->uploadStreak = b->uploadFrame == frame - 1 ? b->uploadStreak + 1 : 1;
+        b->uploadFrame = frame;
+        const bool streaming = b->uploadStreak >= BufferHeap::StreamFrames;
+
         /* Allocate memory for this batch. Merged batches are divided into three separate blocks
            1. Vertex data for all elements, as they were in the QSGGeometry object, but
               with the tranform relative to this batch's root applied. The vertex data
@@ -1871,6 +2500,14 @@ void Renderer::uploadBatch(Batch *b)
             int drawSetIndices = indexData - vertexData;
 #endif
             b->drawSets << DrawSet(0, zData - vertexData, drawSetIndices);
+
+            // Large batches are transformed and copied in parallel. The elements are
+            // only laid out here, advancing the pointers like uploadMergedElement() does.
+            const bool parallel = m_uploadPool
+                    && b->vertexCount >= QSG_RENDERER_PARALLEL_UPLOAD_VERTICES
+                    && Q_LIKELY(!debug_upload());
+            const int vSize = g->sizeOfVertex();
+
             while (e) {
                 verticesInSet  += e->node->geometry()->vertexCount();
                 if (verticesInSet > 0xffff) {
@@ -1891,9 +2528,34 @@ void Renderer::uploadBatch(Batch *b)
                     verticesInSet = e->node->geometry()->vertexCount();
                     indicesInSet = 0;
                 }
-                uploadMergedElement(e, b->positionAttribute, &vertexData, &zData, &indexData, &iOffset, &indicesInSet);
+                QSGGeometry *eg = e->node->geometry();
+                const int vCount = eg->vertexCount();
+                const int iCount = qsg_fixIndexCount(eg->indexCount() ? eg->indexCount() : vCount, eg->drawingMode());
+                e->vertexOffset = vertexData - b->vbo.data;
+#ifdef QSG_SEPARATE_INDEX_BUFFER
+                e->indexOffset = indexData - b->ibo.data;
+#else
+                e->indexOffset = indexData - b->vbo.data;
+#endif
+                e->uploadedVertexCount = vCount;
+                e->uploadedIndexCount = iCount;
+                e->uploadedIndexBase = iOffset;
+                if (parallel) {
+                    MergedUploadJob job = { e, vertexData, zData, indexData, iOffset };
+                    m_uploadJobs.add(job);
+                    vertexData += vCount * vSize;
+                    if (m_useDepthBuffer)
+                        zData += vCount * sizeof(float);
+                    indexData += iCount * sizeof(quint16);
+                    iOffset += vCount;
+                    indicesInSet += iCount;
+                } else {
+                    uploadMergedElement(e, b->positionAttribute, &vertexData, &zData, &indexData, &iOffset, &indicesInSet);
+                }
                 e = e->nextInBatch;
             }
+            if (parallel)
+                runUploadJobs(b->positionAttribute);
             b->drawSets.last().indexCount = indicesInSet;
             // We skip the very first and very last degenerate triangles since they aren't needed
             // and the first one would reverse the vertex ordering of the merged strips.
@@ -1977,14 +2639,15 @@ void Renderer::uploadBatch(Batch *b)
         }
 #endif // QT_NO_DEBUG_OUTPUT
 
-        unmap(&b->vbo);
+        unmap(&b->vbo, false, streaming);
 #ifdef QSG_SEPARATE_INDEX_BUFFER
-        unmap(&b->ibo, true);
+        unmap(&b->ibo, true, streaming);
 #endif
 
         if (Q_UNLIKELY(debug_upload())) qDebug() << "  --- vertex/index buffers unmapped, batch upload completed...";
 
         b->needsUpload = false;
+        b->hasDirtyElements = false;
 
         if (Q_UNLIKELY(debug_render()))
             b->uploadedThisFrame = true;
@@ -2000,13 +2663,13 @@ Renderer::ClipType Renderer::updateStencilClip(const QSGClipNode *clip)
 {
     if (!clip) {
         glDisable(GL_STENCIL_TEST);
-        glDisable(GL_SCISSOR_TEST);
+        resetScissor();
         return NoClip;
     }
 
     ClipType clipType = NoClip;
 
-    glDisable(GL_SCISSOR_TEST);
+    resetScissor();
 
     m_currentStencilValue = 0;
     m_currentScissorRect = QRect();
@@ -2052,6 +2715,8 @@ Renderer::ClipType Renderer::updateStencilClip(const QSGClipNode *clip)
 
             if (!(clipType & ScissorClip)) {
                 m_currentScissorRect = QRect(ix1, iy1, ix2 - ix1, iy2 - iy1);
+                if (m_partialUpdate)
+                    m_currentScissorRect &= m_damageBounds;
                 glEnable(GL_SCISSOR_TEST);
                 clipType |= ScissorClip;
             } else {
@@ -2244,6 +2909,7 @@ void Renderer::renderMergedBatch(const Batch *batch)
         indexBase = indexBuf->data;
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
     } else {
+        indexBase += indexBuf->offset;
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuf->id);
     }
 
@@ -2290,11 +2956,11 @@ void Renderer::renderMergedBatch(const Batch *batch)
                 continue;
             const QSGGeometry::Attribute &a = g->attributes()[j];
             GLboolean normalize = a.type != GL_FLOAT && a.type != GL_DOUBLE;
-            glVertexAttribPointer(a.position, a.tupleSize, a.type, normalize, g->sizeOfVertex(), (void *) (qintptr) (offset + draw.vertices));
+            glVertexAttribPointer(a.position, a.tupleSize, a.type, normalize, g->sizeOfVertex(), (void *) (qintptr) (batch->vbo.offset + offset + draw.vertices));
             offset += a.tupleSize * size_of_type(a.type);
         }
         if (m_useDepthBuffer)
-            glVertexAttribPointer(sms->pos_order, 1, GL_FLOAT, false, 0, (void *) (qintptr) (draw.zorders));
+            glVertexAttribPointer(sms->pos_order, 1, GL_FLOAT, false, 0, (void *) (qintptr) (batch->vbo.offset + draw.zorders));
 
         glDrawElements(g->drawingMode(), draw.indexCount, GL_UNSIGNED_SHORT, (void *) (qintptr) (indexBase + draw.indices));
     }
@@ -2340,6 +3006,7 @@ void Renderer::renderUnmergedBatch(const Batch *batch)
             indexBase = indexBuf->data;
             glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
         } else {
+            indexBase += indexBuf->offset;
             glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuf->id);
         }
     }
@@ -2362,7 +3029,7 @@ void Renderer::renderUnmergedBatch(const Batch *batch)
         sms->lastOpacity = m_current_opacity;
     }
 
-    int vOffset = 0;
+    int vOffset = batch->vbo.offset;
 #ifdef QSG_SEPARATE_INDEX_BUFFER
     char *iOffset = indexBase;
 #else
@@ -2444,6 +3111,352 @@ void Renderer::renderUnmergedBatch(const Batch *batch)
     }
 }
 
+/*
+ * Damage tracking for partial updates.
+ *
+ * When the render target keeps its contents from one frame to the next, only the
+ * parts of the scene which changed need to be redrawn. Elements are flagged as
+ * damaged when they are added or when their geometry, material, opacity or
+ * transform changes, and removed elements damage the area they were last drawn
+ * in. At the start of the frame each damaged element contributes both its old and
+ * its new window rect. The bounding rect of the damage is then used as scissor for
+ * the clear and for all batches, and batches outside of it are skipped entirely.
+ *
+ * Changes we cannot attribute to individual elements, such as a batch root moving
+ * or a clip changing, fall back to redrawing everything.
+ */
+void Renderer::markDamaged(Element *e)
+{
+    if (!e->damaged) {
+        e->damaged = true;
+        m_damagedElements.add(e);
+    }
+}
+
+void Renderer::addDamage(const QRect &rect)
+{
+    if (rect.isEmpty())
+        return;
+    m_damage << rect;
+}
+
+static inline bool qsg_hasPerspective(const QMatrix4x4 &matrix)
+{
+    const float *m = matrix.constData();
+    return m[3] != 0 || m[7] != 0 || m[15] != 1;
+}
+
+/*
+ * Returns the window rect covered by \a e in device pixels, with the origin in the
+ * bottom left corner, like glScissor.
+ */
+QRect Renderer::elementWindowRect(Element *e)
+{
+    const QSGGeometry *g = e->node->geometry();
+    if (!g || g->vertexCount() == 0)
+        return QRect();
+
+    const QRect window(QPoint(0, 0), deviceRect().size());
+
+    e->ensureBoundsValid();
+    if (e->boundsOutsideFloatRange)
+        return window;
+
+    QMatrix4x4 m = projectionMatrix();
+    if (e->root)
+        m *= qsg_matrixForRoot(e->root);
+    if (qsg_hasPerspective(m) || qsg_hasPerspective(*e->node->matrix()))
+        return window;
+
+    Rect r = e->bounds;
+    r.map(m);
+
+    // Pad by a pixel to cover antialiasing and rounding in the rasterizer.
+    const qreal w = window.width() * qreal(0.5);
+    const qreal h = window.height() * qreal(0.5);
+    const int x1 = qFloor((r.tl.x + 1) * w) - 1;
+    const int y1 = qFloor((r.tl.y + 1) * h) - 1;
+    const int x2 = qCeil((r.br.x + 1) * w) + 1;
+    const int y2 = qCeil((r.br.y + 1) * h) + 1;
+    return QRect(x1, y1, x2 - x1, y2 - y1) & window;
+}
+
+/*
+ * The area a clip list restricts drawing to, in normalized device
+ * coordinates. Clips which are not rectangles are ignored and rotated
+ * rectangles contribute their bounding box, in which case the result is
+ * larger than the actual clip and false is returned.
+ */
+static bool qsg_clipBounds(const QSGClipNode *clip, const QMatrix4x4 &projection, Rect *bounds)
+{
+    bool exact = true;
+    bounds->set(-1, -1, 1, 1);
+    while (clip) {
+        QMatrix4x4 m = projection;
+        if (clip->matrix())
+            m *= *clip->matrix();
+        if (clip->isRectangular() && !qsg_hasPerspective(m)) {
+            const QRectF r = clip->clipRect();
+            Rect c;
+            c.set(r.left(), r.top(), r.right(), r.bottom());
+            c.map(m);
+            *bounds &= c;
+            exact &= qFuzzyIsNull(m(0, 1)) && qFuzzyIsNull(m(1, 0));
+        } else {
+            exact = false;
+        }
+        clip = clip->clipList();
+    }
+    return exact;
+}
+
+static inline bool qsg_isCullable(QSGGeometryNode *gn)
+{
+    // Positions may be changed by a custom vertex shader, and points can be any size
+    return (gn->activeMaterial()->flags() & (QSGMaterial::CustomCompileStep | QSGMaterial_FullMatrix)) == 0
+            && gn->geometry()->drawingMode() != GL_POINTS;
+}
+
+/*
+ * Computes the bounds of the batch in normalized device coordinates and the
+ * highest render order in it. Returns false if the bounds are unknown.
+ */
+bool Renderer::batchBounds(Batch *b, Rect *bounds, int *lastOrder)
+{
+    Rect r;
+    r.set(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+    int order = -1;
+    for (Element *e = b->first; e; e = e->nextInBatch) {
+        if (e->removed)
+            continue;
+        e->ensureBoundsValid();
+        if (e->boundsOutsideFloatRange || qsg_hasPerspective(*e->node->matrix()))
+            return false;
+        r |= e->bounds;
+        order = qMax(order, e->order);
+    }
+    if (order < 0)
+        return false;
+
+    QMatrix4x4 m = projectionMatrix();
+    if (b->root)
+        m *= qsg_matrixForRoot(b->root);
+    if (qsg_hasPerspective(m))
+        return false;
+    r.map(m);
+
+    // Lines are wider than their bounds, pad by the line width plus a pixel
+    // for antialiasing and rounding.
+    const QRect viewport = viewportRect();
+    const float pad = b->first->node->geometry()->lineWidth() + 1;
+    const float padX = 2 * pad / qMax(1, viewport.width());
+    const float padY = 2 * pad / qMax(1, viewport.height());
+    r.tl.x -= padX;
+    r.tl.y -= padY;
+    r.br.x += padX;
+    r.br.y += padY;
+
+    *bounds = r;
+    *lastOrder = order;
+    return true;
+}
+
+/*
+ * Finds the largest opaque elements which are axis aligned rectangles, in
+ * front of which nothing behind needs to be drawn.
+ */
+void Renderer::collectOccluders()
+{
+    m_occluderCount = 0;
+    if (!m_occlusionCulling || !m_useDepthBuffer)
+        return;
+
+    // Too small to be worth testing against
+    const float minimumArea = 4.0f / 64;
+    const QMatrix4x4 projection = projectionMatrix();
+
+    for (int i=0; i<m_opaqueRenderList.size(); ++i) {
+        Element *e = m_opaqueRenderList.at(i);
+        if (!e || e->removed)
+            continue;
+        QSGGeometryNode *gn = e->node;
+        const QSGGeometry *g = gn->geometry();
+        if (g->drawingMode() != GL_TRIANGLE_STRIP || g->vertexCount() != 4 || g->indexCount() != 0
+                || g->attributeCount() < 1 || g->attributes()[0].type != GL_FLOAT
+                || g->attributes()[0].tupleSize != 2 || !qsg_isCullable(gn)) {
+            continue;
+        }
+
+        // The strip must be laid out like QSGGeometry::updateRectGeometry() does
+        const int stride = g->sizeOfVertex();
+        const char *v = (const char *) g->vertexData();
+        const float *p0 = (const float *) v;
+        const float *p1 = (const float *) (v + stride);
+        const float *p2 = (const float *) (v + 2 * stride);
+        const float *p3 = (const float *) (v + 3 * stride);
+        if (p0[0] != p1[0] || p2[0] != p3[0] || p0[1] != p2[1] || p1[1] != p3[1])
+            continue;
+
+        QMatrix4x4 m = projection;
+        if (e->root)
+            m *= qsg_matrixForRoot(e->root);
+        m *= *gn->matrix();
+        if (qsg_hasPerspective(m) || !qFuzzyIsNull(m(0, 1)) || !qFuzzyIsNull(m(1, 0)))
+            continue;
+
+        Rect r;
+        r.set(qMin(p0[0], p2[0]), qMin(p0[1], p1[1]), qMax(p0[0], p2[0]), qMax(p0[1], p1[1]));
+        r.map(m);
+        Rect clip;
+        if (!qsg_clipBounds(gn->clipList(), projection, &clip))
+            continue;
+        r &= clip;
+        if (r.isEmpty())
+            continue;
+
+        // Keep the largest ones, sorted by decreasing area
+        const float area = (r.br.x - r.tl.x) * (r.br.y - r.tl.y);
+        if (area < minimumArea)
+            continue;
+        int pos = m_occluderCount;
+        while (pos > 0) {
+            const Rect &o = m_occluders[pos - 1].rect;
+            if ((o.br.x - o.tl.x) * (o.br.y - o.tl.y) >= area)
+                break;
+            --pos;
+        }
+        if (pos == MaxOccluders)
+            continue;
+        const int last = qMin(m_occluderCount, int(MaxOccluders) - 1);
+        for (int j=last; j>pos; --j)
+            m_occluders[j] = m_occluders[j - 1];
+        m_occluders[pos].rect = r;
+        m_occluders[pos].order = e->order;
+        m_occluderCount = qMin(m_occluderCount + 1, int(MaxOccluders));
+    }
+}
+
+/*
+ * Marks the batches which are outside their clip and the viewport, or
+ * completely behind an occluder, so that they are neither uploaded nor drawn.
+ */
+void Renderer::cullBatches(QDataBuffer<Batch *> *batches)
+{
+    for (int i=0; i<batches->size(); ++i) {
+        Batch *b = batches->at(i);
+        b->culled = false;
+        if (!b->first || b->isRenderNode || Q_UNLIKELY(debug_noculling()) || m_visualizeMode != VisualizeNothing)
+            continue;
+
+        QSGGeometryNode *gn = b->first->node;
+        if (!gn || !qsg_isCullable(gn))
+            continue;
+
+        Rect bounds;
+        int lastOrder;
+        if (!batchBounds(b, &bounds, &lastOrder))
+            continue;
+
+        Rect clip;
+        qsg_clipBounds(gn->clipList(), projectionMatrix(), &clip);
+        bounds &= clip;
+        if (bounds.tl.x > bounds.br.x || bounds.tl.y > bounds.br.y) {
+            b->culled = true;
+            ++m_viewportCulledBatches;
+            continue;
+        }
+
+        for (int j=0; j<m_occluderCount; ++j) {
+            const Occluder &o = m_occluders[j];
+            if (o.order > lastOrder && o.rect.contains(bounds)) {
+                b->culled = true;
+                ++m_occlusionCulledBatches;
+                break;
+            }
+        }
+    }
+}
+
+void Renderer::updateDamage()
+{
+    const bool enabled = isBufferPreserved()
+            && (clearMode() & ClearColorBuffer)
+            && viewportRect() == deviceRect()
+            && m_renderNodeElements.isEmpty()
+            && m_visualizeMode == VisualizeNothing;
+
+    bool full = !enabled
+            || !m_damageTracked
+            || m_fullDamage
+            || m_buffer_contents_lost
+            || deviceRect() != m_lastDeviceRect
+            || projectionMatrix() != m_lastProjectionMatrix
+            || clearColor() != m_lastClearColor;
+
+    for (int i=0; i<m_damagedElements.size(); ++i) {
+        Element *e = m_damagedElements.at(i);
+        e->damaged = false;
+        if (full || e->removed)
+            continue;
+        addDamage(e->renderedRect);
+        e->renderedRect = elementWindowRect(e);
+        addDamage(e->renderedRect);
+    }
+    m_damagedElements.reset();
+
+    const QRect window(QPoint(0, 0), deviceRect().size());
+    m_damageBounds = QRect();
+    for (int i=0; i<m_damage.size(); ++i)
+        m_damageBounds |= m_damage.at(i);
+    m_damageBounds &= window;
+    if (m_damageBounds == window)
+        full = true;
+
+    m_partialUpdate = !full;
+    m_damageTracked = enabled;
+    m_fullDamage = false;
+    m_lastDeviceRect = deviceRect();
+    m_lastProjectionMatrix = projectionMatrix();
+    m_lastClearColor = clearColor();
+
+    if (Q_UNLIKELY(debug_render())) {
+        if (m_partialUpdate)
+            qDebug() << " -> partial update:" << m_damageBounds << "in" << m_damage.size() << "rects";
+        else
+            qDebug() << " -> full update";
+    }
+
+    m_damage.clear();
+}
+
+void Renderer::updateRenderedRects(const QDataBuffer<Element *> &renderList)
+{
+    for (int i=0; i<renderList.size(); ++i) {
+        Element *e = renderList.at(i);
+        if (e && !e->removed && !e->isRenderNode)
+            e->renderedRect = elementWindowRect(e);
+    }
+}
+
+bool Renderer::batchIntersectsDamage(const Batch *batch) const
+{
+    for (Element *e = batch->first; e; e = e->nextInBatch) {
+        if (!e->removed && e->renderedRect.intersects(m_damageBounds))
+            return true;
+    }
+    return false;
+}
+
+void Renderer::resetScissor()
+{
+    if (m_partialUpdate) {
+        glEnable(GL_SCISSOR_TEST);
+        glScissor(m_damageBounds.x(), m_damageBounds.y(), m_damageBounds.width(), m_damageBounds.height());
+    } else {
+        glDisable(GL_SCISSOR_TEST);
+    }
+}
+
 void Renderer::renderBatches()
 {
     if (Q_UNLIKELY(debug_render())) {
@@ -2468,7 +3481,7 @@ void Renderer::renderBatches()
     }
     glDisable(GL_CULL_FACE);
     glColorMask(true, true, true, true);
-    glDisable(GL_SCISSOR_TEST);
+    resetScissor();
     glDisable(GL_STENCIL_TEST);
 
     bindable()->clear(clearMode());
@@ -2485,6 +3498,8 @@ void Renderer::renderBatches()
     if (Q_LIKELY(renderOpaque)) {
         for (int i=0; i<m_opaqueBatches.size(); ++i) {
             Batch *b = m_opaqueBatches.at(i);
+            if (b->culled || (m_partialUpdate && !batchIntersectsDamage(b)))
+                continue;
             if (b->merged)
                 renderMergedBatch(b);
             else
@@ -2500,6 +3515,8 @@ void Renderer::renderBatches()
     if (Q_LIKELY(renderAlpha)) {
         for (int i=0; i<m_alphaBatches.size(); ++i) {
             Batch *b = m_alphaBatches.at(i);
+            if (b->culled || (m_partialUpdate && !batchIntersectsDamage(b)))
+                continue;
             if (b->merged)
                 renderMergedBatch(b);
             else if (b->isRenderNode)
@@ -2512,6 +3529,8 @@ void Renderer::renderBatches()
     if (m_currentShader)
         setActiveShader(0, 0);
     updateStencilClip(0);
+    if (m_partialUpdate)
+        glDisable(GL_SCISSOR_TEST);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
     glDepthMask(true);
@@ -2580,6 +3599,9 @@ void Renderer::render()
     if (m_vao)
         m_vao->bind();
 
+    // Must happen before deleteRemovedElements() as it touches the damaged elements.
+    updateDamage();
+
     if (m_rebuild & (BuildRenderLists | BuildRenderListsForTaggedRoots)) {
         bool complete = (m_rebuild & BuildRenderLists) != 0;
         if (complete)
@@ -2643,6 +3665,12 @@ void Renderer::render()
 
     deleteRemovedElements();
 
+    // After a full update, remember where everything went so the next frame can be partial.
+    if (m_damageTracked && !m_partialUpdate) {
+        updateRenderedRects(m_opaqueRenderList);
+        updateRenderedRects(m_alphaRenderList);
+    }
+
     if (m_rebuild != 0) {
         // Then sort opaque batches so that we're drawing the batches with the highest
         // order first, maximizing the benefit of front-to-back z-ordering.
@@ -2658,6 +3686,20 @@ void Renderer::render()
 
     if (Q_UNLIKELY(debug_render())) timeSorting = timer.restart();
 
+    m_viewportCulledBatches = 0;
+    m_occlusionCulledBatches = 0;
+    collectOccluders();
+    cullBatches(&m_opaqueBatches);
+    cullBatches(&m_alphaBatches);
+    qCDebug(QSG_LOG_TIME_RENDERER, "culled batches: viewport=%d, occlusion=%d, batches=%d",
+            m_viewportCulledBatches, m_occlusionCulledBatches,
+            m_opaqueBatches.size() + m_alphaBatches.size());
+
+    m_vertexHeap.beginFrame();
+#ifdef QSG_SEPARATE_INDEX_BUFFER
+    m_indexHeap.beginFrame();
+#endif
+
     int largestVBO = 0;
 #ifdef QSG_SEPARATE_INDEX_BUFFER
     int largestIBO = 0;
@@ -2670,7 +3712,8 @@ void Renderer::render()
 #ifdef QSG_SEPARATE_INDEX_BUFFER
         largestIBO = qMax(b->ibo.size, largestIBO);
 #endif
-        uploadBatch(b);
+        if (!b->culled)
+            uploadBatch(b);
     }
     if (Q_UNLIKELY(debug_render())) timeUploadOpaque = timer.restart();
 
@@ -2678,7 +3721,8 @@ void Renderer::render()
     if (Q_UNLIKELY(debug_upload())) qDebug() << "Uploading Alpha Batches:";
     for (int i=0; i<m_alphaBatches.size(); ++i) {
         Batch *b = m_alphaBatches.at(i);
-        uploadBatch(b);
+        if (!b->culled)
+            uploadBatch(b);
         largestVBO = qMax(b->vbo.size, largestVBO);
 #ifdef QSG_SEPARATE_INDEX_BUFFER
         largestIBO = qMax(b->ibo.size, largestIBO);
@@ -2870,12 +3914,12 @@ void Renderer::visualizeBatch(Batch *b)
         shader->setUniformValue(shader->matrix, matrix);
         for (int ds=0; ds<b->drawSets.size(); ++ds) {
             const DrawSet &set = b->drawSets.at(ds);
-            glVertexAttribPointer(a.position, 2, a.type, false, g->sizeOfVertex(), (void *) (qintptr) (set.vertices));
-            glDrawElements(g->drawingMode(), set.indexCount, GL_UNSIGNED_SHORT, (void *) (qintptr) (b->vbo.data + set.indices));
+            glVertexAttribPointer(a.position, 2, a.type, false, g->sizeOfVertex(), (void *) (qintptr) (b->vbo.offset + set.vertices));
+            glDrawElements(g->drawingMode(), set.indexCount, GL_UNSIGNED_SHORT, (void *) (qintptr) (b->vbo.data + b->vbo.offset + set.indices));
         }
     } else {
         Element *e = b->first;
-        int offset = 0;
+        int offset = b->vbo.offset;
         while (e) {
             gn = e->node;
             g = gn->geometry();
@@ -45,6 +45,7 @@
 QT_BEGIN_NAMESPACE
 
 class QOpenGLVertexArrayObject;
+class QThreadPool;
 
 namespace QSGBatchRenderer
 {
@@ -233,12 +234,31 @@ struct Rect {
         br.set(right, bottom);
     }
 
+    void operator &= (const Rect &r) {
+        if (r.tl.x > tl.x)
+            tl.x = r.tl.x;
+        if (r.tl.y > tl.y)
+            tl.y = r.tl.y;
+        if (r.br.x < br.x)
+            br.x = r.br.x;
+        if (r.br.y < br.y)
+            br.y = r.br.y;
+    }
+
     bool intersects(const Rect &r) {
         bool xOverlap = r.tl.x < br.x && r.br.x > tl.x;
         bool yOverlap = r.tl.y < br.y && r.br.y > tl.y;
         return xOverlap && yOverlap;
     }
 
+    bool contains(const Rect &r) const {
+        return r.tl.x >= tl.x && r.br.x <= br.x && r.tl.y >= tl.y && r.br.y <= br.y;
+    }
+
+    bool isEmpty() const {
+        return tl.x >= br.x || tl.y >= br.y;
+    }
+
     bool isOutsideFloatRange() const {
         return tl.x < -QSG_RENDERER_COORD_LIMIT
                 || tl.y < -QSG_RENDERER_COORD_LIMIT
@@ -252,14 +272,105 @@ inline QDebug operator << (QDebug d, const Rect &r) {
     return d;
 }
 
+enum BufferStorage {
+    DedicatedStorage,   // A buffer object of its own
+    HeapStorage,        // A range in one of the BufferHeap's pages
+    StreamStorage       // A range in the BufferHeap's streaming ring
+};
+
 struct Buffer {
     GLuint id;
     int size;
+    // Where the data starts in 'id', only non-zero for heap and stream storage.
+    int offset;
+    // Size of the range reserved in 'id', only used for heap and stream storage.
+    int capacity;
+    int storage;
+    // BufferHeap frame in which the data was last written
+    int frame;
     // Data is only valid while preparing the upload. Exception is if we are using the
     // broken IBO workaround or we are using a visualization mode.
     char *data;
 };
 
+/*
+ * Renderer wide storage for vertex and index data. Batches get a range
+ * sub-allocated from one of a few large buffer objects, instead of a buffer
+ * object each. A batch which is uploaded again gets a new range; the old one
+ * is only reused StreamFrames frames later, so that writing never has to wait
+ * for the GPU to finish a frame which is still in flight.
+ *
+ * Batches which are uploaded every frame are placed in a streaming ring
+ * instead, which has one buffer object per frame in flight and where
+ * allocation is just bumping an offset.
+ *
+ * Partial updates go through relocate(), which moves a range to a fresh one
+ * with a GPU side copy, so the elements can then be rewritten without
+ * touching data an earlier frame reads.
+ */
+class BufferHeap
+{
+public:
+    enum { StreamFrames = 3 };
+
+    BufferHeap(GLenum target);
+
+    void initialize(QOpenGLFunctions *funcs, GLenum usage, int pageSize);
+    void destroy();
+
+    void beginFrame();
+    void upload(Buffer *buffer, bool streaming);
+    void release(Buffer *buffer);
+    bool relocate(Buffer *buffer);
+
+    bool canRelocate() const { return m_copyBufferSubData != 0; }
+    int frame() const { return m_frame; }
+    int pageCount() const { return m_pages.size(); }
+
+private:
+    struct Range {
+        int offset;
+        int size;
+    };
+
+    struct Page {
+        GLuint id;
+        int size;
+        int used;
+        QVector<Range> freeRanges;
+    };
+
+    struct RetiredRange {
+        GLuint id;
+        int offset;
+        int size;
+        int frame;
+    };
+
+    bool stream(Buffer *buffer, int size);
+    void allocate(Buffer *buffer, int size);
+    void freeRange(GLuint id, int offset, int size);
+
+    typedef void (QOPENGLF_APIENTRYP CopyBufferSubData)(GLenum readTarget, GLenum writeTarget,
+                                                         GLintptr readOffset, GLintptr writeOffset,
+                                                         GLsizeiptr size);
+
+    QOpenGLFunctions *m_funcs;
+    CopyBufferSubData m_copyBufferSubData;
+    GLenum m_target;
+    GLenum m_usage;
+    int m_pageSize;
+    int m_frame;
+
+    QVector<Page> m_pages;
+    QVector<RetiredRange> m_retired;
+
+    GLuint m_streamBuffers[StreamFrames];
+    int m_streamSizes[StreamFrames];
+    int m_streamUsed;
+    int m_streamPeak;
+};
+
 struct Element {
 
     Element()
@@ -275,6 +386,13 @@ struct Element {
         , orphaned(false)
         , isRenderNode(false)
         , isMaterialBlended(false)
+        , damaged(false)
+        , needsUpload(false)
+        , vertexOffset(0)
+        , indexOffset(0)
+        , uploadedVertexCount(0)
+        , uploadedIndexCount(0)
+        , uploadedIndexBase(0)
     {
     }
 
@@ -295,6 +413,7 @@ struct Element {
     Node *root;
 
     Rect bounds; // in device coordinates
+    QRect renderedRect; // in window coordinates, where the element was last drawn
 
     int order;
 
@@ -305,6 +424,16 @@ struct Element {
     uint orphaned : 1;
     uint isRenderNode : 1;
     uint isMaterialBlended : 1;
+    uint damaged : 1;
+    uint needsUpload : 1;
+
+    // Where the element was put in its merged batch's buffers by the last
+    // full upload, so that it can be rewritten on its own.
+    int vertexOffset;
+    int indexOffset;
+    int uploadedVertexCount;
+    int uploadedIndexCount;
+    quint16 uploadedIndexBase;
 };
 
 struct RenderNodeElement : public Element {
@@ -348,6 +477,17 @@ struct DrawSet
     int indexCount;
 };
 
+// Where one element of a merged batch goes in the upload buffer. Laid out up
+// front so that the elements can be transformed and copied independently.
+struct MergedUploadJob
+{
+    Element *element;
+    char *vertexData;
+    char *zData;
+    char *indexData;
+    quint16 iBase;
+};
+
 enum BatchCompatibility
 {
     BatchBreaksOnCompare,
@@ -377,6 +517,10 @@ struct Batch
         positionAttribute = -1;
         uploadedThisFrame = false;
         isRenderNode = false;
+        hasDirtyElements = false;
+        culled = false;
+        uploadFrame = -1;
+        uploadStreak = 0;
     }
 
     Element *first;
@@ -393,6 +537,12 @@ struct Batch
     uint needsUpload : 1;
     uint merged : 1;
     uint isRenderNode : 1;
+    uint hasDirtyElements : 1;
+    uint culled : 1;
+
+    // Consecutive frames in which the batch was fully uploaded
+    int uploadFrame;
+    int uploadStreak;
 
     mutable uint uploadedThisFrame : 1; // solely for debugging purposes
 
@@ -503,8 +653,11 @@ public Q_SLOTS:
     void invalidated();
 
 public:
+    static ShaderManager *forContext(QSGRenderContext *ctx);
+
     Shader *prepareMaterial(QSGMaterial *material);
     Shader *prepareMaterialNoRewrite(QSGMaterial *material);
+    void precompile(QSGMaterial *material);
 
     QHash<QSGMaterialType *, Shader *> rewrittenShaders;
     QHash<QSGMaterialType *, Shader *> stockShaders;
@@ -549,9 +702,13 @@ private:
     };
 
     friend class Updater;
+    friend class MergedUploadTask;
 
     void map(Buffer *buffer, int size, bool isIndexBuf = false);
-    void unmap(Buffer *buffer, bool isIndexBuf = false);
+    void unmap(Buffer *buffer, bool isIndexBuf = false, bool streaming = false);
+    bool useBufferHeap() const;
+    void markForUpload(Element *e);
+    bool uploadDirtyElements(Batch *b);
 
     void buildRenderListsFromScratch();
     void buildRenderListsForTaggedRoots();
@@ -561,12 +718,26 @@ private:
     void deleteRemovedElements();
     void cleanupBatches(QDataBuffer<Batch *> *batches);
     void prepareOpaqueBatches();
-    bool checkOverlap(int first, int last, const Rect &bounds);
     void prepareAlphaBatches();
     void invalidateBatchAndOverlappingRenderOrders(Batch *batch);
 
     void uploadBatch(Batch *b);
     void uploadMergedElement(Element *e, int vaOffset, char **vertexData, char **zData, char **indexData, quint16 *iBase, int *indexCount);
+    void uploadMergedElements(const MergedUploadJob *jobs, int count, int vaOffset);
+    void runUploadJobs(int vaOffset);
+    static QThreadPool *uploadPoolForContext(QSGRenderContext *ctx, int threads);
+
+    void markDamaged(Element *e);
+    void addDamage(const QRect &rect);
+    QRect elementWindowRect(Element *e);
+    void updateDamage();
+    void updateRenderedRects(const QDataBuffer<Element *> &renderList);
+    bool batchIntersectsDamage(const Batch *batch) const;
+    void resetScissor();
+
+    bool batchBounds(Batch *b, Rect *bounds, int *lastOrder);
+    void collectOccluders();
+    void cullBatches(QDataBuffer<Batch *> *batches);
 
     void renderBatches();
     void renderMergedBatch(const Batch *batch);
@@ -625,9 +796,19 @@ private:
     int m_renderOrderRebuildUpper;
 
     GLuint m_bufferStrategy;
+    int m_bufferHeapPageSize;
+    BufferHeap m_vertexHeap;
+#ifdef QSG_SEPARATE_INDEX_BUFFER
+    BufferHeap m_indexHeap;
+#endif
     int m_batchNodeThreshold;
     int m_batchVertexThreshold;
 
+    // Workers transforming and copying vertices of large merged batches, owned by the context
+    QThreadPool *m_uploadPool;
+    int m_uploadThreads;
+    QDataBuffer<MergedUploadJob> m_uploadJobs;
+
     // Stuff used during rendering only...
     ShaderManager *m_shaderManager;
     QSGMaterial *m_currentMaterial;
@@ -648,6 +829,29 @@ private:
     // For minimal OpenGL core profile support
     QOpenGLVertexArrayObject *m_vao;
 
+    // Damage tracking for partial updates, in window coordinates
+    QDataBuffer<Element *> m_damagedElements;
+    QVector<QRect> m_damage;
+    QRect m_damageBounds;
+    QRect m_lastDeviceRect;
+    QMatrix4x4 m_lastProjectionMatrix;
+    QColor m_lastClearColor;
+    bool m_fullDamage;
+    bool m_damageTracked;
+    bool m_partialUpdate;
+
+    // Culling of batches outside their clip or behind large opaque rectangles
+    struct Occluder {
+        Rect rect;
+        int order;
+    };
+    enum { MaxOccluders = 8 };
+    Occluder m_occluders[MaxOccluders];
+    int m_occluderCount;
+    bool m_occlusionCulling;
+    int m_viewportCulledBatches;
+    int m_occlusionCulledBatches;
+
     QHash<Node *, uint> m_visualizeChanceSet;
     VisualizeMode m_visualizeMode;
 
@@ -35,6 +35,7 @@
 #include "qsgrenderer_p.h"
 #include "qsgmaterialshader_p.h"
 #include <private/qsgshadersourcebuilder_p.h>
+#include <private/qsgshadercache_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -340,16 +341,15 @@ void QSGMaterialShader::setShaderSourceFiles(QOpenGLShader::ShaderType type, con
 
     The default implementation will extract the vertexShader() and
     fragmentShader() and bind the names returned from attributeNames()
-    to consecutive vertex attribute registers starting at 0.
+    to consecutive vertex attribute registers starting at 0. Where the
+    OpenGL implementation supports program binaries, the linked program
+    is cached on disk and reused on subsequent runs.
  */
 
 void QSGMaterialShader::compile()
 {
     Q_ASSERT_X(!m_program.isLinked(), "QSGSMaterialShader::compile()", "Compile called multiple times!");
 
-    program()->addShaderFromSourceCode(QOpenGLShader::Vertex, vertexShader());
-    program()->addShaderFromSourceCode(QOpenGLShader::Fragment, fragmentShader());
-
     char const *const *attr = attributeNames();
 #ifndef QT_NO_DEBUG
     int maxVertexAttribs = 0;
@@ -373,7 +373,7 @@ void QSGMaterialShader::compile()
     }
 #endif
 
-    if (!program()->link()) {
+    if (!QSGShaderCache::link(program(), vertexShader(), fragmentShader(), attr)) {
         qWarning("QSGMaterialShader: Shader compilation failed:");
         qWarning() << program()->log();
     }
@@ -105,6 +105,8 @@ QSGRenderer::QSGRenderer(QSGRenderContext *context)
     , m_current_determinant(1)
     , m_device_pixel_ratio(1)
     , m_context(context)
+    , m_buffer_preserved(false)
+    , m_buffer_contents_lost(true)
     , m_node_updater(0)
     , m_bindable(0)
     , m_changed_emitted(false)
@@ -212,6 +214,7 @@ void QSGRenderer::renderScene(const QSGBindable &bindable)
 
     m_is_rendering = false;
     m_changed_emitted = false;
+    m_buffer_contents_lost = false;
     m_bindable = 0;
 
     qCDebug(QSG_LOG_TIME_RENDERER,
@@ -81,6 +81,12 @@ public:
 
     void clearChangedFlag() { m_changed_emitted = false; }
 
+    // Partial updates: the window tells the renderer whether the target keeps its
+    // contents between frames.
+    void setBufferPreserved(bool preserved) { m_buffer_preserved = preserved; }
+    bool isBufferPreserved() const { return m_buffer_preserved; }
+    void invalidateBufferContents() { m_buffer_contents_lost = true; }
+
 protected:
     virtual void render() = 0;
 
@@ -99,6 +105,9 @@ protected:
 
     QSGRenderContext *m_context;
 
+    uint m_buffer_preserved : 1;
+    uint m_buffer_contents_lost : 1;
+
 private:
     QSGNodeUpdater *m_node_updater;
 
@@ -0,0 +1,168 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qsgvertextransform_p.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+QT_BEGIN_NAMESPACE
+
+static void qsg_translate_scalar(char *vertices, int count, int stride, float dx, float dy)
+{
+    for (int i=0; i<count; ++i) {
+        float *p = (float *) vertices;
+        p[0] += dx;
+        p[1] += dy;
+        vertices += stride;
+    }
+}
+
+static void qsg_map_scalar(char *vertices, int count, int stride, const float *m)
+{
+    for (int i=0; i<count; ++i) {
+        float *p = (float *) vertices;
+        const float x = p[0];
+        const float y = p[1];
+        p[0] = x * m[0] + y * m[4] + m[12];
+        p[1] = x * m[1] + y * m[5] + m[13];
+        vertices += stride;
+    }
+}
+
+// Written so that NaN positions are skipped, like the comparisons in Rect.
+static void qsg_bounds_scalar(const char *vertices, int count, int stride, float *bounds)
+{
+    for (int i=0; i<count; ++i) {
+        const float *p = (const float *) vertices;
+        if (p[0] < bounds[0])
+            bounds[0] = p[0];
+        if (p[0] > bounds[2])
+            bounds[2] = p[0];
+        if (p[1] < bounds[1])
+            bounds[1] = p[1];
+        if (p[1] > bounds[3])
+            bounds[3] = p[1];
+        vertices += stride;
+    }
+}
+
+const QSGVertexKernels qsg_vertexKernels_scalar = {
+    "scalar",
+    qsg_translate_scalar,
+    qsg_map_scalar,
+    qsg_bounds_scalar
+};
+
+#ifdef __SSE2__
+
+/*
+    Two vertices are processed at a time as {x0, y0, x1, y1}. Positions are
+    strided and not necessarily aligned, so they are loaded and stored as
+    64-bit halves.
+ */
+static inline __m128 qsg_loadTwo(const char *vertices, int stride)
+{
+    __m128 p = _mm_loadl_pi(_mm_setzero_ps(), (const __m64 *) vertices);
+    return _mm_loadh_pi(p, (const __m64 *) (vertices + stride));
+}
+
+static inline void qsg_storeTwo(char *vertices, int stride, __m128 p)
+{
+    _mm_storel_pi((__m64 *) vertices, p);
+    _mm_storeh_pi((__m64 *) (vertices + stride), p);
+}
+
+static void qsg_translate_sse2(char *vertices, int count, int stride, float dx, float dy)
+{
+    const __m128 t = _mm_setr_ps(dx, dy, dx, dy);
+    int i = 0;
+    for (; i + 1 < count; i += 2) {
+        qsg_storeTwo(vertices, stride, _mm_add_ps(qsg_loadTwo(vertices, stride), t));
+        vertices += 2 * stride;
+    }
+    if (i < count)
+        qsg_translate_scalar(vertices, 1, stride, dx, dy);
+}
+
+static void qsg_map_sse2(char *vertices, int count, int stride, const float *m)
+{
+    const __m128 mx = _mm_setr_ps(m[0], m[1], m[0], m[1]);
+    const __m128 my = _mm_setr_ps(m[4], m[5], m[4], m[5]);
+    const __m128 mt = _mm_setr_ps(m[12], m[13], m[12], m[13]);
+    int i = 0;
+    for (; i + 1 < count; i += 2) {
+        const __m128 p = qsg_loadTwo(vertices, stride);
+        const __m128 xx = _mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 2, 0, 0));
+        const __m128 yy = _mm_shuffle_ps(p, p, _MM_SHUFFLE(3, 3, 1, 1));
+        const __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(xx, mx), _mm_mul_ps(yy, my)), mt);
+        qsg_storeTwo(vertices, stride, r);
+        vertices += 2 * stride;
+    }
+    if (i < count)
+        qsg_map_scalar(vertices, 1, stride, m);
+}
+
+static void qsg_bounds_sse2(const char *vertices, int count, int stride, float *bounds)
+{
+    // minps/maxps return the second operand when either is NaN, so keeping the
+    // accumulator second skips NaN positions.
+    __m128 lo = _mm_setr_ps(bounds[0], bounds[1], bounds[0], bounds[1]);
+    __m128 hi = _mm_setr_ps(bounds[2], bounds[3], bounds[2], bounds[3]);
+    int i = 0;
+    for (; i + 1 < count; i += 2) {
+        const __m128 p = qsg_loadTwo(vertices, stride);
+        lo = _mm_min_ps(p, lo);
+        hi = _mm_max_ps(p, hi);
+        vertices += 2 * stride;
+    }
+    lo = _mm_min_ps(_mm_movehl_ps(lo, lo), lo);
+    hi = _mm_max_ps(_mm_movehl_ps(hi, hi), hi);
+    _mm_storel_pi((__m64 *) bounds, lo);
+    _mm_storel_pi((__m64 *) (bounds + 2), hi);
+    if (i < count)
+        qsg_bounds_scalar(vertices, 1, stride, bounds);
+}
+
+const QSGVertexKernels qsg_vertexKernels_sse2 = {
+    "sse2",
+    qsg_translate_sse2,
+    qsg_map_sse2,
+    qsg_bounds_sse2
+};
+
+#endif // __SSE2__
+
+QT_END_NAMESPACE
@@ -0,0 +1,125 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qsgvertextransform_p.h"
+
+#ifdef QT_COMPILER_SUPPORTS_AVX2
+
+#include <immintrin.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Four vertices at a time as {x0, y0, x1, y1 | x2, y2, x3, y3}. The strided
+    positions are gathered as 64-bit halves of two 128-bit lanes; all shuffles
+    stay within a lane.
+ */
+static inline __m256 qsg_loadFour(const char *vertices, int stride)
+{
+    __m128 a = _mm_loadl_pi(_mm_setzero_ps(), (const __m64 *) vertices);
+    a = _mm_loadh_pi(a, (const __m64 *) (vertices + stride));
+    __m128 b = _mm_loadl_pi(_mm_setzero_ps(), (const __m64 *) (vertices + 2 * stride));
+    b = _mm_loadh_pi(b, (const __m64 *) (vertices + 3 * stride));
+    return _mm256_insertf128_ps(_mm256_castps128_ps256(a), b, 1);
+}
+
+static inline void qsg_storeFour(char *vertices, int stride, __m256 p)
+{
+    const __m128 a = _mm256_castps256_ps128(p);
+    const __m128 b = _mm256_extractf128_ps(p, 1);
+    _mm_storel_pi((__m64 *) vertices, a);
+    _mm_storeh_pi((__m64 *) (vertices + stride), a);
+    _mm_storel_pi((__m64 *) (vertices + 2 * stride), b);
+    _mm_storeh_pi((__m64 *) (vertices + 3 * stride), b);
+}
+
+static void qsg_translate_avx2(char *vertices, int count, int stride, float dx, float dy)
+{
+    const __m256 t = _mm256_setr_ps(dx, dy, dx, dy, dx, dy, dx, dy);
+    int i = 0;
+    for (; i + 3 < count; i += 4) {
+        qsg_storeFour(vertices, stride, _mm256_add_ps(qsg_loadFour(vertices, stride), t));
+        vertices += 4 * stride;
+    }
+    qsg_vertexKernels_scalar.translate(vertices, count - i, stride, dx, dy);
+}
+
+static void qsg_map_avx2(char *vertices, int count, int stride, const float *m)
+{
+    const __m256 mx = _mm256_setr_ps(m[0], m[1], m[0], m[1], m[0], m[1], m[0], m[1]);
+    const __m256 my = _mm256_setr_ps(m[4], m[5], m[4], m[5], m[4], m[5], m[4], m[5]);
+    const __m256 mt = _mm256_setr_ps(m[12], m[13], m[12], m[13], m[12], m[13], m[12], m[13]);
+    int i = 0;
+    for (; i + 3 < count; i += 4) {
+        const __m256 p = qsg_loadFour(vertices, stride);
+        const __m256 xx = _mm256_shuffle_ps(p, p, _MM_SHUFFLE(2, 2, 0, 0));
+        const __m256 yy = _mm256_shuffle_ps(p, p, _MM_SHUFFLE(3, 3, 1, 1));
+        const __m256 r = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(xx, mx), _mm256_mul_ps(yy, my)), mt);
+        qsg_storeFour(vertices, stride, r);
+        vertices += 4 * stride;
+    }
+    qsg_vertexKernels_scalar.map(vertices, count - i, stride, m);
+}
+
+static void qsg_bounds_avx2(const char *vertices, int count, int stride, float *bounds)
+{
+    // Accumulators second, so NaN positions are skipped as in the SSE2 version.
+    __m256 lo = _mm256_setr_ps(bounds[0], bounds[1], bounds[0], bounds[1], bounds[0], bounds[1], bounds[0], bounds[1]);
+    __m256 hi = _mm256_setr_ps(bounds[2], bounds[3], bounds[2], bounds[3], bounds[2], bounds[3], bounds[2], bounds[3]);
+    int i = 0;
+    for (; i + 3 < count; i += 4) {
+        const __m256 p = qsg_loadFour(vertices, stride);
+        lo = _mm256_min_ps(p, lo);
+        hi = _mm256_max_ps(p, hi);
+        vertices += 4 * stride;
+    }
+    __m128 lo4 = _mm_min_ps(_mm256_extractf128_ps(lo, 1), _mm256_castps256_ps128(lo));
+    __m128 hi4 = _mm_max_ps(_mm256_extractf128_ps(hi, 1), _mm256_castps256_ps128(hi));
+    lo4 = _mm_min_ps(_mm_movehl_ps(lo4, lo4), lo4);
+    hi4 = _mm_max_ps(_mm_movehl_ps(hi4, hi4), hi4);
+    _mm_storel_pi((__m64 *) bounds, lo4);
+    _mm_storel_pi((__m64 *) (bounds + 2), hi4);
+    qsg_vertexKernels_scalar.bounds(vertices, count - i, stride, bounds);
+}
+
+const QSGVertexKernels qsg_vertexKernels_avx2 = {
+    "avx2",
+    qsg_translate_avx2,
+    qsg_map_avx2,
+    qsg_bounds_avx2
+};
+
+QT_END_NAMESPACE
+
+#endif // QT_COMPILER_SUPPORTS_AVX2
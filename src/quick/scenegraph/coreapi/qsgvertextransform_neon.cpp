@@ -0,0 +1,117 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qsgvertextransform_p.h"
+
+#ifdef QT_COMPILER_SUPPORTS_NEON
+
+#include <arm_neon.h>
+
+QT_BEGIN_NAMESPACE
+
+// Two vertices at a time as {x0, y0, x1, y1}, see the SSE2 version.
+static inline float32x4_t qsg_loadTwo(const char *vertices, int stride)
+{
+    return vcombine_f32(vld1_f32((const float *) vertices), vld1_f32((const float *) (vertices + stride)));
+}
+
+static inline void qsg_storeTwo(char *vertices, int stride, float32x4_t p)
+{
+    vst1_f32((float *) vertices, vget_low_f32(p));
+    vst1_f32((float *) (vertices + stride), vget_high_f32(p));
+}
+
+static void qsg_translate_neon(char *vertices, int count, int stride, float dx, float dy)
+{
+    const float tv[4] = { dx, dy, dx, dy };
+    const float32x4_t t = vld1q_f32(tv);
+    int i = 0;
+    for (; i + 1 < count; i += 2) {
+        qsg_storeTwo(vertices, stride, vaddq_f32(qsg_loadTwo(vertices, stride), t));
+        vertices += 2 * stride;
+    }
+    qsg_vertexKernels_scalar.translate(vertices, count - i, stride, dx, dy);
+}
+
+static void qsg_map_neon(char *vertices, int count, int stride, const float *m)
+{
+    const float mxv[4] = { m[0], m[1], m[0], m[1] };
+    const float myv[4] = { m[4], m[5], m[4], m[5] };
+    const float mtv[4] = { m[12], m[13], m[12], m[13] };
+    const float32x4_t mx = vld1q_f32(mxv);
+    const float32x4_t my = vld1q_f32(myv);
+    const float32x4_t mt = vld1q_f32(mtv);
+    int i = 0;
+    for (; i + 1 < count; i += 2) {
+        const float32x4_t p = qsg_loadTwo(vertices, stride);
+        // {x0, x0, x1, x1} and {y0, y0, y1, y1}
+        const float32x4x2_t xy = vtrnq_f32(p, p);
+        const float32x4_t r = vaddq_f32(vaddq_f32(vmulq_f32(xy.val[0], mx), vmulq_f32(xy.val[1], my)), mt);
+        qsg_storeTwo(vertices, stride, r);
+        vertices += 2 * stride;
+    }
+    qsg_vertexKernels_scalar.map(vertices, count - i, stride, m);
+}
+
+// Unlike SSE, vmin/vmax propagate NaN. A NaN position therefore makes the
+// bounds unbounded, which is safe as the renderer treats such elements as
+// overlapping everything.
+static void qsg_bounds_neon(const char *vertices, int count, int stride, float *bounds)
+{
+    const float lov[4] = { bounds[0], bounds[1], bounds[0], bounds[1] };
+    const float hiv[4] = { bounds[2], bounds[3], bounds[2], bounds[3] };
+    float32x4_t lo = vld1q_f32(lov);
+    float32x4_t hi = vld1q_f32(hiv);
+    int i = 0;
+    for (; i + 1 < count; i += 2) {
+        const float32x4_t p = qsg_loadTwo(vertices, stride);
+        lo = vminq_f32(p, lo);
+        hi = vmaxq_f32(p, hi);
+        vertices += 2 * stride;
+    }
+    vst1_f32(bounds, vmin_f32(vget_low_f32(lo), vget_high_f32(lo)));
+    vst1_f32(bounds + 2, vmax_f32(vget_low_f32(hi), vget_high_f32(hi)));
+    qsg_vertexKernels_scalar.bounds(vertices, count - i, stride, bounds);
+}
+
+const QSGVertexKernels qsg_vertexKernels_neon = {
+    "neon",
+    qsg_translate_neon,
+    qsg_map_neon,
+    qsg_bounds_neon
+};
+
+QT_END_NAMESPACE
+
+#endif // QT_COMPILER_SUPPORTS_NEON
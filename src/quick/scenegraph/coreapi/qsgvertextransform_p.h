@@ -0,0 +1,89 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QSGVERTEXTRANSFORM_P_H
+#define QSGVERTEXTRANSFORM_P_H
+
+#include <QtQuick/qtquickglobal.h>
+#include <QtCore/private/qsimd_p.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Kernels for the per vertex work of merging geometry in the batch renderer.
+    They operate on the two float x/y position found at the start of every
+    \a stride bytes of \a vertices, and leave the rest of the vertex alone.
+    Matrices are column major 4x4, of which only the 2D affine part is used.
+ */
+struct QSGVertexKernels
+{
+    const char *name;
+    void (*translate)(char *vertices, int count, int stride, float dx, float dy);
+    void (*map)(char *vertices, int count, int stride, const float *matrix);
+    // Grows the {left, top, right, bottom} rect in \a bounds to contain all positions.
+    void (*bounds)(const char *vertices, int count, int stride, float *bounds);
+};
+
+extern Q_QUICK_PRIVATE_EXPORT const QSGVertexKernels qsg_vertexKernels_scalar;
+#ifdef __SSE2__
+extern Q_QUICK_PRIVATE_EXPORT const QSGVertexKernels qsg_vertexKernels_sse2;
+#endif
+#ifdef QT_COMPILER_SUPPORTS_AVX2
+extern Q_QUICK_PRIVATE_EXPORT const QSGVertexKernels qsg_vertexKernels_avx2;
+#endif
+#ifdef QT_COMPILER_SUPPORTS_NEON
+extern Q_QUICK_PRIVATE_EXPORT const QSGVertexKernels qsg_vertexKernels_neon;
+#endif
+
+// The fastest kernels the CPU we are running on supports
+inline const QSGVertexKernels &qsg_vertexKernels()
+{
+#ifdef QT_COMPILER_SUPPORTS_AVX2
+    if (qCpuHasFeature(AVX2))
+        return qsg_vertexKernels_avx2;
+#endif
+#if defined(__SSE2__)
+    return qsg_vertexKernels_sse2;
+#else
+# ifdef QT_COMPILER_SUPPORTS_NEON
+    if (qCpuHasFeature(NEON))
+        return qsg_vertexKernels_neon;
+# endif
+    return qsg_vertexKernels_scalar;
+#endif
+}
+
+QT_END_NAMESPACE
+
+#endif // QSGVERTEXTRANSFORM_P_H
@@ -45,6 +45,7 @@
 #include <QtQuick/private/qsgatlastexture_p.h>
 #include <QtQuick/private/qsgrenderloop_p.h>
 #include <QtQuick/private/qsgdefaultlayer_p.h>
+#include <QtQuick/private/qsgshadercache_p.h>
 
 #include <QtQuick/private/qsgtexture_p.h>
 #include <QtQuick/private/qquickpixmapcache_p.h>
@@ -796,6 +797,23 @@ QSGRenderer *QSGRenderContext::createRenderer()
     return new QSGBatchRenderer::Renderer(this);
 }
 
+/*!
+    Compiles and links the shaders of \a materials ahead of their first use,
+    for instance while a splash screen is shown. Only the type of each
+    material matters, so one instance per QSGMaterialType is enough. Where
+    supported, the linked programs also end up in the shader disk cache.
+
+    This function must be called on the rendering thread with the render
+    context's OpenGL context current, for instance from a direct connection
+    to QQuickWindow::sceneGraphInitialized().
+ */
+void QSGRenderContext::precompileMaterials(const QVector<QSGMaterial *> &materials)
+{
+    QSGBatchRenderer::ShaderManager *manager = QSGBatchRenderer::ShaderManager::forContext(this);
+    for (int i = 0; i < materials.size(); ++i)
+        manager->precompile(materials.at(i));
+}
+
 QSGTexture *QSGRenderContext::textureForFactory(QQuickTextureFactory *factory, QQuickWindow *window)
 {
     if (!factory)
@@ -843,11 +861,12 @@ void QSGRenderContext::compile(QSGMaterialShader *shader, QSGMaterial *material,
                    "QSGRenderContext::compile()",
                    "materials with custom compile step cannot have custom vertex/fragment code");
         QOpenGLShaderProgram *p = shader->program();
-        p->addShaderFromSourceCode(QOpenGLShader::Vertex, vertexCode ? vertexCode : shader->vertexShader());
-        p->addShaderFromSourceCode(QOpenGLShader::Fragment, fragmentCode ? fragmentCode : shader->fragmentShader());
-        p->link();
-        if (!p->isLinked())
+        if (!QSGShaderCache::link(p,
+                                  vertexCode ? vertexCode : shader->vertexShader(),
+                                  fragmentCode ? fragmentCode : shader->fragmentShader(),
+                                  shader->attributeNames())) {
             qWarning() << "shader compilation failed:" << endl << p->log();
+        }
     } else {
         shader->compile();
     }
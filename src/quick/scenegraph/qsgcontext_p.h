@@ -113,12 +113,15 @@ public:
 
     virtual void compile(QSGMaterialShader *shader, QSGMaterial *material, const char *vertexCode = 0, const char *fragmentCode = 0);
     virtual void initialize(QSGMaterialShader *shader);
+    virtual void precompileMaterials(const QVector<QSGMaterial *> &materials);
 
     void setAttachToGLContext(bool attach);
     void registerFontengineForCleanup(QFontEngine *engine);
 
     static QSGRenderContext *from(QOpenGLContext *context);
 
+    QSGAtlasTexture::Manager *atlasManager() const { return m_atlasManager; }
+
     bool hasBrokenIndexBufferObjects() const { return m_brokenIBOs; }
     int maxTextureSize() const { return m_maxTextureSize; }
 
@@ -101,6 +101,19 @@
    windows have disabled persistency). Especially for multiprocess,
    low-end systems, this should be quite important.
 
+   ---
+
+   With QSG_RENDER_AHEAD set, the render thread picks up a sync request
+   which is already waiting when it has finished issuing the OpenGL
+   commands for a frame, but before it swaps. The commands of frame N are
+   then owned by the driver, so the nodes are free to receive the state of
+   frame N+1 and the GUI thread is released before the potentially
+   blocking swap rather than after it. At most one frame is in flight
+   this way, as the GUI thread still blocks in polishAndSync() until
+   the following frame has been issued. Until the state synced ahead has
+   been rendered, further sync requests are left in the queue, so no
+   synced frame is dropped and animations advance once per rendered frame.
+
  */
 
 QT_BEGIN_NAMESPACE
@@ -240,6 +253,24 @@ public:
         return e;
     }
 
+    bool hasSyncEvent() {
+        mutex.lock();
+        bool has = !isEmpty() && head()->type() == WM_RequestSync;
+        mutex.unlock();
+        return has;
+    }
+
+    QEvent *takeSyncEvent() {
+        mutex.lock();
+        QEvent *e = 0;
+        if (!isEmpty() && head()->type() == WM_RequestSync
+            && !static_cast<WMSyncEvent *>(head())->syncInExpose) {
+            e = dequeue();
+        }
+        mutex.unlock();
+        return e;
+    }
+
     bool hasMoreEvents() {
         mutex.lock();
         bool has = !isEmpty();
@@ -269,6 +300,8 @@ public:
         , active(false)
         , window(0)
         , stopEventProcessing(false)
+        , renderAhead(qEnvironmentVariableIntValue("QSG_RENDER_AHEAD") > 0)
+        , syncedAhead(false)
     {
 #if defined(Q_OS_QNX) && !defined(Q_OS_BLACKBERRY) && defined(Q_PROCESSOR_X86)
         // The SDP 6.6.0 x86 MESA driver requires a larger stack than the default.
@@ -290,6 +323,7 @@ public:
 
     void syncAndRender();
     void sync(bool inExpose);
+    bool syncAhead();
 
     void requestRepaint()
     {
@@ -341,6 +375,9 @@ public:
     // Local event queue stuff...
     bool stopEventProcessing;
     QSGRenderThreadEventQueue eventQueue;
+
+    bool renderAhead;
+    bool syncedAhead; // the state synced ahead of the last swap is not rendered yet
 };
 
 bool QSGRenderThread::event(QEvent *e)
@@ -358,6 +395,7 @@ bool QSGRenderThread::event(QEvent *e)
             qCDebug(QSG_LOG_RENDERLOOP) << QSG_RT_PAD << "- window removed";
             gl->doneCurrent();
             window = 0;
+            syncedAhead = false;
         }
         waitCondition.wakeOne();
         mutex.unlock();
@@ -556,6 +594,34 @@ void QSGRenderThread::sync(bool inExpose)
     }
 }
 
+/*!
+    Picks up a sync request which the GUI thread posted while the previous
+    frame was being rendered and syncs it before that frame is swapped.
+
+    Returns true if a sync was done. The render pass for the synced state
+    is then scheduled as a repaint, so the next syncAndRender() renders it
+    without waiting for the GUI.
+ */
+bool QSGRenderThread::syncAhead()
+{
+    QEvent *e = eventQueue.takeSyncEvent();
+    if (!e)
+        return false;
+
+    qCDebug(QSG_LOG_RENDERLOOP) << QSG_RT_PAD << "- sync ahead of swap";
+    event(e);
+    delete e;
+
+    syncResultedInChanges = false;
+    pendingUpdate &= ~SyncRequest;
+    sync(false);
+    if (syncResultedInChanges) {
+        pendingUpdate |= RepaintRequest;
+        syncedAhead = true;
+    }
+    return true;
+}
+
 void QSGRenderThread::syncAndRender()
 {
     bool profileFrames = QSG_LOG_TIME_RENDERLOOP().isDebugEnabled();
@@ -616,13 +682,21 @@ void QSGRenderThread::syncAndRender()
     }
     if (current) {
         d->renderSceneGraph(windowSize);
+        syncedAhead = false;
         if (profileFrames)
             renderTime = threadTimer.nsecsElapsed();
         Q_QUICK_SG_PROFILE_RECORD(QQuickProfiler::SceneGraphRenderLoopFrame);
+        // The scene graph is not touched again by this frame once the
+        // commands are issued, so a waiting GUI thread can be synced with
+        // while the swap is pending. Initial expose keeps the GUI locked
+        // until after the swap and is excluded.
+        if (renderAhead && !exposeRequested && !d->customRenderStage)
+            syncAhead();
         if (!d->customRenderStage || !d->customRenderStage->swap())
             gl->swapBuffers(window);
         d->fireFrameSwapped();
     } else {
+        syncedAhead = false;
         Q_QUICK_SG_PROFILE_SKIP(QQuickProfiler::SceneGraphRenderLoopFrame, 1);
         qCDebug(QSG_LOG_RENDERLOOP) << QSG_RT_PAD << "- window not ready, skipping render";
     }
@@ -664,6 +738,10 @@ void QSGRenderThread::processEvents()
 {
     qCDebug(QSG_LOG_RENDERLOOP) << QSG_RT_PAD << "--- begin processEvents()";
     while (eventQueue.hasMoreEvents()) {
+        // The next sync would overwrite the state synced ahead of the last
+        // swap before it is rendered, so it waits for the next iteration.
+        if (syncedAhead && eventQueue.hasSyncEvent())
+            break;
         QEvent *e = eventQueue.takeEvent(false);
         event(e);
         delete e;
@@ -16,7 +16,8 @@ HEADERS += \
     $$PWD/coreapi/qsgrenderer_p.h \
     $$PWD/coreapi/qsgrendernode_p.h \
     $$PWD/coreapi/qsggeometry_p.h \
-    $$PWD/coreapi/qsgmaterialshader_p.h
+    $$PWD/coreapi/qsgmaterialshader_p.h \
+    $$PWD/coreapi/qsgvertextransform_p.h
 
 SOURCES += \
     $$PWD/coreapi/qsgabstractrenderer.cpp \
@@ -27,12 +28,17 @@ SOURCES += \
     $$PWD/coreapi/qsgnodeupdater.cpp \
     $$PWD/coreapi/qsgrenderer.cpp \
     $$PWD/coreapi/qsgrendernode.cpp \
-    $$PWD/coreapi/qsgshaderrewriter.cpp
+    $$PWD/coreapi/qsgshaderrewriter.cpp \
+    $$PWD/coreapi/qsgvertextransform.cpp
+
+AVX2_SOURCES += $$PWD/coreapi/qsgvertextransform_avx2.cpp
+NEON_SOURCES += $$PWD/coreapi/qsgvertextransform_neon.cpp
 
 # Util API
 HEADERS += \
     $$PWD/util/qsgareaallocator_p.h \
     $$PWD/util/qsgatlastexture_p.h \
+    $$PWD/util/qsgcompressedtexture_p.h \
     $$PWD/util/qsgdepthstencilbuffer_p.h \
     $$PWD/util/qsgengine.h \
     $$PWD/util/qsgengine_p.h \
@@ -48,11 +54,13 @@ HEADERS += \
     $$PWD/util/qsgtextureprovider.h \
     $$PWD/util/qsgdefaultpainternode_p.h \
     $$PWD/util/qsgdistancefieldutil_p.h \
-    $$PWD/util/qsgshadersourcebuilder_p.h
+    $$PWD/util/qsgshadersourcebuilder_p.h \
+    $$PWD/util/qsgshadercache_p.h
 
 SOURCES += \
     $$PWD/util/qsgareaallocator.cpp \
     $$PWD/util/qsgatlastexture.cpp \
+    $$PWD/util/qsgcompressedtexture.cpp \
     $$PWD/util/qsgdepthstencilbuffer.cpp \
     $$PWD/util/qsgengine.cpp \
     $$PWD/util/qsgflatcolormaterial.cpp \
@@ -65,7 +73,8 @@ SOURCES += \
     $$PWD/util/qsgdefaultpainternode.cpp \
     $$PWD/util/qsgdistancefieldutil.cpp \
     $$PWD/util/qsgsimplematerial.cpp \
-    $$PWD/util/qsgshadersourcebuilder.cpp
+    $$PWD/util/qsgshadersourcebuilder.cpp \
+    $$PWD/util/qsgshadercache.cpp
 
 # QML / Adaptations API
 HEADERS += \
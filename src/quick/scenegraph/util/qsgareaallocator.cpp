@@ -107,6 +107,16 @@ bool QSGAreaAllocator::deallocate(const QRect &rect)
     return deallocateInNode(rect.topLeft(), m_root);
 }
 
+/*
+    Returns the area of the largest unoccupied rectangle in the allocator.
+    Compared with the total free area, this tells how fragmented the
+    allocator has become.
+ */
+int QSGAreaAllocator::largestFreeArea() const
+{
+    return largestFreeAreaInNode(QRect(QPoint(0, 0), m_size), m_root);
+}
+
 bool QSGAreaAllocator::allocateInNode(const QSize &size, QPoint &result, const QRect &currentRect, QSGAreaAllocatorNode *node)
 {
     if (size.width() > currentRect.width() || size.height() > currentRect.height())
@@ -156,6 +166,24 @@ bool QSGAreaAllocator::allocateInNode(const QSize &size, QPoint &result, const Q
     }
 }
 
+int QSGAreaAllocator::largestFreeAreaInNode(const QRect &currentRect, QSGAreaAllocatorNode *node) const
+{
+    if (node->isLeaf())
+        return node->isOccupied ? 0 : currentRect.width() * currentRect.height();
+
+    QRect leftRect = currentRect;
+    QRect rightRect = currentRect;
+    if (node->splitType == HorizontalSplit) {
+        leftRect.setHeight(node->split - leftRect.top());
+        rightRect.setTop(node->split);
+    } else {
+        leftRect.setWidth(node->split - leftRect.left());
+        rightRect.setLeft(node->split);
+    }
+    return qMax(largestFreeAreaInNode(leftRect, node->left),
+                largestFreeAreaInNode(rightRect, node->right));
+}
+
 bool QSGAreaAllocator::deallocateInNode(const QPoint &pos, QSGAreaAllocatorNode *node)
 {
     while (!node->isLeaf()) {
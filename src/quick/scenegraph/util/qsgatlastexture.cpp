@@ -70,7 +70,7 @@ static int qsg_envInt(const char *name, int defaultValue)
 }
 
 Manager::Manager()
-    : m_atlas(0)
+    : m_fallback_count(0)
 {
     QOpenGLContext *gl = QOpenGLContext::currentContext();
     Q_ASSERT(gl);
@@ -93,41 +93,125 @@ Manager::Manager()
 
     m_atlas_size_limit = qsg_envInt("QSG_ATLAS_SIZE_LIMIT", qMax(w, h) / 2);
     m_atlas_size = QSize(w, h);
+    m_max_pages = qMax(1, qsg_envInt("QSG_ATLAS_PAGES", 2));
 
-    qCDebug(QSG_LOG_INFO, "texture atlas dimensions: %dx%d", w, h);
+    qCDebug(QSG_LOG_INFO, "texture atlas dimensions: %dx%d, pages: %d", w, h, m_max_pages);
 }
 
 
 Manager::~Manager()
 {
-    Q_ASSERT(m_atlas == 0);
+    Q_ASSERT(m_atlases.isEmpty());
 }
 
 void Manager::invalidate()
 {
-    if (m_atlas) {
-        m_atlas->invalidate();
-        m_atlas->deleteLater();
-        m_atlas = 0;
+    for (int i = 0; i < m_atlases.size(); ++i) {
+        Atlas *atlas = m_atlases.at(i);
+        atlas->invalidate();
+        atlas->deleteLater();
     }
+    m_atlases.clear();
 }
 
 QSGTexture *Manager::create(const QImage &image)
 {
     QSGTexture *t = 0;
     if (image.width() < m_atlas_size_limit && image.height() < m_atlas_size_limit) {
-        if (!m_atlas)
-            m_atlas = new Atlas(m_atlas_size);
-        t = m_atlas->create(image);
+        for (int i = 0; i < m_atlases.size() && !t; ++i) {
+            Atlas *atlas = m_atlases.at(i);
+            if (atlas->isRetired())
+                continue;
+            t = atlas->create(image);
+            if (!t)
+                maybeRetire(atlas);
+        }
+        if (!t && m_atlases.size() < m_max_pages)
+            t = addAtlas()->create(image);
+        if (!t)
+            ++m_fallback_count;
     }
     return t;
 }
 
-Atlas::Atlas(const QSize &size)
-    : m_allocator(size)
+Atlas *Manager::addAtlas()
+{
+    Atlas *atlas = new Atlas(this, m_atlas_size);
+    m_atlases << atlas;
+    qCDebug(QSG_LOG_INFO, "texture atlas page added, %d in use", m_atlases.size());
+    return atlas;
+}
+
+/*
+    Textures cannot be moved around in a page once handed out, since nodes
+    bake the normalized sub rect into their geometry. Instead, a page which
+    has enough free space but is too fragmented to hold new images is closed
+    for allocation when there is room for a fresh page. New images are then
+    packed into the fresh page and the old one is released once its last
+    texture is gone.
+ */
+void Manager::maybeRetire(Atlas *atlas)
+{
+    if (m_atlases.size() >= m_max_pages)
+        return;
+
+    const qint64 area = qint64(atlas->size().width()) * atlas->size().height();
+    if (atlas->usedArea() * 2 > area || atlas->fragmentation() < 0.5)
+        return;
+
+    atlas->retire();
+    qCDebug(QSG_LOG_INFO, "texture atlas page retired, occupancy=%d%%, fragmentation=%d%%",
+            int(atlas->usedArea() * 100 / area), int(atlas->fragmentation() * 100));
+}
+
+void Manager::atlasEmptied(Atlas *atlas)
+{
+    // Keep the first page around so that a single texture coming and going
+    // does not reallocate the whole atlas.
+    if (!atlas->isRetired() && atlas == m_atlases.first())
+        return;
+
+    m_atlases.removeOne(atlas);
+    atlas->invalidate();
+    atlas->deleteLater();
+    qCDebug(QSG_LOG_INFO, "texture atlas page released, %d in use", m_atlases.size());
+}
+
+Manager::Statistics Manager::statistics() const
+{
+    Statistics stats;
+    stats.pageCount = m_atlases.size();
+    stats.textureCount = 0;
+    stats.totalArea = 0;
+    stats.usedArea = 0;
+    stats.fallbackCount = m_fallback_count;
+
+    qint64 freeArea = 0;
+    qint64 fragmentedArea = 0;
+    for (int i = 0; i < m_atlases.size(); ++i) {
+        const Atlas *atlas = m_atlases.at(i);
+        const qint64 area = qint64(atlas->size().width()) * atlas->size().height();
+        stats.textureCount += atlas->textureCount();
+        stats.totalArea += area;
+        stats.usedArea += atlas->usedArea();
+        freeArea += area - atlas->usedArea();
+        fragmentedArea += qMax<qint64>(0, area - atlas->usedArea() - atlas->largestFreeArea());
+    }
+
+    stats.occupancy = stats.totalArea ? qreal(stats.usedArea) / stats.totalArea : 0;
+    stats.fragmentation = freeArea ? qreal(fragmentedArea) / freeArea : 0;
+    return stats;
+}
+
+Atlas::Atlas(Manager *manager, const QSize &size)
+    : m_manager(manager)
+    , m_allocator(size)
     , m_texture_id(0)
     , m_size(size)
+    , m_texture_count(0)
+    , m_used_area(0)
     , m_allocated(false)
+    , m_retired(false)
 {
 
     m_internalFormat = GL_RGBA;
@@ -181,6 +265,16 @@ void Atlas::invalidate()
     if (m_texture_id && QOpenGLContext::currentContext())
         QOpenGLContext::currentContext()->functions()->glDeleteTextures(1, &m_texture_id);
     m_texture_id = 0;
+    // Textures still alive are only removed from the allocator from now on.
+    m_manager = 0;
+}
+
+qreal Atlas::fragmentation() const
+{
+    const qint64 freeArea = qint64(m_size.width()) * m_size.height() - m_used_area;
+    if (freeArea <= 0)
+        return 0;
+    return qMax<qreal>(0, 1 - qreal(m_allocator.largestFreeArea()) / freeArea);
 }
 
 Texture *Atlas::create(const QImage &image)
@@ -190,6 +284,8 @@ Texture *Atlas::create(const QImage &image)
     if (rect.width() > 0 && rect.height() > 0) {
         Texture *t = new Texture(this, rect, image);
         m_pending_uploads << t;
+        ++m_texture_count;
+        m_used_area += rect.width() * rect.height();
         return t;
     }
     return 0;
@@ -415,6 +511,11 @@ void Atlas::remove(Texture *t)
     QRect atlasRect = t->atlasSubRect();
     m_allocator.deallocate(atlasRect);
     m_pending_uploads.removeOne(t);
+
+    --m_texture_count;
+    m_used_area -= atlasRect.width() * atlasRect.height();
+    if (m_texture_count == 0 && m_manager)
+        m_manager->atlasEmptied(this);
 }
 
 
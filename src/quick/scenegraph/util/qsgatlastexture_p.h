@@ -35,6 +35,7 @@
 #define QSGATLASTEXTURE_P_H
 
 #include <QtCore/QSize>
+#include <QtCore/QVector>
 
 #include <QtGui/qopengl.h>
 
@@ -50,7 +51,7 @@ namespace QSGAtlasTexture
 class Texture;
 class Atlas;
 
-class Manager : public QObject
+class Q_QUICK_PRIVATE_EXPORT Manager : public QObject
 {
     Q_OBJECT
 
@@ -58,20 +59,39 @@ public:
     Manager();
     ~Manager();
 
+    struct Statistics {
+        int pageCount;
+        int textureCount;
+        qint64 totalArea;
+        qint64 usedArea;
+        qreal occupancy;
+        qreal fragmentation;
+        int fallbackCount;
+    };
+
     QSGTexture *create(const QImage &image);
     void invalidate();
 
+    Statistics statistics() const;
+
+    void atlasEmptied(Atlas *atlas);
+
 private:
-    Atlas *m_atlas;
+    Atlas *addAtlas();
+    void maybeRetire(Atlas *atlas);
+
+    QVector<Atlas *> m_atlases;
 
     QSize m_atlas_size;
     int m_atlas_size_limit;
+    int m_max_pages;
+    int m_fallback_count;
 };
 
 class Atlas : public QObject
 {
 public:
-    Atlas(const QSize &size);
+    Atlas(Manager *manager, const QSize &size);
     ~Atlas();
 
     void invalidate();
@@ -87,15 +107,27 @@ public:
 
     QSize size() const { return m_size; }
 
+    int textureCount() const { return m_texture_count; }
+    qint64 usedArea() const { return m_used_area; }
+    int largestFreeArea() const { return m_allocator.largestFreeArea(); }
+    qreal fragmentation() const;
+
+    bool isRetired() const { return m_retired; }
+    void retire() { m_retired = true; }
+
     GLuint internalFormat() const { return m_internalFormat; }
     GLuint externalFormat() const { return m_externalFormat; }
 
 private:
+    Manager *m_manager;
     QSGAreaAllocator m_allocator;
     GLuint m_texture_id;
     QSize m_size;
     QList<Texture *> m_pending_uploads;
 
+    int m_texture_count;
+    qint64 m_used_area;
+
     GLuint m_internalFormat;
     GLuint m_externalFormat;
 
@@ -103,6 +135,7 @@ private:
     uint m_use_bgra_fallback: 1;
 
     uint m_debug_overlay : 1;
+    uint m_retired : 1;
 };
 
 class Texture : public QSGTexture
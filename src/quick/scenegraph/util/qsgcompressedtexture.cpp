@@ -0,0 +1,368 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qsgcompressedtexture_p.h"
+
+#include <private/qsgcontext_p.h>
+
+#include <QtGui/qopenglcontext.h>
+#include <QtGui/qopenglfunctions.h>
+
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qendian.h>
+#include <QtCore/qiodevice.h>
+#include <QtCore/qvarlengtharray.h>
+
+#include <limits.h>
+
+#ifndef GL_NUM_COMPRESSED_TEXTURE_FORMATS
+#define GL_NUM_COMPRESSED_TEXTURE_FORMATS 0x86A2
+#endif
+
+#ifndef GL_COMPRESSED_TEXTURE_FORMATS
+#define GL_COMPRESSED_TEXTURE_FORMATS 0x86A3
+#endif
+
+#ifndef GL_ETC1_RGB8_OES
+#define GL_ETC1_RGB8_OES 0x8D64
+#endif
+
+#ifndef GL_COMPRESSED_R11_EAC
+#define GL_COMPRESSED_R11_EAC                        0x9270
+#define GL_COMPRESSED_SIGNED_R11_EAC                 0x9271
+#define GL_COMPRESSED_RG11_EAC                       0x9272
+#define GL_COMPRESSED_SIGNED_RG11_EAC                0x9273
+#define GL_COMPRESSED_RGB8_ETC2                      0x9274
+#define GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2  0x9276
+#define GL_COMPRESSED_RGBA8_ETC2_EAC                 0x9278
+#endif
+
+QT_BEGIN_NAMESPACE
+
+/*
+ * Compressed textures are read from KTX and PKM containers and handed to
+ * OpenGL as is, without decoding them on the CPU. Only the base mipmap
+ * level is used. Like any other texture in the scene graph, the data is
+ * expected to have premultiplied alpha and the first row of blocks at the
+ * top of the image.
+ */
+
+static QElapsedTimer qsg_compressed_timer;
+
+static const char qsg_ktxIdentifier[12] = { '\xAB', 'K', 'T', 'X', ' ', '1', '1', '\xBB', '\r', '\n', '\x1A', '\n' };
+static const int qsg_ktxHeaderSize = 64;
+static const int qsg_pkmHeaderSize = 16;
+
+QSGCompressedTexture::QSGCompressedTexture(const QByteArray &data, const QSize &size, GLenum format, bool hasAlpha)
+    : m_data(data)
+    , m_size(size)
+    , m_format(format)
+    , m_texture_id(0)
+    , m_has_alpha(hasAlpha)
+    , m_uploaded(false)
+{
+}
+
+QSGCompressedTexture::~QSGCompressedTexture()
+{
+    if (m_texture_id && QOpenGLContext::currentContext())
+        QOpenGLContext::currentContext()->functions()->glDeleteTextures(1, &m_texture_id);
+}
+
+int QSGCompressedTexture::textureId() const
+{
+    if (!m_texture_id) {
+        // Generate the id up front, the data is uploaded in the first bind().
+        QOpenGLContext::currentContext()->functions()->glGenTextures(1, &const_cast<QSGCompressedTexture *>(this)->m_texture_id);
+    }
+    return m_texture_id;
+}
+
+void QSGCompressedTexture::bind()
+{
+    QOpenGLFunctions *funcs = QOpenGLContext::currentContext()->functions();
+    if (m_uploaded) {
+        funcs->glBindTexture(GL_TEXTURE_2D, m_texture_id);
+        updateBindOptions();
+        return;
+    }
+
+    m_uploaded = true;
+
+    bool profileFrames = QSG_LOG_TIME_TEXTURE().isDebugEnabled();
+    if (profileFrames)
+        qsg_compressed_timer.start();
+
+    funcs->glBindTexture(GL_TEXTURE_2D, textureId());
+    updateBindOptions(true);
+    funcs->glCompressedTexImage2D(GL_TEXTURE_2D, 0, m_format, m_size.width(), m_size.height(), 0,
+                                  m_data.size(), m_data.constData());
+
+    qCDebug(QSG_LOG_TIME_TEXTURE, "compressed texture uploaded in %dms - %dx%d, %d bytes, format=0x%x",
+            (int) qsg_compressed_timer.elapsed(), m_size.width(), m_size.height(), m_data.size(), m_format);
+
+    // The factory keeps the data for other windows, this copy is not needed anymore.
+    m_data = QByteArray();
+}
+
+/*
+ * Returns true if the current OpenGL context lists \a format among its
+ * compressed texture formats.
+ */
+bool QSGCompressedTexture::formatSupported(GLenum format)
+{
+    QOpenGLFunctions *funcs = QOpenGLContext::currentContext()->functions();
+    GLint count = 0;
+    funcs->glGetIntegerv(GL_NUM_COMPRESSED_TEXTURE_FORMATS, &count);
+    if (count <= 0)
+        return false;
+
+    QVarLengthArray<GLint, 64> formats(count);
+    funcs->glGetIntegerv(GL_COMPRESSED_TEXTURE_FORMATS, formats.data());
+    for (int i = 0; i < count; ++i) {
+        if (GLenum(formats.at(i)) == format)
+            return true;
+    }
+    return false;
+}
+
+QSGCompressedTextureFactory::QSGCompressedTextureFactory(const QByteArray &data, const QSize &size,
+                                                         GLenum format, bool hasAlpha)
+    : m_data(data)
+    , m_size(size)
+    , m_format(format)
+    , m_has_alpha(hasAlpha)
+{
+}
+
+QSGTexture *QSGCompressedTextureFactory::createTexture(QQuickWindow *) const
+{
+    if (!QSGCompressedTexture::formatSupported(m_format)) {
+        qWarning("QSGCompressedTextureFactory: compressed texture format 0x%x is not supported", m_format);
+        return 0;
+    }
+    return new QSGCompressedTexture(m_data, m_size, m_format, m_has_alpha);
+}
+
+/*
+ * Returns true if \a device starts with a KTX or PKM header. The device
+ * position is left untouched.
+ */
+bool QSGCompressedTextureFactory::canRead(QIODevice *device)
+{
+    const QByteArray header = device->peek(sizeof(qsg_ktxIdentifier));
+    if (header.size() < 4)
+        return false;
+    if (header.startsWith("PKM "))
+        return true;
+    return header.size() == sizeof(qsg_ktxIdentifier)
+            && memcmp(header.constData(), qsg_ktxIdentifier, sizeof(qsg_ktxIdentifier)) == 0;
+}
+
+QSGCompressedTextureFactory *QSGCompressedTextureFactory::read(QIODevice *device, QString *errorString)
+{
+    if (device->peek(4) == QByteArrayLiteral("PKM "))
+        return readPkm(device, errorString);
+    return readKtx(device, errorString);
+}
+
+/*
+ * Returns the size in bytes of the base level of a \a size texture in the
+ * ETC1, ETC2 or EAC \a format, or 0 for formats whose block layout is not
+ * known here. The size is computed in 64 bits, as it does not fit into an
+ * int for the largest dimensions a file can give.
+ */
+static qint64 qsg_etcDataSize(GLenum format, const QSize &size)
+{
+    qint64 blockBytes;
+    switch (format) {
+    case GL_ETC1_RGB8_OES:
+    case GL_COMPRESSED_RGB8_ETC2:
+    case GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2:
+    case GL_COMPRESSED_R11_EAC:
+    case GL_COMPRESSED_SIGNED_R11_EAC:
+        blockBytes = 8;
+        break;
+    case GL_COMPRESSED_RGBA8_ETC2_EAC:
+    case GL_COMPRESSED_RG11_EAC:
+    case GL_COMPRESSED_SIGNED_RG11_EAC:
+        blockBytes = 16;
+        break;
+    default:
+        return 0;
+    }
+    return qint64((size.width() + 3) / 4) * ((size.height() + 3) / 4) * blockBytes;
+}
+
+static inline quint32 qsg_ktxValue(const uchar *header, int index, bool bigEndian)
+{
+    const uchar *p = header + sizeof(qsg_ktxIdentifier) + index * 4;
+    return bigEndian ? qFromBigEndian<quint32>(p) : qFromLittleEndian<quint32>(p);
+}
+
+QSGCompressedTextureFactory *QSGCompressedTextureFactory::readKtx(QIODevice *device, QString *errorString)
+{
+    enum {
+        Endianness, GlType, GlTypeSize, GlFormat, GlInternalFormat, GlBaseInternalFormat,
+        PixelWidth, PixelHeight, PixelDepth, NumberOfArrayElements, NumberOfFaces,
+        NumberOfMipmapLevels, BytesOfKeyValueData
+    };
+
+    const QByteArray header = device->read(qsg_ktxHeaderSize);
+    if (header.size() != qsg_ktxHeaderSize) {
+        *errorString = QStringLiteral("Truncated KTX header");
+        return 0;
+    }
+
+    const uchar *h = reinterpret_cast<const uchar *>(header.constData());
+    const bool bigEndian = qFromLittleEndian<quint32>(h + sizeof(qsg_ktxIdentifier)) != 0x04030201;
+
+    if (qsg_ktxValue(h, GlType, bigEndian) != 0 || qsg_ktxValue(h, GlFormat, bigEndian) != 0) {
+        *errorString = QStringLiteral("KTX file does not contain compressed data");
+        return 0;
+    }
+    if (qsg_ktxValue(h, PixelDepth, bigEndian) > 1
+            || qsg_ktxValue(h, NumberOfArrayElements, bigEndian) > 0
+            || qsg_ktxValue(h, NumberOfFaces, bigEndian) != 1) {
+        *errorString = QStringLiteral("Only 2D KTX textures are supported");
+        return 0;
+    }
+
+    const quint32 width = qsg_ktxValue(h, PixelWidth, bigEndian);
+    const quint32 height = qsg_ktxValue(h, PixelHeight, bigEndian);
+    if (width == 0 || height == 0 || width > 0xffff || height > 0xffff) {
+        *errorString = QStringLiteral("Invalid KTX texture size");
+        return 0;
+    }
+    const QSize size(width, height);
+    const GLenum format = qsg_ktxValue(h, GlInternalFormat, bigEndian);
+    const bool hasAlpha = qsg_ktxValue(h, GlBaseInternalFormat, bigEndian) != GL_RGB
+            && format != GL_ETC1_RGB8_OES
+            && format != GL_COMPRESSED_RGB8_ETC2;
+
+    if (!device->seek(device->pos() + qsg_ktxValue(h, BytesOfKeyValueData, bigEndian))) {
+        *errorString = QStringLiteral("Truncated KTX key/value data");
+        return 0;
+    }
+
+    const QByteArray sizeField = device->read(4);
+    if (sizeField.size() != 4) {
+        *errorString = QStringLiteral("Truncated KTX image data");
+        return 0;
+    }
+    const uchar *s = reinterpret_cast<const uchar *>(sizeField.constData());
+    const quint32 imageSize = bigEndian ? qFromBigEndian<quint32>(s) : qFromLittleEndian<quint32>(s);
+
+    // Check the size given by the file before allocating anything for it.
+    const qint64 expectedSize = qsg_etcDataSize(format, size);
+    // No format, compressed or not, takes more than 16 bytes per pixel.
+    const quint64 maximumSize = quint64(width) * height * 16;
+    if (imageSize == 0 || imageSize > quint32(INT_MAX) || (expectedSize && imageSize != quint64(expectedSize))
+            || imageSize > maximumSize) {
+        *errorString = QStringLiteral("Invalid KTX image size %1").arg(imageSize);
+        return 0;
+    }
+    if (!device->isSequential() && imageSize > quint64(device->size() - device->pos())) {
+        *errorString = QStringLiteral("Truncated KTX image data");
+        return 0;
+    }
+
+    const QByteArray data = device->read(imageSize);
+    if (quint32(data.size()) != imageSize) {
+        *errorString = QStringLiteral("Truncated KTX image data");
+        return 0;
+    }
+
+    return new QSGCompressedTextureFactory(data, size, format, hasAlpha);
+}
+
+QSGCompressedTextureFactory *QSGCompressedTextureFactory::readPkm(QIODevice *device, QString *errorString)
+{
+    const QByteArray header = device->read(qsg_pkmHeaderSize);
+    if (header.size() != qsg_pkmHeaderSize) {
+        *errorString = QStringLiteral("Truncated PKM header");
+        return 0;
+    }
+
+    const uchar *h = reinterpret_cast<const uchar *>(header.constData());
+    const quint16 type = qFromBigEndian<quint16>(h + 6);
+    const QSize paddedSize(qFromBigEndian<quint16>(h + 8), qFromBigEndian<quint16>(h + 10));
+    const QSize size(qFromBigEndian<quint16>(h + 12), qFromBigEndian<quint16>(h + 14));
+
+    GLenum format;
+    bool hasAlpha = false;
+    if (header.mid(4, 2) == QByteArrayLiteral("10")) {
+        format = GL_ETC1_RGB8_OES;
+    } else {
+        switch (type) {
+        case 0: format = GL_ETC1_RGB8_OES; break;
+        case 1: format = GL_COMPRESSED_RGB8_ETC2; break;
+        case 3: format = GL_COMPRESSED_RGBA8_ETC2_EAC; hasAlpha = true; break;
+        case 4: format = GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2; hasAlpha = true; break;
+        case 5: format = GL_COMPRESSED_R11_EAC; break;
+        case 6: format = GL_COMPRESSED_RG11_EAC; break;
+        case 7: format = GL_COMPRESSED_SIGNED_R11_EAC; break;
+        case 8: format = GL_COMPRESSED_SIGNED_RG11_EAC; break;
+        default:
+            *errorString = QStringLiteral("Unsupported PKM texture type %1").arg(type);
+            return 0;
+        }
+    }
+
+    if (size.isEmpty() || paddedSize.width() < size.width() || paddedSize.height() < size.height()) {
+        *errorString = QStringLiteral("Invalid PKM texture size");
+        return 0;
+    }
+
+    // Check the size given by the header before allocating anything for it.
+    const qint64 dataSize = qsg_etcDataSize(format, paddedSize);
+    if (dataSize > INT_MAX) {
+        *errorString = QStringLiteral("Invalid PKM texture size");
+        return 0;
+    }
+    if (!device->isSequential() && dataSize > device->size() - device->pos()) {
+        *errorString = QStringLiteral("Truncated PKM image data");
+        return 0;
+    }
+
+    const QByteArray data = device->read(dataSize);
+    if (data.size() != dataSize) {
+        *errorString = QStringLiteral("Truncated PKM image data");
+        return 0;
+    }
+
+    return new QSGCompressedTextureFactory(data, size, format, hasAlpha);
+}
+
+QT_END_NAMESPACE
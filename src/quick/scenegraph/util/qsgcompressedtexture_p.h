@@ -0,0 +1,105 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QSGCOMPRESSEDTEXTURE_P_H
+#define QSGCOMPRESSEDTEXTURE_P_H
+
+#include <private/qtquickglobal_p.h>
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qsize.h>
+
+#include <QtGui/qopengl.h>
+
+#include <QtQuick/qsgtexture.h>
+#include <QtQuick/qquickimageprovider.h>
+
+QT_BEGIN_NAMESPACE
+
+class QIODevice;
+
+class Q_QUICK_PRIVATE_EXPORT QSGCompressedTexture : public QSGTexture
+{
+    Q_OBJECT
+public:
+    QSGCompressedTexture(const QByteArray &data, const QSize &size, GLenum format, bool hasAlpha);
+    ~QSGCompressedTexture();
+
+    int textureId() const;
+    QSize textureSize() const { return m_size; }
+    bool hasAlphaChannel() const { return m_has_alpha; }
+    bool hasMipmaps() const { return false; }
+
+    void bind();
+
+    static bool formatSupported(GLenum format);
+
+private:
+    QByteArray m_data;
+    QSize m_size;
+    GLenum m_format;
+    GLuint m_texture_id;
+
+    uint m_has_alpha : 1;
+    uint m_uploaded : 1;
+};
+
+class Q_QUICK_PRIVATE_EXPORT QSGCompressedTextureFactory : public QQuickTextureFactory
+{
+    Q_OBJECT
+public:
+    static bool canRead(QIODevice *device);
+    static QSGCompressedTextureFactory *read(QIODevice *device, QString *errorString);
+
+    QSGTexture *createTexture(QQuickWindow *window) const;
+    QSize textureSize() const { return m_size; }
+    int textureByteCount() const { return m_data.size(); }
+
+    GLenum format() const { return m_format; }
+
+private:
+    QSGCompressedTextureFactory(const QByteArray &data, const QSize &size, GLenum format, bool hasAlpha);
+
+    static QSGCompressedTextureFactory *readKtx(QIODevice *device, QString *errorString);
+    static QSGCompressedTextureFactory *readPkm(QIODevice *device, QString *errorString);
+
+    QByteArray m_data;
+    QSize m_size;
+    GLenum m_format;
+    bool m_has_alpha;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSGCOMPRESSEDTEXTURE_P_H
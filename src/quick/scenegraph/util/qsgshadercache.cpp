@@ -0,0 +1,347 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qsgshadercache_p.h"
+
+#include <private/qsgcontext_p.h>
+
+#include <QtGui/qopenglcontext.h>
+#include <QtGui/qopenglfunctions.h>
+#include <QtGui/qopenglshaderprogram.h>
+
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdatastream.h>
+#include <QtCore/qdir.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qsavefile.h>
+#include <QtCore/qstandardpaths.h>
+
+#ifndef GL_PROGRAM_BINARY_LENGTH
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#endif
+
+#ifndef GL_NUM_PROGRAM_BINARY_FORMATS
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#endif
+
+#ifndef GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#endif
+
+QT_BEGIN_NAMESPACE
+
+/*
+ * Linked programs are stored on disk using glGetProgramBinary() and given
+ * back to the driver with glProgramBinary() the next time the same shader
+ * is needed. This is available with OpenGL ES 3.0, OpenGL 4.1 and through
+ * the GL_OES_get_program_binary and GL_ARB_get_program_binary extensions.
+ *
+ * The cache lives in "qtshadercache" in the generic cache location, or in
+ * the directory given by QSG_SHADER_CACHE_DIR. Setting
+ * QT_DISABLE_SHADER_DISK_CACHE turns it off.
+ */
+
+static const quint32 QSG_SHADER_CACHE_MAGIC = 0x51534742; // "QSGB"
+static const quint32 QSG_SHADER_CACHE_VERSION = 1;
+
+struct QSGShaderCacheLocation
+{
+    QSGShaderCacheLocation()
+    {
+        if (qEnvironmentVariableIsSet("QT_DISABLE_SHADER_DISK_CACHE"))
+            return;
+        path = QString::fromLocal8Bit(qgetenv("QSG_SHADER_CACHE_DIR"));
+        if (path.isEmpty()) {
+            const QString cache = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation);
+            if (!cache.isEmpty())
+                path = cache + QLatin1String("/qtshadercache");
+        }
+    }
+
+    QString path;
+};
+
+Q_GLOBAL_STATIC(QSGShaderCacheLocation, qsg_shaderCacheLocation)
+
+typedef void (QOPENGLF_APIENTRYP QSGGetProgramBinary)(GLuint program, GLsizei bufSize, GLsizei *length, GLenum *binaryFormat, void *binary);
+typedef void (QOPENGLF_APIENTRYP QSGProgramBinary)(GLuint program, GLenum binaryFormat, const void *binary, GLsizei length);
+typedef void (QOPENGLF_APIENTRYP QSGProgramParameteri)(GLuint program, GLenum pname, GLint value);
+
+// The program binary functions of a context, and the driver identity its keys start from
+struct QSGProgramBinarySupport
+{
+    QSGProgramBinarySupport()
+        : getProgramBinary(0)
+        , programBinary(0)
+        , programParameteri(0)
+    {
+    }
+
+    bool isValid() const { return programBinary; }
+
+    QSGGetProgramBinary getProgramBinary;
+    QSGProgramBinary programBinary;
+    QSGProgramParameteri programParameteri;
+    QByteArray driver;
+};
+
+static QSGProgramBinarySupport qsg_resolveProgramBinarySupport(QOpenGLContext *ctx)
+{
+    QSGProgramBinarySupport support;
+    if (qsg_shaderCacheLocation()->path.isEmpty())
+        return support;
+
+    const QSurfaceFormat format = ctx->format();
+    const char *suffix = 0;
+    if (ctx->isOpenGLES()) {
+        if (format.majorVersion() >= 3)
+            suffix = "";
+        else if (ctx->hasExtension(QByteArrayLiteral("GL_OES_get_program_binary")))
+            suffix = "OES";
+    } else if (format.version() >= qMakePair(4, 1)
+               || ctx->hasExtension(QByteArrayLiteral("GL_ARB_get_program_binary"))) {
+        suffix = "";
+    }
+    if (!suffix)
+        return support;
+
+    // Drivers may support the entry points without supporting any format
+    QOpenGLFunctions *funcs = ctx->functions();
+    GLint formats = 0;
+    funcs->glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    if (formats <= 0)
+        return support;
+
+    support.getProgramBinary = (QSGGetProgramBinary) ctx->getProcAddress(QByteArray("glGetProgramBinary") + suffix);
+    support.programBinary = (QSGProgramBinary) ctx->getProcAddress(QByteArray("glProgramBinary") + suffix);
+    if (!support.getProgramBinary || !support.programBinary)
+        return QSGProgramBinarySupport();
+
+    // Desktop drivers only need to keep a program retrievable when asked to
+    if (!ctx->isOpenGLES())
+        support.programParameteri = (QSGProgramParameteri) ctx->getProcAddress("glProgramParameteri");
+
+    support.driver = QByteArray((const char *) funcs->glGetString(GL_VENDOR)) + '\0'
+            + QByteArray((const char *) funcs->glGetString(GL_RENDERER)) + '\0'
+            + QByteArray((const char *) funcs->glGetString(GL_VERSION));
+    return support;
+}
+
+/*
+ * Resolves the program binary functions once per context and forgets them
+ * when the context goes away.
+ */
+class QSGProgramBinaryResolver : public QObject
+{
+    Q_OBJECT
+public:
+    QSGProgramBinarySupport support(QOpenGLContext *ctx)
+    {
+        QMutexLocker locker(&m_mutex);
+        QHash<QOpenGLContext *, QSGProgramBinarySupport>::const_iterator it = m_contexts.constFind(ctx);
+        if (it != m_contexts.constEnd())
+            return it.value();
+
+        const QSGProgramBinarySupport support = qsg_resolveProgramBinarySupport(ctx);
+        m_contexts.insert(ctx, support);
+        connect(ctx, SIGNAL(aboutToBeDestroyed()), this, SLOT(contextDestroyed()), Qt::DirectConnection);
+        return support;
+    }
+
+private Q_SLOTS:
+    void contextDestroyed()
+    {
+        QMutexLocker locker(&m_mutex);
+        m_contexts.remove(static_cast<QOpenGLContext *>(sender()));
+    }
+
+private:
+    QMutex m_mutex;
+    QHash<QOpenGLContext *, QSGProgramBinarySupport> m_contexts;
+};
+
+Q_GLOBAL_STATIC(QSGProgramBinaryResolver, qsg_programBinaryResolver)
+
+static inline QSGProgramBinarySupport qsg_programBinarySupport()
+{
+    QOpenGLContext *ctx = QOpenGLContext::currentContext();
+    return ctx ? qsg_programBinaryResolver()->support(ctx) : QSGProgramBinarySupport();
+}
+
+/*!
+    Links \a program from \a vertexCode and \a fragmentCode, using a program
+    binary from the disk cache when one is available and adding the result to
+    the cache otherwise. The attribute locations must already have been bound
+    as given by \a attributeNames. Returns true if the program was linked.
+ */
+bool QSGShaderCache::link(QOpenGLShaderProgram *program,
+                          const QByteArray &vertexCode,
+                          const QByteArray &fragmentCode,
+                          char const *const *attributeNames)
+{
+    const QByteArray cacheKey = key(vertexCode, fragmentCode, attributeNames);
+    if (load(program, cacheKey))
+        return true;
+
+    program->addShaderFromSourceCode(QOpenGLShader::Vertex, vertexCode);
+    program->addShaderFromSourceCode(QOpenGLShader::Fragment, fragmentCode);
+    if (!cacheKey.isEmpty()) {
+        const QSGProgramBinarySupport gl = qsg_programBinarySupport();
+        if (gl.programParameteri)
+            gl.programParameteri(program->programId(), GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+    if (!program->link())
+        return false;
+
+    store(program, cacheKey);
+    return true;
+}
+
+/*!
+    Returns the name the program built from \a vertexCode, \a fragmentCode and
+    \a attributeNames is cached under for the current context, or an empty
+    array if program binaries cannot be used. The driver identity is part of
+    the key, so that a driver update does not pick up stale binaries.
+ */
+QByteArray QSGShaderCache::key(const QByteArray &vertexCode,
+                               const QByteArray &fragmentCode,
+                               char const *const *attributeNames)
+{
+    const QSGProgramBinarySupport gl = qsg_programBinarySupport();
+    if (!gl.isValid())
+        return QByteArray();
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(QT_VERSION_STR);
+    hash.addData(gl.driver);
+    hash.addData("\0", 1);
+    hash.addData(vertexCode);
+    hash.addData("\0", 1);
+    hash.addData(fragmentCode);
+    for (int i = 0; attributeNames && attributeNames[i]; ++i) {
+        hash.addData("\0", 1);
+        hash.addData(attributeNames[i]);
+    }
+    return hash.result().toHex();
+}
+
+/*!
+    Loads the program binary stored under \a key into \a program, which must
+    not have any shaders added. Returns true if \a program is now linked.
+ */
+bool QSGShaderCache::load(QOpenGLShaderProgram *program, const QByteArray &key)
+{
+    if (key.isEmpty())
+        return false;
+    const QSGProgramBinarySupport gl = qsg_programBinarySupport();
+    if (!gl.isValid())
+        return false;
+
+    const QString fileName = qsg_shaderCacheLocation()->path + QLatin1Char('/') + QString::fromLatin1(key);
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream stream(&file);
+    quint32 magic = 0;
+    quint32 version = 0;
+    quint32 format = 0;
+    QByteArray binary;
+    stream >> magic >> version >> format >> binary;
+    file.close();
+    if (stream.status() != QDataStream::Ok || magic != QSG_SHADER_CACHE_MAGIC
+            || version != QSG_SHADER_CACHE_VERSION || binary.isEmpty()) {
+        return false;
+    }
+
+    const GLuint id = program->programId();
+    if (!id)
+        return false;
+    gl.programBinary(id, format, binary.constData(), binary.size());
+
+    // The driver may reject a binary it produced itself, for instance after
+    // an update which kept the version string. The sources are used then.
+    GLint linked = 0;
+    QOpenGLContext::currentContext()->functions()->glGetProgramiv(id, GL_LINK_STATUS, &linked);
+    if (!linked) {
+        QFile::remove(fileName);
+        return false;
+    }
+
+    // Without shaders added, link() only picks up the link status.
+    qCDebug(QSG_LOG_INFO, "shader program loaded from cache: %s", key.constData());
+    return program->link();
+}
+
+/*!
+    Stores the binary of the linked \a program under \a key.
+ */
+void QSGShaderCache::store(QOpenGLShaderProgram *program, const QByteArray &key)
+{
+    if (key.isEmpty() || !program->isLinked())
+        return;
+    const QSGProgramBinarySupport gl = qsg_programBinarySupport();
+    if (!gl.isValid())
+        return;
+
+    const GLuint id = program->programId();
+    GLint length = 0;
+    QOpenGLContext::currentContext()->functions()->glGetProgramiv(id, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+        return;
+
+    QByteArray binary(length, Qt::Uninitialized);
+    GLsizei written = 0;
+    GLenum format = 0;
+    gl.getProgramBinary(id, length, &written, &format, binary.data());
+    if (written <= 0)
+        return;
+    binary.resize(written);
+
+    const QString path = qsg_shaderCacheLocation()->path;
+    if (!QDir().mkpath(path))
+        return;
+
+    QSaveFile file(path + QLatin1Char('/') + QString::fromLatin1(key));
+    if (!file.open(QIODevice::WriteOnly))
+        return;
+    QDataStream stream(&file);
+    stream << QSG_SHADER_CACHE_MAGIC << QSG_SHADER_CACHE_VERSION << quint32(format) << binary;
+    file.commit();
+}
+
+QT_END_NAMESPACE
+
+#include "qsgshadercache.moc"
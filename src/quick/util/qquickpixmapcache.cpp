@@ -44,6 +44,7 @@
 #include <qpa/qplatformintegration.h>
 
 #include <QtQuick/private/qsgtexture_p.h>
+#include <QtQuick/private/qsgcompressedtexture_p.h>
 
 #include <QQuickWindow>
 #include <QCoreApplication>
@@ -392,6 +393,35 @@ static bool readImage(const QUrl& url, QIODevice *dev, QImage *image, QString *e
     }
 }
 
+/*
+    Like readImage(), but also recognizes KTX and PKM containers. Their
+    compressed data is passed on to the texture without being decoded, so
+    the request size does not apply to them.
+ */
+static bool readTexture(const QUrl& url, QIODevice *dev, QQuickTextureFactory **factory, QString *errorString,
+                        QSize *impsize, const QSize &requestSize)
+{
+    if (QSGCompressedTextureFactory::canRead(dev)) {
+        QString error;
+        QSGCompressedTextureFactory *compressed = QSGCompressedTextureFactory::read(dev, &error);
+        if (!compressed) {
+            if (errorString)
+                *errorString = QQuickPixmap::tr("Error decoding: %1: %2").arg(url.toString()).arg(error);
+            return false;
+        }
+        if (impsize)
+            *impsize = compressed->textureSize();
+        *factory = compressed;
+        return true;
+    }
+
+    QImage image;
+    if (!readImage(url, dev, &image, errorString, impsize, requestSize))
+        return false;
+    *factory = QQuickTextureFactory::textureFactoryForImage(image);
+    return true;
+}
+
 QQuickPixmapReader::QQuickPixmapReader(QQmlEngine *eng)
 : QThread(eng), engine(eng), threadObject(0), accessManager(0)
 {
@@ -453,7 +483,7 @@ void QQuickPixmapReader::networkRequestDone(QNetworkReply *reply)
             }
         }
 
-        QImage image;
+        QQuickTextureFactory *factory = 0;
         QQuickPixmapReply::ReadError error = QQuickPixmapReply::NoError;
         QString errorString;
         QSize readSize;
@@ -464,13 +494,15 @@ void QQuickPixmapReader::networkRequestDone(QNetworkReply *reply)
             QByteArray all = reply->readAll();
             QBuffer buff(&all);
             buff.open(QIODevice::ReadOnly);
-            if (!readImage(reply->url(), &buff, &image, &errorString, &readSize, job->requestSize))
+            if (!readTexture(reply->url(), &buff, &factory, &errorString, &readSize, job->requestSize))
                 error = QQuickPixmapReply::Decoding;
        }
         // send completion event to the QQuickPixmapReply
         mutex.lock();
         if (!cancelled.contains(job))
-            job->postReply(error, errorString, readSize, QQuickTextureFactory::textureFactoryForImage(image));
+            job->postReply(error, errorString, readSize, factory);
+        else
+            delete factory;
         mutex.unlock();
     }
     reply->deleteLater();
@@ -695,13 +727,13 @@ void QQuickPixmapReader::processJob(QQuickPixmapReply *runningJob, const QUrl &u
     } else {
         if (!localFile.isEmpty()) {
             // Image is local - load/decode immediately
-            QImage image;
+            QQuickTextureFactory *factory = 0;
             QQuickPixmapReply::ReadError errorCode = QQuickPixmapReply::NoError;
             QString errorStr;
             QFile f(localFile);
             QSize readSize;
             if (f.open(QIODevice::ReadOnly)) {
-                if (!readImage(url, &f, &image, &errorStr, &readSize, runningJob->requestSize))
+                if (!readTexture(url, &f, &factory, &errorStr, &readSize, runningJob->requestSize))
                     errorCode = QQuickPixmapReply::Loading;
             } else {
                 errorStr = QQuickPixmap::tr("Cannot open: %1").arg(url.toString());
@@ -709,7 +741,9 @@ void QQuickPixmapReader::processJob(QQuickPixmapReply *runningJob, const QUrl &u
             }
             mutex.lock();
             if (!cancelled.contains(runningJob))
-                runningJob->postReply(errorCode, errorStr, readSize, QQuickTextureFactory::textureFactoryForImage(image));
+                runningJob->postReply(errorCode, errorStr, readSize, factory);
+            else
+                delete factory;
             mutex.unlock();
         } else {
             // Network resource
@@ -1150,11 +1184,11 @@ static QQuickPixmapData* createPixmapDataSync(QQuickPixmap *declarativePixmap, Q
     QString errorString;
 
     if (f.open(QIODevice::ReadOnly)) {
-        QImage image;
+        QQuickTextureFactory *factory = 0;
 
-        if (readImage(url, &f, &image, &errorString, &readSize, requestSize)) {
+        if (readTexture(url, &f, &factory, &errorString, &readSize, requestSize)) {
             *ok = true;
-            return new QQuickPixmapData(declarativePixmap, url, QQuickTextureFactory::textureFactoryForImage(image), readSize, requestSize);
+            return new QQuickPixmapData(declarativePixmap, url, factory, readSize, requestSize);
         }
         errorString = QQuickPixmap::tr("Invalid image data: %1").arg(url.toString());
 
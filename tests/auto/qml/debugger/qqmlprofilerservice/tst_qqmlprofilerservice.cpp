@@ -98,6 +98,7 @@ public:
         Binding,            //running a binding
         HandlingSignal,     //running a signal handler
         Javascript,
+        ImportResolution,
 
         MaximumRangeType
     };
@@ -213,6 +214,7 @@ private slots:
     void controlFromJS();
     void signalSourceLocation();
     void javascript();
+    void importResolution();
 };
 
 #define VERIFY(type, position, expected, checks) QVERIFY(verify(type, position, expected, checks))
@@ -766,6 +768,36 @@ void tst_QQmlProfilerService::javascript()
     VERIFY(MessageListJavaScript, 21, expected, CheckMessageType | CheckDetailType);
 }
 
+void tst_QQmlProfilerService::importResolution()
+{
+    connect(true, "test.qml");
+    QVERIFY(m_client);
+    QTRY_COMPARE(m_client->state(), QQmlDebugClient::Enabled);
+
+    m_client->setTraceState(true);
+    m_client->setTraceState(false);
+    checkTraceReceived();
+
+    // The import of QtQuick in test.qml is reported as a range carrying the module URI.
+    int openRanges = 0;
+    QStringList uris;
+    foreach (const QQmlProfilerData &data, m_client->qmlMessages) {
+        if (data.detailType != QQmlProfilerClient::ImportResolution)
+            continue;
+        if (data.messageType == QQmlProfilerClient::RangeStart) {
+            ++openRanges;
+        } else if (data.messageType == QQmlProfilerClient::RangeData) {
+            QVERIFY(openRanges > 0);
+            uris.append(data.detailData);
+        } else if (data.messageType == QQmlProfilerClient::RangeEnd) {
+            QVERIFY(openRanges > 0);
+            --openRanges;
+        }
+    }
+    QCOMPARE(openRanges, 0);
+    QVERIFY2(uris.contains(QLatin1String("QtQuick")), qPrintable(uris.join(QLatin1String(", "))));
+}
+
 QTEST_MAIN(tst_QQmlProfilerService)
 
 #include "tst_qqmlprofilerservice.moc"
@@ -30,6 +30,7 @@ PUBLICTESTS += \
 PRIVATETESTS += \
     animation \
     qqmlcpputils \
+    qqmlcreationarena \
     qqmlecmascript \
     qqmlcontext \
     qqmlexpression \
@@ -0,0 +1,10 @@
+import QtQuick 2.0
+
+Item {
+    property string stringValue: "hello"
+    property url urlValue: "images/logo.png"
+    property color colorValue: "steelblue"
+
+    NumberAnimation on x { from: 0; to: 100; running: false }
+    Behavior on y { NumberAnimation {} }
+}
@@ -40,6 +40,8 @@
 #include <QtQuick>
 #include <QtQuick/private/qquickrectangle_p.h>
 #include <QtQuick/private/qquickmousearea_p.h>
+#include <QtQuick/private/qquickanimation_p.h>
+#include <QtQuick/private/qquickbehavior_p.h>
 #include <qcolor.h>
 #include "../../shared/util.h"
 #include "testhttpserver.h"
@@ -115,6 +117,7 @@ private slots:
     void onDestructionCount();
     void recursion();
     void recursionContinuation();
+    void repeatedInstantiation();
 
 private:
     QQmlEngine engine;
@@ -493,6 +496,23 @@ void tst_qqmlcomponent::recursionContinuation()
     QVERIFY(object->property("success").toBool());
 }
 
+void tst_qqmlcomponent::repeatedInstantiation()
+{
+    QQmlEngine engine;
+    QQmlComponent component(&engine, testFileUrl("repeatedInstantiation.qml"));
+
+    // The first instantiation records the plan, the following ones replay it.
+    for (int i = 0; i < 3; ++i) {
+        QScopedPointer<QObject> object(component.create());
+        QVERIFY(object != 0);
+        QCOMPARE(object->property("stringValue").toString(), QStringLiteral("hello"));
+        QCOMPARE(object->property("urlValue").toUrl(), testFileUrl("images/logo.png"));
+        QCOMPARE(object->property("colorValue").value<QColor>(), QColor("steelblue"));
+        QVERIFY(object->findChild<QQuickNumberAnimation *>() != 0);
+        QVERIFY(object->findChild<QQuickBehavior *>() != 0);
+    }
+}
+
 QTEST_MAIN(tst_qqmlcomponent)
 
 #include "tst_qqmlcomponent.moc"
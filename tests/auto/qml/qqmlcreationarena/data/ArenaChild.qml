@@ -0,0 +1,6 @@
+import QtQml 2.0
+
+QtObject {
+    property int value: 1
+    property QtObject inner: QtObject { property string name: "inner" }
+}
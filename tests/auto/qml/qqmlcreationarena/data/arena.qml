@@ -0,0 +1,12 @@
+import QtQml 2.0
+
+QtObject {
+    id: root
+    property int base: 3
+    property QtObject kept: ArenaChild { value: root.base * 2 }
+    property list<QtObject> items: [
+        QtObject { property int v: root.base + 1 },
+        ArenaChild { value: 7 },
+        ArenaChild {}
+    ]
+}
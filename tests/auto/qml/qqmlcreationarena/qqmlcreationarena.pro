@@ -0,0 +1,12 @@
+CONFIG += testcase
+TARGET = tst_qqmlcreationarena
+macx:CONFIG -= app_bundle
+
+include (../../shared/util.pri)
+
+SOURCES += tst_qqmlcreationarena.cpp
+
+TESTDATA = data/*
+
+QT += core-private qml-private testlib
+DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0
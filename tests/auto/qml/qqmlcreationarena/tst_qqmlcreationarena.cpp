@@ -0,0 +1,132 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "../../shared/util.h"
+#include <QQmlEngine>
+#include <QQmlComponent>
+#include <QQmlListReference>
+#include <private/qqmldata_p.h>
+
+// QML_CREATION_ARENA is read once per process, so the arena path is tested on its own.
+class tst_qqmlcreationarena : public QQmlDataTest
+{
+    Q_OBJECT
+public:
+    tst_qqmlcreationarena() {}
+
+private slots:
+    void initTestCase();
+    void create();
+    void outliveRoot();
+
+private:
+    static bool checkData(QObject *object);
+};
+
+void tst_qqmlcreationarena::initTestCase()
+{
+    qputenv("QML_CREATION_ARENA", "1");
+    QQmlDataTest::initTestCase();
+}
+
+bool tst_qqmlcreationarena::checkData(QObject *object)
+{
+    QQmlData *data = QQmlData::get(object);
+    if (!data || !data->arenaAllocated) {
+        qWarning() << object << "has no arena allocated QQmlData";
+        return false;
+    }
+    if (reinterpret_cast<quintptr>(data) % Q_ALIGNOF(QQmlData)) {
+        qWarning() << "QQmlData of" << object << "is misaligned at" << static_cast<void *>(data);
+        return false;
+    }
+    return true;
+}
+
+void tst_qqmlcreationarena::create()
+{
+    QQmlEngine engine;
+    QQmlComponent component(&engine, testFileUrl("arena.qml"));
+    QScopedPointer<QObject> root(component.create());
+    QVERIFY2(root, qPrintable(component.errorString()));
+
+    QVERIFY(checkData(root.data()));
+
+    QObject *kept = root->property("kept").value<QObject *>();
+    QVERIFY(kept);
+    QVERIFY(checkData(kept));
+    QObject *inner = kept->property("inner").value<QObject *>();
+    QVERIFY(inner);
+    QVERIFY(checkData(inner));
+    QCOMPARE(inner->property("name").toString(), QStringLiteral("inner"));
+
+    QQmlListReference items(root.data(), "items");
+    QCOMPARE(items.count(), 3);
+    for (int i = 0; i < items.count(); ++i)
+        QVERIFY(checkData(items.at(i)));
+
+    // Bindings on arena allocated objects behave as usual.
+    QCOMPARE(kept->property("value").toInt(), 6);
+    QCOMPARE(items.at(0)->property("v").toInt(), 4);
+    QCOMPARE(items.at(1)->property("value").toInt(), 7);
+    QCOMPARE(items.at(2)->property("value").toInt(), 1);
+    root->setProperty("base", 10);
+    QCOMPARE(kept->property("value").toInt(), 20);
+    QCOMPARE(items.at(0)->property("v").toInt(), 11);
+}
+
+void tst_qqmlcreationarena::outliveRoot()
+{
+    QQmlEngine engine;
+    QQmlComponent component(&engine, testFileUrl("arena.qml"));
+    QObject *root = component.create();
+    QVERIFY2(root, qPrintable(component.errorString()));
+
+    QObject *kept = root->property("kept").value<QObject *>();
+    QVERIFY(kept);
+    QQmlEngine::setObjectOwnership(kept, QQmlEngine::CppOwnership);
+    kept->setParent(0);
+
+    // The arena stays alive for the objects that outlive the root object.
+    delete root;
+    QVERIFY(checkData(kept));
+    QCOMPARE(kept->property("value").toInt(), 6);
+    QObject *inner = kept->property("inner").value<QObject *>();
+    QVERIFY(inner);
+    QCOMPARE(inner->property("name").toString(), QStringLiteral("inner"));
+    delete kept;
+}
+
+QTEST_MAIN(tst_qqmlcreationarena)
+
+#include "tst_qqmlcreationarena.moc"
@@ -46,6 +46,7 @@
 #include <QQmlExpression>
 #include <QQmlIncubationController>
 #include <private/qqmlengine_p.h>
+#include <private/qqmldata_p.h>
 #include <QQmlAbstractUrlInterceptor>
 
 class tst_qqmlengine : public QQmlDataTest
@@ -74,6 +75,7 @@ private slots:
     void qtqmlModule();
     void urlInterceptor_data();
     void urlInterceptor();
+    void dataArena();
 
 public slots:
     QObject *createAQObjectForOwnershipTest ()
@@ -777,6 +779,38 @@ void tst_qqmlengine::urlInterceptor()
     QCOMPARE(o->property("absoluteUrl").toString(), expectedAbsoluteUrl);
 }
 
+void tst_qqmlengine::dataArena()
+{
+    QQmlDataArena *arena = QQmlDataArena::create(2);
+
+    QObject *first = new QObject;
+    QObject *second = new QObject;
+    QObject *third = new QObject;
+
+    QQmlData *data = arena->allocate();
+    QVERIFY(data);
+    QVERIFY(data->arenaAllocated);
+    QVERIFY(!data->ownMemory);
+    QCOMPARE(reinterpret_cast<quintptr>(data) % Q_ALIGNOF(QQmlData), quintptr(0));
+    QObjectPrivate::get(first)->declarativeData = data;
+
+    data = arena->allocate();
+    QVERIFY(data);
+    QCOMPARE(reinterpret_cast<quintptr>(data) % Q_ALIGNOF(QQmlData), quintptr(0));
+    QObjectPrivate::get(second)->declarativeData = data;
+
+    // Exhausted arenas leave the allocation to the caller.
+    QVERIFY(!arena->allocate());
+    QQmlData::get(third, /*create*/true);
+
+    // The objects keep the arena alive after its creator is done with it.
+    arena->release();
+    delete first;
+    delete third;
+    QVERIFY(QQmlData::get(second));
+    delete second;
+}
+
 QTEST_MAIN(tst_qqmlengine)
 
 #include "tst_qqmlengine.moc"
@@ -45,6 +45,7 @@ class tst_QQmlImport : public QQmlDataTest
 private slots:
     void testDesignerSupported();
     void uiFormatLoading();
+    void importIndex();
     void cleanup();
 };
 
@@ -127,6 +128,61 @@ void tst_QQmlImport::uiFormatLoading()
     delete test;
 }
 
+static bool writeFile(const QString &filePath, const QByteArray &content)
+{
+    if (!QDir().mkpath(QFileInfo(filePath).absolutePath()))
+        return false;
+    QFile file(filePath);
+    return file.open(QFile::WriteOnly) && file.write(content) == content.size();
+}
+
+static bool writeModule(const QString &importPath, const QByteArray &origin)
+{
+    const QString moduleDir = importPath + QLatin1String("/ImportIndex/");
+    return writeFile(moduleDir + QLatin1String("qmldir"), "module ImportIndex\nMarker 1.0 Marker.qml\n")
+        && writeFile(moduleDir + QLatin1String("Marker.qml"),
+                     "import QtQml 2.0\nQtObject { property string origin: \"" + origin + "\" }\n");
+}
+
+void tst_QQmlImport::importIndex()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString firstPath = dir.path() + QLatin1String("/first");
+    const QString secondPath = dir.path() + QLatin1String("/second");
+    const QString indexPath = dir.path() + QLatin1String("/importindex");
+    const QString documentPath = dir.path() + QLatin1String("/main.qml");
+    QVERIFY(QDir().mkpath(firstPath));
+    QVERIFY(writeModule(secondPath, "second"));
+    QVERIFY(writeFile(documentPath, "import ImportIndex 1.0\nMarker {}\n"));
+
+    qputenv("QML_IMPORT_INDEX", QFile::encodeName(indexPath));
+
+    // The first run records the module found in the second import path.  A module installed
+    // into the first import path afterwards is only found once the index is removed, which
+    // shows that the second run resolved the import from the index.
+    const char *expectedOrigins[] = { "second", "second", "first" };
+    for (int run = 0; run < 3; ++run) {
+        if (run == 1) {
+            QVERIFY(QFile::exists(indexPath));
+            QVERIFY(writeModule(firstPath, "first"));
+        } else if (run == 2) {
+            QVERIFY(QFile::remove(indexPath));
+        }
+
+        QQmlEngine engine;
+        engine.addImportPath(secondPath);
+        engine.addImportPath(firstPath);
+        QQmlComponent component(&engine, QUrl::fromLocalFile(documentPath));
+        QScopedPointer<QObject> object(component.create());
+        QVERIFY2(object, qPrintable(component.errorString()));
+        QCOMPARE(object->property("origin").toString(), QString::fromLatin1(expectedOrigins[run]));
+    }
+
+    qunsetenv("QML_IMPORT_INDEX");
+    QVERIFY(QFile::exists(indexPath));
+}
+
 QTEST_MAIN(tst_QQmlImport)
 
 #include "tst_qqmlimport.moc"
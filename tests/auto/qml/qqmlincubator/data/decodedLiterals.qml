@@ -0,0 +1,14 @@
+import QtQuick 2.0
+
+Item {
+    property color colorValue: "#80ff0000"
+    property rect rectValue: "1,2,3,4"
+    property point pointValue: "5,6"
+    property size sizeValue: "7x8"
+    property date dateValue: "2015-09-21"
+
+    Item {
+        objectName: "child"
+        property rect rectValue: "10,20,30,40"
+    }
+}
@@ -43,9 +43,14 @@
 #include <QQmlProperty>
 #include <QQmlComponent>
 #include <QQmlIncubator>
+#include <QThreadPool>
+#include <QColor>
+#include <QRectF>
 #include "../../shared/util.h"
 #include <private/qqmlincubator_p.h>
 #include <private/qqmlobjectcreator_p.h>
+#include <private/qqmlcomponent_p.h>
+#include <private/qqmlengine_p.h>
 
 class tst_qqmlincubator : public QQmlDataTest
 {
@@ -73,6 +78,8 @@ private slots:
     void chainedAsynchronousClear();
     void selfDelete();
     void contextDelete();
+    void decodedLiterals();
+    void decodedLiteralsEngineDeleted();
 
 private:
     QQmlIncubationController controller;
@@ -1149,6 +1156,58 @@ void tst_qqmlincubator::contextDelete()
     }
 }
 
+void tst_qqmlincubator::decodedLiterals()
+{
+    QQmlComponent component(&engine, testFileUrl("decodedLiterals.qml"));
+    QVERIFY(component.isReady());
+
+    QQmlIncubator incubator;
+    component.create(incubator);
+    QVERIFY(incubator.isLoading());
+
+    // The literal values are decoded on a worker thread of the engine.
+    QQmlEnginePrivate::get(&engine)->literalDecodingThreadPool()->waitForDone();
+    QVERIFY(QQmlComponentPrivate::get(&component)->cc->decodedLiterals.load() != 0);
+
+    {
+        bool b = true;
+        controller.incubateWhile(&b);
+    }
+
+    QVERIFY(incubator.isReady());
+    QScopedPointer<QObject> object(incubator.object());
+    QVERIFY(object);
+
+    QCOMPARE(object->property("colorValue").value<QColor>(), QColor(255, 0, 0, 128));
+    QCOMPARE(object->property("rectValue").toRectF(), QRectF(1, 2, 3, 4));
+    QCOMPARE(object->property("pointValue").toPointF(), QPointF(5, 6));
+    QCOMPARE(object->property("sizeValue").toSizeF(), QSizeF(7, 8));
+    QCOMPARE(object->property("dateValue").toDate(), QDate(2015, 9, 21));
+
+    QObject *child = object->findChild<QObject *>("child");
+    QVERIFY(child);
+    QCOMPARE(child->property("rectValue").toRectF(), QRectF(10, 20, 30, 40));
+}
+
+void tst_qqmlincubator::decodedLiteralsEngineDeleted()
+{
+    // Pending decoding jobs may hold the last reference to the compiled data; the engine
+    // must see them finished or cancelled before it goes away.
+    for (int ii = 0; ii < 10; ++ii) {
+        QQmlEngine *localEngine = new QQmlEngine;
+        QQmlComponent *component = new QQmlComponent(localEngine, testFileUrl("decodedLiterals.qml"));
+        QVERIFY(component->isReady());
+
+        QQmlIncubator incubator;
+        component->create(incubator);
+        QVERIFY(incubator.isLoading());
+
+        incubator.clear();
+        delete component;
+        delete localEngine;
+    }
+}
+
 QTEST_MAIN(tst_qqmlincubator)
 
 #include "tst_qqmlincubator.moc"
@@ -144,6 +144,7 @@ private slots:
     void find();
     void findInsertPosition_data();
     void findInsertPosition();
+    void findFragmented();
     void insert();
     void clearFlags_data();
     void clearFlags();
@@ -152,6 +153,8 @@ private slots:
     void move_data();
     void move();
     void moveFromEnd();
+    void reorder_data();
+    void reorder();
     void clear();
     void listItemsInserted_data();
     void listItemsInserted();
@@ -286,6 +289,61 @@ void tst_qqmllistcompositor::findInsertPosition()
     QCOMPARE(it->index, rangeIndex);
 }
 
+void tst_qqmllistcompositor::findFragmented()
+{
+    // Enough single item ranges that lookups are served from the range index.
+    static const int flagCycle[] = {
+        C::DefaultFlag, VisibleFlag, C::DefaultFlag | SelectionFlag, VisibleFlag | SelectionFlag
+    };
+    const int itemCount = 400;
+    int a[itemCount];
+
+    QQmlListCompositor compositor;
+    compositor.setGroupCount(4);
+
+    QVector<int> itemFlags;
+    for (int i = 0; i < itemCount; ++i) {
+        itemFlags.append(flagCycle[i % lengthOf(flagCycle)]);
+        compositor.append(a, i, 1, itemFlags.last());
+    }
+
+    for (int pass = 0; pass < 3; ++pass) {
+        if (pass == 2) {
+            // Changes discard the index; it's rebuilt by later lookups.
+            compositor.setFlags(C::Default, 10, 5, SelectionFlag);
+            for (int i = 0, defaultIndex = 0; i < itemCount; ++i) {
+                if (itemFlags.at(i) & C::DefaultFlag) {
+                    if (defaultIndex >= 10 && defaultIndex < 15)
+                        itemFlags[i] |= SelectionFlag;
+                    ++defaultIndex;
+                }
+            }
+        }
+
+        for (int group = C::Default; group <= Selection; ++group) {
+            int expected[4] = { 0, 0, 0, 0 };
+            for (int i = 0; i < itemCount; ++i) {
+                if (itemFlags.at(i) & (1 << group)) {
+                    QQmlListCompositor::iterator it = compositor.find(C::Group(group), expected[group]);
+                    QCOMPARE(it.modelIndex(), i);
+                    QCOMPARE(it.index[C::Default], expected[C::Default]);
+                    QCOMPARE(it.index[Visible], expected[Visible]);
+                    QCOMPARE(it.index[Selection], expected[Selection]);
+
+                    QQmlListCompositor::insert_iterator insertIt
+                            = compositor.findInsertPosition(C::Group(group), expected[group]);
+                    QCOMPARE(insertIt.modelIndex(), i);
+                }
+                for (int j = C::Default; j <= Selection; ++j) {
+                    if (itemFlags.at(i) & (1 << j))
+                        ++expected[j];
+                }
+            }
+            QCOMPARE(compositor.count(C::Group(group)), expected[group]);
+        }
+    }
+}
+
 void tst_qqmllistcompositor::insert()
 {
     QQmlListCompositor compositor;
@@ -1066,6 +1124,89 @@ void tst_qqmllistcompositor::moveFromEnd()
     QCOMPARE(it.modelIndex(), 0);
 }
 
+void tst_qqmllistcompositor::reorder_data()
+{
+    QTest::addColumn<QVector<int> >("order");
+    QTest::addColumn<int>("expectedMoves");
+
+    QTest::newRow("sorted")
+            << (QVector<int>() << 0 << 1 << 2 << 3 << 4 << 5 << 6 << 7 << 8 << 9) << 0;
+    QTest::newRow("first to end")
+            << (QVector<int>() << 1 << 2 << 3 << 4 << 5 << 6 << 7 << 8 << 9 << 0) << 1;
+    QTest::newRow("last to start")
+            << (QVector<int>() << 9 << 0 << 1 << 2 << 3 << 4 << 5 << 6 << 7 << 8) << 1;
+    QTest::newRow("swap ranges")
+            << (QVector<int>() << 5 << 6 << 7 << 8 << 9 << 0 << 1 << 2 << 3 << 4) << 3;
+    QTest::newRow("reversed")
+            << (QVector<int>() << 9 << 8 << 7 << 6 << 5 << 4 << 3 << 2 << 1 << 0) << 9;
+    QTest::newRow("shuffled")
+            << (QVector<int>() << 3 << 7 << 0 << 9 << 4 << 1 << 8 << 2 << 6 << 5) << 6;
+}
+
+void tst_qqmllistcompositor::reorder()
+{
+    QFETCH(QVector<int>, order);
+    QFETCH(int, expectedMoves);
+
+    int listA; void *a = &listA;
+
+    QQmlListCompositor compositor;
+    compositor.setGroupCount(4);
+    compositor.setDefaultGroups(VisibleFlag | C::DefaultFlag);
+    compositor.append(a, 0, 10, C::AppendFlag | C::PrependFlag | VisibleFlag | C::DefaultFlag);
+    compositor.setFlags(C::Default, 2, 3, SelectionFlag);
+    compositor.setFlags(C::Default, 6, 2, C::CacheFlag);
+
+    QVector<C::Remove> removes;
+    QVector<C::Insert> inserts;
+    compositor.reorder(C::Default, order, &removes, &inserts);
+
+    QCOMPARE(compositor.count(C::Default), 10);
+    QCOMPARE(compositor.count(Visible), 10);
+    QCOMPARE(compositor.count(Selection), 3);
+    QCOMPARE(compositor.count(C::Cache), 2);
+    QCOMPARE(removes.count(), expectedMoves);
+    QCOMPARE(inserts.count(), expectedMoves);
+
+    QVector<int> selectionOrder;
+    for (int i = 0; i < order.count(); ++i) {
+        C::iterator it = compositor.find(C::Default, i);
+        QCOMPARE(it->list, a);
+        QCOMPARE(it.modelIndex(), order.at(i));
+        QCOMPARE(compositor.find(Visible, i).modelIndex(), order.at(i));
+        if (order.at(i) >= 2 && order.at(i) < 5)
+            selectionOrder.append(order.at(i));
+    }
+    for (int i = 0; i < selectionOrder.count(); ++i)
+        QCOMPARE(compositor.find(Selection, i).modelIndex(), selectionOrder.at(i));
+
+    // Replaying the notifications on the original order gives the new order.
+    QVector<int> items;
+    for (int i = 0; i < order.count(); ++i)
+        items.append(i);
+    QHash<int, QVector<int> > movedItems;
+    foreach (const C::Remove &remove, removes) {
+        QVERIFY(remove.isMove());
+        QVERIFY(remove.inGroup(C::Default));
+        movedItems.insert(remove.moveId, items.mid(remove.index[C::Default], remove.count));
+        items.remove(remove.index[C::Default], remove.count);
+    }
+    foreach (const C::Insert &insert, inserts) {
+        QVERIFY(movedItems.contains(insert.moveId));
+        const QVector<int> moved = movedItems.take(insert.moveId);
+        QCOMPARE(moved.count(), insert.count);
+        for (int i = 0; i < moved.count(); ++i)
+            items.insert(insert.index[C::Default] + i, moved.at(i));
+    }
+    QVERIFY(movedItems.isEmpty());
+    QCOMPARE(items, order);
+
+    // Items inserted into the source list after a reorder still land in the compositor.
+    QVector<C::Insert> listInserts;
+    compositor.listItemsInserted(a, 10, 1, &listInserts);
+    QCOMPARE(compositor.count(C::Default), 11);
+}
+
 void tst_qqmllistcompositor::clear()
 {
     QQmlListCompositor compositor;
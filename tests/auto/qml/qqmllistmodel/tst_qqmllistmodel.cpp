@@ -74,6 +74,59 @@ static bool isValidErrorMessage(const QString &msg, bool dynamicRoleTest)
     return valid;
 }
 
+// Checks the rows reported by the row signals against rowCount() when they are emitted,
+// the way QAbstractItemModel and the views do.
+class RowCountChecker : public QObject
+{
+    Q_OBJECT
+public:
+    RowCountChecker(QAbstractItemModel *model)
+        : model(model), expected(model->rowCount(QModelIndex()))
+    {
+        connect(model, SIGNAL(rowsAboutToBeRemoved(QModelIndex,int,int)), this, SLOT(aboutToBeRemoved(QModelIndex,int,int)));
+        connect(model, SIGNAL(rowsRemoved(QModelIndex,int,int)), this, SLOT(removed(QModelIndex,int,int)));
+        connect(model, SIGNAL(rowsAboutToBeInserted(QModelIndex,int,int)), this, SLOT(aboutToBeInserted(QModelIndex,int,int)));
+        connect(model, SIGNAL(rowsInserted(QModelIndex,int,int)), this, SLOT(inserted(QModelIndex,int,int)));
+    }
+
+    QAbstractItemModel *model;
+    int expected;
+    QStringList errors;
+
+private slots:
+    void aboutToBeRemoved(const QModelIndex &, int first, int last)
+    {
+        check(QStringLiteral("rowsAboutToBeRemoved"), expected);
+        if (first < 0 || last < first || last >= model->rowCount(QModelIndex()))
+            errors.append(QStringLiteral("removing rows %1-%2 of %3").arg(first).arg(last).arg(model->rowCount(QModelIndex())));
+        else if (!model->index(last, 0).isValid())
+            errors.append(QStringLiteral("no index for removed row %1").arg(last));
+    }
+    void removed(const QModelIndex &, int first, int last)
+    {
+        expected -= last - first + 1;
+        check(QStringLiteral("rowsRemoved"), expected);
+    }
+    void aboutToBeInserted(const QModelIndex &, int first, int last)
+    {
+        check(QStringLiteral("rowsAboutToBeInserted"), expected);
+        if (first < 0 || last < first || first > model->rowCount(QModelIndex()))
+            errors.append(QStringLiteral("inserting rows %1-%2 into %3").arg(first).arg(last).arg(model->rowCount(QModelIndex())));
+    }
+    void inserted(const QModelIndex &, int first, int last)
+    {
+        expected += last - first + 1;
+        check(QStringLiteral("rowsInserted"), expected);
+    }
+
+private:
+    void check(const QString &signal, int count)
+    {
+        if (model->rowCount(QModelIndex()) != count)
+            errors.append(QStringLiteral("rowCount() is %1 at %2, expected %3").arg(model->rowCount(QModelIndex())).arg(signal).arg(count));
+    }
+};
+
 class tst_qqmllistmodel : public QQmlDataTest
 {
     Q_OBJECT
@@ -125,6 +178,10 @@ private slots:
     void datetime();
     void datetime_data();
     void about_to_be_signals();
+    void columnarStorage();
+    void columnarStringTable();
+    void batch();
+    void batchRemove();
 };
 
 bool tst_qqmllistmodel::compareVariantList(const QVariantList &testList, QVariant object)
@@ -1427,6 +1484,188 @@ void tst_qqmllistmodel::about_to_be_signals()
     QCOMPARE(tester.rowsRemovedCount, 0);
 }
 
+void tst_qqmllistmodel::columnarStorage()
+{
+    QQmlEngine engine;
+    QQmlListModel model;
+    model.setColumnarStorage(true);
+    QVERIFY(model.columnarStorage());
+    QQmlEngine::setContextForObject(&model, engine.rootContext());
+    engine.rootContext()->setContextObject(&model);
+
+    QSignalSpy insertedSpy(&model, SIGNAL(rowsInserted(QModelIndex,int,int)));
+
+    // A whole array is appended as one insertion.
+    QCOMPARE(RUNEXPR("{ var rows = []; for (var i = 0; i < 100; ++i)"
+                     " rows.push({ id: i, value: i / 2, ok: i % 2 == 0, name: 'n' + (i % 3) });"
+                     " append(rows); count }").toInt(), 100);
+    QCOMPARE(insertedSpy.count(), 1);
+
+    QCOMPARE(model.roleNames().count(), 4);
+    const int idRole = roleFromName(&model, "id");
+    const int valueRole = roleFromName(&model, "value");
+    const int okRole = roleFromName(&model, "ok");
+    const int nameRole = roleFromName(&model, "name");
+
+    QCOMPARE(model.data(7, idRole), QVariant(7));
+    QCOMPARE(model.data(7, valueRole), QVariant(3.5));
+    QCOMPARE(model.data(7, okRole), QVariant(false));
+    QCOMPARE(model.data(7, nameRole), QVariant(QStringLiteral("n1")));
+
+    // The "value" role started with an integer and was promoted to double.
+    QCOMPARE(model.data(8, valueRole), QVariant(4.0));
+    QCOMPARE(RUNEXPR("get(9).value").toDouble(), 4.5);
+    QCOMPARE(RUNEXPR("get(9).name").toString(), QStringLiteral("n0"));
+
+    // Elements that do not set a role read its default value.
+    RUNEXPR("append({ id: 100 })");
+    QCOMPARE(model.data(100, nameRole), QVariant(QString()));
+    QCOMPARE(model.data(100, okRole), QVariant(false));
+
+    // A value of a different type turns the role into a variant role.
+    RUNEXPR("setProperty(0, 'id', 'first')");
+    QCOMPARE(model.data(0, idRole), QVariant(QStringLiteral("first")));
+    QCOMPARE(model.data(1, idRole).toInt(), 1);
+
+    QSignalSpy changedSpy(&model, SIGNAL(dataChanged(QModelIndex,QModelIndex,QVector<int>)));
+    RUNEXPR("set(2, { ok: true, name: 'n2' })");
+    QCOMPARE(changedSpy.count(), 0);
+    RUNEXPR("set(2, { ok: false })");
+    QCOMPARE(changedSpy.count(), 1);
+    QCOMPARE(changedSpy.at(0).at(2).value<QVector<int> >(), QVector<int>() << okRole);
+
+    RUNEXPR("move(0, 98, 3)");
+    QCOMPARE(model.data(0, idRole).toInt(), 3);
+    QCOMPARE(model.data(98, idRole), QVariant(QStringLiteral("first")));
+    QCOMPARE(model.data(100, idRole).toInt(), 2);
+
+    RUNEXPR("remove(0, 50)");
+    QCOMPARE(model.count(), 51);
+    QCOMPARE(model.data(0, idRole).toInt(), 53);
+
+    RUNEXPR("clear()");
+    QCOMPARE(model.count(), 0);
+    QCOMPARE(model.roleNames().count(), 4);
+
+    // The storage can only be chosen while the model is empty of roles.
+    QTest::ignoreMessage(QtWarningMsg, "<Unknown File>: QML ListModel: unable to change the storage of this model as it is not empty!");
+    model.setColumnarStorage(false);
+    QVERIFY(model.columnarStorage());
+}
+
+void tst_qqmllistmodel::columnarStringTable()
+{
+    QQmlEngine engine;
+    QQmlListModel model;
+    model.setColumnarStorage(true);
+    QQmlEngine::setContextForObject(&model, engine.rootContext());
+    engine.rootContext()->setContextObject(&model);
+
+    RUNEXPR("for (var i = 0; i < 10; ++i) append({ name: 'a' + i, label: 'b' })");
+    QCOMPARE(model.columnarStringCount(), 12);
+
+    // Rewriting a string column doesn't keep every value it ever held.
+    RUNEXPR("for (var n = 0; n < 1000; ++n) for (var i = 0; i < 10; ++i) setProperty(i, 'name', 'v' + n + '_' + i)");
+    QVERIFY(model.columnarStringCount() < 200);
+
+    const int nameRole = roleFromName(&model, "name");
+    const int labelRole = roleFromName(&model, "label");
+    for (int i = 0; i < 10; ++i) {
+        QCOMPARE(model.data(i, nameRole).toString(), QString(QLatin1String("v999_") + QString::number(i)));
+        QCOMPARE(model.data(i, labelRole).toString(), QStringLiteral("b"));
+    }
+
+    RUNEXPR("clear()");
+    QCOMPARE(model.columnarStringCount(), 1);
+}
+
+void tst_qqmllistmodel::batch()
+{
+    QQmlEngine engine;
+    QQmlListModel model;
+    QQmlEngine::setContextForObject(&model, engine.rootContext());
+    engine.rootContext()->setContextObject(&model);
+
+    RUNEXPR("{ for (var i = 0; i < 10; ++i) append({ value: i }) }");
+    QCOMPARE(model.count(), 10);
+
+    QSignalSpy insertedSpy(&model, SIGNAL(rowsInserted(QModelIndex,int,int)));
+    QSignalSpy removedSpy(&model, SIGNAL(rowsRemoved(QModelIndex,int,int)));
+    QSignalSpy changedSpy(&model, SIGNAL(dataChanged(QModelIndex,QModelIndex,QVector<int>)));
+    QSignalSpy countSpy(&model, SIGNAL(countChanged()));
+
+    RUNEXPR("beginBatch()");
+    RUNEXPR("{ for (var i = 0; i < 100; ++i) append({ value: 10 + i }) }");
+    RUNEXPR("{ for (var i = 0; i < 5; ++i) setProperty(i, 'value', -i - 1) }");
+    RUNEXPR("remove(50, 20)");
+    QCOMPARE(model.count(), 90);
+    QCOMPARE(insertedSpy.count(), 0);
+    QCOMPARE(removedSpy.count(), 0);
+    QCOMPARE(changedSpy.count(), 0);
+    QCOMPARE(countSpy.count(), 0);
+
+    // Nested batches only deliver on the outermost endBatch().
+    RUNEXPR("beginBatch()");
+    RUNEXPR("endBatch()");
+    QCOMPARE(insertedSpy.count(), 0);
+
+    RUNEXPR("endBatch()");
+
+    // The appended rows and the removal inside them collapse into one insert.
+    QCOMPARE(removedSpy.count(), 0);
+    QCOMPARE(insertedSpy.count(), 1);
+    QCOMPARE(insertedSpy.at(0).at(1).toInt(), 10);
+    QCOMPARE(insertedSpy.at(0).at(2).toInt(), 89);
+    QCOMPARE(changedSpy.count(), 1);
+    QCOMPARE(changedSpy.at(0).at(0).value<QModelIndex>().row(), 0);
+    QCOMPARE(changedSpy.at(0).at(1).value<QModelIndex>().row(), 4);
+    QCOMPARE(countSpy.count(), 1);
+
+    QTest::ignoreMessage(QtWarningMsg, "<Unknown File>: QML ListModel: endBatch: no batch in progress");
+    RUNEXPR("endBatch()");
+}
+
+void tst_qqmllistmodel::batchRemove()
+{
+    QQmlEngine engine;
+    QQmlListModel model;
+    QQmlEngine::setContextForObject(&model, engine.rootContext());
+    engine.rootContext()->setContextObject(&model);
+
+    RUNEXPR("{ for (var i = 0; i < 10; ++i) append({ value: i }) }");
+    QCOMPARE(model.count(), 10);
+
+    RowCountChecker checker(&model);
+    QSignalSpy removedSpy(&model, SIGNAL(rowsRemoved(QModelIndex,int,int)));
+    QSignalSpy insertedSpy(&model, SIGNAL(rowsInserted(QModelIndex,int,int)));
+    QSignalSpy countSpy(&model, SIGNAL(countChanged()));
+
+    // Two separate removes that leave 2 of the 10 rows, and an insert after them.
+    RUNEXPR("beginBatch()");
+    RUNEXPR("remove(0, 4)");
+    RUNEXPR("remove(2, 4)");
+    RUNEXPR("insert(1, { value: 100 })");
+    RUNEXPR("endBatch()");
+
+    QCOMPARE(model.count(), 3);
+    QCOMPARE(checker.errors, QStringList());
+    QCOMPARE(checker.expected, 3);
+    QCOMPARE(removedSpy.count(), 2);
+    QCOMPARE(insertedSpy.count(), 1);
+    QCOMPARE(countSpy.count(), 1);
+    QCOMPARE(model.rowCount(QModelIndex()), 3);
+    QCOMPARE(RUNEXPR("get(0).value").toInt(), 4);
+    QCOMPARE(RUNEXPR("get(1).value").toInt(), 100);
+    QCOMPARE(RUNEXPR("get(2).value").toInt(), 5);
+
+    // Removing all but the last rows.
+    RUNEXPR("beginBatch()");
+    RUNEXPR("remove(0, 2)");
+    RUNEXPR("endBatch()");
+    QCOMPARE(checker.errors, QStringList());
+    QCOMPARE(checker.expected, 1);
+}
+
 QTEST_MAIN(tst_qqmllistmodel)
 
 #include "tst_qqmllistmodel.moc"
@@ -0,0 +1,41 @@
+import QtQuick 2.0
+
+Item {
+    id: item
+    width: 100
+    height: 200
+    property variant model
+    property bool done: false
+    property alias view: list
+
+    function evalExpressionViaWorker(commands) {
+        done = false
+        worker.sendMessage({'commands': commands, 'model': model})
+    }
+
+    function runEval(js) {
+        eval(js);
+    }
+
+    function valueAt(y) {
+        var delegate = list.itemAt(0, y)
+        return delegate ? delegate.value : -1
+    }
+
+    ListView {
+        id: list
+        anchors.fill: parent
+        model: item.model
+        delegate: Item {
+            property int value: model.value
+            width: 100
+            height: 10
+        }
+    }
+
+    WorkerScript {
+        id: worker
+        source: "script.js"
+        onMessage: item.done = true
+    }
+}
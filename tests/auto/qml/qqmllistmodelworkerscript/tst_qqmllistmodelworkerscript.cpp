@@ -33,6 +33,7 @@
 #include <qtest.h>
 #include <QtQuick/private/qquickitem_p.h>
 #include <QtQuick/private/qquicktext_p.h>
+#include <QtQuick/qquickwindow.h>
 #include <QtQml/private/qqmlengine_p.h>
 #include <QtQml/private/qqmllistmodel_p.h>
 #include <QtQml/private/qqmlexpression_p.h>
@@ -109,6 +110,9 @@ private slots:
     void worker_remove_list();
     void dynamic_role_data();
     void dynamic_role();
+    void worker_sync_columnar();
+    void worker_remove_view_data();
+    void worker_remove_view();
 };
 
 bool tst_qqmllistmodelworkerscript::compareVariantList(const QVariantList &testList, QVariant object)
@@ -846,6 +850,127 @@ void tst_qqmllistmodelworkerscript::dynamic_role()
     qApp->processEvents();
 }
 
+void tst_qqmllistmodelworkerscript::worker_sync_columnar()
+{
+    QQmlListModel model;
+    model.setColumnarStorage(true);
+    QQmlEngine eng;
+    QQmlComponent component(&eng, testFileUrl("model.qml"));
+    QQuickItem *item = createWorkerTest(&eng, &component, &model);
+    QVERIFY(item != 0);
+
+    RUNEVAL(item, "model.append([{ value: 1, name: 'a' }, { value: 2, name: 'b' }])");
+    QCOMPARE(model.count(), 2);
+
+    QSignalSpy spyInserted(&model, SIGNAL(rowsInserted(QModelIndex,int,int)));
+    QSignalSpy spyRemoved(&model, SIGNAL(rowsRemoved(QModelIndex,int,int)));
+    QSignalSpy spyChanged(&model, SIGNAL(dataChanged(QModelIndex,QModelIndex,QVector<int>)));
+    QSignalSpy spyCount(&model, SIGNAL(countChanged()));
+
+    QStringList commands;
+    commands << "append({ value: 3, name: 'c' })"
+             << "append({ value: 4, name: 'd' })"
+             << "append({ value: 5, name: 'e' })"
+             << "setProperty(2, 'value', 30)"
+             << "remove(3)"
+             << "setProperty(0, 'name', 'z')";
+    QVERIFY(QMetaObject::invokeMethod(item, "evalExpressionViaWorker",
+            Q_ARG(QVariant, commands)));
+    waitForWorker(item);
+
+    QCOMPARE(model.count(), 4);
+    const int valueRole = roleFromName(&model, "value");
+    const int nameRole = roleFromName(&model, "name");
+    QCOMPARE(model.data(0, nameRole).toString(), QStringLiteral("z"));
+    QCOMPARE(model.data(2, valueRole).toInt(), 30);
+    QCOMPARE(model.data(3, valueRole).toInt(), 5);
+
+    // The worker's changes arrive as one insertion and one change.
+    QCOMPARE(spyRemoved.count(), 0);
+    QCOMPARE(spyInserted.count(), 1);
+    QCOMPARE(spyInserted.at(0).at(1).toInt(), 2);
+    QCOMPARE(spyInserted.at(0).at(2).toInt(), 3);
+    QCOMPARE(spyChanged.count(), 1);
+    QCOMPARE(spyChanged.at(0).at(0).value<QModelIndex>(), model.index(0, 0, QModelIndex()));
+    QCOMPARE(spyChanged.at(0).at(1).value<QModelIndex>(), model.index(0, 0, QModelIndex()));
+    QCOMPARE(spyCount.count(), 1);
+
+    delete item;
+    qApp->processEvents();
+}
+
+void tst_qqmllistmodelworkerscript::worker_remove_view_data()
+{
+    QTest::addColumn<bool>("columnar");
+
+    QTest::newRow("blocks") << false;
+    QTest::newRow("columnar") << true;
+}
+
+void tst_qqmllistmodelworkerscript::worker_remove_view()
+{
+    QFETCH(bool, columnar);
+
+    QQmlListModel model;
+    model.setColumnarStorage(columnar);
+    QQmlEngine eng;
+    QQmlComponent component(&eng, testFileUrl("workerview.qml"));
+    QQuickItem *item = createWorkerTest(&eng, &component, &model);
+    QVERIFY(item != 0);
+
+    QQuickWindow window;
+    window.resize(100, 200);
+    item->setParentItem(window.contentItem());
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+
+    RUNEVAL(item, "for (var i = 0; i < 10; ++i) model.append({ value: i })");
+    QObject *view = item->property("view").value<QObject *>();
+    QVERIFY(view);
+    QTRY_COMPARE(view->property("count").toInt(), 10);
+
+    QSignalSpy spyRemoved(&model, SIGNAL(rowsRemoved(QModelIndex,int,int)));
+    QSignalSpy spyInserted(&model, SIGNAL(rowsInserted(QModelIndex,int,int)));
+
+    // The sync removes 8 of the 10 rows the view is showing in two separate ranges.
+    QStringList commands;
+    commands << "remove(0, 4)" << "remove(2, 4)";
+    QVERIFY(QMetaObject::invokeMethod(item, "evalExpressionViaWorker",
+            Q_ARG(QVariant, commands)));
+    waitForWorker(item);
+
+    QCOMPARE(model.count(), 2);
+    QCOMPARE(model.rowCount(QModelIndex()), 2);
+    QCOMPARE(spyRemoved.count(), 2);
+    QCOMPARE(spyInserted.count(), 0);
+    QTRY_COMPARE(view->property("count").toInt(), 2);
+
+    QVariant value;
+    QTRY_VERIFY(QMetaObject::invokeMethod(item, "valueAt", Q_RETURN_ARG(QVariant, value), Q_ARG(QVariant, 5))
+                && value.toInt() == 4);
+    QVERIFY(QMetaObject::invokeMethod(item, "valueAt", Q_RETURN_ARG(QVariant, value), Q_ARG(QVariant, 15)));
+    QCOMPARE(value.toInt(), 5);
+
+    // Removes followed by inserts in the same sync.
+    commands.clear();
+    commands << "remove(0)" << "append({ value: 20 })" << "insert(0, { value: 10 })";
+    QVERIFY(QMetaObject::invokeMethod(item, "evalExpressionViaWorker",
+            Q_ARG(QVariant, commands)));
+    waitForWorker(item);
+
+    QCOMPARE(model.count(), 3);
+    QTRY_COMPARE(view->property("count").toInt(), 3);
+    QTRY_VERIFY(QMetaObject::invokeMethod(item, "valueAt", Q_RETURN_ARG(QVariant, value), Q_ARG(QVariant, 5))
+                && value.toInt() == 10);
+    QVERIFY(QMetaObject::invokeMethod(item, "valueAt", Q_RETURN_ARG(QVariant, value), Q_ARG(QVariant, 15)));
+    QCOMPARE(value.toInt(), 5);
+    QVERIFY(QMetaObject::invokeMethod(item, "valueAt", Q_RETURN_ARG(QVariant, value), Q_ARG(QVariant, 25)));
+    QCOMPARE(value.toInt(), 20);
+
+    delete item;
+    qApp->processEvents();
+}
+
 QTEST_MAIN(tst_qqmllistmodelworkerscript)
 
 #include "tst_qqmllistmodelworkerscript.moc"
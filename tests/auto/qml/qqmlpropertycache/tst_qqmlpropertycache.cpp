@@ -33,7 +33,9 @@
 
 #include <qtest.h>
 #include <private/qqmlpropertycache_p.h>
+#include <private/qqmlmetatype_p.h>
 #include <QtQml/qqmlengine.h>
+#include <QtQml/qqml.h>
 #include "../../shared/util.h"
 
 class tst_qqmlpropertycache : public QObject
@@ -49,6 +51,7 @@ private slots:
     void methodsDerived();
     void signalHandlers();
     void signalHandlersDerived();
+    void sharedMembers();
 
 private:
     QQmlEngine engine;
@@ -270,6 +273,39 @@ void tst_qqmlpropertycache::signalHandlersDerived()
     QCOMPARE(data->coreIndex, metaObject->indexOfMethod("propertyDChanged()"));
 }
 
+void tst_qqmlpropertycache::sharedMembers()
+{
+    QVERIFY(!QQmlMetaType::metaObjectMembers(&DerivedObject::staticMetaObject));
+
+    qmlRegisterType<DerivedObject>("Test.SharedMembers", 1, 0, "DerivedObject");
+
+    QQmlRefPointer<QQmlMetaObjectMembers> members;
+    members.take(QQmlMetaType::metaObjectMembers(&DerivedObject::staticMetaObject));
+    QVERIFY(!members.isNull());
+    QCOMPARE(members->propertyCount, DerivedObject::staticMetaObject.propertyCount());
+
+    QQmlRefPointer<QQmlMetaObjectMembers> other;
+    other.take(QQmlMetaType::metaObjectMembers(&DerivedObject::staticMetaObject));
+    QCOMPARE(other.data(), members.data());
+
+    QQmlEngine engine1;
+    QQmlEngine engine2;
+    QQmlRefPointer<QQmlPropertyCache> cache1(new QQmlPropertyCache(&engine1, &DerivedObject::staticMetaObject));
+    QQmlRefPointer<QQmlPropertyCache> cache2(new QQmlPropertyCache(&engine2, &DerivedObject::staticMetaObject));
+
+    QQmlPropertyData *data1;
+    QQmlPropertyData *data2;
+    QVERIFY(data1 = cacheProperty(cache1, "propertyC"));
+    QVERIFY(data2 = cacheProperty(cache2, "propertyC"));
+    QCOMPARE(data1->coreIndex, DerivedObject::staticMetaObject.indexOfProperty("propertyC"));
+    QCOMPARE(data2->coreIndex, data1->coreIndex);
+
+    QVERIFY(data1 = cacheProperty(cache1, "onSignalB"));
+    QVERIFY(data2 = cacheProperty(cache2, "onSignalB"));
+    QCOMPARE(data1->coreIndex, DerivedObject::staticMetaObject.indexOfMethod("signalB()"));
+    QCOMPARE(data2->coreIndex, data1->coreIndex);
+}
+
 QTEST_MAIN(tst_qqmlpropertycache)
 
 #include "tst_qqmlpropertycache.moc"
@@ -0,0 +1,6 @@
+WorkerScript.onMessage = function(msg) {
+    var data = msg.data;
+    for (var i = 0; i < data.length; ++i)
+        data[i] = (data[i] + 1) % 256;
+    WorkerScript.sendMessage(msg, [data.buffer]);
+}
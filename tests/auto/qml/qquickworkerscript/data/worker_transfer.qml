@@ -0,0 +1,60 @@
+import QtQuick 2.0
+
+WorkerScript {
+    id: worker
+    source: "script_transfer.js"
+
+    property bool transferred: false
+    property bool copied: false
+    property bool neutered: false
+    property bool received: false
+
+    signal done()
+
+    function testSend() {
+        var data = new Uint8Array(1024)
+        for (var i = 0; i < data.length; ++i)
+            data[i] = i % 256
+        var copy = new ArrayBuffer(16)
+        var view = new DataView(data.buffer)
+
+        worker.sendMessage({ 'data': data, 'copy': copy }, [data.buffer])
+
+        transferred = data.buffer.byteLength === 0
+        copied = copy.byteLength === 16
+
+        // Views on the transferred buffer are left empty
+        var ok = data.length === 0 && data.byteLength === 0 && data.byteOffset === 0
+                && data[0] === undefined && view.byteLength === 0
+                && new Uint16Array(data).length === 0 && data.subarray(1).length === 0
+        try {
+            data.set([1, 2, 3])
+            ok = false
+        } catch (e) {
+            ok = ok && e instanceof RangeError
+        }
+        try {
+            data.set(new Uint8Array(16))
+            ok = false
+        } catch (e) {
+            ok = ok && e instanceof RangeError
+        }
+        try {
+            view.setUint8(0, 1)
+            ok = false
+        } catch (e) {
+            ok = ok && e instanceof TypeError
+        }
+        neutered = ok
+    }
+
+    onMessage: {
+        var data = messageObject.data
+        var ok = data instanceof Uint8Array && data.length === 1024
+                && messageObject.copy.byteLength === 16
+        for (var i = 0; ok && i < data.length; ++i)
+            ok = data[i] === (i + 1) % 256
+        worker.received = ok
+        worker.done()
+    }
+}
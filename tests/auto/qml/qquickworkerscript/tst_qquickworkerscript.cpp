@@ -47,8 +47,6 @@
 class tst_QQuickWorkerScript : public QQmlDataTest
 {
     Q_OBJECT
-public:
-    tst_QQuickWorkerScript() {}
 private slots:
     void source();
     void messaging();
@@ -56,6 +54,7 @@ private slots:
     void messaging_sendQObjectList();
     void messaging_sendJsObject();
     void messaging_sendExternalObject();
+    void messaging_transferArrayBuffer();
     void script_with_pragma();
     void script_included();
     void scriptError_onLoad();
@@ -64,6 +63,7 @@ private slots:
     void script_var();
     void script_global();
     void stressDispose();
+    void threadPool();
 
 private:
     void waitForEchoMessage(QQuickWorkerScript *worker) {
@@ -203,6 +203,24 @@ void tst_QQuickWorkerScript::messaging_sendExternalObject()
     delete obj;
 }
 
+void tst_QQuickWorkerScript::messaging_transferArrayBuffer()
+{
+    QQmlComponent component(&m_engine, testFileUrl("worker_transfer.qml"));
+    QQuickWorkerScript *worker = qobject_cast<QQuickWorkerScript*>(component.create());
+    QVERIFY(worker != 0);
+
+    QVERIFY(QMetaObject::invokeMethod(worker, "testSend"));
+    QVERIFY(worker->property("transferred").toBool());
+    QVERIFY(worker->property("copied").toBool());
+    QVERIFY(worker->property("neutered").toBool());
+
+    waitForEchoMessage(worker);
+    QVERIFY(worker->property("received").toBool());
+
+    qApp->processEvents();
+    delete worker;
+}
+
 void tst_QQuickWorkerScript::script_with_pragma()
 {
     QVariant value(100);
@@ -372,6 +390,35 @@ void tst_QQuickWorkerScript::stressDispose()
     }
 }
 
+// QML_WORKER_SCRIPT_THREADS is set to 2 in the constructor
+void tst_QQuickWorkerScript::threadPool()
+{
+    qputenv("QML_WORKER_SCRIPT_THREADS", "2");
+    QQmlEngine engine;
+    qunsetenv("QML_WORKER_SCRIPT_THREADS");
+    QList<QQuickWorkerScript *> workers;
+    for (int ii = 0; ii < 3; ++ii) {
+        QQmlComponent component(&engine, testFileUrl("worker.qml"));
+        QQuickWorkerScript *worker = qobject_cast<QQuickWorkerScript*>(component.create());
+        QVERIFY(worker != 0);
+        workers << worker;
+    }
+
+    QCOMPARE(QQmlEnginePrivate::get(&engine)->workerScriptEngines.count(), 2);
+    QCOMPARE(QQmlEnginePrivate::get(&engine)->workerScriptEngines.at(0)->scriptCount(), 2);
+    QCOMPARE(QQmlEnginePrivate::get(&engine)->workerScriptEngines.at(1)->scriptCount(), 1);
+
+    for (int ii = 0; ii < workers.count(); ++ii) {
+        QQuickWorkerScript *worker = workers.at(ii);
+        QVERIFY(QMetaObject::invokeMethod(worker, "testSend", Q_ARG(QVariant, QVariant(ii))));
+        waitForEchoMessage(worker);
+        QCOMPARE(worker->property("response").toInt(), ii);
+    }
+
+    qApp->processEvents();
+    qDeleteAll(workers);
+}
+
 QTEST_MAIN(tst_QQuickWorkerScript)
 
 #include "tst_qquickworkerscript.moc"
@@ -0,0 +1,29 @@
+import QtQuick 2.7
+
+GridView {
+    id: grid
+    width: 240
+    height: 320
+    cellWidth: 80
+    cellHeight: 60
+    cacheBuffer: 0
+    reuseItems: true
+    model: 300
+
+    property int createdCount: 0
+    property int pooledCount: 0
+    property int reusedCount: 0
+
+    delegate: Rectangle {
+        objectName: "wrapper"
+        width: grid.cellWidth
+        height: grid.cellHeight
+        property int itemIndex: index
+
+        Component.onCompleted: grid.createdCount++
+        GridView.onPooled: grid.pooledCount++
+        GridView.onReused: grid.reusedCount++
+
+        Text { text: index }
+    }
+}
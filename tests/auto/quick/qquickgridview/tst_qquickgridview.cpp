@@ -206,6 +206,8 @@ private slots:
 
     void jsArrayChange();
 
+    void reuseItems();
+
 private:
     QList<int> toIntList(const QVariantList &list);
     void matchIndexLists(const QVariantList &indexLists, const QList<int> &expectedIndexes);
@@ -6460,6 +6462,46 @@ void tst_QQuickGridView::jsArrayChange()
     QCOMPARE(spy.count(), 1);
 }
 
+void tst_QQuickGridView::reuseItems()
+{
+    QScopedPointer<QQuickView> window(createView());
+    window->setSource(testFileUrl("reuseItems.qml"));
+    window->show();
+    QVERIFY(QTest::qWaitForWindowExposed(window.data()));
+
+    QQuickGridView *gridview = qobject_cast<QQuickGridView *>(window->rootObject());
+    QVERIFY(gridview);
+    QVERIFY(gridview->reuseItems());
+    QTRY_COMPARE(QQuickItemPrivate::get(gridview)->polishScheduled, false);
+
+    const int initialCount = gridview->property("createdCount").toInt();
+    QVERIFY(initialCount > 0);
+
+    // Scroll a page at a time; whole rows leaving the view must be pooled
+    // and handed out again rather than destroyed and created from scratch.
+    for (int i = 1; i <= 10; ++i) {
+        gridview->setContentY(i * gridview->height());
+        QTRY_COMPARE(QQuickItemPrivate::get(gridview)->polishScheduled, false);
+    }
+
+    QVERIFY(gridview->property("pooledCount").toInt() > 0);
+    QVERIFY(gridview->property("reusedCount").toInt() > 0);
+    QVERIFY(gridview->property("createdCount").toInt() <= initialCount + 2 * 3);
+
+    // Row 55 is the first row fully inside the last page.
+    QQuickItem *item = findItem<QQuickItem>(gridview->contentItem(), "wrapper", 165);
+    QVERIFY(item);
+    QCOMPARE(item->property("itemIndex").toInt(), 165);
+    QCOMPARE(item->y(), qreal(55 * 60));
+
+    // Switching reuse off stops pooling.
+    gridview->setReuseItems(false);
+    const int pooledCount = gridview->property("pooledCount").toInt();
+    gridview->setContentY(0);
+    QTRY_COMPARE(QQuickItemPrivate::get(gridview)->polishScheduled, false);
+    QCOMPARE(gridview->property("pooledCount").toInt(), pooledCount);
+}
+
 QTEST_MAIN(tst_QQuickGridView)
 
 #include "tst_qquickgridview.moc"
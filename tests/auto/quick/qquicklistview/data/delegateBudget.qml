@@ -0,0 +1,14 @@
+import QtQuick 2.0
+
+ListView {
+    width: 240
+    height: 320
+    model: 1000
+    cacheBuffer: 0
+    delegate: Rectangle {
+        objectName: "wrapper"
+        width: ListView.view.width
+        height: 20
+        color: index % 2 ? "white" : "lightsteelblue"
+    }
+}
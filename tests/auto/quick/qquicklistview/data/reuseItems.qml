@@ -0,0 +1,27 @@
+import QtQuick 2.7
+
+ListView {
+    id: list
+    width: 240
+    height: 320
+    cacheBuffer: 0
+    reuseItems: true
+    model: 200
+
+    property int createdCount: 0
+    property int pooledCount: 0
+    property int reusedCount: 0
+
+    delegate: Rectangle {
+        objectName: "wrapper"
+        width: list.width
+        height: 20
+        property int itemIndex: index
+
+        Component.onCompleted: list.createdCount++
+        ListView.onPooled: list.pooledCount++
+        ListView.onReused: list.reusedCount++
+
+        Text { text: index }
+    }
+}
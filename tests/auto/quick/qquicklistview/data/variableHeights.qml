@@ -0,0 +1,13 @@
+import QtQuick 2.0
+
+ListView {
+    width: 240
+    height: 100
+    model: 200
+    delegate: Rectangle {
+        objectName: "wrapper"
+        width: ListView.view.width
+        height: index < 100 ? 10 : 40
+        color: index % 2 ? "white" : "lightsteelblue"
+    }
+}
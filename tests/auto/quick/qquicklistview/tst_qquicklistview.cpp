@@ -241,6 +241,10 @@ private slots:
 
     void jsArrayChange();
 
+    void reuseItems();
+    void delegateCreationBudget();
+    void variableHeightPositions();
+
 private:
     template <class T> void items(const QUrl &source);
     template <class T> void changed(const QUrl &source);
@@ -8001,6 +8005,116 @@ void tst_QQuickListView::jsArrayChange()
     QCOMPARE(spy.count(), 1);
 }
 
+void tst_QQuickListView::reuseItems()
+{
+    QScopedPointer<QQuickView> window(createView());
+    window->setSource(testFileUrl("reuseItems.qml"));
+    window->show();
+    QVERIFY(QTest::qWaitForWindowExposed(window.data()));
+
+    QQuickListView *listview = qobject_cast<QQuickListView *>(window->rootObject());
+    QVERIFY(listview);
+    QVERIFY(listview->reuseItems());
+    QTRY_COMPARE(QQuickItemPrivate::get(listview)->polishScheduled, false);
+
+    const int initialCount = listview->property("createdCount").toInt();
+    QVERIFY(initialCount > 0);
+
+    // Scroll a page at a time; items leaving the view must be pooled and
+    // handed out again rather than destroyed and created from scratch.
+    for (int i = 1; i <= 10; ++i) {
+        listview->setContentY(i * listview->height());
+        QTRY_COMPARE(QQuickItemPrivate::get(listview)->polishScheduled, false);
+    }
+
+    QVERIFY(listview->property("pooledCount").toInt() > 0);
+    QVERIFY(listview->property("reusedCount").toInt() > 0);
+    QVERIFY(listview->property("createdCount").toInt() <= initialCount + 2);
+
+    QQuickItem *item = findItem<QQuickItem>(listview->contentItem(), "wrapper", 160);
+    QVERIFY(item);
+    QCOMPARE(item->property("itemIndex").toInt(), 160);
+
+    // Switching reuse off stops pooling.
+    listview->setReuseItems(false);
+    const int pooledCount = listview->property("pooledCount").toInt();
+    listview->setContentY(0);
+    QTRY_COMPARE(QQuickItemPrivate::get(listview)->polishScheduled, false);
+    QCOMPARE(listview->property("pooledCount").toInt(), pooledCount);
+}
+
+void tst_QQuickListView::delegateCreationBudget()
+{
+    // Without a budget for synchronous creation every delegate entering the view while it
+    // moves is incubated, and the view must still fill in once they're ready.
+    qputenv("QML_ITEMVIEW_DELEGATE_BUDGET", "0");
+    QScopedPointer<QQuickView> window(createView());
+    qunsetenv("QML_ITEMVIEW_DELEGATE_BUDGET");
+    window->setSource(testFileUrl("delegateBudget.qml"));
+    window->show();
+    QVERIFY(QTest::qWaitForWindowExposed(window.data()));
+
+    QQuickListView *listview = qobject_cast<QQuickListView *>(window->rootObject());
+    QVERIFY(listview);
+    QTRY_COMPARE(QQuickItemPrivate::get(listview)->polishScheduled, false);
+
+    const int rows = listview->height() / 20;
+    for (int row = 0; row < rows; ++row)
+        QVERIFY(listview->itemAt(120, row * 20 + 10));
+
+    // Start dragging, so that the view is moving before most of a page is revealed at once.
+    QTest::mousePress(window.data(), Qt::LeftButton, 0, QPoint(120, 300));
+    QTest::mouseMove(window.data(), QPoint(120, 280));
+    QTest::mouseMove(window.data(), QPoint(120, 260));
+    QVERIFY(listview->isMoving());
+    QTest::mouseMove(window.data(), QPoint(120, 20));
+    QVERIFY(listview->contentY() > 200);
+
+    int created = 0;
+    for (int row = 0; row < rows; ++row) {
+        if (listview->itemAt(120, listview->contentY() + row * 20 + 10))
+            ++created;
+    }
+    QVERIFY(created < rows);
+
+    for (int row = 0; row < rows; ++row)
+        QTRY_VERIFY(listview->itemAt(120, listview->contentY() + row * 20 + 10));
+
+    QTest::mouseRelease(window.data(), Qt::LeftButton, 0, QPoint(120, 20));
+}
+
+void tst_QQuickListView::variableHeightPositions()
+{
+    QScopedPointer<QQuickView> window(createView());
+    window->setSource(testFileUrl("variableHeights.qml"));
+    window->show();
+    QVERIFY(QTest::qWaitForWindowExposed(window.data()));
+
+    QQuickListView *listview = qobject_cast<QQuickListView *>(window->rootObject());
+    QVERIFY(listview);
+    QTRY_COMPARE(QQuickItemPrivate::get(listview)->polishScheduled, false);
+
+    // Scroll through the whole model once, so that every delegate size is known.
+    for (int i = 0; i < 1000 && !listview->isAtYEnd(); ++i) {
+        listview->setContentY(listview->contentY() + 50);
+        QTRY_COMPARE(QQuickItemPrivate::get(listview)->polishScheduled, false);
+    }
+    QVERIFY(listview->isAtYEnd());
+
+    // The 10px delegates at the top are no longer used to estimate the 40px ones.
+    listview->positionViewAtBeginning();
+    QTRY_COMPARE(QQuickItemPrivate::get(listview)->polishScheduled, false);
+    QCOMPARE(listview->contentHeight(), 100 * 10.0 + 100 * 40.0);
+
+    // Jumping far away lands on the exact position in a single pass.
+    listview->positionViewAtIndex(150, QQuickListView::Beginning);
+    QTRY_COMPARE(QQuickItemPrivate::get(listview)->polishScheduled, false);
+    QCOMPARE(listview->contentY(), 100 * 10.0 + 50 * 40.0);
+    QQuickItem *item = findItem<QQuickItem>(listview->contentItem(), "wrapper", 150);
+    QVERIFY(item);
+    QCOMPARE(item->y(), listview->contentY());
+}
+
 QTEST_MAIN(tst_QQuickListView)
 
 #include "tst_qquicklistview.moc"
@@ -0,0 +1,33 @@
+import QtQuick 2.7
+
+PathView {
+    id: view
+    width: 400
+    height: 100
+    pathItemCount: 5
+    cacheItemCount: 0
+    reuseItems: true
+    model: 100
+
+    property int createdCount: 0
+    property int pooledCount: 0
+    property int reusedCount: 0
+
+    path: Path {
+        startX: 0; startY: 50
+        PathLine { x: 400; y: 50 }
+    }
+
+    delegate: Rectangle {
+        objectName: "wrapper"
+        width: 60
+        height: 60
+        property int itemIndex: index
+
+        Component.onCompleted: view.createdCount++
+        PathView.onPooled: view.pooledCount++
+        PathView.onReused: view.reusedCount++
+
+        Text { text: index }
+    }
+}
@@ -140,6 +140,7 @@ private slots:
     void nestedinFlickable();
     void flickableDelegate();
     void jsArrayChange();
+    void reuseItems();
 };
 
 class TestObject : public QObject
@@ -2322,6 +2323,56 @@ void tst_QQuickPathView::jsArrayChange()
     QCOMPARE(spy.count(), 1);
 }
 
+static QQuickItem *pathItemForIndex(QQuickPathView *pathview, int index)
+{
+    // Pooled delegates stay children of the view and keep their old index,
+    // so only look at the ones that are shown.
+    foreach (QQuickItem *item, findItems<QQuickItem>(pathview, "wrapper")) {
+        if (item->property("itemIndex").toInt() == index)
+            return item;
+    }
+    return 0;
+}
+
+void tst_QQuickPathView::reuseItems()
+{
+    QScopedPointer<QQuickView> window(createView());
+    window->setSource(testFileUrl("reuseItems.qml"));
+    window->show();
+    QVERIFY(QTest::qWaitForWindowExposed(window.data()));
+
+    QQuickPathView *pathview = qobject_cast<QQuickPathView *>(window->rootObject());
+    QVERIFY(pathview);
+    QVERIFY(pathview->reuseItems());
+    QTRY_VERIFY(pathItemForIndex(pathview, 0));
+
+    const int initialCount = pathview->property("createdCount").toInt();
+    QCOMPARE(initialCount, 5);
+
+    // Move a whole path length at a time; items leaving the path must be
+    // pooled and handed out again rather than destroyed and created anew.
+    for (int i = 1; i <= 10; ++i) {
+        pathview->setOffset(i * 5);
+        QTRY_VERIFY(pathItemForIndex(pathview, (100 - i * 5) % 100));
+    }
+
+    QVERIFY(pathview->property("pooledCount").toInt() > 0);
+    QVERIFY(pathview->property("reusedCount").toInt() > 0);
+    QVERIFY(pathview->property("createdCount").toInt() < 2 * initialCount);
+
+    QQuickItem *item = pathItemForIndex(pathview, 50);
+    QVERIFY(item);
+    QQmlExpression e(qmlContext(item), item, "index");
+    QCOMPARE(e.evaluate().toInt(), 50);
+
+    // Switching reuse off stops pooling.
+    pathview->setReuseItems(false);
+    const int pooledCount = pathview->property("pooledCount").toInt();
+    pathview->setOffset(0);
+    QTRY_VERIFY(pathItemForIndex(pathview, 0));
+    QCOMPARE(pathview->property("pooledCount").toInt(), pooledCount);
+}
+
 QTEST_MAIN(tst_QQuickPathView)
 
 #include "tst_qquickpathview.moc"
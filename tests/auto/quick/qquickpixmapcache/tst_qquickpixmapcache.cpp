@@ -67,6 +67,7 @@ private slots:
 #endif
     void lockingCrash();
     void uncached();
+    void compressed();
 #if PIXMAP_DATA_LEAK_TEST
     void dataLeak();
 #endif
@@ -469,6 +470,65 @@ void tst_qquickpixmapcache::uncached()
     }
 }
 
+void tst_qquickpixmapcache::compressed()
+{
+    QQmlEngine engine;
+
+    // The ETC1 blocks are kept as they are and not decoded into an image.
+    {
+        QQuickPixmap p(&engine, testFileUrl("compressed.pkm"));
+        QVERIFY(p.isReady());
+        QCOMPARE(p.width(), 8);
+        QCOMPARE(p.height(), 8);
+        QVERIFY(p.textureFactory());
+        QCOMPARE(p.textureFactory()->textureByteCount(), 32);
+        QVERIFY(p.image().isNull());
+    }
+
+    {
+        QQuickPixmap p(&engine, testFileUrl("truncated.pkm"));
+        QVERIFY(p.isError());
+    }
+
+    // A PKM header claiming more data than the file holds is rejected before reading it,
+    // and so is one whose data wouldn't fit into memory at all.
+    {
+        QQuickPixmap p(&engine, testFileUrl("oversized.pkm"));
+        QVERIFY(p.isError());
+        QVERIFY(p.error().contains(QLatin1String("Truncated PKM image data")));
+    }
+
+    {
+        QQuickPixmap p(&engine, testFileUrl("huge.pkm"));
+        QVERIFY(p.isError());
+        QVERIFY(p.error().contains(QLatin1String("Invalid PKM texture size")));
+    }
+
+    // KTX files may be written in either byte order and carry key/value data.
+    const char *ktxFiles[] = { "compressed.ktx", "compressed_be.ktx" };
+    for (uint i = 0; i < sizeof(ktxFiles) / sizeof(ktxFiles[0]); ++i) {
+        QQuickPixmap p(&engine, testFileUrl(ktxFiles[i]));
+        QVERIFY2(p.isReady(), ktxFiles[i]);
+        QCOMPARE(p.width(), 8);
+        QCOMPARE(p.height(), 8);
+        QVERIFY(p.textureFactory());
+        QCOMPARE(p.textureFactory()->textureByteCount(), 32);
+    }
+
+    // An image size which doesn't match the format is rejected before reading the data.
+    {
+        QQuickPixmap p(&engine, testFileUrl("badsize.ktx"));
+        QVERIFY(p.isError());
+        QVERIFY(p.error().contains(QLatin1String("Invalid KTX image size")));
+    }
+
+    // So is an image size larger than the rest of the file.
+    {
+        QQuickPixmap p(&engine, testFileUrl("truncated.ktx"));
+        QVERIFY(p.isError());
+        QVERIFY(p.error().contains(QLatin1String("Truncated KTX image data")));
+    }
+}
 
 #if PIXMAP_DATA_LEAK_TEST
 // This test should not be enabled by default as it
@@ -0,0 +1,12 @@
+import QtQuick 2.0
+import QtQml.Models 2.2
+
+DelegateModel {
+    model: countingModel
+    delegate: Item {
+        property var first: role0
+        property var second: role1
+        property int secondChanges: 0
+        onSecondChanged: ++secondChanges
+    }
+}
@@ -0,0 +1,38 @@
+import QtQuick 2.0
+import QtQml.Models 2.3
+
+DelegateModel {
+    id: visualModel
+
+    property int minSize: 0
+
+    function names() {
+        var result = []
+        for (var i = 0; i < items.count; ++i)
+            result.push(items.get(i).model.name)
+        return result.join(",")
+    }
+
+    function append(name, size) { listModel.append({ "name": name, "size": size }) }
+    function setProperty(index, property, value) { listModel.setProperty(index, property, value) }
+    function remove(index) { listModel.remove(index) }
+    function clearFilter() { filter = undefined }
+
+    sortRole: "name"
+    filterRole: "size"
+    filter: function(size) { return size !== 3 && size > minSize }
+
+    model: ListModel {
+        id: listModel
+        ListElement { name: "delta"; size: 4 }
+        ListElement { name: "alpha"; size: 1 }
+        ListElement { name: "echo"; size: 5 }
+        ListElement { name: "charlie"; size: 3 }
+        ListElement { name: "bravo"; size: 2 }
+    }
+
+    delegate: Item {
+        width: 100
+        height: 20
+    }
+}
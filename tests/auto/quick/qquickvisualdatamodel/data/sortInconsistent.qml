@@ -0,0 +1,19 @@
+import QtQml.Models 2.3
+
+DelegateModel {
+    function fill(count) {
+        for (var i = 0; i < count; ++i)
+            listModel.append({ "value": i })
+    }
+
+    function sum() {
+        var result = 0
+        for (var i = 0; i < items.count; ++i)
+            result += items.get(i).model.value
+        return result
+    }
+
+    sortRole: "value"
+
+    model: ListModel { id: listModel }
+}
@@ -0,0 +1,38 @@
+import QtQuick 2.0
+import QtQml.Models 2.3
+
+DelegateModel {
+    id: visualModel
+
+    property int changeCount: 0
+    property int movedCount: 0
+
+    function values() {
+        var result = []
+        for (var i = 0; i < items.count; ++i)
+            result.push(items.get(i).model.value)
+        return result
+    }
+
+    function fill(count) {
+        for (var i = 0; i < count; ++i)
+            listModel.append({ "value": (i * 7919) % count })
+    }
+
+    function setValue(index, value) { listModel.setProperty(index, "value", value) }
+
+    items.onChanged: {
+        ++changeCount
+        for (var i = 0; i < inserted.length; ++i) {
+            if (inserted[i].moveId !== undefined)
+                movedCount += inserted[i].count
+        }
+    }
+
+    model: ListModel { id: listModel }
+
+    delegate: Item {
+        width: 100
+        height: 20
+    }
+}
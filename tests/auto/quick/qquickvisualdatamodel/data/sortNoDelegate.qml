@@ -0,0 +1,20 @@
+import QtQml.Models 2.3
+
+DelegateModel {
+    property int removedCount: 0
+    property int insertedCount: 0
+
+    items.onChanged: {
+        for (var i = 0; i < removed.length; ++i)
+            removedCount += removed[i].count
+        for (var i = 0; i < inserted.length; ++i)
+            insertedCount += inserted[i].count
+    }
+
+    model: ListModel {
+        ListElement { name: "charlie" }
+        ListElement { name: "bravo" }
+        ListElement { name: "alpha" }
+        ListElement { name: "delta" }
+    }
+}
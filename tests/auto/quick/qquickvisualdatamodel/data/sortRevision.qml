@@ -0,0 +1,5 @@
+import QtQml.Models 2.2
+
+DelegateModel {
+    sortRole: "name"
+}
@@ -50,6 +50,7 @@
 #include <private/qqmlengine_p.h>
 #include <math.h>
 #include <QtGui/qstandarditemmodel.h>
+#include <QtCore/qregularexpression.h>
 
 using namespace QQuickVisualTestUtil;
 using namespace QQuickViewTestUtil;
@@ -262,6 +263,44 @@ public:
     }
 };
 
+class CountingRoleModel : public QAbstractListModel
+{
+public:
+    enum { RoleCount = 30 };
+
+    CountingRoleModel(int rows)
+        : values(rows * RoleCount, 0), fetchCounts(RoleCount, 0) {}
+
+    int rowCount(const QModelIndex &) const { return values.count() / RoleCount; }
+
+    QVariant data(const QModelIndex &index, int role) const
+    {
+        role -= Qt::UserRole;
+        if (!index.isValid() || role < 0 || role >= RoleCount)
+            return QVariant();
+        ++fetchCounts[role];
+        return values.at(index.row() * RoleCount + role);
+    }
+
+    QHash<int, QByteArray> roleNames() const
+    {
+        QHash<int, QByteArray> names;
+        for (int role = 0; role < RoleCount; ++role)
+            names.insert(Qt::UserRole + role, "role" + QByteArray::number(role));
+        return names;
+    }
+
+    // Changes a value without telling which role changed.
+    void setValue(int row, int role, int value)
+    {
+        values[row * RoleCount + role] = value;
+        emit dataChanged(index(row), index(row));
+    }
+
+    QVector<int> values;
+    mutable QVector<int> fetchCounts;
+};
+
 class DataSubObject : public QObject
 {
     Q_OBJECT
@@ -430,6 +469,12 @@ private slots:
     void asynchronousMove_data();
     void asynchronousCancel();
     void invalidContext();
+    void sortFilter();
+    void sortLarge();
+    void sortNoDelegate();
+    void sortInconsistentLessThan();
+    void sortRevision();
+    void lazyRoles();
 
 private:
     template <int N> void groups_verify(
@@ -4235,6 +4280,182 @@ void tst_qquickvisualdatamodel::invalidContext()
     QVERIFY(!item);
 }
 
+static QString sortFilterNames(QObject *object)
+{
+    QVariant names;
+    QMetaObject::invokeMethod(object, "names", Q_RETURN_ARG(QVariant, names));
+    return names.toString();
+}
+
+void tst_qquickvisualdatamodel::sortFilter()
+{
+    QQmlComponent component(&engine, testFileUrl("sortFilter.qml"));
+    QScopedPointer<QObject> object(component.create());
+    QQmlDelegateModel *visualModel = qobject_cast<QQmlDelegateModel *>(object.data());
+    QVERIFY(visualModel);
+
+    QCOMPARE(visualModel->count(), 4);
+    QCOMPARE(sortFilterNames(visualModel), QStringLiteral("alpha,bravo,delta,echo"));
+
+    visualModel->setSortOrder(Qt::DescendingOrder);
+    QCOMPARE(sortFilterNames(visualModel), QStringLiteral("echo,delta,bravo,alpha"));
+
+    QMetaObject::invokeMethod(visualModel, "append",
+            Q_ARG(QVariant, QStringLiteral("foxtrot")), Q_ARG(QVariant, 6));
+    QCOMPARE(sortFilterNames(visualModel), QStringLiteral("foxtrot,echo,delta,bravo,alpha"));
+
+    QMetaObject::invokeMethod(visualModel, "setProperty",
+            Q_ARG(QVariant, 1), Q_ARG(QVariant, QStringLiteral("name")), Q_ARG(QVariant, QStringLiteral("golf")));
+    QCOMPARE(sortFilterNames(visualModel), QStringLiteral("golf,foxtrot,echo,delta,bravo"));
+
+    // Rejected items are re-evaluated when they change.
+    QMetaObject::invokeMethod(visualModel, "setProperty",
+            Q_ARG(QVariant, 3), Q_ARG(QVariant, QStringLiteral("size")), Q_ARG(QVariant, 7));
+    QCOMPARE(sortFilterNames(visualModel), QStringLiteral("golf,foxtrot,echo,delta,charlie,bravo"));
+
+    visualModel->setProperty("minSize", 4);
+    QCOMPARE(visualModel->count(), 6);
+    visualModel->invalidate();
+    QCOMPARE(sortFilterNames(visualModel), QStringLiteral("foxtrot,echo,charlie"));
+
+    QMetaObject::invokeMethod(visualModel, "remove", Q_ARG(QVariant, 2));
+    QCOMPARE(sortFilterNames(visualModel), QStringLiteral("foxtrot,charlie"));
+
+    visualModel->setSortRole(QString());
+    QCOMPARE(sortFilterNames(visualModel), QStringLiteral("charlie,foxtrot"));
+
+    QMetaObject::invokeMethod(visualModel, "clearFilter");
+    QCOMPARE(sortFilterNames(visualModel), QStringLiteral("delta,golf,charlie,bravo,foxtrot"));
+}
+
+void tst_qquickvisualdatamodel::sortLarge()
+{
+    QQmlComponent component(&engine, testFileUrl("sortLarge.qml"));
+    QScopedPointer<QObject> object(component.create());
+    QQmlDelegateModel *visualModel = qobject_cast<QQmlDelegateModel *>(object.data());
+    QVERIFY(visualModel);
+
+    const int count = 1000;
+    QMetaObject::invokeMethod(visualModel, "fill", Q_ARG(QVariant, count));
+    QCOMPARE(visualModel->count(), count);
+
+    // Sorting a shuffled model moves most items, which views are told as a reset.
+    visualModel->setProperty("changeCount", 0);
+    visualModel->setSortRole(QStringLiteral("value"));
+    QCOMPARE(visualModel->property("changeCount").toInt(), 1);
+    QCOMPARE(visualModel->property("movedCount").toInt(), 0);
+
+    QVariant values;
+    QMetaObject::invokeMethod(visualModel, "values", Q_RETURN_ARG(QVariant, values));
+    QVariantList list = values.toList();
+    QCOMPARE(list.count(), count);
+    for (int i = 0; i < count; ++i)
+        QCOMPARE(list.at(i).toInt(), i);
+
+    // Changing one value moves only that item.
+    QMetaObject::invokeMethod(visualModel, "setValue", Q_ARG(QVariant, 0), Q_ARG(QVariant, 500.5));
+    QCOMPARE(visualModel->property("movedCount").toInt(), 1);
+    QMetaObject::invokeMethod(visualModel, "values", Q_RETURN_ARG(QVariant, values));
+    list = values.toList();
+    QCOMPARE(list.count(), count);
+    QCOMPARE(list.at(0).toInt(), 1);
+    QCOMPARE(list.at(499).toInt(), 500);
+    QCOMPARE(list.at(500).toDouble(), 500.5);
+    QCOMPARE(list.at(501).toInt(), 501);
+
+    // Reversing the order is a reset again.
+    visualModel->setProperty("movedCount", 0);
+    visualModel->setSortOrder(Qt::DescendingOrder);
+    QCOMPARE(visualModel->property("movedCount").toInt(), 0);
+    QMetaObject::invokeMethod(visualModel, "values", Q_RETURN_ARG(QVariant, values));
+    list = values.toList();
+    QCOMPARE(list.first().toInt(), count - 1);
+    QCOMPARE(list.last().toInt(), 1);
+}
+
+void tst_qquickvisualdatamodel::sortNoDelegate()
+{
+    QQmlComponent component(&engine, testFileUrl("sortNoDelegate.qml"));
+    QScopedPointer<QObject> object(component.create());
+    QQmlDelegateModel *visualModel = qobject_cast<QQmlDelegateModel *>(object.data());
+    QVERIFY(visualModel);
+    QCOMPARE(visualModel->count(), 4);
+
+    // Without a delegate the items group still reports the new order.
+    visualModel->setSortRole(QStringLiteral("name"));
+    QCOMPARE(visualModel->property("removedCount").toInt(), 4);
+    QCOMPARE(visualModel->property("insertedCount").toInt(), 4);
+    QCOMPARE(visualModel->count(), 4);
+}
+
+void tst_qquickvisualdatamodel::sortInconsistentLessThan()
+{
+    QQmlComponent component(&engine, testFileUrl("sortInconsistent.qml"));
+    QScopedPointer<QObject> object(component.create());
+    QQmlDelegateModel *visualModel = qobject_cast<QQmlDelegateModel *>(object.data());
+    QVERIFY(visualModel);
+
+    const int count = 200;
+    QMetaObject::invokeMethod(visualModel, "fill", Q_ARG(QVariant, count));
+    QCOMPARE(visualModel->count(), count);
+
+    // A comparison which claims every item is less than every other must leave the items
+    // in some order without corrupting the model.
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression(".*lessThan: The function does not define a strict weak ordering"));
+    visualModel->setLessThan(engine.evaluate(QStringLiteral("(function(left, right) { return true })")));
+    QCOMPARE(visualModel->count(), count);
+
+    QVariant sum;
+    QMetaObject::invokeMethod(visualModel, "sum", Q_RETURN_ARG(QVariant, sum));
+    QCOMPARE(sum.toInt(), count * (count - 1) / 2);
+}
+
+void tst_qquickvisualdatamodel::sortRevision()
+{
+    // The sorting and filtering properties need QtQml.Models 2.3.
+    QQmlComponent component(&engine, testFileUrl("sortRevision.qml"));
+    QScopedPointer<QObject> object(component.create());
+    QVERIFY(!object);
+    QVERIFY(component.errorString().contains(QStringLiteral("\"sortRole\"")));
+}
+
+void tst_qquickvisualdatamodel::lazyRoles()
+{
+    CountingRoleModel model(10);
+
+    QQmlEngine engine;
+    engine.rootContext()->setContextProperty("countingModel", &model);
+    QQmlComponent component(&engine, testFileUrl("lazyRoles.qml"));
+    QScopedPointer<QObject> object(component.create());
+    QQmlDelegateModel *visualModel = qobject_cast<QQmlDelegateModel *>(object.data());
+    QVERIFY(visualModel);
+
+    // Only the roles the delegate reads are fetched, once each.
+    QObject *item = visualModel->object(0);
+    QVERIFY(item);
+    QCOMPARE(model.fetchCounts.at(0), 1);
+    QCOMPARE(model.fetchCounts.at(1), 1);
+    for (int role = 2; role < CountingRoleModel::RoleCount; ++role)
+        QCOMPARE(model.fetchCounts.at(role), 0);
+
+    QCOMPARE(item->property("first").toInt(), 0);
+    QCOMPARE(item->property("secondChanges").toInt(), 0);
+
+    // A change without roles only notifies the values that differ.
+    model.setValue(0, 0, 5);
+    QCOMPARE(item->property("first").toInt(), 5);
+    QCOMPARE(item->property("secondChanges").toInt(), 0);
+
+    model.setValue(0, 1, 7);
+    QCOMPARE(item->property("second").toInt(), 7);
+    QCOMPARE(item->property("secondChanges").toInt(), 1);
+
+    for (int role = 2; role < CountingRoleModel::RoleCount; ++role)
+        QCOMPARE(model.fetchCounts.at(role), 0);
+
+    visualModel->release(item);
+}
+
 QTEST_MAIN(tst_qquickvisualdatamodel)
 
 #include "tst_qquickvisualdatamodel.moc"
@@ -49,6 +49,7 @@
 #include <private/qquickwindow_p.h>
 #include <private/qguiapplication_p.h>
 #include <QRunnable>
+#include <QPropertyAnimation>
 
 struct TouchEventData {
     QEvent::Type type;
@@ -297,6 +298,7 @@ private slots:
     void constantUpdates();
     void constantUpdatesOnWindow_data();
     void constantUpdatesOnWindow();
+    void renderAheadPacing();
     void mouseFiltering();
     void headless();
     void noUpdateWhenNothingChanges();
@@ -482,6 +484,45 @@ void tst_qquickwindow::constantUpdatesOnWindow()
     window.hide();
 }
 
+void tst_qquickwindow::renderAheadPacing()
+{
+    qputenv("QSG_RENDER_AHEAD", "1");
+    QQuickWindow window;
+    window.setGeometry(100, 100, 300, 200);
+    QQuickRectangle rect(window.contentItem());
+    rect.setSize(QSizeF(100, 100));
+    rect.setColor(Qt::red);
+
+    window.show();
+    QTest::qWaitForWindowExposed(&window);
+    qunsetenv("QSG_RENDER_AHEAD");
+
+    if (window.openglContext()->thread() == QGuiApplication::instance()->thread())
+        QSKIP("Only the threaded render loop renders ahead");
+
+    // Every sync carries a change, so every synced frame has to be rendered.
+    QPropertyAnimation animation(&rect, "rotation");
+    animation.setFrom(0);
+    animation.setTo(360);
+    animation.setDuration(1000);
+    animation.setLoopCount(-1);
+
+    FrameCounter synced;
+    FrameCounter rendered;
+    connect(&window, SIGNAL(afterSynchronizing()), &synced, SLOT(incr()), Qt::DirectConnection);
+    connect(&window, SIGNAL(afterRendering()), &rendered, SLOT(incr()), Qt::DirectConnection);
+
+    animation.start();
+    QTRY_VERIFY(rendered.count() > 60);
+    animation.stop();
+    window.hide();
+
+    // At most the frame synced ahead of the last swap is still waiting.
+    QVERIFY2(synced.count() - rendered.count() <= 1,
+             qPrintable(QString::fromLatin1("synced %1 frames, rendered %2")
+                        .arg(synced.count()).arg(rendered.count())));
+}
+
 void tst_qquickwindow::touchEvent_basic()
 {
     TestTouchItem::clearMousePressCounter();
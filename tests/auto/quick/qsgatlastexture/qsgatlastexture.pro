@@ -0,0 +1,7 @@
+CONFIG += testcase
+TARGET = tst_qsgatlastexture
+SOURCES += tst_qsgatlastexture.cpp
+
+osx:CONFIG -= app_bundle
+
+QT += quick-private gui-private testlib
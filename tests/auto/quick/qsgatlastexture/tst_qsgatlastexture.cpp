@@ -0,0 +1,145 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/qtest.h>
+
+#include <QtGui/qimage.h>
+#include <QtQuick/qquickwindow.h>
+#include <QtQuick/qsgtexture.h>
+
+#include <private/qquickwindow_p.h>
+#include <private/qsgareaallocator_p.h>
+#include <private/qsgatlastexture_p.h>
+#include <private/qsgcontext_p.h>
+
+class tst_QSGAtlasTexture : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void areaAllocator();
+    void pages();
+};
+
+// The atlas manager reads its configuration once, when the scene graph is initialized.
+void tst_QSGAtlasTexture::initTestCase()
+{
+    qputenv("QSG_ATLAS_WIDTH", "256");
+    qputenv("QSG_ATLAS_HEIGHT", "256");
+    qputenv("QSG_ATLAS_PAGES", "2");
+}
+
+void tst_QSGAtlasTexture::areaAllocator()
+{
+    QSGAreaAllocator allocator(QSize(256, 256));
+    QCOMPARE(allocator.largestFreeArea(), 256 * 256);
+
+    // The space left over by an allocation stays in two pieces.
+    QRect rect = allocator.allocate(QSize(100, 50));
+    QCOMPARE(rect, QRect(0, 0, 100, 50));
+    QCOMPARE(allocator.largestFreeArea(), 256 * 206);
+    QVERIFY(allocator.deallocate(rect));
+    QCOMPARE(allocator.largestFreeArea(), 256 * 256);
+
+    QRect quarters[4];
+    for (int i = 0; i < 4; ++i) {
+        quarters[i] = allocator.allocate(QSize(128, 128));
+        QVERIFY(!quarters[i].isNull());
+    }
+    QCOMPARE(allocator.largestFreeArea(), 0);
+    QVERIFY(allocator.allocate(QSize(1, 1)).isNull());
+
+    // Two opposite quarters are free, but only one of them fits in an allocation.
+    QVERIFY(allocator.deallocate(QRect(0, 0, 128, 128)));
+    QVERIFY(allocator.deallocate(QRect(128, 128, 128, 128)));
+    QCOMPARE(allocator.largestFreeArea(), 128 * 128);
+    QVERIFY(allocator.allocate(QSize(128, 200)).isNull());
+
+    // Freeing a neighbour merges the space back.
+    QVERIFY(allocator.deallocate(QRect(0, 128, 128, 128)));
+    QCOMPARE(allocator.largestFreeArea(), 128 * 256);
+    QVERIFY(allocator.deallocate(QRect(128, 0, 128, 128)));
+    QCOMPARE(allocator.largestFreeArea(), 256 * 256);
+    QVERIFY(!allocator.deallocate(QRect(128, 0, 128, 128)));
+}
+
+// Four 100x100 images fit in a 256x256 page. Once both pages are full,
+// images fall back to standalone textures.
+void tst_QSGAtlasTexture::pages()
+{
+    QQuickWindow window;
+    window.resize(100, 100);
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+    QTRY_VERIFY(window.isSceneGraphInitialized());
+
+    QSGAtlasTexture::Manager *manager = QQuickWindowPrivate::get(&window)->context->atlasManager();
+    QVERIFY(manager);
+
+    QImage image(100, 100, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::red);
+
+    QList<QSGTexture *> textures;
+    for (int i = 0; i < 9; ++i)
+        textures << window.createTextureFromImage(image, QQuickWindow::TextureCanUseAtlas);
+
+    for (int i = 0; i < 8; ++i)
+        QVERIFY2(textures.at(i)->isAtlasTexture(), qPrintable(QString::number(i)));
+    QVERIFY(!textures.at(8)->isAtlasTexture());
+
+    QSGAtlasTexture::Manager::Statistics stats = manager->statistics();
+    QCOMPARE(stats.pageCount, 2);
+    QCOMPARE(stats.textureCount, 8);
+    QCOMPARE(stats.fallbackCount, 1);
+    QCOMPARE(stats.usedArea, qint64(8 * 102 * 102));
+    QCOMPARE(stats.totalArea, qint64(2 * 256 * 256));
+
+    // The second page is released once it is empty, the first one is kept.
+    for (int i = 4; i < 9; ++i)
+        delete textures.at(i);
+    stats = manager->statistics();
+    QCOMPARE(stats.pageCount, 1);
+    QCOMPARE(stats.textureCount, 4);
+
+    for (int i = 0; i < 4; ++i)
+        delete textures.at(i);
+    stats = manager->statistics();
+    QCOMPARE(stats.pageCount, 1);
+    QCOMPARE(stats.textureCount, 0);
+    QCOMPARE(stats.fallbackCount, 1);
+}
+
+QTEST_MAIN(tst_QSGAtlasTexture)
+
+#include "tst_qsgatlastexture.moc"
@@ -0,0 +1,7 @@
+CONFIG += testcase
+TARGET = tst_qsgshadercache
+SOURCES += tst_qsgshadercache.cpp
+
+osx:CONFIG -= app_bundle
+
+QT += quick-private gui-private testlib
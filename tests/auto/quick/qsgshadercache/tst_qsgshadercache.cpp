@@ -0,0 +1,162 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/qtest.h>
+
+#include <QtCore/qatomic.h>
+#include <QtCore/qdir.h>
+#include <QtCore/qtemporarydir.h>
+#include <QtGui/qoffscreensurface.h>
+#include <QtGui/qopenglcontext.h>
+#include <QtGui/qopenglshaderprogram.h>
+#include <QtQuick/qquickwindow.h>
+#include <QtQuick/qsgflatcolormaterial.h>
+#include <QtQuick/qsgtexturematerial.h>
+
+#include <private/qsgshadercache_p.h>
+
+static const char vertexCode[] =
+        "attribute highp vec4 vertex;\n"
+        "uniform highp mat4 matrix;\n"
+        "void main() { gl_Position = matrix * vertex; }\n";
+
+static const char fragmentCode[] =
+        "uniform lowp vec4 color;\n"
+        "void main() { gl_FragColor = color; }\n";
+
+static const char *const attributeNames[] = { "vertex", 0 };
+
+class tst_QSGShaderCache : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void storeAndLoad();
+    void precompileMaterials();
+
+private:
+    QTemporaryDir m_cacheDir;
+};
+
+// The cache location is read once, so it must be set before any shader is linked.
+void tst_QSGShaderCache::initTestCase()
+{
+    QVERIFY(m_cacheDir.isValid());
+    qputenv("QSG_SHADER_CACHE_DIR", QFile::encodeName(m_cacheDir.path()));
+}
+
+void tst_QSGShaderCache::storeAndLoad()
+{
+    QOpenGLContext context;
+    QVERIFY(context.create());
+    QOffscreenSurface surface;
+    surface.setFormat(context.format());
+    surface.create();
+    QVERIFY(context.makeCurrent(&surface));
+
+    const QByteArray key = QSGShaderCache::key(vertexCode, fragmentCode, attributeNames);
+    if (key.isEmpty())
+        QSKIP("OpenGL program binaries are not supported");
+
+    // The first link compiles the sources and stores the program.
+    {
+        QOpenGLShaderProgram program;
+        program.bindAttributeLocation(attributeNames[0], 0);
+        QVERIFY(QSGShaderCache::link(&program, vertexCode, fragmentCode, attributeNames));
+        QVERIFY(program.isLinked());
+        QVERIFY(program.shaders().count() == 2);
+    }
+    QVERIFY(QFile::exists(m_cacheDir.path() + QLatin1Char('/') + QString::fromLatin1(key)));
+
+    // The second one is a linked program without any shader compiled.
+    {
+        QOpenGLShaderProgram program;
+        program.bindAttributeLocation(attributeNames[0], 0);
+        QVERIFY(QSGShaderCache::link(&program, vertexCode, fragmentCode, attributeNames));
+        QVERIFY(program.isLinked());
+        QVERIFY(program.shaders().isEmpty());
+        QVERIFY(program.uniformLocation("color") >= 0);
+        QCOMPARE(program.attributeLocation("vertex"), 0);
+    }
+
+    // Different sources don't find that program.
+    QVERIFY(QSGShaderCache::key(vertexCode, QByteArray(fragmentCode) + "\n", attributeNames) != key);
+
+    context.doneCurrent();
+}
+
+class Precompiler : public QObject
+{
+    Q_OBJECT
+public:
+    Precompiler(QQuickWindow *window) : window(window), supported(false), done(0) { }
+
+public slots:
+    void precompile()
+    {
+        supported = !QSGShaderCache::key(vertexCode, fragmentCode, attributeNames).isEmpty();
+        QSGFlatColorMaterial flatColor;
+        QSGTextureMaterial texture;
+        window->precompileMaterials(QVector<QSGMaterial *>() << &flatColor << &texture);
+        done.storeRelease(1);
+    }
+
+public:
+    QQuickWindow *window;
+    bool supported;
+    QAtomicInt done;
+};
+
+// Materials precompiled from the rendering thread end up in the cache.
+void tst_QSGShaderCache::precompileMaterials()
+{
+    QDir cacheDir(m_cacheDir.path());
+    const int stored = cacheDir.entryList(QDir::Files).count();
+
+    QQuickWindow window;
+    Precompiler precompiler(&window);
+    connect(&window, SIGNAL(sceneGraphInitialized()), &precompiler, SLOT(precompile()), Qt::DirectConnection);
+    window.resize(100, 100);
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+    QTRY_VERIFY(precompiler.done.loadAcquire());
+
+    if (!precompiler.supported)
+        QSKIP("OpenGL program binaries are not supported");
+    QVERIFY(cacheDir.entryList(QDir::Files).count() > stored);
+}
+
+QTEST_MAIN(tst_QSGShaderCache)
+
+#include "tst_qsgshadercache.moc"
@@ -74,6 +74,8 @@ QUICKTESTS =  \
     qquickview \
     qquickcanvasitem \
     qquickscreen \
+    qsgatlastexture \
+    qsgshadercache \
     touchmouse \
     scenegraph
 
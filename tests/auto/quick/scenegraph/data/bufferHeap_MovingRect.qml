@@ -0,0 +1,65 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+import QtQuick 2.2
+
+/*
+    Many opaque rectangles of the same kind end up in one merged batch.
+    Moving one of them only changes that element's part of the batch.
+*/
+
+Rectangle {
+    width: 200
+    height: 200
+    color: "white"
+
+    Repeater {
+        model: 64
+        Rectangle {
+            x: (index % 8) * 25
+            y: Math.floor(index / 8) * 25
+            width: 20
+            height: 20
+            color: Qt.rgba((index % 8) / 8, Math.floor(index / 8) / 8, 0.5, 1)
+        }
+    }
+
+    Rectangle {
+        objectName: "moving"
+        x: 2
+        y: 2
+        width: 16
+        height: 16
+        color: "black"
+    }
+}
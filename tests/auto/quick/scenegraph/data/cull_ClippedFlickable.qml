@@ -0,0 +1,82 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+import QtQuick 2.2
+
+/*
+    The image is scrolled out of the clipped Flickable, so its batch is
+    outside its clip and doesn't need to be uploaded or drawn.
+*/
+
+Rectangle {
+    id: root
+    width: 200
+    height: 200
+    color: "white"
+
+    property bool showOutside: true
+
+    Flickable {
+        width: 200
+        height: 100
+        clip: true
+        contentWidth: 200
+        contentHeight: 1000
+
+        Repeater {
+            model: 8
+            Rectangle {
+                x: index * 25
+                y: 10
+                width: 20
+                height: 80
+                color: Qt.rgba(index / 8, 0.5, 1 - index / 8, 1)
+            }
+        }
+
+        Image {
+            y: 600
+            width: 100
+            height: 100
+            source: "logo-small.jpg"
+            visible: root.showOutside
+        }
+    }
+
+    Rectangle {
+        y: 120
+        width: 200
+        height: 80
+        color: "palegreen"
+    }
+}
@@ -0,0 +1,75 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+import QtQuick 2.2
+
+/*
+    Over 8192 vertices of opaque rectangles, under several transforms, end up
+    in one merged batch, which is large enough to be uploaded in parallel.
+*/
+
+Rectangle {
+    width: 200
+    height: 200
+    color: "white"
+
+    Repeater {
+        model: 4
+        Item {
+            x: (index % 2) * 100
+            y: Math.floor(index / 2) * 100
+            width: 100
+            height: 100
+            scale: 0.9 + index * 0.025
+            Repeater {
+                model: 625
+                Rectangle {
+                    x: (index % 25) * 4
+                    y: Math.floor(index / 25) * 4
+                    width: 3
+                    height: 3
+                    color: Qt.rgba((index % 25) / 25, Math.floor(index / 25) / 25, 0.5, 1)
+                }
+            }
+        }
+    }
+
+    Rectangle {
+        objectName: "moving"
+        x: 2
+        y: 2
+        width: 16
+        height: 16
+        color: "black"
+    }
+}
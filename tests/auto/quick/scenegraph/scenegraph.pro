@@ -13,4 +13,9 @@ DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0
 OTHER_FILES += \
     data/render_OutOfFloatRange.qml \
     data/simple.qml \
-    data/render_ImageFiltering.qml
+    data/render_ImageFiltering.qml \
+    data/render_Software.qml \
+    data/parallelUpload.qml \
+    data/cull_ClippedFlickable.qml \
+    data/cull_Occlusion.qml \
+    data/render_PartialUpdate.qml
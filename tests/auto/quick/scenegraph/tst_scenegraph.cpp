@@ -33,6 +33,10 @@
 
 #include <qtest.h>
 
+#include <QProcess>
+#include <QLoggingCategory>
+#include <QMutex>
+#include <QRegularExpression>
 #include <QOffscreenSurface>
 #include <QOpenGLContext>
 #include <QOpenGLFunctions>
@@ -103,6 +107,15 @@ private slots:
     void render();
 
     void hideWithOtherContext();
+
+    void bufferHeap();
+    void parallelUpload();
+
+    void cullClippedFlickable();
+    void cullPartiallyCovered();
+
+    void softwareContext();
+    void partialUpdate();
 };
 
 template <typename T> class ScopedList : public QList<T> {
@@ -531,6 +544,303 @@ void tst_SceneGraph::hideWithOtherContext()
     QVERIFY(!renderingOnMainThread || QOpenGLContext::currentContext() != &context);
 }
 
+static QList<QImage> grabMovingRectFrames(const QString &file, const char *variable, const QByteArray &value)
+{
+    qputenv(variable, value);
+
+    QList<QImage> frames;
+    {
+        QQuickView view;
+        view.setSource(QUrl::fromLocalFile(file));
+        view.setResizeMode(QQuickView::SizeViewToRootObject);
+        view.show();
+        if (QTest::qWaitForWindowExposed(&view)) {
+            QQuickItem *moving = view.rootObject()->findChild<QQuickItem *>("moving");
+            frames << view.grabWindow();
+            for (int i=0; i<8; ++i) {
+                moving->setX(moving->x() + 25);
+                moving->setY(moving->y() + 25);
+                frames << view.grabWindow();
+            }
+        }
+    }
+
+    qunsetenv(variable);
+    return frames;
+}
+
+// Moving a single element of a merged batch is written in place into a
+// sub-allocated range when the buffer heap is enabled. The frames must match
+// the ones rendered with a dedicated buffer object per batch, which always
+// uploads the whole batch.
+void tst_SceneGraph::bufferHeap()
+{
+    const QString file = QStringLiteral("data/bufferHeap_MovingRect.qml");
+    QList<QImage> dedicated = grabMovingRectFrames(file, "QSG_RENDERER_BUFFER_HEAP_SIZE", "0");
+    QList<QImage> heap = grabMovingRectFrames(file, "QSG_RENDERER_BUFFER_HEAP_SIZE", "64");
+    QCOMPARE(dedicated.size(), 9);
+    QCOMPARE(heap.size(), dedicated.size());
+    for (int i=0; i<dedicated.size(); ++i) {
+        QVERIFY(containsSomethingOtherThanWhite(dedicated.at(i)));
+        QVERIFY2(compareImages(heap.at(i), dedicated.at(i)), qPrintable(QString::number(i)));
+    }
+}
+
+// Large merged batches are transformed and copied by several threads. The
+// frames must match the ones uploaded by the render thread alone.
+void tst_SceneGraph::parallelUpload()
+{
+    const QString file = QStringLiteral("data/parallelUpload.qml");
+    QList<QImage> serial = grabMovingRectFrames(file, "QSG_RENDERER_UPLOAD_THREADS", "0");
+    QList<QImage> parallel = grabMovingRectFrames(file, "QSG_RENDERER_UPLOAD_THREADS", "3");
+    QCOMPARE(serial.size(), 9);
+    QCOMPARE(parallel.size(), serial.size());
+    for (int i=0; i<serial.size(); ++i) {
+        QVERIFY(containsSomethingOtherThanWhite(serial.at(i)));
+        QVERIFY2(compareImages(parallel.at(i), serial.at(i)), qPrintable(QString::number(i)));
+    }
+}
+
+struct CullingCounts
+{
+    int viewport;
+    int occlusion;
+};
+
+static QMutex cullingMutex;
+static QList<CullingCounts> cullingCounts;
+static QtMessageHandler previousMessageHandler = 0;
+
+// The renderer logs the number of culled batches of each frame from the render thread.
+static void cullingMessageHandler(QtMsgType type, const QMessageLogContext &context, const QString &message)
+{
+    if (context.category && qstrcmp(context.category, "qt.scenegraph.time.renderer") == 0) {
+        static const QRegularExpression counts(QStringLiteral("^culled batches: viewport=(\\d+), occlusion=(\\d+), batches=\\d+$"));
+        const QRegularExpressionMatch match = counts.match(message);
+        if (match.hasMatch()) {
+            CullingCounts c = { match.captured(1).toInt(), match.captured(2).toInt() };
+            QMutexLocker locker(&cullingMutex);
+            cullingCounts << c;
+        }
+        return;
+    }
+    previousMessageHandler(type, context, message);
+}
+
+class CullingLog
+{
+public:
+    CullingLog()
+    {
+        cullingCounts.clear();
+        QLoggingCategory::setFilterRules(QStringLiteral("qt.scenegraph.time.renderer.debug=true"));
+        previousMessageHandler = qInstallMessageHandler(cullingMessageHandler);
+    }
+
+    ~CullingLog()
+    {
+        qInstallMessageHandler(previousMessageHandler);
+        QLoggingCategory::setFilterRules(QString());
+    }
+
+    // Returns the largest counts of the frames rendered since the last call
+    CullingCounts take()
+    {
+        QMutexLocker locker(&cullingMutex);
+        CullingCounts result = { 0, 0 };
+        foreach (const CullingCounts &c, cullingCounts) {
+            result.viewport = qMax(result.viewport, c.viewport);
+            result.occlusion = qMax(result.occlusion, c.occlusion);
+        }
+        cullingCounts.clear();
+        return result;
+    }
+};
+
+// The image scrolled out of the Flickable is culled, and leaving it out of
+// the scene altogether gives the same frame.
+void tst_SceneGraph::cullClippedFlickable()
+{
+    CullingLog log;
+
+    QQuickView view;
+    view.setSource(QUrl::fromLocalFile("data/cull_ClippedFlickable.qml"));
+    view.setResizeMode(QQuickView::SizeViewToRootObject);
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+
+    const QImage culled = view.grabWindow();
+    QVERIFY(containsSomethingOtherThanWhite(culled));
+    QVERIFY(log.take().viewport > 0);
+
+    view.rootObject()->setProperty("showOutside", false);
+    const QImage reference = view.grabWindow();
+    QVERIFY(compareImages(culled, reference));
+}
+
+// A batch only partially behind an opaque rectangle is drawn. Once the
+// rectangle covers it, it is culled without changing the frame.
+void tst_SceneGraph::cullPartiallyCovered()
+{
+    qputenv("QSG_RENDERER_OCCLUSION_CULLING", "1");
+    CullingLog log;
+
+    QQuickView view;
+    view.setSource(QUrl::fromLocalFile("data/cull_Occlusion.qml"));
+    view.setResizeMode(QQuickView::SizeViewToRootObject);
+    view.show();
+    const bool exposed = QTest::qWaitForWindowExposed(&view);
+    qunsetenv("QSG_RENDERER_OCCLUSION_CULLING");
+    QVERIFY(exposed);
+    if (view.openglContext()->format().depthBufferSize() == 0)
+        QSKIP("Occlusion culling needs a depth buffer");
+
+    const qreal dpr = view.effectiveDevicePixelRatio();
+    QImage content = view.grabWindow();
+    QCOMPARE(log.take().occlusion, 0);
+    QVERIFY(containsSomethingOtherThanWhite(content.copy(QRect(QPoint(20, 20) * dpr, QSize(50, 100) * dpr))));
+    QCOMPARE(content.pixel(QPoint(100, 100) * dpr), QColor("steelblue").rgb());
+
+    view.rootObject()->setProperty("covering", true);
+    content = view.grabWindow();
+    QVERIFY(log.take().occlusion > 0);
+    QCOMPARE(content.pixel(QPoint(40, 60) * dpr), QColor("steelblue").rgb());
+    QCOMPARE(content.pixel(QPoint(180, 180) * dpr), qRgb(255, 255, 255));
+}
+
+static bool comparePixel(QRgb actual, QRgb expected)
+{
+    return qAbs(qRed(actual) - qRed(expected)) <= 2
+            && qAbs(qGreen(actual) - qGreen(expected)) <= 2
+            && qAbs(qBlue(actual) - qBlue(expected)) <= 2;
+}
+
+// The scene graph adaptation is chosen once per process, so the test runs
+// itself again with the software context selected.
+void tst_SceneGraph::softwareContext()
+{
+    if (qgetenv("QMLSCENE_DEVICE") != "softwarecontext") {
+        QProcessEnvironment environment = QProcessEnvironment::systemEnvironment();
+        environment.insert(QStringLiteral("QMLSCENE_DEVICE"), QStringLiteral("softwarecontext"));
+        QProcess process;
+        process.setProcessEnvironment(environment);
+        process.setProcessChannelMode(QProcess::ForwardedChannels);
+        process.start(QCoreApplication::applicationFilePath(), QStringList() << QStringLiteral("softwareContext"));
+        QVERIFY(process.waitForFinished(60000));
+        QCOMPARE(process.exitStatus(), QProcess::NormalExit);
+        QCOMPARE(process.exitCode(), 0);
+        return;
+    }
+
+    QQuickView view;
+    view.setSource(QUrl::fromLocalFile("data/render_Software.qml"));
+    view.setResizeMode(QQuickView::SizeViewToRootObject);
+
+    // Hiding and showing the window again reuses its backing store.
+    for (int i = 0; i < 2; ++i) {
+        view.show();
+        QVERIFY(QTest::qWaitForWindowExposed(&view));
+        QVERIFY(!view.openglContext());
+
+        const qreal dpr = view.effectiveDevicePixelRatio();
+        const QImage content = view.grabWindow();
+        QCOMPARE(content.size(), QSize(200, 200) * dpr);
+        QVERIFY(comparePixel(content.pixel(50 * dpr, 50 * dpr), qRgb(255, 0, 0)));
+        QVERIFY(comparePixel(content.pixel(150 * dpr, 150 * dpr), qRgb(127, 127, 255)));
+        QVERIFY(comparePixel(content.pixel(155 * dpr, 55 * dpr), qRgb(0, 255, 0)));
+        QVERIFY(comparePixel(content.pixel(50 * dpr, 150 * dpr), qRgb(255, 255, 255)));
+
+        view.hide();
+    }
+}
+
+static int partialUpdateCount = 0;
+
+// With QSG_RENDERER_DEBUG=render the renderer logs whether it draws a frame in full.
+static void partialUpdateMessageHandler(QtMsgType type, const QMessageLogContext &context, const QString &message)
+{
+    if (type == QtDebugMsg) {
+        if (message.contains(QLatin1String("-> partial update")))
+            ++partialUpdateCount;
+        return;
+    }
+    previousMessageHandler(type, context, message);
+}
+
+// The renderer only redraws what changed when the surface keeps its contents,
+// which is opt-in and read once per process, so the test runs itself again.
+// Unchanged pixels must be kept and changed ones redrawn, giving the same frame
+// as a full redraw.
+void tst_SceneGraph::partialUpdate()
+{
+    if (!qEnvironmentVariableIsSet("QSG_PRESERVED_SWAP")) {
+        QProcessEnvironment environment = QProcessEnvironment::systemEnvironment();
+        environment.insert(QStringLiteral("QSG_PRESERVED_SWAP"), QStringLiteral("1"));
+        environment.insert(QStringLiteral("QSG_RENDERER_DEBUG"), QStringLiteral("render"));
+        environment.insert(QStringLiteral("QSG_RENDER_LOOP"), QStringLiteral("basic"));
+        QProcess process;
+        process.setProcessEnvironment(environment);
+        process.setProcessChannelMode(QProcess::ForwardedChannels);
+        process.start(QCoreApplication::applicationFilePath(), QStringList() << QStringLiteral("partialUpdate"));
+        QVERIFY(process.waitForFinished(60000));
+        QCOMPARE(process.exitStatus(), QProcess::NormalExit);
+        QCOMPARE(process.exitCode(), 0);
+        return;
+    }
+
+    partialUpdateCount = 0;
+    previousMessageHandler = qInstallMessageHandler(partialUpdateMessageHandler);
+
+    // Grabbing renders without swapping, and a single buffered surface keeps what was
+    // drawn into it from one frame to the next.
+    QQuickView view;
+    QSurfaceFormat format = view.requestedFormat();
+    format.setSwapBehavior(QSurfaceFormat::SingleBuffer);
+    view.setFormat(format);
+    view.setSource(QUrl::fromLocalFile("data/render_PartialUpdate.qml"));
+    view.setResizeMode(QQuickView::SizeViewToRootObject);
+    view.show();
+    const bool exposed = QTest::qWaitForWindowExposed(&view);
+    if (exposed && view.openglContext()->format().swapBehavior() != QSurfaceFormat::SingleBuffer) {
+        qInstallMessageHandler(previousMessageHandler);
+        QSKIP("Partial updates need a surface which keeps its contents");
+    }
+    QVERIFY(exposed);
+
+    const qreal dpr = view.effectiveDevicePixelRatio();
+    QImage content = view.grabWindow();
+    QVERIFY(comparePixel(content.pixel(30 * dpr, 30 * dpr), qRgb(255, 0, 0)));
+
+    int moverX = 10;
+    for (int frame = 1; frame <= 4; ++frame) {
+        const int previousX = moverX;
+        moverX += 40;
+        view.rootObject()->setProperty("moverX", moverX);
+        view.rootObject()->setProperty("recolored", frame % 2 == 1);
+        content = view.grabWindow();
+
+        QVERIFY(comparePixel(content.pixel(30 * dpr, 30 * dpr), qRgb(255, 0, 0)));
+        QVERIFY(comparePixel(content.pixel((moverX + 15) * dpr, 115 * dpr), qRgb(0, 0, 255)));
+        QVERIFY(comparePixel(content.pixel((previousX + 15) * dpr, 115 * dpr), qRgb(255, 255, 255)));
+        QVERIFY(comparePixel(content.pixel(160 * dpr, 30 * dpr),
+                             frame % 2 == 1 ? qRgb(0, 128, 0) : qRgb(255, 255, 0)));
+        QVERIFY(comparePixel(content.pixel(100 * dpr, 60 * dpr), qRgb(255, 255, 255)));
+    }
+
+    qInstallMessageHandler(previousMessageHandler);
+    QVERIFY(partialUpdateCount > 0);
+
+    // The first frame of a new window is always drawn in full.
+    QQuickView reference;
+    reference.setFormat(format);
+    reference.setSource(QUrl::fromLocalFile("data/render_PartialUpdate.qml"));
+    reference.setResizeMode(QQuickView::SizeViewToRootObject);
+    reference.rootObject()->setProperty("moverX", moverX);
+    reference.rootObject()->setProperty("recolored", false);
+    reference.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&reference));
+    QVERIFY(compareImages(content, reference.grabWindow()));
+}
 
 #include "tst_scenegraph.moc"
 
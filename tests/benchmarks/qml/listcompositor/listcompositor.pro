@@ -0,0 +1,9 @@
+CONFIG += testcase
+TEMPLATE = app
+TARGET = tst_listcompositor
+QT += qml-private testlib
+macx:CONFIG -= app_bundle
+
+SOURCES += tst_listcompositor.cpp
+
+DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0
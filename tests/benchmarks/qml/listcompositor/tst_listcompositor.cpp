@@ -0,0 +1,171 @@
+/***************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <qtest.h>
+#include <private/qqmllistcompositor_p.h>
+
+typedef QQmlListCompositor C;
+
+// Stresses a compositor fragmented into one range per item by interleaved
+// memberships of four groups, as produced by a DelegateModel with several
+// groups assigned item by item.
+class tst_listcompositor : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void find_data();
+    void find();
+    void setFlags();
+    void findCache();
+    void move();
+
+private:
+    void populate(QQmlListCompositor *compositor);
+
+    enum {
+        ItemCount = 100000,
+        LookupCount = 10000
+    };
+    int list;
+};
+
+void tst_listcompositor::populate(QQmlListCompositor *compositor)
+{
+    static const int flagCycle[] = {
+        C::DefaultFlag | (1 << 3),
+        1 << 4,
+        C::DefaultFlag | (1 << 5),
+        (1 << 3) | (1 << 4) | (1 << 6),
+        C::DefaultFlag | (1 << 6)
+    };
+
+    compositor->setGroupCount(7);
+    for (int i = 0; i < ItemCount; ++i)
+        compositor->append(&list, i, 1, flagCycle[i % 5]);
+}
+
+// A fixed sequence of pseudo random numbers so runs are comparable.
+static int nextRandom(uint *seed, int maximum)
+{
+    *seed = *seed * 1103515245 + 12345;
+    return int((*seed >> 8) % uint(maximum));
+}
+
+void tst_listcompositor::find_data()
+{
+    QTest::addColumn<int>("group");
+
+    QTest::newRow("default") << int(C::Default);
+    QTest::newRow("group 3") << 3;
+    QTest::newRow("group 6") << 6;
+}
+
+void tst_listcompositor::find()
+{
+    QFETCH(int, group);
+
+    QQmlListCompositor compositor;
+    populate(&compositor);
+
+    const int count = compositor.count(C::Group(group));
+    QBENCHMARK {
+        uint seed = 1;
+        for (int i = 0; i < LookupCount; ++i)
+            compositor.find(C::Group(group), nextRandom(&seed, count));
+    }
+}
+
+void tst_listcompositor::setFlags()
+{
+    QQmlListCompositor compositor;
+    populate(&compositor);
+
+    const int count = compositor.count(C::Default);
+    QBENCHMARK {
+        uint seed = 1;
+        for (int i = 0; i < LookupCount; ++i) {
+            const int index = nextRandom(&seed, count);
+            QVector<C::Insert> inserts;
+            QVector<C::Remove> removes;
+            compositor.setFlags(C::Default, index, 1, 1 << 5, &inserts);
+            compositor.find(C::Default, nextRandom(&seed, count));
+            compositor.clearFlags(C::Default, index, 1, 1 << 5, &removes);
+        }
+    }
+}
+
+// Interleaves lookups with caching and releasing items, as QQmlDelegateModel does
+// when it creates and releases delegates, so that the ranges change between lookups.
+void tst_listcompositor::findCache()
+{
+    QQmlListCompositor compositor;
+    populate(&compositor);
+
+    const int count = compositor.count(C::Default);
+    QBENCHMARK {
+        uint seed = 1;
+        for (int i = 0; i < LookupCount; ++i) {
+            const int index = nextRandom(&seed, count);
+            compositor.find(C::Default, nextRandom(&seed, count));
+            C::iterator it = compositor.find(C::Default, index);
+            if (!it->inCache())
+                compositor.setFlags(it, 1, C::CacheFlag);
+            compositor.find(C::Default, nextRandom(&seed, count));
+            compositor.clearFlags(C::Default, index, 1, C::CacheFlag);
+        }
+    }
+}
+
+void tst_listcompositor::move()
+{
+    QQmlListCompositor compositor;
+    populate(&compositor);
+
+    const int count = compositor.count(C::Default);
+    QBENCHMARK {
+        uint seed = 1;
+        for (int i = 0; i < LookupCount / 10; ++i) {
+            QVector<C::Remove> removes;
+            QVector<C::Insert> inserts;
+            compositor.move(
+                    C::Default, nextRandom(&seed, count - 10),
+                    C::Default, nextRandom(&seed, count - 10),
+                    10, C::Default, &removes, &inserts);
+        }
+    }
+}
+
+QTEST_MAIN(tst_listcompositor)
+
+#include "tst_listcompositor.moc"
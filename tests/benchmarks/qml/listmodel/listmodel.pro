@@ -0,0 +1,9 @@
+CONFIG += testcase
+TEMPLATE = app
+TARGET = tst_listmodel
+QT += qml quick testlib
+macx:CONFIG -= app_bundle
+
+SOURCES += tst_listmodel.cpp
+
+DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0
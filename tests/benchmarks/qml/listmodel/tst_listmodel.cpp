@@ -0,0 +1,102 @@
+/***************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <qtest.h>
+#include <QtQml/qqmlengine.h>
+#include <QtQml/qqmlcomponent.h>
+
+// Measures the cost of filling a ListModel that a ListView is bound to,
+// including the delegate model updates and the view relayout.
+class tst_listmodel : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void populate_data();
+    void populate();
+
+private:
+    QQmlEngine engine;
+};
+
+void tst_listmodel::populate_data()
+{
+    QTest::addColumn<QString>("script");
+
+    QTest::newRow("append")
+            << "for (var i = 0; i < 10000; ++i) model.append({ value: i, name: 'Item ' + i })";
+    QTest::newRow("append batched")
+            << "model.beginBatch();"
+               "for (var i = 0; i < 10000; ++i) model.append({ value: i, name: 'Item ' + i });"
+               "model.endBatch()";
+    QTest::newRow("append array")
+            << "var rows = [];"
+               "for (var i = 0; i < 10000; ++i) rows.push({ value: i, name: 'Item ' + i });"
+               "model.append(rows)";
+    QTest::newRow("insert front batched")
+            << "model.beginBatch();"
+               "for (var i = 0; i < 10000; ++i) model.insert(0, { value: i, name: 'Item ' + i });"
+               "model.endBatch()";
+}
+
+void tst_listmodel::populate()
+{
+    QFETCH(QString, script);
+
+    QQmlComponent component(&engine);
+    component.setData("import QtQuick 2.0\n"
+                      "ListView {\n"
+                      "    width: 240; height: 320\n"
+                      "    model: ListModel { id: listModel }\n"
+                      "    delegate: Item { width: 240; height: 20 }\n"
+                      "    function populate() {\n"
+                      "        var model = listModel;\n"
+                      "        model.clear();\n"
+                      "        " + script.toUtf8() + "\n"
+                      "    }\n"
+                      "}\n", QUrl());
+    QScopedPointer<QObject> view(component.create());
+    QVERIFY2(view, qPrintable(component.errorString()));
+
+    QBENCHMARK {
+        QMetaObject::invokeMethod(view.data(), "populate");
+        // Lay the view out, as the next frame would.
+        QMetaObject::invokeMethod(view.data(), "forceLayout");
+    }
+
+    QCOMPARE(view->property("count").toInt(), 10000);
+}
+
+QTEST_MAIN(tst_listmodel)
+
+#include "tst_listmodel.moc"
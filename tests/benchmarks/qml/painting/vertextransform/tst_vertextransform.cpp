@@ -0,0 +1,178 @@
+/***************************************************************************
+**
+** Copyright (C) 2015 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL21$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see http://www.qt.io/terms-conditions. For further
+** information use the contact form at http://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 2.1 or version 3 as published by the Free
+** Software Foundation and appearing in the file LICENSE.LGPLv21 and
+** LICENSE.LGPLv3 included in the packaging of this file. Please review the
+** following information to ensure the GNU Lesser General Public License
+** requirements will be met: https://www.gnu.org/licenses/lgpl.html and
+** http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+**
+** As a special exception, The Qt Company gives you certain additional
+** rights. These rights are described in The Qt Company LGPL Exception
+** version 1.1, included in the file LGPL_EXCEPTION.txt in this package.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <qtest.h>
+#include <QtGui/QMatrix4x4>
+#include <private/qsgvertextransform_p.h>
+
+#include <float.h>
+
+// Compares the vertex kernels the batch renderer can pick from when merging
+// geometry, on the vertex layouts of the default materials.
+class tst_vertextransform : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void translate_data() { kernelData(); }
+    void translate();
+    void map_data() { kernelData(); }
+    void map();
+    void bounds_data() { kernelData(); }
+    void bounds();
+
+private:
+    void kernelData();
+    void fill(QByteArray *data, int stride) const;
+
+    enum { VertexCount = 100000 };
+    QList<const QSGVertexKernels *> m_kernels;
+    QMatrix4x4 m_matrix;
+};
+
+void tst_vertextransform::initTestCase()
+{
+    m_matrix.translate(12.5, -3);
+    m_matrix.rotate(30, 0, 0, 1);
+    m_matrix.scale(1.5, 0.75);
+
+    m_kernels << &qsg_vertexKernels_scalar;
+#ifdef __SSE2__
+    m_kernels << &qsg_vertexKernels_sse2;
+#endif
+#ifdef QT_COMPILER_SUPPORTS_AVX2
+    if (qCpuHasFeature(AVX2))
+        m_kernels << &qsg_vertexKernels_avx2;
+#endif
+#ifdef QT_COMPILER_SUPPORTS_NEON
+    if (qCpuHasFeature(NEON))
+        m_kernels << &qsg_vertexKernels_neon;
+#endif
+}
+
+void tst_vertextransform::kernelData()
+{
+    QTest::addColumn<int>("kernel");
+    QTest::addColumn<int>("stride");
+
+    // Point2D, ColoredPoint2D and TexturedPoint2D
+    static const int strides[] = { 8, 12, 16 };
+    for (int k = 0; k < m_kernels.size(); ++k) {
+        for (int i = 0; i < 3; ++i) {
+            QTest::newRow(QByteArray(m_kernels.at(k)->name) + " stride " + QByteArray::number(strides[i]))
+                    << k << strides[i];
+        }
+    }
+}
+
+void tst_vertextransform::fill(QByteArray *data, int stride) const
+{
+    data->resize(VertexCount * stride);
+    float *f = reinterpret_cast<float *>(data->data());
+    for (int i = 0; i < data->size() / int(sizeof(float)); ++i)
+        f[i] = (i * 37 % 1000) * 0.25f;
+}
+
+void tst_vertextransform::translate()
+{
+    QFETCH(int, kernel);
+    QFETCH(int, stride);
+    const QSGVertexKernels *kernels = m_kernels.at(kernel);
+
+    QByteArray data;
+    fill(&data, stride);
+
+    QByteArray expected = data;
+    qsg_vertexKernels_scalar.translate(expected.data(), VertexCount, stride, 7, -2);
+    kernels->translate(data.data(), VertexCount, stride, 7, -2);
+    QCOMPARE(data, expected);
+
+    QBENCHMARK {
+        kernels->translate(data.data(), VertexCount, stride, 0.5f, -0.5f);
+    }
+}
+
+void tst_vertextransform::map()
+{
+    QFETCH(int, kernel);
+    QFETCH(int, stride);
+    const QSGVertexKernels *kernels = m_kernels.at(kernel);
+
+    QByteArray data;
+    fill(&data, stride);
+
+    QByteArray expected = data;
+    qsg_vertexKernels_scalar.map(expected.data(), VertexCount, stride, m_matrix.constData());
+    kernels->map(data.data(), VertexCount, stride, m_matrix.constData());
+    const float *a = reinterpret_cast<const float *>(data.constData());
+    const float *b = reinterpret_cast<const float *>(expected.constData());
+    for (int i = 0; i < data.size() / int(sizeof(float)); ++i)
+        QVERIFY(qAbs(a[i] - b[i]) <= 1e-3f * qMax(1.0f, qAbs(b[i])));
+
+    // Rotating back and forth keeps the values in range however often we run.
+    const QMatrix4x4 inverse = m_matrix.inverted();
+    QBENCHMARK {
+        kernels->map(data.data(), VertexCount, stride, m_matrix.constData());
+        kernels->map(data.data(), VertexCount, stride, inverse.constData());
+    }
+}
+
+void tst_vertextransform::bounds()
+{
+    QFETCH(int, kernel);
+    QFETCH(int, stride);
+    const QSGVertexKernels *kernels = m_kernels.at(kernel);
+
+    QByteArray data;
+    fill(&data, stride);
+
+    float expected[4] = { FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX };
+    qsg_vertexKernels_scalar.bounds(data.constData(), VertexCount, stride, expected);
+
+    float bounds[4] = { FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX };
+    QBENCHMARK {
+        bounds[0] = bounds[1] = FLT_MAX;
+        bounds[2] = bounds[3] = -FLT_MAX;
+        kernels->bounds(data.constData(), VertexCount, stride, bounds);
+    }
+
+    for (int i = 0; i < 4; ++i)
+        QCOMPARE(bounds[i], expected[i]);
+}
+
+QTEST_MAIN(tst_vertextransform)
+
+#include "tst_vertextransform.moc"
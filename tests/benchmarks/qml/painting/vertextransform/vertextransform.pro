@@ -0,0 +1,9 @@
+CONFIG += testcase
+TEMPLATE = app
+TARGET = tst_vertextransform
+QT += quick-private testlib
+macx:CONFIG -= app_bundle
+
+SOURCES += tst_vertextransform.cpp
+
+DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0
@@ -13,8 +13,14 @@ SUBDIRS += \
 #            script \ ### FIXME: doesn't build
            qmltime \
            js \
+           listmodel \
            qquickwindow
 
 qtHaveModule(opengl): SUBDIRS += painting
 
+contains(QT_CONFIG, private_tests) {
+    SUBDIRS += listcompositor
+    qtHaveModule(quick): SUBDIRS += painting/vertextransform
+}
+
 include(../trusted-benchmarks.pri)
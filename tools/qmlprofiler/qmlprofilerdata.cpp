@@ -47,7 +47,8 @@ static const char *RANGE_TYPE_STRINGS[] = {
     "Creating",
     "Binding",
     "HandlingSignal",
-    "Javascript"
+    "Javascript",
+    "ImportResolution"
 };
 
 Q_STATIC_ASSERT(sizeof(RANGE_TYPE_STRINGS) ==